@@ -4,12 +4,82 @@
 #include <stdio.h>
 #include "BsEditorApplication.h"
 #include "Error/BsCrashHandler.h"
+#include "FileSystem/BsFileSystem.h"
+
+using namespace bs;
+
+/** Options provided to the editor executable through the command line. */
+struct EditorCommandLine
+{
+	bool build = false; /**< True if the editor should build a project headlessly, and then exit. */
+	Path projectPath; /**< Project to build. */
+	PlatformType platform = PlatformType::Windows; /**< Platform to build the project for. */
+};
+
+/**
+ * Parses the editor command line. Supported usage:
+ *
+ * Banshee3D --build <project path> [--platform <platform name>]
+ *
+ * Returns false if the command line is not valid.
+ */
+bool parseCommandLine(int argc, char* argv[], EditorCommandLine& output)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const String arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+
+		if (arg == "--build" && hasValue)
+		{
+			output.build = true;
+			output.projectPath = Path(argv[++i]);
+
+			if (!output.projectPath.isAbsolute())
+				output.projectPath.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+		}
+		else if (arg == "--platform" && hasValue)
+		{
+			const String platformName = argv[++i];
+			if (platformName == "Windows")
+				output.platform = PlatformType::Windows;
+			else
+			{
+				std::cerr << "Unknown platform \"" << platformName << "\"." << std::endl;
+				return false;
+			}
+		}
+		else
+		{
+			std::cerr << "Unknown argument \"" << arg << "\"." << std::endl;
+			std::cerr << "Usage: Banshee3D [--build <project path> [--platform <platform name>]]" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** Starts the editor without a user interface, builds the project and reports the statistics. Returns the exit code. */
+int buildHeadless(const EditorCommandLine& commandLine)
+{
+	EditorApplication::startUp(EditorMode::Headless);
+	HeadlessBuildStats stats = gEditorApplication().runHeadlessBuild(commandLine.projectPath, commandLine.platform);
+	EditorApplication::shutDown();
+
+	std::cout << "Build " << (stats.success ? "succeeded" : "failed") << "." << std::endl;
+	std::cout << "Resources imported: " << stats.numImported << std::endl;
+	std::cout << "Project load time: " << stats.loadTime << " ms" << std::endl;
+	std::cout << "Import time: " << stats.importTime << " ms" << std::endl;
+	std::cout << "Build time: " << stats.buildTime << " ms" << std::endl;
+	std::cout << "Total time: " << stats.totalTime << " ms" << std::endl;
+
+	return stats.success ? 0 : 1;
+}
 
 #if BS_PLATFORM == BS_PLATFORM_WIN32
 #include <windows.h>
 
-using namespace bs;
-
 int CALLBACK WinMain(
 	_In_  HINSTANCE hInstance,
 	_In_  HINSTANCE hPrevInstance,
@@ -17,13 +87,33 @@ int CALLBACK WinMain(
 	_In_  int nCmdShow
 	)
 {
+	EditorCommandLine commandLine;
+	if (__argc > 1)
+	{
+		// GUI applications have no console of their own, write to the console of the process that ran the editor
+		if (AttachConsole(ATTACH_PARENT_PROCESS))
+		{
+			freopen("CONOUT$", "w", stdout);
+			freopen("CONOUT$", "w", stderr);
+		}
+
+		if (!parseCommandLine(__argc, __argv, commandLine))
+			return 1;
+	}
+
 	CrashHandler::startUp();
 
+	int exitCode = 0;
 	__try
 	{
-		EditorApplication::startUp();
-		EditorApplication::instance().runMainLoop();
-		EditorApplication::shutDown();
+		if (commandLine.build)
+			exitCode = buildHeadless(commandLine);
+		else
+		{
+			EditorApplication::startUp();
+			EditorApplication::instance().runMainLoop();
+			EditorApplication::shutDown();
+		}
 	}
 	__except (gCrashHandler().reportCrash(GetExceptionInformation()))
 	{
@@ -32,15 +122,22 @@ int CALLBACK WinMain(
 
 	CrashHandler::shutDown();
 
-	return 0;
+	return exitCode;
 }
 #else
-using namespace bs;
-
-int main()
+int main(int argc, char* argv[])
 {
+	EditorCommandLine commandLine;
+	if (!parseCommandLine(argc, argv, commandLine))
+		return 1;
+
+	if (commandLine.build)
+		return buildHeadless(commandLine);
+
 	EditorApplication::startUp();
 	EditorApplication::instance().runMainLoop();
 	EditorApplication::shutDown();
+
+	return 0;
 }
-#endif // End BS_PLATFORM
\ No newline at end of file
+#endif // End BS_PLATFORM
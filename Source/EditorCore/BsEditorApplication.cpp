@@ -19,6 +19,7 @@
 #include "Library/BsEditorShaderIncludeHandler.h"
 #include "EditorWindow/BsDropDownWindowManager.h"
 #include "Library/BsProjectLibrary.h"
+#include "Library/BsImportCache.h"
 #include "Settings/BsProjectSettings.h"
 #include "Settings/BsEditorSettings.h"
 #include "Script/BsScriptManager.h"
@@ -39,13 +40,24 @@ namespace bs
 	const Path EditorApplication::BUILD_DATA_PATH = PROJECT_INTERNAL_DIR + "BuildData.asset";
 	const Path EditorApplication::PROJECT_SETTINGS_PATH = PROJECT_INTERNAL_DIR + "Settings.asset";
 
-	START_UP_DESC createStartupDesc()
+	START_UP_DESC createStartupDesc(EditorMode mode)
 	{
 		START_UP_DESC startUpDesc;
-		startUpDesc.renderAPI = BS_RENDER_API_MODULE;
-		startUpDesc.renderer = BS_RENDERER_MODULE;
-		startUpDesc.audio = BS_AUDIO_MODULE;
-		startUpDesc.physics = BS_PHYSICS_MODULE;
+		if (mode == EditorMode::Headless)
+		{
+			startUpDesc.renderAPI = "bsfNullRenderAPI";
+			startUpDesc.renderer = "bsfNullRenderer";
+			startUpDesc.audio = "bsfNullAudio";
+			startUpDesc.physics = "bsfNullPhysics";
+		}
+		else
+		{
+			startUpDesc.renderAPI = BS_RENDER_API_MODULE;
+			startUpDesc.renderer = BS_RENDERER_MODULE;
+			startUpDesc.audio = BS_AUDIO_MODULE;
+			startUpDesc.physics = BS_PHYSICS_MODULE;
+		}
+
 		startUpDesc.scripting = true;
 
 		startUpDesc.primaryWindowDesc.videoMode = VideoMode(1920, 1080);
@@ -70,8 +82,14 @@ namespace bs
 		return gEditorApplication().getDataPath() + "Settings.asset";
 	}
 
-	EditorApplication::EditorApplication()
-		:Application(createStartupDesc()), mIsProjectLoaded(false), mSBansheeEditorPlugin(nullptr)
+	/** Converts the time elapsed on the timer to milliseconds. */
+	static float getElapsedMs(const Timer& timer)
+	{
+		return timer.getMicroseconds() / 1000.0f;
+	}
+
+	EditorApplication::EditorApplication(EditorMode mode)
+		:Application(createStartupDesc(mode)), mMode(mode), mIsProjectLoaded(false), mSBansheeEditorPlugin(nullptr)
 	{
 
 	}
@@ -135,7 +153,9 @@ namespace bs
 		BuildManager::startUp();
 		CodeEditorManager::startUp();
 
-		MainEditorWindow::create(getPrimaryWindow());
+		if (!isHeadless())
+			MainEditorWindow::create(getPrimaryWindow());
+
 		ScriptManager::instance().initialize();
 	}
 
@@ -181,13 +201,70 @@ namespace bs
 			unloadPlugin(mMonoPlugin);
 	}
 
-	void EditorApplication::startUp()
+	void EditorApplication::startUp(EditorMode mode)
 	{
-		CoreApplication::startUp<EditorApplication>();
+		CoreApplication::startUp<EditorApplication>(mode);
+	}
+
+	HeadlessBuildStats EditorApplication::runHeadlessBuild(const Path& projectPath, PlatformType platform)
+	{
+		typedef bool(*RunHeadlessBuildFunc)();
+
+		HeadlessBuildStats stats;
+		Timer totalTimer;
+
+		if (!isValidProjectPath(projectPath))
+		{
+			LOGERR("Cannot build, \"" + projectPath.toString() + "\" is not a valid project.");
+			return stats;
+		}
+
+		Timer timer;
+		loadProject(projectPath);
+		stats.loadTime = getElapsedMs(timer);
+
+		timer.reset();
+		stats.numImported = gProjectLibrary().checkForModifications(gProjectLibrary().getResourcesFolder());
+		gProjectLibrary()._finishQueuedImports(true);
+		stats.importTime = getElapsedMs(timer);
+
+		// Resources that failed to import would be missing from the build
+		const UINT32 numFailed = gProjectLibrary().getFailedImportCount();
+		if (numFailed > 0)
+		{
+			LOGERR("Cannot build, " + toString(numFailed) + " resource(s) failed to import.");
+
+			stats.totalTime = getElapsedMs(totalTimer);
+			return stats;
+		}
+
+		BuildManager::instance().setActivePlatform(platform);
+
+		// Build pipeline is implemented in the managed editor assembly
+		timer.reset();
+		RunHeadlessBuildFunc runHeadlessBuildCall = nullptr;
+		if (mSBansheeEditorPlugin != nullptr)
+			runHeadlessBuildCall = (RunHeadlessBuildFunc)mSBansheeEditorPlugin->getSymbol("runHeadlessBuild");
+
+		if (runHeadlessBuildCall != nullptr)
+			stats.success = runHeadlessBuildCall();
+		else
+			LOGERR("Cannot build, the editor script plugin is not loaded.");
+
+		stats.buildTime = getElapsedMs(timer);
+
+		// Persist the import results so the next build of the project only imports what changed since
+		saveProject();
+
+		stats.totalTime = getElapsedMs(totalTimer);
+		return stats;
 	}
 
 	void EditorApplication::startUpRenderer()
 	{
+		if (isHeadless())
+			return;
+
 		mSplashScreenTimer.reset();
 		SplashScreen::show();
 	}
@@ -198,6 +275,7 @@ namespace bs
 
 		EditorWidgetManager::instance().update();
 		DropDownWindowManager::instance().update();
+		ScenePicking::instance().update();
 	}
 
 	void EditorApplication::postUpdate()
@@ -208,7 +286,7 @@ namespace bs
 
 		Application::postUpdate();
 
-		if(mSplashScreenShown)
+		if(mSplashScreenShown && !isHeadless())
 		{
 			UINT64 currentTime = mSplashScreenTimer.getMilliseconds();
 			if (currentTime >= SPLASH_SCREEN_DURATION_MS)
@@ -268,7 +346,10 @@ namespace bs
 		buildDataPath.append(BUILD_DATA_PATH);
 
 		BuildManager::instance().save(buildDataPath);
-		saveWidgetLayout(EditorWidgetManager::instance().getLayout());
+
+		if (!isHeadless())
+			saveWidgetLayout(EditorWidgetManager::instance().getLayout());
+
 		saveEditorSettings();
 		saveProjectSettings();
 
@@ -310,10 +391,27 @@ namespace bs
 		buildDataPath.append(BUILD_DATA_PATH);
 
 		BuildManager::instance().load(buildDataPath);
-		gProjectLibrary().loadLibrary();
+
+		// Import cache is optional, enabled by specifying its location in editor settings
+		SPtr<ImportCache> importCache;
+		const WString importCacheFolder = mEditorSettings->getString("ImportCacheFolder");
+		if (!importCacheFolder.empty())
+		{
+			importCache = bs_shared_ptr_new<ImportCache>(Path(importCacheFolder));
+
+			const WString sharedImportCacheFolder = mEditorSettings->getString("SharedImportCacheFolder");
+			if (!sharedImportCacheFolder.empty())
+				importCache->addBackend(bs_shared_ptr_new<FolderImportCacheBackend>(Path(sharedImportCacheFolder)));
+		}
+
+		gProjectLibrary().setImportCache(importCache);
+		gProjectLibrary().loadLibrary(getProjectPath());
 
 		// Do this before restoring windows to ensure types are loaded
 		ScriptManager::instance().reload();
+
+		if (isHeadless())
+			return;
 		
 		SPtr<EditorWidgetLayout> layout = loadWidgetLayout();
 		if (layout != nullptr)
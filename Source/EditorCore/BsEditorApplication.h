@@ -5,6 +5,7 @@
 #include "BsEditorPrerequisites.h"
 #include "BsApplication.h"
 #include "Utility/BsTimer.h"
+#include "Build/BsPlatformInfo.h"
 
 namespace bs
 {
@@ -12,15 +13,53 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Determines how is the editor ran. */
+	enum class EditorMode
+	{
+		/** Regular editor with its user interface. */
+		Standard,
+		/**
+		 * Editor without any user interface, for running builds from the command line. Uses the null render API,
+		 * renderer, audio and physics backends so no window, display or GPU device is required.
+		 */
+		Headless
+	};
+
+	/** Statistics about a build ran with EditorApplication::runHeadlessBuild(). All times are in milliseconds. */
+	struct HeadlessBuildStats
+	{
+		bool success = false; /**< True if the build completed successfully. */
+		UINT32 numImported = 0; /**< Number of resources imported because they changed since the project was saved. */
+
+		float loadTime = 0.0f; /**< Time spent loading the project. */
+		float importTime = 0.0f; /**< Time spent checking for modified resources and importing them. */
+		float buildTime = 0.0f; /**< Time spent running the build pipeline. */
+		float totalTime = 0.0f; /**< Total time of the headless build. */
+	};
+
 	/**	Primary editor class containing the editor entry point. */
 	class BS_ED_EXPORT EditorApplication : public Application
 	{
 	public:
-		EditorApplication();
+		EditorApplication(EditorMode mode = EditorMode::Standard);
 		virtual ~EditorApplication();
 
 		/**	Starts the editor with the specified render and audio systems. */
-		static void startUp();
+		static void startUp(EditorMode mode = EditorMode::Standard);
+
+		/** Checks is the editor running without a user interface. See EditorMode::Headless. */
+		bool isHeadless() const { return mMode == EditorMode::Headless; }
+
+		/**
+		 * Loads the project, imports all resources that were modified since the project was last saved and builds the
+		 * project for the specified platform, using the platform settings saved in the project. Imports are performed
+		 * synchronously. Should be called instead of runMainLoop() when the editor is started in headless mode.
+		 *
+		 * @param[in]	projectPath		Absolute path to the root project folder.
+		 * @param[in]	platform		Platform to build the project for.
+		 * @return						Statistics about the build, including whether it succeeded.
+		 */
+		HeadlessBuildStats runHeadlessBuild(const Path& projectPath, PlatformType platform);
 
 		/**	Checks whether the editor currently has a project loaded. */
 		bool isProjectLoaded() const { return mIsProjectLoaded; }
@@ -144,6 +183,7 @@ namespace bs
 
 		Path mBuiltinDataPath;
 
+		EditorMode mMode;
 		bool mIsProjectLoaded;
 		Path mProjectPath;
 		String mProjectName;
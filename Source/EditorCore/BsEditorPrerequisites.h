@@ -174,6 +174,19 @@ namespace bs
 	class EditorCommand;
 	class ProjectFileMeta;
 	class ProjectResourceMeta;
+	class ImportCache;
+	class ProjectLibraryJournal;
+	struct ProjectLibraryJournalEntry;
+	class ResourceUUIDIndex;
+	class ProjectLibrarySearchIndex;
+	class ResourceDependencyGraph;
+	class ResourcePackager;
+	class ResourceArchiveWriter;
+	class ResourceLoadProfile;
+	class ResourceLoadRecorder;
+	class ResourceCooker;
+	class IconGenerator;
+	class BuildManifest;
 	class SceneGrid;
 	class HandleSlider;
 	class HandleSliderLine;
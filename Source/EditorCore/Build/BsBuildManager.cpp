@@ -4,6 +4,7 @@
 #include "RTTI/BsBuildDataRTTI.h"
 #include "Serialization/BsFileSerializer.h"
 #include "FileSystem/BsFileSystem.h"
+#include "Resources/BsGameResourceManager.h"
 #include "BsEditorApplication.h"
 
 namespace bs
@@ -133,6 +134,8 @@ namespace bs
 			return Paths::RELEASE_ASSEMBLY_PATH;
 		case BuildFolder::Data:
 			return Paths::FRAMEWORK_DATA_PATH;
+		case BuildFolder::Resources:
+			return Path(GAME_RESOURCES_FOLDER_NAME);
 		}
 
 		return Path::BLANK;
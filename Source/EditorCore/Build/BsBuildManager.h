@@ -39,7 +39,8 @@ namespace bs
 		NativeBinaries, /**< Folder where native binaries are stored. Relative to root. */
 		BansheeReleaseAssemblies, /**< Folder where Banshee specific release assemblies are stored. Relative to root. */
 		BansheeDebugAssemblies, /**< Folder where Banshee specific debug assemblies are stored. Relative to root. */
-		Data /**< Folder where builtin data is stored. Relative to root. */
+		Data, /**< Folder where builtin data is stored. Relative to root. */
+		Resources /**< Folder where packaged game resources are stored. Relative to root. */
 	};
 
 	/**	Handles building of the game executable and related files. */
@@ -0,0 +1,260 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Build/BsBuildManifest.h"
+#include "Resources/BsGameResourceManager.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsContentHash.h"
+#include "Utility/BsEditorUtility.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	const char* BuildManifest::MANIFEST_NAME = "BuildManifest.txt";
+	const char* BuildManifest::REMOVED_FILES_NAME = "RemovedFiles.txt";
+	const char* BuildManifest::HEADER = "# Banshee build manifest 1";
+
+	void BuildManifest::add(const String& path, UINT64 size, UINT64 hash)
+	{
+		BuildManifestEntry& entry = mEntries[path];
+		entry.path = path;
+		entry.size = size;
+		entry.hash = hash;
+	}
+
+	bool BuildManifest::save(const Path& path) const
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if (stream == nullptr)
+			return false;
+
+		StringStream output;
+		output << HEADER << "\n";
+
+		// Each line is: <hash in hex>\t<size>\t<path>. Path goes last since it can contain whitespace.
+		char hashStr[17];
+		for (auto& entry : mEntries)
+		{
+			snprintf(hashStr, sizeof(hashStr), "%016llx", (unsigned long long)entry.second.hash);
+			output << hashStr << "\t" << entry.second.size << "\t" << entry.second.path << "\n";
+		}
+
+		const String contents = output.str();
+		stream->write(contents.data(), contents.size());
+		stream->close();
+
+		return true;
+	}
+
+	SPtr<BuildManifest> BuildManifest::load(const Path& path)
+	{
+		if (!FileSystem::isFile(path))
+			return nullptr;
+
+		SPtr<DataStream> stream = FileSystem::openFile(path, true);
+		if (stream == nullptr)
+			return nullptr;
+
+		const String contents = stream->getAsString();
+		stream->close();
+
+		Vector<String> lines = StringUtil::split(contents, "\n");
+		if (lines.empty() || lines[0] != HEADER)
+		{
+			LOGWRN("Build manifest \"" + path.toString() + "\" is corrupt or incompatible.");
+			return nullptr;
+		}
+
+		SPtr<BuildManifest> manifest = bs_shared_ptr_new<BuildManifest>();
+		for (size_t i = 1; i < lines.size(); i++)
+		{
+			const String& line = lines[i];
+			if (line.empty())
+				continue;
+
+			const size_t hashEnd = line.find('\t');
+			const size_t sizeEnd = hashEnd != String::npos ? line.find('\t', hashEnd + 1) : String::npos;
+			if (sizeEnd == String::npos)
+			{
+				LOGWRN("Build manifest \"" + path.toString() + "\" is corrupt or incompatible.");
+				return nullptr;
+			}
+
+			const UINT64 hash = strtoull(line.substr(0, hashEnd).c_str(), nullptr, 16);
+			const UINT64 size = strtoull(line.substr(hashEnd + 1, sizeEnd - hashEnd - 1).c_str(), nullptr, 10);
+
+			manifest->add(line.substr(sizeEnd + 1), size, hash);
+		}
+
+		return manifest;
+	}
+
+	SPtr<BuildManifest> BuildManifest::create(const Path& buildFolder)
+	{
+		const Path manifestPath = getManifestPath(buildFolder);
+
+		Vector<Path> files;
+		findFiles(buildFolder, files);
+
+		files.erase(std::remove(files.begin(), files.end(), manifestPath), files.end());
+
+		Vector<BuildManifestEntry> entries(files.size());
+		EditorUtility::runInParallel("BuildManifest", (UINT32)files.size(), 1,
+			[&files, &entries, &buildFolder](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				Path relativePath = files[i];
+				relativePath.makeRelative(buildFolder);
+
+				// Paths are always stored with forward slashes, so manifests don't depend on the platform they were made on
+				entries[i].path = relativePath.toString(Path::PathType::Unix);
+				entries[i].size = FileSystem::getFileSize(files[i]);
+				entries[i].hash = ContentHash::hashFile(files[i]);
+			}
+		});
+
+		SPtr<BuildManifest> manifest = bs_shared_ptr_new<BuildManifest>();
+		for (auto& entry : entries)
+			manifest->add(entry.path, entry.size, entry.hash);
+
+		return manifest;
+	}
+
+	BuildManifestDiff BuildManifest::diff(const BuildManifest& oldManifest, const BuildManifest& newManifest)
+	{
+		BuildManifestDiff output;
+
+		// Both entry maps are sorted by path, so they can be walked in lockstep
+		auto iterOld = oldManifest.mEntries.begin();
+		auto iterNew = newManifest.mEntries.begin();
+		while (iterOld != oldManifest.mEntries.end() || iterNew != newManifest.mEntries.end())
+		{
+			if (iterNew == newManifest.mEntries.end() ||
+				(iterOld != oldManifest.mEntries.end() && iterOld->first < iterNew->first))
+			{
+				output.removed.push_back(iterOld->first);
+				++iterOld;
+			}
+			else if (iterOld == oldManifest.mEntries.end() || iterNew->first < iterOld->first)
+			{
+				output.added.push_back(iterNew->first);
+				++iterNew;
+			}
+			else
+			{
+				if (iterOld->second.hash != iterNew->second.hash || iterOld->second.size != iterNew->second.size)
+					output.modified.push_back(iterNew->first);
+
+				++iterOld;
+				++iterNew;
+			}
+		}
+
+		return output;
+	}
+
+	bool BuildManifest::createPatch(const BuildManifest& oldManifest, const Path& buildFolder, const Path& patchFolder)
+	{
+		const Path manifestPath = getManifestPath(buildFolder);
+
+		SPtr<BuildManifest> newManifest = load(manifestPath);
+		if (newManifest == nullptr)
+		{
+			LOGERR("Cannot create patch, build in \"" + buildFolder.toString() + "\" has no valid build manifest.");
+			return false;
+		}
+
+		const BuildManifestDiff changes = diff(oldManifest, *newManifest);
+
+		if (FileSystem::exists(patchFolder))
+			FileSystem::remove(patchFolder, true);
+
+		FileSystem::createDir(patchFolder);
+
+		auto copyFile = [&buildFolder, &patchFolder](const String& relativePath)
+		{
+			const Path relative(relativePath, Path::PathType::Unix);
+
+			Path destination = patchFolder;
+			destination.append(relative);
+
+			Path destinationFolder = destination.getParent();
+			if (!FileSystem::isDirectory(destinationFolder))
+				FileSystem::createDir(destinationFolder);
+
+			Path source = buildFolder;
+			source.append(relative);
+
+			FileSystem::copy(source, destination, true);
+		};
+
+		for (auto& entry : changes.added)
+			copyFile(entry);
+
+		for (auto& entry : changes.modified)
+			copyFile(entry);
+
+		// Include the new manifest so the patched build can be patched again
+		Path patchManifestPath = manifestPath;
+		patchManifestPath.makeRelative(buildFolder);
+		copyFile(patchManifestPath.toString(Path::PathType::Unix));
+
+		StringStream removedFiles;
+		for (auto& entry : changes.removed)
+			removedFiles << entry << "\n";
+
+		Path removedFilesPath = patchFolder;
+		removedFilesPath.append(REMOVED_FILES_NAME);
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(removedFilesPath);
+		if (stream == nullptr)
+			return false;
+
+		const String contents = removedFiles.str();
+		stream->write(contents.data(), contents.size());
+		stream->close();
+
+		LOGDBG("Created patch in \"" + patchFolder.toString() + "\": " + toString((UINT32)changes.added.size()) +
+			" added, " + toString((UINT32)changes.modified.size()) + " modified, " +
+			toString((UINT32)changes.removed.size()) + " removed files.");
+
+		return true;
+	}
+
+	SPtr<BuildManifest> BuildManifest::writeToBuild(const Path& buildFolder)
+	{
+		SPtr<BuildManifest> manifest = create(buildFolder);
+
+		const Path manifestPath = getManifestPath(buildFolder);
+		if (!manifest->save(manifestPath))
+		{
+			LOGWRN("Unable to save the build manifest to \"" + manifestPath.toString() + "\".");
+			return nullptr;
+		}
+
+		return manifest;
+	}
+
+	Path BuildManifest::getManifestPath(const Path& buildFolder)
+	{
+		Path manifestPath = buildFolder;
+		manifestPath.append(GAME_RESOURCES_FOLDER_NAME);
+		manifestPath.setFilename(MANIFEST_NAME);
+
+		return manifestPath;
+	}
+
+	void BuildManifest::findFiles(const Path& folder, Vector<Path>& output)
+	{
+		Vector<Path> files;
+		Vector<Path> folders;
+		FileSystem::getChildren(folder, files, folders);
+
+		for (auto& file : files)
+			output.push_back(file);
+
+		for (auto& childFolder : folders)
+			findFiles(childFolder, output);
+	}
+}
@@ -0,0 +1,94 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Build
+	 *  @{
+	 */
+
+	/** Single file in a BuildManifest. */
+	struct BuildManifestEntry
+	{
+		String path; /**< Path of the file relative to the build folder, using forward slashes. */
+		UINT64 size = 0; /**< Size of the file in bytes. */
+		UINT64 hash = 0; /**< Hash of the file contents. */
+	};
+
+	/** Differences between two build manifests. All paths are relative to the build folder, sorted. */
+	struct BuildManifestDiff
+	{
+		Vector<String> added; /**< Files only present in the new build. */
+		Vector<String> modified; /**< Files present in both builds, with different contents. */
+		Vector<String> removed; /**< Files only present in the old build. */
+	};
+
+	/**
+	 * Lists every file in a build along with a hash of its contents. A manifest is written into every build, allowing
+	 * two builds to be compared file by file, and a patch containing only the changed files to be created.
+	 *
+	 * The manifest is a text file with one file per line, sorted by path, so builds of identical inputs produce identical
+	 * manifests and manifests can be compared with regular text tools.
+	 */
+	class BS_ED_EXPORT BuildManifest
+	{
+	public:
+		/** Registers a file with the manifest, replacing an existing entry with the same path. */
+		void add(const String& path, UINT64 size, UINT64 hash);
+
+		/** Returns all files in the manifest, keyed and sorted by path. */
+		const Map<String, BuildManifestEntry>& getEntries() const { return mEntries; }
+
+		/** Saves the manifest to the specified file. Returns false if the file couldn't be written. */
+		bool save(const Path& path) const;
+
+		/** Loads a manifest saved with save(). Returns null if the file doesn't exist or isn't a valid manifest. */
+		static SPtr<BuildManifest> load(const Path& path);
+
+		/**
+		 * Creates a manifest of all files in the build folder, hashing them on task scheduler worker threads. The build's
+		 * own manifest file is not included.
+		 */
+		static SPtr<BuildManifest> create(const Path& buildFolder);
+
+		/** Compares two manifests and returns the files that were added, modified or removed in the new one. */
+		static BuildManifestDiff diff(const BuildManifest& oldManifest, const BuildManifest& newManifest);
+
+		/**
+		 * Creates a patch that updates the build described by the old manifest to the build in the build folder. The patch
+		 * folder receives the added and modified files, the new build's manifest and a list of files to remove.
+		 *
+		 * @param[in]	oldManifest		Manifest of the build the patch is applied to.
+		 * @param[in]	buildFolder		Root folder of the new build. Must contain a manifest written by
+		 *								writeToBuild().
+		 * @param[in]	patchFolder		Folder to write the patch to.
+		 * @return						False if the patch could not be created.
+		 */
+		static bool createPatch(const BuildManifest& oldManifest, const Path& buildFolder, const Path& patchFolder);
+
+		/** Creates a manifest for the build in the build folder and saves it in the build. Returns null on failure. */
+		static SPtr<BuildManifest> writeToBuild(const Path& buildFolder);
+
+		/** Returns the path of the manifest within the provided build folder. */
+		static Path getManifestPath(const Path& buildFolder);
+
+		/** Name of the manifest file in the build's resource folder. */
+		static const char* MANIFEST_NAME;
+
+		/** Name of the file in the patch folder listing the files the patch removes, one per line. */
+		static const char* REMOVED_FILES_NAME;
+
+	private:
+		/** Appends the paths of all files in the folder and its sub-folders to the output. */
+		static void findFiles(const Path& folder, Vector<Path>& output);
+
+		static const char* HEADER;
+
+		Map<String, BuildManifestEntry> mEntries;
+	};
+
+	/** @} */
+}
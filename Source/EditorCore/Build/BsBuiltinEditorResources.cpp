@@ -91,6 +91,9 @@ namespace bs
 	const String BuiltinEditorResources::ShaderGizmoPickingFile = u8"GizmoPicking.bsl";
 	const String BuiltinEditorResources::ShaderGizmoPickingAlphaFile = u8"GizmoPickingAlpha.bsl";
 	const String BuiltinEditorResources::ShaderTextGizmoFile = u8"TextGizmo.bsl";
+	const String BuiltinEditorResources::ShaderSolidGizmoInstancedFile = u8"SolidGizmoInstanced.bsl";
+	const String BuiltinEditorResources::ShaderLineGizmoInstancedFile = u8"LineGizmoInstanced.bsl";
+	const String BuiltinEditorResources::ShaderGizmoPickingInstancedFile = u8"GizmoPickingInstanced.bsl";
 	const String BuiltinEditorResources::ShaderSelectionFile = u8"Selection.bsl";
 
 	/************************************************************************/
@@ -184,6 +187,9 @@ namespace bs
 		mShaderGizmoPicking = getShader(ShaderGizmoPickingFile);
 		mShaderGizmoAlphaPicking = getShader(ShaderGizmoPickingAlphaFile);
 		mShaderGizmoText = getShader(ShaderTextGizmoFile);
+		mShaderGizmoSolidInstanced = getShader(ShaderSolidGizmoInstancedFile);
+		mShaderGizmoLineInstanced = getShader(ShaderLineGizmoInstancedFile);
+		mShaderGizmoPickingInstanced = getShader(ShaderGizmoPickingInstancedFile);
 		mShaderHandleSolid = getShader(ShaderSolidHandleFile);
 		mShaderHandleClearAlpha = getShader(ShaderHandleClearAlphaFile);
 		mShaderHandleLine = getShader(ShaderLineHandleFile);
@@ -518,6 +524,21 @@ namespace bs
 		return Material::create(mShaderGizmoAlphaPicking);
 	}
 
+	HMaterial BuiltinEditorResources::createInstancedSolidGizmoMat() const
+	{
+		return Material::create(mShaderGizmoSolidInstanced);
+	}
+
+	HMaterial BuiltinEditorResources::createInstancedLineGizmoMat() const
+	{
+		return Material::create(mShaderGizmoLineInstanced);
+	}
+
+	HMaterial BuiltinEditorResources::createInstancedGizmoPickingMat() const
+	{
+		return Material::create(mShaderGizmoPickingInstanced);
+	}
+
 	HMaterial BuiltinEditorResources::createLineHandleMat() const
 	{
 		return Material::create(mShaderHandleLine);
@@ -6,7 +6,8 @@
 namespace bs
 {
 	PlatformInfo::PlatformInfo()
-		:type(PlatformType::Windows), fullscreen(true), windowedWidth(1280), windowedHeight(720)
+		:type(PlatformType::Windows), fullscreen(true), windowedWidth(1280), windowedHeight(720), packResources(false),
+		compressTextures(false), textureMipsToSkip(0), stripMeshTangents(false), stripCPUCachedData(false)
 	{ }
 
 	PlatformInfo::~PlatformInfo()
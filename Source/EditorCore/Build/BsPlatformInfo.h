@@ -32,6 +32,19 @@ namespace bs
 		UINT32 windowedWidth; /**< Width of the window if not starting the application in fullscreen. */
 		UINT32 windowedHeight; /**< Height of the window if not starting the application in fullscreen. */
 		bool debug; /**< Determines should the scripts be output in debug mode (worse performance but better error reporting). */
+		bool packResources; /**< If true resources are packed into a single archive, instead of being output as separate files. */
+
+		/** @name Resource cooking
+		 *  Settings used for converting textures and meshes for the platform when they are packaged.
+		 *  @{
+		 */
+
+		bool compressTextures; /**< If true uncompressed textures are block compressed. */
+		UINT32 textureMipsToSkip; /**< Number of largest mip levels to remove from textures. */
+		bool stripMeshTangents; /**< If true meshes are output without tangents. */
+		bool stripCPUCachedData; /**< If true textures and meshes don't keep a CPU copy of their data in the build. */
+
+		/** @} */
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
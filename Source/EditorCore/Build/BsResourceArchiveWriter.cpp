@@ -0,0 +1,346 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Build/BsResourceArchiveWriter.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsCompression.h"
+#include "Math/BsMath.h"
+#include "Utility/BsEditorUtility.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	const char* ResourceArchiveWriter::ARCHIVE_NAME = "Resources.archive";
+	const UINT32 ResourceArchiveWriter::MAGIC = 0x41525342; // "BSRA"
+	const UINT32 ResourceArchiveWriter::VERSION = 2;
+	const UINT32 ResourceArchiveWriter::PAGE_SIZE = 4096;
+	const UINT32 ResourceArchiveWriter::COMPRESSED_ALIGNMENT = 16;
+	const UINT32 ResourceArchiveWriter::FLAG_COMPRESSED = 1 << 0;
+	const UINT32 ResourceArchiveWriter::BATCH_SIZE = 32;
+
+	ResourceArchiveWriter::ResourceArchiveWriter(const Path& path, UINT64 maxChunkSize)
+		:mPath(path), mMaxChunkSize(maxChunkSize)
+	{ }
+
+	void ResourceArchiveWriter::add(const UUID& uuid, const Path& assetPath, UINT64 key)
+	{
+		mEntries.push_back({ uuid, assetPath, key });
+	}
+
+	bool ResourceArchiveWriter::write()
+	{
+		mNumReused = 0;
+
+		PreviousArchive previous;
+		openPrevious(previous);
+
+		const bool success = write(previous);
+
+		if (!previous.path.isEmpty())
+			remove(previous.path);
+
+		return success;
+	}
+
+	bool ResourceArchiveWriter::write(const PreviousArchive& previous)
+	{
+		// Table of contents is sorted so the game can use binary search to find entries
+		std::sort(mEntries.begin(), mEntries.end(), [](const Entry& a, const Entry& b) { return a.uuid < b.uuid; });
+
+		const UINT32 numEntries = (UINT32)mEntries.size();
+		Vector<TocEntry> toc(numEntries);
+
+		SPtr<DataStream> firstStream = FileSystem::createAndOpenFile(mPath);
+		if (firstStream == nullptr)
+		{
+			LOGERR("Unable to create resource archive \"" + mPath.toString() + "\".");
+			return false;
+		}
+
+		// Space for the header and the table of contents, written once all entries are known
+		UINT64 offset = sizeof(Header) + numEntries * (UINT64)sizeof(TocEntry);
+		writeZeroes(firstStream, offset);
+
+		SPtr<DataStream> stream = firstStream;
+		UINT32 chunk = 0;
+		UINT32 numChunkEntries = 0;
+
+		// Assets are read and compressed on worker threads in batches, so only a limited number of them is kept in
+		// memory at once
+		Vector<SPtr<MemoryDataStream>> data(BATCH_SIZE);
+		Vector<UINT64> uncompressedSizes(BATCH_SIZE);
+		Vector<UINT8> compressed(BATCH_SIZE);
+		Vector<UINT8> reused(BATCH_SIZE);
+
+		for (UINT32 batchStart = 0; batchStart < numEntries; batchStart += BATCH_SIZE)
+		{
+			const UINT32 batchSize = std::min(BATCH_SIZE, numEntries - batchStart);
+
+			EditorUtility::runInParallel("ArchiveCompress", batchSize, 1,
+				[this, batchStart, &previous, &data, &uncompressedSizes, &compressed, &reused](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					const Entry& entry = mEntries[batchStart + i];
+
+					data[i] = nullptr;
+					compressed[i] = false;
+					reused[i] = false;
+
+					// Unchanged entries are copied from the previous archive as stored, avoiding recompression
+					const TocEntry* previousEntry = nullptr;
+					if (entry.key != 0)
+					{
+						const auto iterFind = std::lower_bound(previous.toc.begin(), previous.toc.end(), entry.uuid,
+							[](const TocEntry& tocEntry, const UUID& value) { return tocEntry.uuid < value; });
+
+						if (iterFind != previous.toc.end() && iterFind->uuid == entry.uuid && iterFind->key == entry.key)
+							previousEntry = &*iterFind;
+					}
+
+					if (previousEntry != nullptr)
+					{
+						data[i] = readPrevious(previous, *previousEntry);
+						if (data[i] != nullptr)
+						{
+							uncompressedSizes[i] = previousEntry->uncompressedSize;
+							compressed[i] = (previousEntry->flags & FLAG_COMPRESSED) != 0;
+							reused[i] = true;
+
+							continue;
+						}
+					}
+
+					SPtr<DataStream> file = FileSystem::openFile(entry.assetPath, true);
+					if (file == nullptr)
+						continue;
+
+					SPtr<MemoryDataStream> contents = bs_shared_ptr_new<MemoryDataStream>(file);
+					file->close();
+
+					uncompressedSizes[i] = contents->size();
+
+					// Only keep the compressed data if it is notably smaller, since uncompressed entries can be used
+					// directly from mapped memory
+					SPtr<DataStream> source = contents;
+					SPtr<MemoryDataStream> compressedContents = Compression::compress(source);
+					if (compressedContents != nullptr && compressedContents->size() * 4 <= contents->size() * 3)
+					{
+						data[i] = compressedContents;
+						compressed[i] = true;
+					}
+					else
+						data[i] = contents;
+				}
+			});
+
+			for (UINT32 i = 0; i < batchSize; i++)
+			{
+				const Entry& entry = mEntries[batchStart + i];
+				if (data[i] == nullptr)
+				{
+					LOGERR("Unable to read asset \"" + entry.assetPath.toString() + "\" for the resource archive.");
+
+					if (stream != firstStream)
+						stream->close();
+
+					firstStream->close();
+					return false;
+				}
+
+				const UINT64 size = data[i]->size();
+				const UINT64 alignment = compressed[i] ? COMPRESSED_ALIGNMENT : PAGE_SIZE;
+				const UINT64 alignedOffset = Math::divideAndRoundUp(offset, alignment) * alignment;
+
+				if (mMaxChunkSize > 0 && numChunkEntries > 0 && alignedOffset + size > mMaxChunkSize)
+				{
+					if (stream != firstStream)
+						stream->close();
+
+					chunk++;
+					numChunkEntries = 0;
+
+					const Path chunkPath = getChunkPath(mPath, chunk);
+					stream = FileSystem::createAndOpenFile(chunkPath);
+					if (stream == nullptr)
+					{
+						LOGERR("Unable to create resource archive chunk \"" + chunkPath.toString() + "\".");
+
+						firstStream->close();
+						return false;
+					}
+
+					ChunkHeader chunkHeader = { MAGIC, VERSION, chunk, 0 };
+					stream->write(&chunkHeader, sizeof(chunkHeader));
+					offset = sizeof(chunkHeader);
+				}
+
+				offset = writePadding(stream, offset, alignment);
+				stream->write(data[i]->getPtr(), (size_t)size);
+
+				TocEntry& tocEntry = toc[batchStart + i];
+				tocEntry.uuid = entry.uuid;
+				tocEntry.offset = offset;
+				tocEntry.size = size;
+				tocEntry.uncompressedSize = uncompressedSizes[i];
+				tocEntry.key = entry.key;
+				tocEntry.chunk = chunk;
+				tocEntry.flags = compressed[i] ? FLAG_COMPRESSED : 0;
+
+				offset += size;
+				numChunkEntries++;
+
+				if (reused[i])
+					mNumReused++;
+
+				data[i] = nullptr;
+			}
+		}
+
+		if (stream != firstStream)
+			stream->close();
+
+		Header header = { MAGIC, VERSION, numEntries, chunk + 1, PAGE_SIZE, 0 };
+
+		firstStream->seek(0);
+		firstStream->write(&header, sizeof(header));
+
+		if (!toc.empty())
+			firstStream->write(toc.data(), toc.size() * sizeof(TocEntry));
+
+		firstStream->close();
+
+		// Remove chunks left over from a previous build that needed more of them
+		for (UINT32 i = chunk + 1; ; i++)
+		{
+			const Path chunkPath = getChunkPath(mPath, i);
+			if (!FileSystem::isFile(chunkPath))
+				break;
+
+			FileSystem::remove(chunkPath);
+		}
+
+		return true;
+	}
+
+	void ResourceArchiveWriter::remove(const Path& path)
+	{
+		for (UINT32 i = 0; ; i++)
+		{
+			const Path chunkPath = getChunkPath(path, i);
+			if (!FileSystem::isFile(chunkPath))
+				break;
+
+			FileSystem::remove(chunkPath);
+		}
+	}
+
+	bool ResourceArchiveWriter::openPrevious(PreviousArchive& previous) const
+	{
+		if (!FileSystem::isFile(mPath))
+			return false;
+
+		SPtr<DataStream> stream = FileSystem::openFile(mPath, true);
+		if (stream == nullptr)
+			return false;
+
+		Header header;
+		const bool isHeaderValid = stream->read(&header, sizeof(header)) == sizeof(header) && header.magic == MAGIC &&
+			header.version == VERSION;
+
+		if (!isHeaderValid)
+		{
+			stream->close();
+			return false;
+		}
+
+		Vector<TocEntry> toc(header.numEntries);
+		const size_t tocSize = toc.size() * sizeof(TocEntry);
+		if (tocSize > 0 && stream->read(toc.data(), tocSize) != tocSize)
+		{
+			stream->close();
+			return false;
+		}
+
+		stream->close();
+
+		// The new archive is written to the same path, so the previous one is moved out of the way while it is read
+		Path previousPath = mPath;
+		previousPath.setFilename(mPath.getFilename() + ".previous");
+		remove(previousPath);
+
+		for (UINT32 i = 0; i < header.numChunks; i++)
+		{
+			const Path chunkPath = getChunkPath(mPath, i);
+			if (!FileSystem::isFile(chunkPath))
+			{
+				remove(previousPath);
+				return false;
+			}
+
+			FileSystem::move(chunkPath, getChunkPath(previousPath, i));
+		}
+
+		previous.path = previousPath;
+		previous.toc = std::move(toc);
+
+		return true;
+	}
+
+	SPtr<MemoryDataStream> ResourceArchiveWriter::readPrevious(const PreviousArchive& previous, const TocEntry& entry)
+	{
+		SPtr<DataStream> file = FileSystem::openFile(getChunkPath(previous.path, entry.chunk), true);
+		if (file == nullptr)
+			return nullptr;
+
+		SPtr<MemoryDataStream> data;
+		if (entry.offset + entry.size <= file->size())
+		{
+			data = bs_shared_ptr_new<MemoryDataStream>((size_t)entry.size);
+
+			file->seek((size_t)entry.offset);
+			if (file->read(data->getPtr(), (size_t)entry.size) != (size_t)entry.size)
+				data = nullptr;
+		}
+
+		file->close();
+		return data;
+	}
+
+	Path ResourceArchiveWriter::getChunkPath(const Path& path, UINT32 chunk)
+	{
+		if (chunk == 0)
+			return path;
+
+		Path chunkPath = path;
+		chunkPath.setFilename(path.getFilename(false) + "." + toString(chunk) + path.getExtension());
+
+		return chunkPath;
+	}
+
+	Path ResourceArchiveWriter::getEntryPath(const Path& path, const UUID& uuid)
+	{
+		return Path(path.toString() + "/" + uuid.toString() + ".asset");
+	}
+
+	UINT64 ResourceArchiveWriter::writePadding(const SPtr<DataStream>& stream, UINT64 offset, UINT64 alignment)
+	{
+		const UINT64 alignedOffset = Math::divideAndRoundUp(offset, alignment) * alignment;
+		writeZeroes(stream, alignedOffset - offset);
+
+		return alignedOffset;
+	}
+
+	void ResourceArchiveWriter::writeZeroes(const SPtr<DataStream>& stream, UINT64 size)
+	{
+		static const UINT8 ZEROES[4096] = { 0 };
+
+		while (size > 0)
+		{
+			const UINT64 writeSize = std::min(size, (UINT64)sizeof(ZEROES));
+			stream->write(ZEROES, (size_t)writeSize);
+
+			size -= writeSize;
+		}
+	}
+}
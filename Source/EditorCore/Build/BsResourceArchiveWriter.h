@@ -0,0 +1,157 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Build
+	 *  @{
+	 */
+
+	/**
+	 * Packs resource assets into an archive read by the standalone game. The archive consists of one or multiple chunks,
+	 * where the first chunk starts with a table of contents sorted by resource UUID. Entries are compressed if that
+	 * makes them notably smaller, otherwise they are stored as is and aligned to page boundaries so the game can
+	 * deserialize them directly from memory mapped chunks.
+	 *
+	 * Every entry is stored along with a key identifying its contents. When the archive is written over an archive from
+	 * a previous build, entries whose key didn't change are copied from the previous archive as stored, without reading
+	 * or compressing their assets again.
+	 *
+	 * @note	Archive layout must match the ResourceArchive reader in the Game project.
+	 */
+	class BS_ED_EXPORT ResourceArchiveWriter
+	{
+	public:
+		/**
+		 * @param[in]	path			Path to the first archive chunk. Additional chunks are written next to it, with
+		 *								the chunk index appended to the file name.
+		 * @param[in]	maxChunkSize	Size in bytes after which a new chunk is started. Zero if the archive should
+		 *								be written as a single file. Entries larger than the chunk size get a chunk of
+		 *								their own.
+		 */
+		ResourceArchiveWriter(const Path& path, UINT64 maxChunkSize = 0);
+
+		/**
+		 * Registers a resource asset to be written to the archive.
+		 *
+		 * @param[in]	uuid		UUID of the resource.
+		 * @param[in]	assetPath	Path to the asset containing the serialized resource.
+		 * @param[in]	key			Value that changes whenever the asset contents change, used for reusing the entry
+		 *							from the previous archive. Zero if the entry should never be reused.
+		 */
+		void add(const UUID& uuid, const Path& assetPath, UINT64 key = 0);
+
+		/** Writes all the registered assets to the archive. Returns false if the archive could not be written. */
+		bool write();
+
+		/** Returns the number of entries the last write() copied from the previous archive. */
+		UINT32 getNumReused() const { return mNumReused; }
+
+		/**
+		 * Deletes all chunks of the archive at the specified path, as written by a previous build.
+		 *
+		 * @param[in]	path	Path to the first archive chunk.
+		 */
+		static void remove(const Path& path);
+
+		/** Returns the path of the archive chunk with the specified index. */
+		static Path getChunkPath(const Path& path, UINT32 chunk);
+
+		/**
+		 * Returns the path the resource manifest uses for a resource stored in an archive. Consists of the archive path
+		 * followed by the resource UUID, as if the archive was a folder.
+		 *
+		 * @param[in]	path	Path to the first archive chunk.
+		 * @param[in]	uuid	UUID of the resource.
+		 */
+		static Path getEntryPath(const Path& path, const UUID& uuid);
+
+		static const char* ARCHIVE_NAME;
+
+	private:
+		/** Asset to be written to the archive. */
+		struct Entry
+		{
+			UUID uuid;
+			Path assetPath;
+			UINT64 key;
+		};
+
+		/** Header at the start of the first chunk, followed by the table of contents. */
+		struct Header
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 numEntries;
+			UINT32 numChunks;
+			UINT32 pageSize;
+			UINT32 reserved;
+		};
+
+		/** Header at the start of every chunk other than the first. */
+		struct ChunkHeader
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 chunk;
+			UINT32 reserved;
+		};
+
+		/** Table of contents entry. */
+		struct TocEntry
+		{
+			UUID uuid;
+			UINT64 offset;
+			UINT64 size;
+			UINT64 uncompressedSize;
+			UINT64 key;
+			UINT32 chunk;
+			UINT32 flags;
+		};
+
+		/** Table of contents of an archive written by a previous build. */
+		struct PreviousArchive
+		{
+			Path path; /**< Path to the first chunk. */
+			Vector<TocEntry> toc;
+		};
+
+		/** Writes all the registered assets to the archive, reusing entries from the provided previous archive. */
+		bool write(const PreviousArchive& previous);
+
+		/**
+		 * Moves the archive at the output path, if any, to a temporary location so its entries can be reused while the
+		 * new archive is written. Returns false if there is no valid archive to reuse.
+		 */
+		bool openPrevious(PreviousArchive& previous) const;
+
+		/**
+		 * Reads the data of an entry, as stored, from a previous archive. Returns null if the data can't be read. Safe
+		 * to call from multiple threads at once.
+		 */
+		static SPtr<MemoryDataStream> readPrevious(const PreviousArchive& previous, const TocEntry& entry);
+
+		/** Writes zeroes to the stream until the offset is aligned to the provided alignment. */
+		static UINT64 writePadding(const SPtr<DataStream>& stream, UINT64 offset, UINT64 alignment);
+
+		/** Writes the specified number of zeroes to the stream. */
+		static void writeZeroes(const SPtr<DataStream>& stream, UINT64 size);
+
+		static const UINT32 MAGIC;
+		static const UINT32 VERSION;
+		static const UINT32 PAGE_SIZE;
+		static const UINT32 COMPRESSED_ALIGNMENT;
+		static const UINT32 FLAG_COMPRESSED;
+		static const UINT32 BATCH_SIZE;
+
+		Path mPath;
+		UINT64 mMaxChunkSize;
+		Vector<Entry> mEntries;
+		UINT32 mNumReused = 0;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,223 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Build/BsResourceCooker.h"
+#include "Build/BsPlatformInfo.h"
+#include "Importer/BsImporter.h"
+#include "Importer/BsTextureImportOptions.h"
+#include "Importer/BsMeshImportOptions.h"
+#include "Image/BsTexture.h"
+#include "Image/BsPixelUtil.h"
+#include "Resources/BsResources.h"
+#include "FileSystem/BsFileSystem.h"
+#include "Utility/BsContentHash.h"
+#include "Debug/BsDebug.h"
+#include "BsEditorApplication.h"
+
+namespace bs
+{
+	const char* ResourceCooker::CACHE_FOLDER_NAME = "CookedResources";
+
+	ResourceCooker::ResourceCooker(const SPtr<PlatformInfo>& platformInfo)
+	{
+		if (platformInfo != nullptr)
+		{
+			mCompressTextures = platformInfo->compressTextures;
+			mTextureMipsToSkip = platformInfo->textureMipsToSkip;
+			mStripMeshTangents = platformInfo->stripMeshTangents;
+			mStripCPUCachedData = platformInfo->stripCPUCachedData;
+		}
+
+		mCacheFolder = gEditorApplication().getProjectPath();
+		mCacheFolder.append(PROJECT_INTERNAL_DIR);
+		mCacheFolder.append(CACHE_FOLDER_NAME);
+	}
+
+	bool ResourceCooker::isCookable(UINT32 typeId) const
+	{
+		// Cooked textures and meshes are saved by reading them back from the GPU, which the headless editor can't do
+		if (gEditorApplication().isHeadless())
+			return false;
+
+		switch (typeId)
+		{
+		case TID_Texture:
+			return mCompressTextures || mTextureMipsToSkip > 0 || mStripCPUCachedData;
+		case TID_Mesh:
+			return mStripMeshTangents || mStripCPUCachedData;
+		default:
+			return false;
+		}
+	}
+
+	UINT64 ResourceCooker::getSettingsHash(UINT32 typeId) const
+	{
+		UINT64 hash = ContentHash::hash(&typeId, sizeof(typeId));
+		hash = ContentHash::combine(hash, ContentHash::hash(&mStripCPUCachedData, sizeof(mStripCPUCachedData)));
+
+		switch (typeId)
+		{
+		case TID_Texture:
+			hash = ContentHash::combine(hash, ContentHash::hash(&mCompressTextures, sizeof(mCompressTextures)));
+			hash = ContentHash::combine(hash, ContentHash::hash(&mTextureMipsToSkip, sizeof(mTextureMipsToSkip)));
+			break;
+		case TID_Mesh:
+			hash = ContentHash::combine(hash, ContentHash::hash(&mStripMeshTangents, sizeof(mStripMeshTangents)));
+			break;
+		default:
+			break;
+		}
+
+		return hash;
+	}
+
+	bool ResourceCooker::cook(const ResourceCookInput& input, const Path& outputPath) const
+	{
+		const UINT64 cacheKey = ContentHash::combine(input.assetHash, getSettingsHash(input.typeId));
+
+		Path cachePath = mCacheFolder;
+		cachePath.setFilename(input.uuid.toString() + "_" + toString(cacheKey) + ".asset");
+
+		if (FileSystem::isFile(cachePath))
+		{
+			FileSystem::copy(cachePath, outputPath);
+			return true;
+		}
+
+		bool cpuCached = false;
+		SPtr<ImportOptions> importOptions = createImportOptions(input, cpuCached);
+		if (importOptions == nullptr)
+			return false;
+
+		SPtr<Resource> resource;
+		Vector<SubResourceRaw> importedResources = gImporter()._importAll(input.sourcePath, importOptions);
+		for (auto& entry : importedResources)
+		{
+			if (entry.name == input.name)
+			{
+				resource = std::static_pointer_cast<Resource>(entry.value);
+				break;
+			}
+		}
+
+		if (resource == nullptr)
+		{
+			LOGWRN("Unable to cook resource \"" + input.name + "\" from \"" + input.sourcePath.toString() + "\".");
+			return false;
+		}
+
+		if (input.typeId == TID_Texture && mTextureMipsToSkip > 0)
+			resource = removeMips(std::static_pointer_cast<Texture>(resource), cpuCached);
+
+		if (!FileSystem::isDirectory(mCacheFolder))
+			FileSystem::createDir(mCacheFolder);
+
+		gResources()._save(resource, cachePath, false);
+		FileSystem::copy(cachePath, outputPath);
+
+		return true;
+	}
+
+	SPtr<ImportOptions> ResourceCooker::createImportOptions(const ResourceCookInput& input, bool& cpuCached) const
+	{
+		SPtr<ImportOptions> importOptions = input.importOptions;
+		if (importOptions == nullptr)
+			importOptions = gImporter().createImportOptions(input.sourcePath);
+
+		if (importOptions == nullptr)
+			return nullptr;
+
+		switch (importOptions->getRTTI()->getRTTIId())
+		{
+		case TID_TextureImportOptions:
+		{
+			SPtr<TextureImportOptions> textureIO = bs_shared_ptr_new<TextureImportOptions>(
+				*std::static_pointer_cast<TextureImportOptions>(importOptions));
+
+			if (mCompressTextures)
+				textureIO->setFormat(getCompressedFormat(textureIO->getFormat()));
+
+			if (mStripCPUCachedData)
+				textureIO->setCPUCached(false);
+
+			cpuCached = textureIO->getCPUCached();
+
+			// Mips are removed from the CPU copy of the imported data. The original setting is restored on the texture
+			// with the mips removed.
+			if (mTextureMipsToSkip > 0)
+				textureIO->setCPUCached(true);
+
+			return textureIO;
+		}
+		case TID_MeshImportOptions:
+		{
+			SPtr<MeshImportOptions> meshIO = bs_shared_ptr_new<MeshImportOptions>(
+				*std::static_pointer_cast<MeshImportOptions>(importOptions));
+
+			if (mStripMeshTangents)
+				meshIO->setImportTangents(false);
+
+			if (mStripCPUCachedData)
+				meshIO->setCPUCached(false);
+
+			cpuCached = meshIO->getCPUCached();
+			return meshIO;
+		}
+		default:
+			return importOptions;
+		}
+	}
+
+	SPtr<Texture> ResourceCooker::removeMips(const SPtr<Texture>& texture, bool cpuCached) const
+	{
+		const TextureProperties& props = texture->getProperties();
+
+		// Always keep at least the smallest mip level
+		const UINT32 numMipsToSkip = std::min(mTextureMipsToSkip, props.getNumMipmaps());
+		if (numMipsToSkip == 0)
+			return texture;
+
+		TEXTURE_DESC desc;
+		desc.type = props.getTextureType();
+		desc.format = props.getFormat();
+		desc.width = std::max(1U, props.getWidth() >> numMipsToSkip);
+		desc.height = std::max(1U, props.getHeight() >> numMipsToSkip);
+		desc.depth = std::max(1U, props.getDepth() >> numMipsToSkip);
+		desc.numMips = props.getNumMipmaps() - numMipsToSkip;
+		desc.numArraySlices = props.getNumArraySlices();
+		desc.hwGamma = props.isHardwareGammaEnabled();
+		desc.usage = props.getUsage();
+
+		if (cpuCached)
+			desc.usage |= TU_CPUCACHED;
+		else
+			desc.usage &= ~TU_CPUCACHED;
+
+		SPtr<Texture> output = Texture::_createPtr(desc);
+		for (UINT32 face = 0; face < props.getNumFaces(); face++)
+		{
+			for (UINT32 mip = 0; mip <= desc.numMips; mip++)
+			{
+				SPtr<PixelData> pixelData = props.allocBuffer(face, mip + numMipsToSkip);
+				texture->readCachedData(*pixelData, face, mip + numMipsToSkip);
+
+				output->writeData(pixelData, face, mip, false);
+			}
+		}
+
+		return output;
+	}
+
+	PixelFormat ResourceCooker::getCompressedFormat(PixelFormat format)
+	{
+		if (PixelUtil::isCompressed(format))
+			return format;
+
+		if (PixelUtil::isFloatingPoint(format))
+			return PF_BC6H;
+
+		if (PixelUtil::hasAlpha(format))
+			return PF_BC3;
+
+		return PF_BC1;
+	}
+}
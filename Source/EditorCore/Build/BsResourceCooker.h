@@ -0,0 +1,85 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Build
+	 *  @{
+	 */
+
+	/** Information about a project library resource required for cooking it. */
+	struct ResourceCookInput
+	{
+		UUID uuid; /**< UUID of the resource. */
+		Path sourcePath; /**< Path to the source file the resource was imported from. */
+		String name; /**< Name of the resource among the resources imported from the source file. */
+		UINT32 typeId = 0; /**< RTTI type of the resource. */
+		SPtr<ImportOptions> importOptions; /**< Options the resource was imported with in the editor. */
+		UINT64 assetHash = 0; /**< Hash of the resource imported in the editor. */
+	};
+
+	/**
+	 * Converts textures and meshes to the form best suited for a particular platform, according to the cooking settings
+	 * in its PlatformInfo. Resources are cooked by importing them again with import options adjusted for the platform,
+	 * after which textures can have their largest mip levels removed.
+	 *
+	 * Cooked resources are cached in the project's internal folder, keyed by the hash of the resource imported in the
+	 * editor and the cooking settings, so they are only cooked again when either changes.
+	 */
+	class BS_ED_EXPORT ResourceCooker
+	{
+	public:
+		/** @param[in]	platformInfo	Information about the platform to cook for. Can be null. */
+		ResourceCooker(const SPtr<PlatformInfo>& platformInfo);
+
+		/** Checks should resources of the provided type be cooked with the current settings. */
+		bool isCookable(UINT32 typeId) const;
+
+		/** Returns a hash of the settings influencing the output of resources of the provided type. */
+		UINT64 getSettingsHash(UINT32 typeId) const;
+
+		/**
+		 * Cooks the resource and writes it to the output path. Can be called from any thread.
+		 *
+		 * @param[in]	input		Information about the resource to cook.
+		 * @param[in]	outputPath	Path to write the cooked resource asset to.
+		 * @return					False if the resource could not be cooked.
+		 */
+		bool cook(const ResourceCookInput& input, const Path& outputPath) const;
+
+	private:
+		/**
+		 * Returns a copy of the import options, adjusted for the platform.
+		 *
+		 * @param[in]	input		Resource to return the import options for.
+		 * @param[out]	cpuCached	Set to true if the cooked resource should keep its CPU cached data. Might differ from
+		 *							the returned options, if the cooker itself needs the CPU cached data.
+		 */
+		SPtr<ImportOptions> createImportOptions(const ResourceCookInput& input, bool& cpuCached) const;
+
+		/**
+		 * Creates a copy of the texture without its largest mip levels. Texture must have CPU cached data.
+		 *
+		 * @param[in]	texture		Texture to remove the mip levels from.
+		 * @param[in]	cpuCached	Determines should the output texture keep its CPU cached data.
+		 */
+		SPtr<Texture> removeMips(const SPtr<Texture>& texture, bool cpuCached) const;
+
+		/** Returns the block compressed format most suitable for replacing the provided format. */
+		static PixelFormat getCompressedFormat(PixelFormat format);
+
+		static const char* CACHE_FOLDER_NAME;
+
+		bool mCompressTextures = false;
+		UINT32 mTextureMipsToSkip = 0;
+		bool mStripMeshTangents = false;
+		bool mStripCPUCachedData = false;
+
+		Path mCacheFolder;
+	};
+
+	/** @} */
+}
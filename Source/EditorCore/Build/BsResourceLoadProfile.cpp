@@ -0,0 +1,140 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Build/BsResourceLoadProfile.h"
+#include "Resources/BsResources.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+#include "BsEditorApplication.h"
+
+using namespace std::placeholders;
+
+namespace bs
+{
+	const char* ResourceLoadProfile::BUILD_PROFILE_NAME = "LoadProfile.dat";
+	const char* ResourceLoadProfile::RECORDED_PROFILE_NAME = "ResourceLoadProfile.dat";
+	const UINT32 ResourceLoadProfile::MAGIC = 0x504C5342; // "BSLP"
+	const UINT32 ResourceLoadProfile::VERSION = 1;
+
+	void ResourceLoadProfile::add(const UUID& uuid, float time)
+	{
+		if (!mLookup.insert(uuid).second)
+			return;
+
+		mEntries.push_back({ uuid, time });
+	}
+
+	bool ResourceLoadProfile::save(const Path& path) const
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if (stream == nullptr)
+			return false;
+
+		Header header = { MAGIC, VERSION, (UINT32)mEntries.size(), 0 };
+		stream->write(&header, sizeof(header));
+
+		for (auto& entry : mEntries)
+		{
+			stream->write(&entry.uuid, sizeof(entry.uuid));
+			stream->write(&entry.time, sizeof(entry.time));
+		}
+
+		stream->close();
+		return true;
+	}
+
+	SPtr<ResourceLoadProfile> ResourceLoadProfile::load(const Path& path)
+	{
+		if (!FileSystem::isFile(path))
+			return nullptr;
+
+		SPtr<DataStream> stream = FileSystem::openFile(path, true);
+		if (stream == nullptr)
+			return nullptr;
+
+		const size_t entrySize = sizeof(UUID) + sizeof(float);
+
+		Header header;
+		if (stream->read(&header, sizeof(header)) != sizeof(header) || header.magic != MAGIC || header.version != VERSION ||
+			stream->size() < sizeof(header) + header.numEntries * entrySize)
+		{
+			LOGWRN("Resource load profile \"" + path.toString() + "\" is corrupt or incompatible.");
+			return nullptr;
+		}
+
+		SPtr<ResourceLoadProfile> profile = bs_shared_ptr_new<ResourceLoadProfile>();
+		for (UINT32 i = 0; i < header.numEntries; i++)
+		{
+			UUID uuid;
+			float time;
+			stream->read(&uuid, sizeof(uuid));
+			stream->read(&time, sizeof(time));
+
+			profile->add(uuid, time);
+		}
+
+		stream->close();
+		return profile;
+	}
+
+	ResourceLoadRecorder::~ResourceLoadRecorder()
+	{
+		mOnResourceLoadedConn.disconnect();
+	}
+
+	void ResourceLoadRecorder::start()
+	{
+		if (mIsRecording)
+			return;
+
+		mProfile = ResourceLoadProfile();
+		mTimer.reset();
+
+		mOnResourceLoadedConn = gResources().onResourceLoaded.connect(
+			std::bind(&ResourceLoadRecorder::onResourceLoaded, this, _1));
+		mIsRecording = true;
+	}
+
+	void ResourceLoadRecorder::stop()
+	{
+		if (!mIsRecording)
+			return;
+
+		mOnResourceLoadedConn.disconnect();
+		mIsRecording = false;
+
+		// Merge with loads recorded during earlier runs, as each run might exercise different parts of the game
+		const Path profilePath = getRecordedProfilePath();
+
+		SPtr<ResourceLoadProfile> merged = ResourceLoadProfile::load(profilePath);
+		if (merged == nullptr)
+			merged = bs_shared_ptr_new<ResourceLoadProfile>();
+
+		{
+			Lock lock(mMutex);
+
+			for (auto& entry : mProfile.getEntries())
+				merged->add(entry.uuid, entry.time);
+		}
+
+		if (!merged->save(profilePath))
+			LOGWRN("Unable to save the resource load profile to \"" + profilePath.toString() + "\".");
+	}
+
+	Path ResourceLoadRecorder::getRecordedProfilePath()
+	{
+		Path profilePath = gEditorApplication().getProjectPath();
+		profilePath.append(PROJECT_INTERNAL_DIR);
+		profilePath.setFilename(ResourceLoadProfile::RECORDED_PROFILE_NAME);
+
+		return profilePath;
+	}
+
+	void ResourceLoadRecorder::onResourceLoaded(const HResource& resource)
+	{
+		const float time = mTimer.getMicroseconds() / 1000.0f;
+
+		Lock lock(mMutex);
+		mProfile.add(resource.getUUID(), time);
+	}
+}
@@ -0,0 +1,105 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Utility/BsTimer.h"
+
+namespace bs
+{
+	/** @addtogroup Build
+	 *  @{
+	 */
+
+	/** Single resource load in a ResourceLoadProfile. */
+	struct ResourceLoadProfileEntry
+	{
+		UUID uuid;
+		float time; /**< Time at which the load finished, in milliseconds since the start of recording. */
+	};
+
+	/**
+	 * Ordered list of resources loaded by the game. A profile is written into every build, allowing the game to start
+	 * loading all the resources it is going to need as soon as it starts up, instead of discovering them one by one.
+	 *
+	 * @note	File layout must match the profile reader in the Game project.
+	 */
+	class BS_ED_EXPORT ResourceLoadProfile
+	{
+	public:
+		/** Appends a resource to the profile, unless it's already in the profile. */
+		void add(const UUID& uuid, float time = 0.0f);
+
+		/** Checks is the resource in the profile. */
+		bool contains(const UUID& uuid) const { return mLookup.find(uuid) != mLookup.end(); }
+
+		/** Returns all resources in the profile, in the order they were loaded. */
+		const Vector<ResourceLoadProfileEntry>& getEntries() const { return mEntries; }
+
+		/** Saves the profile to the specified file. Returns false if the file couldn't be written. */
+		bool save(const Path& path) const;
+
+		/** Loads a profile saved with save(). Returns null if the file doesn't exist or isn't a valid profile. */
+		static SPtr<ResourceLoadProfile> load(const Path& path);
+
+		/** Name of the profile file in the build's resource folder. */
+		static const char* BUILD_PROFILE_NAME;
+
+		/** Name of the file in the project's internal folder, containing loads recorded while playing in the editor. */
+		static const char* RECORDED_PROFILE_NAME;
+
+	private:
+		/** Header at the start of a profile file. */
+		struct Header
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 numEntries;
+			UINT32 reserved;
+		};
+
+		static const UINT32 MAGIC;
+		static const UINT32 VERSION;
+
+		Vector<ResourceLoadProfileEntry> mEntries;
+		UnorderedSet<UUID> mLookup;
+	};
+
+	/**
+	 * Records the resources loaded while the game is running in the editor, and merges them into the project's recorded
+	 * load profile. Builds use the recorded profile to also prefetch resources the game loads dynamically.
+	 */
+	class BS_ED_EXPORT ResourceLoadRecorder
+	{
+	public:
+		~ResourceLoadRecorder();
+
+		/** Starts recording resource loads. Does nothing if already recording. */
+		void start();
+
+		/**
+		 * Stops recording and merges the recorded loads into the project's recorded load profile. Does nothing if not
+		 * recording.
+		 */
+		void stop();
+
+		/** Checks is the recorder currently recording. */
+		bool isRecording() const { return mIsRecording; }
+
+		/** Returns the path to the project's recorded load profile. */
+		static Path getRecordedProfilePath();
+
+	private:
+		/** Triggered when a resource finishes loading. Can be called from any thread. */
+		void onResourceLoaded(const HResource& resource);
+
+		bool mIsRecording = false;
+		HEvent mOnResourceLoadedConn;
+		Timer mTimer;
+
+		Mutex mMutex;
+		ResourceLoadProfile mProfile;
+	};
+
+	/** @} */
+}
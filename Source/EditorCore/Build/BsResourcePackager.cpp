@@ -0,0 +1,1052 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Build/BsResourcePackager.h"
+#include "Build/BsBuildManager.h"
+#include "Build/BsResourceArchiveWriter.h"
+#include "Build/BsResourceLoadProfile.h"
+#include "Library/BsProjectLibrary.h"
+#include "Library/BsProjectResourceMeta.h"
+#include "Resources/BsResources.h"
+#include "Resources/BsResourceManifest.h"
+#include "Resources/BsGameResourceManager.h"
+#include "Resources/BsBuiltinResources.h"
+#include "Scene/BsPrefab.h"
+#include "Scene/BsSceneObject.h"
+#include "Image/BsTexture.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsFileSerializer.h"
+#include "Utility/BsContentHash.h"
+#include "Utility/BsEditorUtility.h"
+#include "Utility/BsTimer.h"
+#include "Debug/BsDebug.h"
+#include "BsEditorApplication.h"
+
+namespace bs
+{
+	/** Reads values from a memory buffer, making sure reads stay in bounds. */
+	class PackageCacheReader
+	{
+	public:
+		PackageCacheReader(const UINT8* data, UINT64 size)
+			:mData(data), mSize(size)
+		{ }
+
+		template<class T>
+		bool read(T& value)
+		{
+			if(mOffset + sizeof(T) > mSize)
+				return false;
+
+			memcpy(&value, mData + mOffset, sizeof(T));
+			mOffset += sizeof(T);
+
+			return true;
+		}
+
+		bool read(String& value)
+		{
+			UINT32 length;
+			if(!read(length) || mOffset + length > mSize)
+				return false;
+
+			value.assign((const char*)mData + mOffset, length);
+			mOffset += length;
+
+			return true;
+		}
+
+	private:
+		const UINT8* mData;
+		UINT64 mSize;
+		UINT64 mOffset = 0;
+	};
+
+	template<class T>
+	static void writePackageCacheValue(Vector<UINT8>& buffer, const T& value)
+	{
+		const UINT8* data = (const UINT8*)&value;
+		buffer.insert(buffer.end(), data, data + sizeof(T));
+	}
+
+	static void writePackageCacheString(Vector<UINT8>& buffer, const String& value)
+	{
+		writePackageCacheValue(buffer, (UINT32)value.size());
+		buffer.insert(buffer.end(), value.begin(), value.end());
+	}
+
+	/** Converts the time elapsed on the timer to milliseconds. */
+	static float getElapsedMs(const Timer& timer)
+	{
+		return timer.getMicroseconds() / 1000.0f;
+	}
+
+	const char* ResourcePackager::CACHE_FILENAME = "PackagedResources.cache";
+	const UINT32 ResourcePackager::CACHE_MAGIC = 0x4B504253; // "SBPK"
+	const UINT32 ResourcePackager::CACHE_VERSION = 2;
+	const char* ResourcePackager::STAGING_FOLDER_NAME = "PackagedResources";
+	const char* ResourcePackager::BAKED_PREFAB_FOLDER_NAME = "BakedPrefabs";
+
+	ResourcePackager::ResourcePackager(const Path& buildFolder, const SPtr<PlatformInfo>& platformInfo)
+		:mBuildFolder(buildFolder), mPlatformInfo(platformInfo), mCooker(platformInfo)
+	{
+		mOutputFolder = mBuildFolder;
+		mOutputFolder.append(GAME_RESOURCES_FOLDER_NAME);
+
+		if (mPlatformInfo != nullptr && mPlatformInfo->packResources)
+		{
+			mAssetFolder = gEditorApplication().getProjectPath();
+			mAssetFolder.append(PROJECT_INTERNAL_DIR);
+			mAssetFolder.append(STAGING_FOLDER_NAME);
+		}
+		else
+			mAssetFolder = mOutputFolder;
+	}
+
+	void ResourcePackager::package()
+	{
+		mStats = ResourcePackagingStats();
+		mResources.clear();
+		mResourceLookup.clear();
+
+		Timer totalTimer;
+		Timer timer;
+
+		loadCache();
+		findResources();
+		mStats.dependencyTime = getElapsedMs(timer);
+
+		timer.reset();
+		calculateOutputKeys();
+		mStats.hashTime = getElapsedMs(timer);
+
+		FileSystem::createDir(mOutputFolder);
+		FileSystem::createDir(mAssetFolder);
+
+		// Only resources that changed since the last build, or whose outputs are missing, need to be written
+		Vector<PackagedResource*> resourcesToCopy;
+		Vector<PackagedResource*> prefabsToSave;
+		for (auto& resource : mResources)
+		{
+			// Resource not part of library, meaning its built-in and we don't need to copy those here
+			if (resource.sourcePath.isEmpty())
+				continue;
+
+			mStats.numResources++;
+
+			const auto iterFind = mCache.find(resource.uuid);
+			if (resource.outputExists && iterFind != mCache.end() && iterFind->second.outputKey == resource.outputKey)
+			{
+				mStats.numSkipped++;
+				continue;
+			}
+
+			// Prefabs without nested prefabs need no baking, and are copied as is so their output stays byte-identical
+			if (resource.isPrefab && !resource.nestedPrefabs.empty())
+				prefabsToSave.push_back(&resource);
+			else
+				resourcesToCopy.push_back(&resource);
+		}
+
+		timer.reset();
+		copyResources(resourcesToCopy);
+		mStats.copyTime = getElapsedMs(timer);
+
+		timer.reset();
+		bakePrefabs(prefabsToSave);
+		mStats.prefabTime = getElapsedMs(timer);
+
+		timer.reset();
+		writeArchive();
+		mStats.archiveTime = getElapsedMs(timer);
+
+		timer.reset();
+
+		// Remove outputs of resources that were packaged by a previous build, but aren't used anymore
+		for (auto& entry : mCache)
+		{
+			if (entry.second.outputName.empty() || mResourceLookup.find(entry.first) != mResourceLookup.end())
+				continue;
+
+			Path outputPath = mAssetFolder;
+			outputPath.setFilename(entry.second.outputName);
+
+			if (FileSystem::isFile(outputPath))
+			{
+				FileSystem::remove(outputPath);
+				mStats.numRemoved++;
+			}
+		}
+
+		removeUnusedOutputs();
+
+		// Packed resources are only stored in the archive, so the mapping and the manifest refer to its entries instead
+		// of individual files
+		const bool packResources = mPlatformInfo != nullptr && mPlatformInfo->packResources;
+
+		Path relArchivePath = GAME_RESOURCES_FOLDER_NAME;
+		relArchivePath.setFilename(ResourceArchiveWriter::ARCHIVE_NAME);
+
+		// Create library -> packaged resource mapping
+		SPtr<ResourceMapping> resourceMap = ResourceMapping::create();
+
+		const Path& libraryDir = gProjectLibrary().getResourcesFolder();
+		for (auto& resource : mResources)
+		{
+			if (resource.sourcePath.isEmpty())
+				continue;
+
+			Path relSourcePath = resource.sourcePath;
+			if (relSourcePath.isAbsolute())
+				relSourcePath.makeRelative(libraryDir);
+
+			Path relDestPath;
+			if (packResources)
+				relDestPath = ResourceArchiveWriter::getEntryPath(relArchivePath, resource.uuid);
+			else
+			{
+				relDestPath = GAME_RESOURCES_FOLDER_NAME;
+				relDestPath.setFilename(resource.assetPath.getFilename());
+			}
+
+			resourceMap->add(relSourcePath, relDestPath);
+		}
+
+		// Save icon
+		if (mPlatformInfo != nullptr)
+		{
+			Path iconFolder = BuiltinResources::getIconFolder();
+
+			Path sourceRoot = BuildManager::instance().getBuildFolder(BuildFolder::SourceRoot, mPlatformInfo->type);
+			iconFolder.makeRelative(sourceRoot);
+
+			Path destRoot = BuildManager::instance().getBuildFolder(BuildFolder::DestinationRoot, mPlatformInfo->type);
+			Path destIconFile = destRoot;
+			destIconFile.append(iconFolder);
+			destIconFile.setFilename(String(BuiltinResources::IconTextureName) + ".asset");
+
+			switch (mPlatformInfo->type)
+			{
+			case PlatformType::Windows:
+			{
+				SPtr<WinPlatformInfo> winPlatformInfo = std::static_pointer_cast<WinPlatformInfo>(mPlatformInfo);
+
+				// Copy the imported asset rather than re-saving the texture, which would read it back from the GPU
+				Path iconAssetPath;
+				if (gResources().getFilePathFromUUID(winPlatformInfo->icon.getUUID(), iconAssetPath))
+				{
+					const Path destIconFolder = destIconFile.getParent();
+					if (!FileSystem::isDirectory(destIconFolder))
+						FileSystem::createDir(destIconFolder);
+
+					FileSystem::copy(iconAssetPath, destIconFile, true);
+				}
+			}
+				break;
+			default:
+				break;
+			};
+		}
+
+		// Save manifest. Only contains the packaged resources, registered in UUID order so that the manifest doesn't
+		// depend on the order resources were imported in the editor.
+		Path manifestPath = mOutputFolder;
+		manifestPath.append(GAME_RESOURCE_MANIFEST_NAME);
+
+		Path internalResourcesFolder = gEditorApplication().getProjectPath();
+		internalResourcesFolder.append(PROJECT_INTERNAL_DIR);
+
+		// Paths are saved relative to the internal folder, which mirrors the build's root folder
+		Path archivePath = internalResourcesFolder;
+		archivePath.append(relArchivePath);
+
+		SPtr<ResourceManifest> manifest = ResourceManifest::create(gProjectLibrary()._getManifest()->getName());
+		for (auto& resource : mResources)
+		{
+			if (resource.sourcePath.isEmpty())
+				continue;
+
+			if (packResources)
+			{
+				const Path entryPath = ResourceArchiveWriter::getEntryPath(archivePath, resource.uuid);
+				manifest->registerResource(resource.uuid, entryPath);
+			}
+			else
+				manifest->registerResource(resource.uuid, resource.assetPath);
+		}
+
+		ResourceManifest::save(manifest, manifestPath, internalResourcesFolder);
+
+		// Save resource map
+		Path mappingPath = mOutputFolder;
+		mappingPath.append(GAME_RESOURCE_MAPPING_NAME);
+
+		FileEncoder fe(mappingPath);
+		fe.encode(resourceMap.get());
+
+		writeLoadProfile();
+
+		saveCache();
+
+		mStats.finalizeTime = getElapsedMs(timer);
+		mStats.totalTime = getElapsedMs(totalTimer);
+	}
+
+	void ResourcePackager::findResources()
+	{
+		Vector<UINT32> newResources;
+		auto addResource = [this, &newResources](const UUID& uuid)
+		{
+			if (mResourceLookup.find(uuid) != mResourceLookup.end())
+				return true;
+
+			Path assetPath;
+			if (!gResources().getFilePathFromUUID(uuid, assetPath))
+				return false;
+
+			PackagedResource resource;
+			resource.uuid = uuid;
+			resource.assetPath = assetPath;
+
+			SPtr<ProjectResourceMeta> resMeta = gProjectLibrary().findResourceMeta(uuid);
+			if (resMeta != nullptr)
+			{
+				resource.sourcePath = gProjectLibrary().uuidToPath(uuid);
+				resource.isPrefab = resMeta->getTypeID() == TID_Prefab;
+
+				if (mCooker.isCookable(resMeta->getTypeID()))
+				{
+					Path filePath = resource.sourcePath;
+					if (gProjectLibrary().isSubresource(filePath))
+						filePath.makeParent();
+
+					ProjectLibrary::LibraryEntry* entry = gProjectLibrary().findEntry(filePath);
+					if (entry != nullptr && entry->type == ProjectLibrary::LibraryEntryType::File)
+					{
+						auto fileEntry = static_cast<ProjectLibrary::FileEntry*>(entry);
+						if (fileEntry->meta != nullptr)
+						{
+							resource.isCooked = true;
+							resource.cookInput.uuid = uuid;
+							resource.cookInput.sourcePath = filePath;
+							resource.cookInput.name = resMeta->getUniqueName();
+							resource.cookInput.typeId = resMeta->getTypeID();
+							resource.cookInput.importOptions = fileEntry->meta->getImportOptions();
+						}
+					}
+				}
+
+				// Resources referenced by library resources are recorded in their meta-data on import
+				if (resMeta->hasDependencies())
+				{
+					resource.dependencies = resMeta->getDependencies();
+					resource.hasKnownDependencies = true;
+				}
+			}
+
+			const UINT32 idx = (UINT32)mResources.size();
+			mResources.push_back(resource);
+			mResourceLookup[uuid] = idx;
+			newResources.push_back(idx);
+
+			return true;
+		};
+
+		// Get all resources manually included in build
+		Vector<ProjectLibrary::FileEntry*> buildResources = gProjectLibrary().getResourcesForBuild();
+		for (auto& entry : buildResources)
+		{
+			if (entry->meta == nullptr)
+			{
+				LOGWRN("Cannot include resource in build, missing meta file for: " + entry->path.toString());
+				continue;
+			}
+
+			auto& resourceMetas = entry->meta->getResourceMetaData();
+			for (auto& resMeta : resourceMetas)
+			{
+				if (!addResource(resMeta->getUUID()))
+					LOGWRN("Cannot include resource in build, missing imported asset for: " + entry->path.toString());
+			}
+		}
+
+		// Include main scene
+		if (mPlatformInfo != nullptr)
+		{
+			if (!addResource(mPlatformInfo->mainScene.getUUID()))
+				LOGWRN("Cannot include main scene in build, missing imported asset.");
+		}
+
+		// Find dependencies of all resources, one level at a time. Dependencies not recorded in the library are read from
+		// the asset headers on worker threads, unless the asset didn't change since the last build, in which case they
+		// are taken from the cache.
+		while (!newResources.empty())
+		{
+			const Vector<UINT32> currentResources = std::move(newResources);
+			newResources.clear();
+
+			EditorUtility::runInParallel("PackageDependencies", (UINT32)currentResources.size(), 8,
+				[this, &currentResources](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					PackagedResource& resource = mResources[currentResources[i]];
+					resource.assetModifiedTime = FileSystem::getLastModifiedTime(resource.assetPath);
+					resource.assetSize = FileSystem::getFileSize(resource.assetPath);
+
+					const auto iterFind = mCache.find(resource.uuid);
+					if (iterFind != mCache.end() && iterFind->second.assetModifiedTime == resource.assetModifiedTime &&
+						iterFind->second.assetSize == resource.assetSize)
+					{
+						if (!resource.hasKnownDependencies)
+							resource.dependencies = iterFind->second.dependencies;
+
+						resource.contentHash = iterFind->second.contentHash;
+						resource.isCached = true;
+					}
+					else if (!resource.hasKnownDependencies)
+						resource.dependencies = gResources().getDependencies(resource.assetPath);
+				}
+			});
+
+			for (auto& idx : currentResources)
+			{
+				// Nested prefabs are not referenced through resource handles, so prefabs that changed since the last
+				// build need to be loaded to find them. Prefabs must be loaded on the main thread.
+				PackagedResource& resource = mResources[idx];
+				if (resource.isPrefab)
+				{
+					const auto iterFind = mCache.find(resource.uuid);
+					if (resource.isCached && iterFind != mCache.end())
+						resource.nestedPrefabs = iterFind->second.nestedPrefabs;
+					else
+					{
+						const bool wasLoaded = gResources().isLoaded(resource.uuid);
+
+						HPrefab prefab = static_resource_cast<Prefab>(gProjectLibrary().load(resource.sourcePath));
+						if (prefab.isLoaded())
+						{
+							resource.nestedPrefabs = findNestedPrefabs(prefab);
+
+							if (!wasLoaded)
+								gResources().release(prefab);
+						}
+					}
+				}
+
+				// Copy, since adding resources can reallocate the resource array
+				const Vector<UUID> dependencies = resource.dependencies;
+				const Vector<UUID> nestedPrefabs = resource.nestedPrefabs;
+
+				for (auto& dependency : dependencies)
+					addResource(dependency);
+
+				for (auto& nestedPrefab : nestedPrefabs)
+					addResource(nestedPrefab);
+			}
+		}
+
+		// Everything written from the resource list is emitted in UUID order, so identical inputs produce identical
+		// outputs regardless of the order resources were discovered in
+		std::sort(mResources.begin(), mResources.end(),
+			[](const PackagedResource& a, const PackagedResource& b) { return a.uuid < b.uuid; });
+
+		mResourceLookup.clear();
+		for (UINT32 i = 0; i < (UINT32)mResources.size(); i++)
+			mResourceLookup[mResources[i].uuid] = i;
+	}
+
+	void ResourcePackager::calculateOutputKeys()
+	{
+		Vector<PackagedResource*> libraryResources;
+		for (auto& resource : mResources)
+		{
+			if (!resource.sourcePath.isEmpty())
+				libraryResources.push_back(&resource);
+		}
+
+		EditorUtility::runInParallel("PackageHash", (UINT32)libraryResources.size(), 1,
+			[this, &libraryResources](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				PackagedResource& resource = *libraryResources[i];
+				if (!resource.isCached)
+					resource.contentHash = ContentHash::hashFile(resource.assetPath);
+
+				resource.outputExists = FileSystem::isFile(getOutputPath(resource));
+			}
+		});
+
+		UnorderedSet<UUID> visited;
+		for (auto& resource : libraryResources)
+			calculateOutputKey(*resource, visited);
+	}
+
+	UINT64 ResourcePackager::calculateOutputKey(PackagedResource& resource, UnorderedSet<UUID>& visited)
+	{
+		if (!visited.insert(resource.uuid).second)
+			return resource.outputKey;
+
+		// If dependencies reference this resource in a cycle, they will use the partially calculated key
+		resource.outputKey = resource.contentHash;
+
+		Vector<UUID> dependencies = resource.dependencies;
+		std::sort(dependencies.begin(), dependencies.end());
+
+		// Prefabs are saved with flattened, up-to-date instances of the prefabs nested in them
+		Vector<UUID> nestedPrefabs = resource.nestedPrefabs;
+		std::sort(nestedPrefabs.begin(), nestedPrefabs.end());
+
+		UINT64 outputKey = resource.contentHash;
+		for (auto& dependency : dependencies)
+		{
+			outputKey = ContentHash::combine(outputKey, ContentHash::hash(&dependency, sizeof(dependency)));
+
+			// Prefabs are saved with up-to-date instances of the prefabs they reference, so their output also depends on
+			// the contents of their dependencies
+			if (resource.isPrefab)
+			{
+				const auto iterFind = mResourceLookup.find(dependency);
+				if (iterFind != mResourceLookup.end())
+				{
+					PackagedResource& dependencyResource = mResources[iterFind->second];
+					outputKey = ContentHash::combine(outputKey, calculateOutputKey(dependencyResource, visited));
+				}
+			}
+		}
+
+		for (auto& nestedPrefab : nestedPrefabs)
+		{
+			outputKey = ContentHash::combine(outputKey, ContentHash::hash(&nestedPrefab, sizeof(nestedPrefab)));
+
+			const auto iterFind = mResourceLookup.find(nestedPrefab);
+			if (iterFind != mResourceLookup.end())
+				outputKey = ContentHash::combine(outputKey, calculateOutputKey(mResources[iterFind->second], visited));
+		}
+
+		// Cooked outputs also depend on the platform's cooking settings
+		if (resource.isCooked)
+			outputKey = ContentHash::combine(outputKey, mCooker.getSettingsHash(resource.cookInput.typeId));
+
+		resource.outputKey = outputKey;
+		return outputKey;
+	}
+
+	void ResourcePackager::copyResources(const Vector<PackagedResource*>& resources)
+	{
+		std::atomic<UINT32> numCooked(0);
+		EditorUtility::runInParallel("PackageCopy", (UINT32)resources.size(), 1,
+			[this, &resources, &numCooked](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				PackagedResource& resource = *resources[i];
+				if (resource.isCooked)
+				{
+					resource.cookInput.assetHash = resource.contentHash;
+					if (mCooker.cook(resource.cookInput, getOutputPath(resource)))
+					{
+						numCooked++;
+						continue;
+					}
+
+					LOGWRN("Failed to cook resource, including it as imported: " + resource.sourcePath.toString());
+				}
+
+				FileSystem::copy(resource.assetPath, getOutputPath(resource));
+			}
+		});
+
+		mStats.numCooked += numCooked;
+		mStats.numCopied += (UINT32)resources.size() - numCooked;
+	}
+
+	void ResourcePackager::bakePrefabs(const Vector<PackagedResource*>& resources)
+	{
+		struct BakedPrefab
+		{
+			PackagedResource* resource;
+			HPrefab prefab;
+			bool reload;
+		};
+
+		// Encoding a baked prefab assigns new instance IDs to its objects, so the output differs every time it is baked.
+		// Baked prefabs are kept in the project's internal folder keyed by their output key, making sure identical
+		// inputs always produce byte-identical outputs, even when building into an empty folder.
+		Path cacheFolder = gEditorApplication().getProjectPath();
+		cacheFolder.append(PROJECT_INTERNAL_DIR);
+		cacheFolder.append(BAKED_PREFAB_FOLDER_NAME);
+
+		auto getCachePath = [&cacheFolder](const UUID& uuid, UINT64 outputKey)
+		{
+			Path cachePath = cacheFolder;
+			cachePath.setFilename(uuid.toString() + "_" + toString(outputKey) + ".asset");
+
+			return cachePath;
+		};
+
+		Vector<PackagedResource*> prefabsToBake;
+		for (auto& resource : resources)
+		{
+			const Path cachePath = getCachePath(resource->uuid, resource->outputKey);
+			if (FileSystem::isFile(cachePath))
+				FileSystem::copy(cachePath, getOutputPath(*resource), true);
+			else
+				prefabsToBake.push_back(resource);
+		}
+
+		mStats.numPrefabsSaved += (UINT32)(resources.size() - prefabsToBake.size());
+
+		// Nested prefabs are updated before the prefabs they are nested in, so each prefab is updated exactly once and
+		// its parents instantiate the already updated version.
+		// Note: Prefabs are loaded and modified on the main thread, as scene objects cannot be safely manipulated
+		// from worker threads
+		Vector<BakedPrefab> bakedPrefabs;
+		for (auto& resource : sortByNesting(prefabsToBake))
+		{
+			const bool reload = gResources().isLoaded(resource->uuid);
+
+			HPrefab prefab = static_resource_cast<Prefab>(gProjectLibrary().load(resource->sourcePath));
+			if (!prefab.isLoaded())
+			{
+				LOGWRN("Cannot include prefab in build, failed to load: " + resource->sourcePath.toString());
+				continue;
+			}
+
+			prefab->_updateChildInstances();
+			bakedPrefabs.push_back({ resource, prefab, reload });
+		}
+
+		// Flattening must wait until all prefabs are updated, since parents instantiate their nested prefabs with links
+		for (auto& entry : bakedPrefabs)
+			flattenPrefab(entry.prefab);
+
+		if (!bakedPrefabs.empty() && !FileSystem::isDirectory(cacheFolder))
+			FileSystem::createDir(cacheFolder);
+
+		// Encoding walks the prefab's scene objects, so it must happen on the main thread as well
+		for (auto& entry : bakedPrefabs)
+		{
+			const PackagedResource& resource = *entry.resource;
+
+			const Path cachePath = getCachePath(resource.uuid, resource.outputKey);
+			gResources().save(entry.prefab, cachePath, true, true);
+		}
+
+		// Only file operations remain, which are safe to perform in parallel
+		EditorUtility::runInParallel("PackagePrefabs", (UINT32)bakedPrefabs.size(), 1,
+			[this, &bakedPrefabs, &getCachePath](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				const PackagedResource& resource = *bakedPrefabs[i].resource;
+
+				const Path cachePath = getCachePath(resource.uuid, resource.outputKey);
+				FileSystem::copy(cachePath, getOutputPath(resource), true);
+
+				// Output of the previous build is never going to be used again
+				const auto iterFind = mCache.find(resource.uuid);
+				if (iterFind != mCache.end() && iterFind->second.outputKey != resource.outputKey)
+				{
+					const Path oldCachePath = getCachePath(resource.uuid, iterFind->second.outputKey);
+					if (FileSystem::isFile(oldCachePath))
+						FileSystem::remove(oldCachePath);
+				}
+			}
+		});
+
+		for (auto& entry : bakedPrefabs)
+		{
+			// Need to unload this one as we modified it in memory, and we don't want to persist those changes past
+			// this point
+			gResources().release(entry.prefab);
+
+			if (entry.reload)
+				gProjectLibrary().load(entry.resource->sourcePath);
+		}
+
+		mStats.numPrefabsSaved += (UINT32)bakedPrefabs.size();
+	}
+
+	Vector<ResourcePackager::PackagedResource*> ResourcePackager::sortByNesting(
+		const Vector<PackagedResource*>& prefabs)
+	{
+		const UINT32 numPrefabs = (UINT32)prefabs.size();
+
+		UnorderedMap<UUID, UINT32> lookup;
+		for (UINT32 i = 0; i < numPrefabs; i++)
+			lookup[prefabs[i]->uuid] = i;
+
+		// Number of prefabs nested in each prefab that are yet to be output, and prefabs each prefab is nested in
+		Vector<UINT32> numPending(numPrefabs, 0);
+		Vector<Vector<UINT32>> parents(numPrefabs);
+		for (UINT32 i = 0; i < numPrefabs; i++)
+		{
+			for (auto& nestedPrefab : prefabs[i]->nestedPrefabs)
+			{
+				const auto iterFind = lookup.find(nestedPrefab);
+				if (iterFind == lookup.end() || iterFind->second == i)
+					continue;
+
+				numPending[i]++;
+				parents[iterFind->second].push_back(i);
+			}
+		}
+
+		Vector<UINT32> order;
+		order.reserve(numPrefabs);
+		for (UINT32 i = 0; i < numPrefabs; i++)
+		{
+			if (numPending[i] == 0)
+				order.push_back(i);
+		}
+
+		for (UINT32 i = 0; i < (UINT32)order.size(); i++)
+		{
+			for (auto& parent : parents[order[i]])
+			{
+				if (--numPending[parent] == 0)
+					order.push_back(parent);
+			}
+		}
+
+		Vector<PackagedResource*> output;
+		output.reserve(numPrefabs);
+		for (auto& idx : order)
+			output.push_back(prefabs[idx]);
+
+		for (UINT32 i = 0; i < numPrefabs; i++)
+		{
+			if (numPending[i] > 0)
+				output.push_back(prefabs[i]);
+		}
+
+		return output;
+	}
+
+	Vector<UUID> ResourcePackager::findNestedPrefabs(const HPrefab& prefab)
+	{
+		Vector<UUID> output;
+		UnorderedSet<UUID> found;
+
+		HSceneObject root = prefab->_getRoot();
+		if (root == nullptr)
+			return output;
+
+		Stack<HSceneObject> todo;
+		for (UINT32 i = 0; i < root->getNumChildren(); i++)
+			todo.push(root->getChild(i));
+
+		while (!todo.empty())
+		{
+			HSceneObject current = todo.top();
+			todo.pop();
+
+			const UUID& prefabLink = current->getPrefabLink(true);
+			if (!prefabLink.empty() && found.insert(prefabLink).second)
+				output.push_back(prefabLink);
+
+			UINT32 numChildren = current->getNumChildren();
+			for (UINT32 i = 0; i < numChildren; i++)
+				todo.push(current->getChild(i));
+		}
+
+		return output;
+	}
+
+	void ResourcePackager::flattenPrefab(const HPrefab& prefab)
+	{
+		HSceneObject root = prefab->_getRoot();
+		if (root == nullptr)
+			return;
+
+		Vector<HSceneObject> sceneObjects;
+		Vector<HSceneObject> instanceRoots;
+
+		Stack<HSceneObject> todo;
+		todo.push(root);
+
+		while (!todo.empty())
+		{
+			HSceneObject current = todo.top();
+			todo.pop();
+
+			sceneObjects.push_back(current);
+			if (current != root && !current->getPrefabLink(true).empty())
+				instanceRoots.push_back(current);
+
+			UINT32 numChildren = current->getNumChildren();
+			for (UINT32 i = 0; i < numChildren; i++)
+				todo.push(current->getChild(i));
+		}
+
+		// Break the innermost links first, so each break only needs to handle its own instance
+		for (auto iter = instanceRoots.rbegin(); iter != instanceRoots.rend(); ++iter)
+			(*iter)->breakPrefabLink();
+
+		// Clear prefab diffs as they're not used in standalone
+		for (auto& sceneObject : sceneObjects)
+			sceneObject->_clearPrefabDiff();
+	}
+
+	void ResourcePackager::loadCache()
+	{
+		mCache.clear();
+
+		Path cachePath = gEditorApplication().getProjectPath();
+		cachePath.append(PROJECT_INTERNAL_DIR);
+		cachePath.setFilename(CACHE_FILENAME);
+
+		SPtr<DataStream> stream = FileSystem::openFile(cachePath, true);
+		if (stream == nullptr)
+			return;
+
+		Vector<UINT8> data(stream->size());
+		if (!data.empty())
+			stream->read(data.data(), data.size());
+
+		stream->close();
+
+		PackageCacheReader reader(data.data(), data.size());
+
+		UINT32 magic = 0;
+		UINT32 version = 0;
+		String outputFolder;
+		UINT32 numEntries = 0;
+		if (!reader.read(magic) || !reader.read(version) || magic != CACHE_MAGIC || version != CACHE_VERSION ||
+			!reader.read(outputFolder) || !reader.read(numEntries))
+		{
+			return;
+		}
+
+		// Outputs of a build to a different folder cannot be reused
+		if (outputFolder != mAssetFolder.toString())
+			return;
+
+		for (UINT32 i = 0; i < numEntries; i++)
+		{
+			UUID uuid;
+			CachedResource entry;
+			UINT64 assetModifiedTime;
+			UINT32 numDependencies;
+			if (!reader.read(uuid) || !reader.read(assetModifiedTime) || !reader.read(entry.assetSize) ||
+				!reader.read(entry.contentHash) || !reader.read(entry.outputKey) || !reader.read(entry.outputName) ||
+				!reader.read(numDependencies))
+			{
+				LOGWRN("Resource package cache \"" + cachePath.toString() + "\" is corrupt. Packaging all resources.");
+				mCache.clear();
+				return;
+			}
+
+			entry.assetModifiedTime = (std::time_t)assetModifiedTime;
+
+			bool isValid = true;
+			entry.dependencies.resize(numDependencies);
+			for (auto& dependency : entry.dependencies)
+				isValid &= reader.read(dependency);
+
+			UINT32 numNestedPrefabs = 0;
+			isValid &= reader.read(numNestedPrefabs);
+
+			if (isValid)
+			{
+				entry.nestedPrefabs.resize(numNestedPrefabs);
+				for (auto& nestedPrefab : entry.nestedPrefabs)
+					isValid &= reader.read(nestedPrefab);
+			}
+
+			if (!isValid)
+			{
+				LOGWRN("Resource package cache \"" + cachePath.toString() + "\" is corrupt. Packaging all resources.");
+				mCache.clear();
+				return;
+			}
+
+			mCache[uuid] = std::move(entry);
+		}
+	}
+
+	void ResourcePackager::saveCache()
+	{
+		mCache.clear();
+
+		Vector<UINT8> data;
+		writePackageCacheValue(data, CACHE_MAGIC);
+		writePackageCacheValue(data, CACHE_VERSION);
+		writePackageCacheString(data, mAssetFolder.toString());
+		writePackageCacheValue(data, (UINT32)mResources.size());
+
+		for (auto& resource : mResources)
+		{
+			const String outputName = resource.sourcePath.isEmpty() ? StringUtil::BLANK : resource.assetPath.getFilename();
+
+			writePackageCacheValue(data, resource.uuid);
+			writePackageCacheValue(data, (UINT64)resource.assetModifiedTime);
+			writePackageCacheValue(data, resource.assetSize);
+			writePackageCacheValue(data, resource.contentHash);
+			writePackageCacheValue(data, resource.outputKey);
+			writePackageCacheString(data, outputName);
+			writePackageCacheValue(data, (UINT32)resource.dependencies.size());
+
+			for (auto& dependency : resource.dependencies)
+				writePackageCacheValue(data, dependency);
+
+			writePackageCacheValue(data, (UINT32)resource.nestedPrefabs.size());
+			for (auto& nestedPrefab : resource.nestedPrefabs)
+				writePackageCacheValue(data, nestedPrefab);
+		}
+
+		Path cachePath = gEditorApplication().getProjectPath();
+		cachePath.append(PROJECT_INTERNAL_DIR);
+		cachePath.setFilename(CACHE_FILENAME);
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(cachePath);
+		if (stream == nullptr)
+		{
+			LOGWRN("Unable to save the resource package cache to \"" + cachePath.toString() + "\".");
+			return;
+		}
+
+		stream->write(data.data(), data.size());
+		stream->close();
+	}
+
+	void ResourcePackager::writeArchive()
+	{
+		Path archivePath = mOutputFolder;
+		archivePath.setFilename(ResourceArchiveWriter::ARCHIVE_NAME);
+
+		if (mPlatformInfo == nullptr || !mPlatformInfo->packResources)
+		{
+			ResourceArchiveWriter::remove(archivePath);
+			return;
+		}
+
+		ResourceArchiveWriter writer(archivePath);
+		for (auto& resource : mResources)
+		{
+			if (!resource.sourcePath.isEmpty())
+				writer.add(resource.uuid, getOutputPath(resource), resource.outputKey);
+		}
+
+		const bool success = writer.write();
+		mStats.numArchiveReused = writer.getNumReused();
+
+		if (!success)
+			return;
+
+		// Remove individual resource files output by previous builds made without packing
+		for (auto& resource : mResources)
+		{
+			if (resource.sourcePath.isEmpty())
+				continue;
+
+			Path loosePath = mOutputFolder;
+			loosePath.setFilename(resource.assetPath.getFilename());
+
+			if (FileSystem::isFile(loosePath))
+				FileSystem::remove(loosePath);
+		}
+	}
+
+	void ResourcePackager::writeLoadProfile()
+	{
+		ResourceLoadProfile profile;
+
+		// Main scene dependencies in the order they finish loading, meaning every resource comes after its dependencies
+		if (mPlatformInfo != nullptr)
+		{
+			const auto iterFind = mResourceLookup.find(mPlatformInfo->mainScene.getUUID());
+			if (iterFind != mResourceLookup.end())
+			{
+				UnorderedSet<UUID> visited;
+				Stack<std::pair<UINT32, UINT32>> todo; // Resource index, index of the next dependency to visit
+
+				visited.insert(mResources[iterFind->second].uuid);
+				todo.push(std::make_pair(iterFind->second, 0));
+
+				while (!todo.empty())
+				{
+					std::pair<UINT32, UINT32>& current = todo.top();
+					const PackagedResource& resource = mResources[current.first];
+
+					if (current.second < (UINT32)resource.dependencies.size())
+					{
+						const UUID& dependency = resource.dependencies[current.second++];
+
+						const auto iterDependency = mResourceLookup.find(dependency);
+						if (iterDependency != mResourceLookup.end() && visited.insert(dependency).second)
+							todo.push(std::make_pair(iterDependency->second, 0));
+					}
+					else
+					{
+						profile.add(resource.uuid);
+						todo.pop();
+					}
+				}
+			}
+		}
+
+		// Resources loaded dynamically, as recorded while playing in the editor
+		const Path recordedProfilePath = ResourceLoadRecorder::getRecordedProfilePath();
+
+		SPtr<ResourceLoadProfile> recordedProfile = ResourceLoadProfile::load(recordedProfilePath);
+		if (recordedProfile != nullptr)
+		{
+			for (auto& entry : recordedProfile->getEntries())
+			{
+				if (mResourceLookup.find(entry.uuid) != mResourceLookup.end())
+					profile.add(entry.uuid, entry.time);
+			}
+		}
+
+		Path profilePath = mOutputFolder;
+		profilePath.setFilename(ResourceLoadProfile::BUILD_PROFILE_NAME);
+
+		if (!profile.save(profilePath))
+			LOGWRN("Unable to save the resource load profile to \"" + profilePath.toString() + "\".");
+	}
+
+	void ResourcePackager::removeUnusedOutputs()
+	{
+		if (!FileSystem::isDirectory(mOutputFolder))
+			return;
+
+		// Packed resources are only read from the archive, so no loose resource files are used
+		UnorderedSet<String> usedOutputs;
+		if (mPlatformInfo == nullptr || !mPlatformInfo->packResources)
+		{
+			for (auto& resource : mResources)
+			{
+				if (!resource.sourcePath.isEmpty())
+					usedOutputs.insert(resource.assetPath.getFilename());
+			}
+		}
+
+		Vector<Path> toDelete;
+		auto processFile = [&](const Path& file)
+		{
+			if (file.getExtension() == ".asset" && usedOutputs.find(file.getFilename()) == usedOutputs.end())
+				toDelete.push_back(file);
+
+			return true;
+		};
+
+		FileSystem::iterate(mOutputFolder, processFile, nullptr, false);
+
+		for (auto& entry : toDelete)
+		{
+			FileSystem::remove(entry);
+			mStats.numRemoved++;
+		}
+	}
+
+	Path ResourcePackager::getOutputPath(const PackagedResource& resource) const
+	{
+		Path outputPath = mAssetFolder;
+		outputPath.setFilename(resource.assetPath.getFilename());
+
+		return outputPath;
+	}
+}
@@ -0,0 +1,180 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Build/BsPlatformInfo.h"
+#include "Build/BsResourceCooker.h"
+
+namespace bs
+{
+	/** @addtogroup Build
+	 *  @{
+	 */
+
+	/** Statistics about a single resource packaging run. All times are in milliseconds. */
+	struct ResourcePackagingStats
+	{
+		UINT32 numResources = 0; /**< Number of project resources included in the build. */
+		UINT32 numCopied = 0; /**< Number of resources copied because they changed since the last build. */
+		UINT32 numCooked = 0; /**< Number of resources cooked because they changed since the last build. */
+		UINT32 numPrefabsSaved = 0; /**< Number of prefabs re-saved because they changed since the last build. */
+		UINT32 numSkipped = 0; /**< Number of resources that were up to date. */
+		UINT32 numRemoved = 0; /**< Number of outputs of previous builds that are no longer used and were deleted. */
+		UINT32 numArchiveReused = 0; /**< Number of archive entries copied from the previous archive as stored. */
+
+		float dependencyTime = 0.0f; /**< Time spent finding resources and their dependencies. */
+		float hashTime = 0.0f; /**< Time spent checking which resources changed. */
+		float copyTime = 0.0f; /**< Time spent copying resources. */
+		float prefabTime = 0.0f; /**< Time spent updating and saving prefabs. */
+		float archiveTime = 0.0f; /**< Time spent writing the resource archive, if resources are packed. */
+		float finalizeTime = 0.0f; /**< Time spent saving the manifest, resource mapping and other data. */
+		float totalTime = 0.0f; /**< Total time of the packaging run. */
+	};
+
+	/**
+	 * Copies all the resources used by a build into the build folder, along with the resource manifest and the mapping
+	 * between project library paths and the packaged resources.
+	 *
+	 * Packaging is incremental: information about the packaged resources is kept in the project's internal folder and
+	 * resources whose contents and dependencies didn't change since the last build are not written again. Finding
+	 * dependencies, checking for changes and copying are done on task scheduler worker threads.
+	 *
+	 * Textures and meshes are cooked for the platform when copied, if the platform requests it. See ResourceCooker.
+	 *
+	 * If the platform requests packed resources, the resources are written to a staging folder in the project's
+	 * internal folder instead, and then packed into a single resource archive in the build folder. Entries of resources
+	 * that didn't change are copied from the previous archive without being compressed again, and the manifest and the
+	 * resource mapping refer to archive entries rather than individual files.
+	 *
+	 * Output is deterministic: resources are emitted in UUID order and every packaged file only depends on the
+	 * resource's contents and the build settings, so building the same project twice yields byte-identical files.
+	 */
+	class BS_ED_EXPORT ResourcePackager
+	{
+	public:
+		/**
+		 * @param[in]	buildFolder		Root folder of the build. Resources are packaged in its
+		 *								GAME_RESOURCES_FOLDER_NAME sub-folder.
+		 * @param[in]	platformInfo	Information about the platform the build is for.
+		 */
+		ResourcePackager(const Path& buildFolder, const SPtr<PlatformInfo>& platformInfo);
+
+		/** Packages the resources. Must be called from the main thread. */
+		void package();
+
+		/** Returns statistics about the last package() call. */
+		const ResourcePackagingStats& getStats() const { return mStats; }
+
+	private:
+		/** Information about a single resource included in the build. */
+		struct PackagedResource
+		{
+			UUID uuid;
+			Path assetPath; /**< Path to the imported resource asset. */
+			Path sourcePath; /**< Path to the resource in the project library. Empty for built-in resources. */
+			std::time_t assetModifiedTime = 0;
+			UINT64 assetSize = 0;
+			UINT64 contentHash = 0;
+			UINT64 outputKey = 0; /**< Hash of everything that influences the packaged output. */
+			Vector<UUID> dependencies;
+			Vector<UUID> nestedPrefabs; /**< Prefabs instantiated within this prefab. Only relevant for prefabs. */
+			bool isPrefab = false;
+			bool isCached = false; /**< True if the content hash was taken from the previous build. */
+			bool hasKnownDependencies = false; /**< True if dependencies were taken from the library meta-data. */
+			bool isCooked = false; /**< True if the resource is cooked for the platform, instead of copied. */
+			ResourceCookInput cookInput; /**< Information required for cooking the resource, if it is cooked. */
+			bool outputExists = false;
+		};
+
+		/** Information about a resource packaged during a previous build. */
+		struct CachedResource
+		{
+			std::time_t assetModifiedTime = 0;
+			UINT64 assetSize = 0;
+			UINT64 contentHash = 0;
+			UINT64 outputKey = 0;
+			String outputName; /**< Name of the packaged file. Empty for built-in resources. */
+			Vector<UUID> dependencies;
+			Vector<UUID> nestedPrefabs;
+		};
+
+		/** Finds all the resources included in the build, along with their dependencies. */
+		void findResources();
+
+		/** Calculates content hashes and output keys, used for determining which resources need to be packaged. */
+		void calculateOutputKeys();
+
+		/** Calculates the output key for the specified resource and its dependencies, if not already calculated. */
+		UINT64 calculateOutputKey(PackagedResource& resource, UnorderedSet<UUID>& visited);
+
+		/** Copies the resources that changed since the last build to the output folder, cooking them if needed. */
+		void copyResources(const Vector<PackagedResource*>& resources);
+
+		/**
+		 * Bakes prefabs that changed since the last build and saves them to the output folder. Baking updates the
+		 * instances of nested prefabs, and then flattens them into the prefab so the game never needs to resolve them.
+		 * Baked prefabs are cached per output key, so the same inputs always produce the same output file.
+		 */
+		void bakePrefabs(const Vector<PackagedResource*>& resources);
+
+		/**
+		 * Sorts the prefabs so that every prefab comes after the prefabs nested in it. Prefabs nesting each other in a
+		 * cycle are kept in their original order.
+		 */
+		static Vector<PackagedResource*> sortByNesting(const Vector<PackagedResource*>& prefabs);
+
+		/** Returns UUIDs of all prefabs instantiated within the provided prefab, at any depth. */
+		static Vector<UUID> findNestedPrefabs(const HPrefab& prefab);
+
+		/** Breaks links to nested prefab instances and clears all prefab diffs, as they're not used in standalone. */
+		static void flattenPrefab(const HPrefab& prefab);
+
+		/** Loads information about the resources packaged by the previous build. */
+		void loadCache();
+
+		/** Saves information about the packaged resources for use by the next build. */
+		void saveCache();
+
+		/**
+		 * Packs the packaged resources into a resource archive in the output folder if the platform requests it, or
+		 * removes an archive written by a previous build if it doesn't.
+		 */
+		void writeArchive();
+
+		/**
+		 * Writes the profile of resources the game loads on startup, allowing it to prefetch them. Consists of the main
+		 * scene's dependencies in load order, followed by resources loaded dynamically when playing in the editor.
+		 */
+		void writeLoadProfile();
+
+		/**
+		 * Removes resource files from the output folder that aren't used by this build. The build folder is not cleared
+		 * between builds, so this catches outputs the package cache doesn't know about, for example if it was deleted.
+		 */
+		void removeUnusedOutputs();
+
+		/** Returns the path the resource is packaged to. */
+		Path getOutputPath(const PackagedResource& resource) const;
+
+		static const char* CACHE_FILENAME;
+		static const UINT32 CACHE_MAGIC;
+		static const UINT32 CACHE_VERSION;
+		static const char* STAGING_FOLDER_NAME;
+		static const char* BAKED_PREFAB_FOLDER_NAME;
+
+		Path mBuildFolder;
+		Path mOutputFolder;
+		Path mAssetFolder; /**< Folder the resource assets are packaged to. */
+		SPtr<PlatformInfo> mPlatformInfo;
+		ResourceCooker mCooker;
+
+		Vector<PackagedResource> mResources;
+		UnorderedMap<UUID, UINT32> mResourceLookup;
+		UnorderedMap<UUID, CachedResource> mCache;
+
+		ResourcePackagingStats mStats;
+	};
+
+	/** @} */
+}
@@ -9,6 +9,11 @@ set(BS_BANSHEEEDITOR_SRC_LIBRARY
 	"Library/BsProjectLibraryEntries.cpp"
 	"Library/BsProjectResourceMeta.cpp"
 	"Library/BsEditorShaderIncludeHandler.cpp"
+	"Library/BsImportCache.cpp"
+	"Library/BsProjectLibraryJournal.cpp"
+	"Library/BsResourceUUIDIndex.cpp"
+	"Library/BsProjectLibrarySearchIndex.cpp"
+	"Library/BsResourceDependencyGraph.cpp"
 )
 
 set(BS_BANSHEEEDITOR_INC_EDITORWINDOW
@@ -29,8 +34,10 @@ set(BS_BANSHEEEDITOR_INC_EDITORWINDOW
 
 set(BS_BANSHEEEDITOR_INC_SCENE
 	"Scene/BsGizmoManager.h"
+	"Scene/BsGizmoInstanceBuffer.h"
 	"Scene/BsSceneGrid.h"
 	"Scene/BsScenePicking.h"
+	"Scene/BsSceneBVH.h"
 	"Scene/BsSelection.h"
 	"Scene/BsSelectionRenderer.h"
 )
@@ -69,6 +76,11 @@ set(BS_BANSHEEEDITOR_INC_LIBRARY
 	"Library/BsProjectLibraryEntries.h"
 	"Library/BsProjectResourceMeta.h"
 	"Library/BsEditorShaderIncludeHandler.h"
+	"Library/BsImportCache.h"
+	"Library/BsProjectLibraryJournal.h"
+	"Library/BsResourceUUIDIndex.h"
+	"Library/BsProjectLibrarySearchIndex.h"
+	"Library/BsResourceDependencyGraph.h"
 )
 
 set(BS_BANSHEEEDITOR_INC_GUI
@@ -132,9 +144,11 @@ set(BS_BANSHEEEDITOR_SRC_NOFILTER
 
 set(BS_BANSHEEEDITOR_SRC_SCENEVIEW
 	"SceneView/BsGizmoManager.cpp"
+	"SceneView/BsGizmoInstanceBuffer.cpp"
 	"SceneView/BsSelectionRenderer.cpp"
 	"SceneView/BsSelection.cpp"
 	"SceneView/BsScenePicking.cpp"
+	"SceneView/BsSceneBVH.cpp"
 	"SceneView/BsSceneGrid.cpp"
 )
 
@@ -158,6 +172,8 @@ set(BS_BANSHEEEDITOR_INC_HANDLES
 set(BS_BANSHEEEDITOR_SRC_UTILITY
 	"Utility/BsEditorUtility.cpp"
 	"Utility/BsSplashScreen.cpp"
+	"Utility/BsContentHash.cpp"
+	"Utility/BsIconGenerator.cpp"
 )
 
 set(BS_BANSHEEEDITOR_SRC_EDITORWINDOW
@@ -180,10 +196,13 @@ set(BS_BANSHEEEDITOR_INC_UTILITY
 	"Utility/BsEditorUtility.h"
 	"Utility/BsBuiltinEditorResources.h"
 	"Utility/BsSplashScreen.h"
+	"Utility/BsContentHash.h"
+	"Utility/BsIconGenerator.h"
 )
 
 set(BS_BANSHEEEDITOR_SRC_TESTING
 	"Testing/BsEditorTestSuite.cpp"
+	"Testing/BsEditorBenchmarks.cpp"
 )
 
 set(BS_BANSHEEEDITOR_SRC_SETTINGS
@@ -207,12 +226,22 @@ set(BS_BANSHEEEDITOR_SRC_UNDOREDO
 set(BS_BANSHEEEDITOR_INC_BUILD
 	"Build/BsBuildManager.h"
 	"Build/BsPlatformInfo.h"
+	"Build/BsResourcePackager.h"
+	"Build/BsResourceArchiveWriter.h"
+	"Build/BsResourceLoadProfile.h"
+	"Build/BsResourceCooker.h"
+	"Build/BsBuildManifest.h"
 )
 
 set(BS_BANSHEEEDITOR_SRC_BUILD
 	"Build/BsBuildManager.cpp"
 	"Build/BsBuiltinEditorResources.cpp"
 	"Build/BsPlatformInfo.cpp"
+	"Build/BsResourcePackager.cpp"
+	"Build/BsResourceArchiveWriter.cpp"
+	"Build/BsResourceLoadProfile.cpp"
+	"Build/BsResourceCooker.cpp"
+	"Build/BsBuildManifest.cpp"
 )
 
 set(BS_BANSHEEEDITOR_SRC_HANDLES
@@ -229,6 +258,7 @@ set(BS_BANSHEEEDITOR_SRC_HANDLES
 
 set(BS_BANSHEEEDITOR_INC_TESTING
 	"Testing/BsEditorTestSuite.h"
+	"Testing/BsEditorBenchmarks.h"
 )
 
 set(BS_BANSHEEEDITOR_INC_CODEEDITOR
@@ -8,6 +8,7 @@
 #include "GUI/BsGUIPanel.h"
 #include "GUI/BsGUIStatusBar.h"
 #include "Testing/BsEditorTestSuite.h"
+#include "Testing/BsEditorBenchmarks.h"
 #include "Testing/BsTestOutput.h"
 #include "RenderAPI/BsRenderWindow.h"
 #include "CoreThread/BsCoreThread.h"
@@ -42,6 +43,15 @@ namespace bs
 		}, 
 			10000);
 
+		// Benchmark results are only logged, so they are run on demand rather than with the tests below
+		mMenuBar->addMenuItemSeparator("Tools", 10000);
+		mMenuBar->addMenuItem("Tools/Run Editor Benchmarks", 
+			[]()
+		{
+			EditorBenchmarks::run();
+		}, 
+			10000);
+
 		SPtr<TestSuite> testSuite = TestSuite::create<EditorTestSuite>();
 		ExceptionTestOutput testOutput;
 		testSuite->run(testOutput);
@@ -0,0 +1,311 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Library/BsImportCache.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsFileSerializer.h"
+#include "Resources/BsResource.h"
+#include "Library/BsProjectResourceMeta.h"
+#include "Utility/BsContentHash.h"
+#include "Utility/BsUUID.h"
+
+namespace bs
+{
+	static const char* ENTRY_LIST_FILENAME = "Entries.txt";
+	static const char* STAGING_FOLDER_NAME = "Staging";
+
+	/** Versions assigned to importers through ImportCache::setImporterVersion(), keyed by lower case extension. */
+	static UnorderedMap<String, UINT32> sImporterVersions;
+	static Mutex sImporterVersionMutex;
+
+	/** Returns the path to the file containing the resource at the specified index in the entry. */
+	static Path getResourcePath(const Path& entryFolder, UINT32 idx)
+	{
+		return entryFolder + (toString(idx) + ".asset");
+	}
+
+	/** Returns the path to the file containing the meta-data of the resource at the specified index in the entry. */
+	static Path getMetaPath(const Path& entryFolder, UINT32 idx)
+	{
+		return entryFolder + (toString(idx) + ".meta");
+	}
+
+	/** Converts a 64-bit value into a fixed length hexadecimal string. */
+	static String toHexString(UINT64 value)
+	{
+		static const char* HEX_DIGITS = "0123456789abcdef";
+
+		String output(16, '0');
+		for(INT32 i = 15; i >= 0; i--)
+		{
+			output[i] = HEX_DIGITS[value & 0xF];
+			value >>= 4;
+		}
+
+		return output;
+	}
+
+	/**
+	 * Returns the folder containing the entry with the specified key. Entries are grouped in sub-folders by their key
+	 * prefix in order to avoid very large directories.
+	 */
+	static Path getEntryFolder(const Path& root, const String& key)
+	{
+		Path output = root;
+		output.append(key.substr(0, 2) + "/");
+		output.append(key + "/");
+
+		return output;
+	}
+
+	/** Returns a new unique folder in which an entry can be assembled before it is moved into its final location. */
+	static Path getStagingFolder(const Path& root)
+	{
+		Path output = root;
+		output.append(String(STAGING_FOLDER_NAME) + "/");
+		output.append(UUIDGenerator::generateRandom().toString() + "/");
+
+		return output;
+	}
+
+	/**
+	 * Moves a fully assembled entry into its final location. Since the move is a single operation, readers never observe
+	 * partially written entries. If another thread or process stored the same entry in the meantime, the staged copy is
+	 * discarded.
+	 */
+	static void commitStagedEntry(const Path& stagingFolder, const Path& entryFolder)
+	{
+		if(!FileSystem::isDirectory(entryFolder))
+		{
+			const Path parentFolder = entryFolder.getParent();
+			if(!FileSystem::isDirectory(parentFolder))
+				FileSystem::createDir(parentFolder);
+
+			FileSystem::move(stagingFolder, entryFolder, false);
+		}
+
+		if(FileSystem::exists(stagingFolder))
+			FileSystem::remove(stagingFolder);
+	}
+
+	/** Reads the list of resources stored in the entry in the provided folder. */
+	static bool readEntryList(const Path& entryFolder, Vector<ImportCacheEntry>& entries)
+	{
+		const Path listPath = entryFolder + ENTRY_LIST_FILENAME;
+
+		SPtr<DataStream> stream = FileSystem::openFile(listPath, true);
+		if(stream == nullptr)
+			return false;
+
+		const String contents = stream->getAsString();
+		stream->close();
+
+		const Vector<String> names = StringUtil::split(contents, "\n");
+		for(UINT32 i = 0; i < (UINT32)names.size(); i++)
+		{
+			if(names[i].empty())
+				continue;
+
+			ImportCacheEntry entry;
+			entry.name = names[i];
+			entry.path = getResourcePath(entryFolder, i);
+
+			const Path metaPath = getMetaPath(entryFolder, i);
+			if(FileSystem::isFile(entry.path) && FileSystem::isFile(metaPath))
+			{
+				FileDecoder fs(metaPath);
+				SPtr<IReflectable> meta = fs.decode();
+
+				if(meta != nullptr && meta->isDerivedFrom(ProjectResourceMeta::getRTTIStatic()))
+					entry.meta = std::static_pointer_cast<ProjectResourceMeta>(meta);
+			}
+
+			if(entry.meta == nullptr)
+			{
+				entries.clear();
+				return false;
+			}
+
+			entries.push_back(entry);
+		}
+
+		return !entries.empty();
+	}
+
+	String ImportCacheKey::toString() const
+	{
+		String lowerExtension = extension;
+		StringUtil::toLowerCase(lowerExtension);
+
+		ContentHash hash;
+		hash.update(&sourceHash, sizeof(sourceHash));
+		hash.update(&importOptionsHash, sizeof(importOptionsHash));
+		hash.update(lowerExtension.data(), lowerExtension.size());
+		hash.update(&importerVersion, sizeof(importerVersion));
+
+		const UINT32 version = ImportCache::VERSION;
+		hash.update(&version, sizeof(version));
+
+		const UINT32 platform = BS_PLATFORM;
+		hash.update(&platform, sizeof(platform));
+
+		return toHexString(sourceHash) + toHexString(hash.digest());
+	}
+
+	FolderImportCacheBackend::FolderImportCacheBackend(const Path& root)
+		:mRoot(root)
+	{ }
+
+	bool FolderImportCacheBackend::fetch(const String& key, const Path& destination)
+	{
+		const Path entryFolder = getEntryFolder(mRoot, key);
+		if(!FileSystem::isDirectory(entryFolder))
+			return false;
+
+		FileSystem::copy(entryFolder, destination, true);
+		return FileSystem::isFile(destination + ENTRY_LIST_FILENAME);
+	}
+
+	void FolderImportCacheBackend::store(const String& key, const Path& source)
+	{
+		const Path entryFolder = getEntryFolder(mRoot, key);
+		if(FileSystem::isDirectory(entryFolder))
+			return;
+
+		const Path stagingFolder = getStagingFolder(mRoot);
+		FileSystem::copy(source, stagingFolder, true);
+
+		commitStagedEntry(stagingFolder, entryFolder);
+	}
+
+	const UINT32 ImportCache::VERSION = 3;
+
+	ImportCache::ImportCache(const Path& localFolder)
+		:mFolder(localFolder)
+	{ }
+
+	void ImportCache::addBackend(const SPtr<ImportCacheBackend>& backend)
+	{
+		Lock lock(mMutex);
+		mBackends.push_back(backend);
+	}
+
+	bool ImportCache::find(const ImportCacheKey& key, Vector<ImportCacheEntry>& entries)
+	{
+		const String keyStr = key.toString();
+		const Path entryFolder = getEntryFolder(mFolder, keyStr);
+
+		if(!FileSystem::isDirectory(entryFolder))
+		{
+			Vector<SPtr<ImportCacheBackend>> backends;
+			{
+				Lock lock(mMutex);
+				backends = mBackends;
+			}
+
+			if(backends.empty())
+				return false;
+
+			const Path stagingFolder = getStagingFolder(mFolder);
+
+			bool fetched = false;
+			for(auto& backend : backends)
+			{
+				if(backend->fetch(keyStr, stagingFolder))
+				{
+					fetched = true;
+					break;
+				}
+			}
+
+			if(!fetched)
+			{
+				if(FileSystem::exists(stagingFolder))
+					FileSystem::remove(stagingFolder);
+
+				return false;
+			}
+
+			commitStagedEntry(stagingFolder, entryFolder);
+		}
+
+		return readEntryList(entryFolder, entries);
+	}
+
+	void ImportCache::store(const ImportCacheKey& key, const Vector<ImportCacheEntry>& entries)
+	{
+		if(entries.empty())
+			return;
+
+		const String keyStr = key.toString();
+		const Path entryFolder = getEntryFolder(mFolder, keyStr);
+
+		if(FileSystem::isDirectory(entryFolder))
+			return;
+
+		const Path stagingFolder = getStagingFolder(mFolder);
+		FileSystem::createDir(stagingFolder);
+
+		StringStream entryList;
+		for(UINT32 i = 0; i < (UINT32)entries.size(); i++)
+		{
+			FileSystem::copy(entries[i].path, getResourcePath(stagingFolder, i), true);
+
+			FileEncoder fs(getMetaPath(stagingFolder, i));
+			fs.encode(entries[i].meta.get());
+
+			entryList << entries[i].name << "\n";
+		}
+
+		// Written last, as entries without the list are considered invalid
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(stagingFolder + ENTRY_LIST_FILENAME);
+		stream->writeString(entryList.str());
+		stream->close();
+
+		commitStagedEntry(stagingFolder, entryFolder);
+
+		Vector<SPtr<ImportCacheBackend>> backends;
+		{
+			Lock lock(mMutex);
+			backends = mBackends;
+		}
+
+		for(auto& backend : backends)
+			backend->store(keyStr, entryFolder);
+	}
+
+	SPtr<Resource> ImportCache::loadResource(const Path& path)
+	{
+		FileDecoder fs(path);
+		fs.skip(); // Skip the header written by Resources, containing resource dependencies
+
+		SPtr<IReflectable> loadedData = fs.decode();
+		if(loadedData == nullptr || !loadedData->isDerivedFrom(Resource::getRTTIStatic()))
+			return nullptr;
+
+		return std::static_pointer_cast<Resource>(loadedData);
+	}
+
+	UINT32 ImportCache::getImporterVersion(const String& extension)
+	{
+		String lowerExtension = extension;
+		StringUtil::toLowerCase(lowerExtension);
+
+		Lock lock(sImporterVersionMutex);
+
+		const auto iterFind = sImporterVersions.find(lowerExtension);
+		if(iterFind != sImporterVersions.end())
+			return iterFind->second;
+
+		return 0;
+	}
+
+	void ImportCache::setImporterVersion(const String& extension, UINT32 version)
+	{
+		String lowerExtension = extension;
+		StringUtil::toLowerCase(lowerExtension);
+
+		Lock lock(sImporterVersionMutex);
+		sImporterVersions[lowerExtension] = version;
+	}
+}
@@ -0,0 +1,151 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Library
+	 *  @{
+	 */
+
+	/** Uniquely identifies the output of a single import operation. */
+	struct BS_ED_EXPORT ImportCacheKey
+	{
+		/** Hash of the contents of the source file. */
+		UINT64 sourceHash = 0;
+
+		/** Hash of the import options used for importing the source file. */
+		UINT64 importOptionsHash = 0;
+
+		/** Extension of the source file, which determines the importer used. */
+		String extension;
+
+		/** Version of the importer used for the source file, as reported by ImportCache::getImporterVersion(). */
+		UINT32 importerVersion = 0;
+
+		/**
+		 * Converts the key into a string that can be used as a file name. The string also encodes the cache version and
+		 * the platform, so outputs of incompatible editor builds never get mixed.
+		 */
+		String toString() const;
+	};
+
+	/** A single resource stored in an import cache entry. */
+	struct ImportCacheEntry
+	{
+		/** Name of the sub-resource, as reported by the importer. */
+		String name;
+
+		/** Path to the file containing the serialized resource. */
+		Path path;
+
+		/**
+		 * Meta-data describing the resource, including its type and preview icons. Stored separately from the resource
+		 * so cached outputs can be used without decoding them.
+		 */
+		SPtr<ProjectResourceMeta> meta;
+	};
+
+	/**
+	 * Remote storage for import cache entries, allowing import outputs to be shared between multiple machines. Each cache
+	 * entry is represented as a folder with a flat list of files. Implementations must be thread safe as they are called
+	 * from import worker threads.
+	 */
+	class BS_ED_EXPORT ImportCacheBackend
+	{
+	public:
+		virtual ~ImportCacheBackend() = default;
+
+		/**
+		 * Retrieves the cache entry with the specified key and copies its files into the destination folder. Returns
+		 * false if the entry doesn't exist.
+		 */
+		virtual bool fetch(const String& key, const Path& destination) = 0;
+
+		/** Stores all the files in the source folder as a cache entry with the specified key. */
+		virtual void store(const String& key, const Path& source) = 0;
+	};
+
+	/** Import cache backend that stores its entries in a (usually shared network) folder. */
+	class BS_ED_EXPORT FolderImportCacheBackend : public ImportCacheBackend
+	{
+	public:
+		FolderImportCacheBackend(const Path& root);
+
+		/** @copydoc ImportCacheBackend::fetch */
+		bool fetch(const String& key, const Path& destination) override;
+
+		/** @copydoc ImportCacheBackend::store */
+		void store(const String& key, const Path& source) override;
+
+	private:
+		Path mRoot;
+	};
+
+	/**
+	 * Content addressed cache of import outputs. Entries are keyed by the contents of the source file and its import
+	 * options, so re-importing identical data (e.g. after switching branches, or on a fresh checkout) only requires a copy
+	 * of previously imported resources instead of a full import. Entries are stored in a local folder, and optionally
+	 * in any number of additional backends shared between multiple users.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_ED_EXPORT ImportCache
+	{
+	public:
+		/** Creates a new cache that stores its entries in the provided local folder. */
+		ImportCache(const Path& localFolder);
+
+		/**
+		 * Registers an additional backend to look up entries in when they are not found locally. Newly stored entries are
+		 * also uploaded to all the registered backends.
+		 */
+		void addBackend(const SPtr<ImportCacheBackend>& backend);
+
+		/**
+		 * Attempts to find an entry with the specified key, either locally or in one of the backends. Entries retrieved
+		 * from backends are stored in the local folder for faster future access.
+		 *
+		 * @param[in]	key			Key of the entry to look up.
+		 * @param[out]	entries		List of resources stored in the entry, in the order they were stored in.
+		 * @return					True if the entry was found, false otherwise.
+		 */
+		bool find(const ImportCacheKey& key, Vector<ImportCacheEntry>& entries);
+
+		/**
+		 * Stores a new entry into the cache. Files referenced by the provided entries are copied, so they may be safely
+		 * modified or deleted afterwards. Does nothing if an entry with the same key already exists.
+		 */
+		void store(const ImportCacheKey& key, const Vector<ImportCacheEntry>& entries);
+
+		/** Loads a resource from a cached resource file. Returns null if the file cannot be loaded. */
+		static SPtr<Resource> loadResource(const Path& path);
+
+		/**
+		 * Returns the version of the importer used for files with the provided extension. Importers that were never
+		 * assigned a version are at version zero.
+		 */
+		static UINT32 getImporterVersion(const String& extension);
+
+		/**
+		 * Assigns a version to the importer used for files with the provided extension. The version must be increased
+		 * whenever the importer changes its output, so entries imported by its previous version are no longer used.
+		 */
+		static void setImporterVersion(const String& extension, UINT32 version);
+
+		/**
+		 * Version of the data stored in the cache. Must be incremented whenever the cache layout or a resource
+		 * serialization format changes, in order to invalidate existing entries.
+		 */
+		static const UINT32 VERSION;
+
+	private:
+		Path mFolder;
+		Vector<SPtr<ImportCacheBackend>> mBackends;
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}
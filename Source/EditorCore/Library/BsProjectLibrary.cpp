@@ -10,6 +10,7 @@
 #include "Resources/BsResources.h"
 #include "Importer/BsImporter.h"
 #include "Importer/BsImportOptions.h"
+#include "Importer/BsTextureImportOptions.h"
 #include "Serialization/BsFileSerializer.h"
 #include "Debug/BsDebug.h"
 #include "Library/BsProjectLibraryEntries.h"
@@ -17,16 +18,35 @@
 #include "BsEditorApplication.h"
 #include "Material/BsShader.h"
 #include "Image/BsTexture.h"
+#include "Mesh/BsMesh.h"
 #include "String/BsUnicode.h"
 #include "CoreThread/BsCoreThread.h"
-#include <regex>
 #include "Threading/BsTaskScheduler.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Utility/BsContentHash.h"
+#include "Utility/BsUtility.h"
+#include "Library/BsImportCache.h"
+#include "Library/BsProjectLibraryJournal.h"
+#include "Library/BsResourceUUIDIndex.h"
+#include "Library/BsProjectLibrarySearchIndex.h"
+#include "Library/BsResourceDependencyGraph.h"
+#include "Utility/BsEditorUtility.h"
+#include "Utility/BsIconGenerator.h"
 
 using namespace std::placeholders;
 
 namespace bs
 {
-	ProjectResourceIcons generatePreviewIcons(Resource& resource)
+	/** Size of the largest preview icon. Source textures are sampled from the smallest mip level at least this large. */
+	static constexpr UINT32 MAX_PREVIEW_ICON_SIZE = 256;
+
+	/**
+	 * Generates preview icons for the provided resource. Meant to be called from the import thread, immediately after
+	 * the resource was imported. Icons are only generated for textures with CPU cached data, in a format that can be
+	 * decompressed, so their data never needs to be read back from the GPU. Other textures are left without a preview,
+	 * in which case the generic texture icon is displayed instead.
+	 */
+	static ProjectResourceIcons generatePreviewIcons(Resource& resource)
 	{
 		ProjectResourceIcons icons;
 
@@ -35,61 +55,170 @@ namespace bs
 		{
 			Texture& texture = static_cast<Texture&>(resource);
 
-			const TextureProperties& props = texture.getProperties();
+			const SPtr<PixelData> srcData = IconGenerator::readCachedPixels(texture, MAX_PREVIEW_ICON_SIZE);
+			if(srcData == nullptr)
+				return icons;
+
+			Map<UINT32, SPtr<PixelData>> iconData = IconGenerator::generate(*srcData,
+				{ 16, 32, 48, 64, 96, 128, 192, MAX_PREVIEW_ICON_SIZE });
+
+			icons.icon16 = Texture::create(iconData[16]);
+			icons.icon32 = Texture::create(iconData[32]);
+			icons.icon48 = Texture::create(iconData[48]);
+			icons.icon64 = Texture::create(iconData[64]);
+			icons.icon96 = Texture::create(iconData[96]);
+			icons.icon128 = Texture::create(iconData[128]);
+			icons.icon192 = Texture::create(iconData[192]);
+			icons.icon256 = Texture::create(iconData[256]);
+		}
 
-			const SPtr<PixelData> srcData = props.allocBuffer(0, 0);
-			AsyncOp readOp = texture.readData(srcData);
-			gCoreThread().submitAll(true);
+		return icons;
+	}
 
-			// 256
-			const SPtr<PixelData> data256 = PixelData::create(256, 256, 1, props.getFormat());
-			PixelUtil::scale(*srcData, *data256);
+	/**
+	 * Checks can the imported resource be saved. Textures and meshes are saved by reading their contents back from the
+	 * GPU, which the null render API used by the headless editor doesn't provide, so they would be saved without any
+	 * data.
+	 */
+	static bool canSaveImported(const Resource& resource)
+	{
+		if(!gEditorApplication().isHeadless())
+			return true;
 
-			// 192
-			const SPtr<PixelData> data192 = PixelData::create(192, 192, 1, props.getFormat());
-			PixelUtil::scale(*data256, *data192);
+		const UINT32 typeId = resource.getTypeId();
+		return typeId != TID_Texture && typeId != TID_Mesh;
+	}
 
-			// 128
-			const SPtr<PixelData> data128 = PixelData::create(128, 128, 1, props.getFormat());
-			PixelUtil::scale(*data192, *data128);
+	/**
+	 * Returns import options to import the file with. Textures are always imported with CPU cached data, so their
+	 * preview icons can be generated from it. If the original options don't request CPU cached data, 
+	 * @p removeCPUCachedData is set to true and the data must be removed using removeCPUCachedData() after the icons are
+	 * generated.
+	 */
+	static SPtr<ImportOptions> getImportOptionsWithCPUData(const SPtr<ImportOptions>& importOptions, 
+		bool& removeCPUCachedData)
+	{
+		removeCPUCachedData = false;
 
-			// 96
-			const SPtr<PixelData> data96 = PixelData::create(96, 96, 1, props.getFormat());
-			PixelUtil::scale(*data128, *data96);
+		if(importOptions == nullptr || importOptions->getRTTI()->getRTTIId() != TID_TextureImportOptions)
+			return importOptions;
 
-			// 64
-			const SPtr<PixelData> data64 = PixelData::create(64, 64, 1, props.getFormat());
-			PixelUtil::scale(*data96, *data64);
+		const SPtr<TextureImportOptions> textureIO = std::static_pointer_cast<TextureImportOptions>(importOptions);
+		if(textureIO->getCPUCached())
+			return importOptions;
 
-			// 48
-			const SPtr<PixelData> data48 = PixelData::create(48, 48, 1, props.getFormat());
-			PixelUtil::scale(*data64, *data48);
+		SPtr<TextureImportOptions> output = bs_shared_ptr_new<TextureImportOptions>(*textureIO);
+		output->setCPUCached(true);
 
-			// 32
-			const SPtr<PixelData> data32 = PixelData::create(32, 32, 1, props.getFormat());
-			PixelUtil::scale(*data48, *data32);
+		removeCPUCachedData = true;
+		return output;
+	}
 
-			// 16
-			const SPtr<PixelData> data16 = PixelData::create(16, 16, 1, props.getFormat());
-			PixelUtil::scale(*data32, *data16);
+	/** 
+	 * Creates a copy of a texture imported with CPU cached data, without that data. The copy is initialized from the 
+	 * cached data, so nothing is read back from the GPU.
+	 */
+	static SPtr<Texture> removeCPUCachedData(const SPtr<Texture>& texture)
+	{
+		const TextureProperties& props = texture->getProperties();
+
+		TEXTURE_DESC desc;
+		desc.type = props.getTextureType();
+		desc.format = props.getFormat();
+		desc.width = props.getWidth();
+		desc.height = props.getHeight();
+		desc.depth = props.getDepth();
+		desc.numMips = props.getNumMipmaps();
+		desc.numArraySlices = props.getNumArraySlices();
+		desc.hwGamma = props.isHardwareGammaEnabled();
+		desc.usage = props.getUsage() & ~TU_CPUCACHED;
+
+		SPtr<Texture> output = Texture::_createPtr(desc);
+		output->setName(texture->getName());
+
+		for (UINT32 face = 0; face < props.getNumFaces(); face++)
+		{
+			for (UINT32 mip = 0; mip <= desc.numMips; mip++)
+			{
+				SPtr<PixelData> pixelData = props.allocBuffer(face, mip);
+				texture->readCachedData(*pixelData, face, mip);
 
-			icons.icon16 = Texture::create(data16);
-			icons.icon32 = Texture::create(data32);
-			icons.icon48 = Texture::create(data48);
-			icons.icon64 = Texture::create(data64);
-			icons.icon96 = Texture::create(data96);
-			icons.icon128 = Texture::create(data128);
-			icons.icon192 = Texture::create(data192);
-			icons.icon256 = Texture::create(data256);
+				output->writeData(pixelData, face, mip, false);
+			}
 		}
 
-		return icons;
+		return output;
+	}
+
+	/**
+	 * Updates the resource referenced by the handle with its newly imported version. Resources copied from the import
+	 * cache are not decoded during import, in which case they are loaded from the provided file, but only if the handle
+	 * is currently in use.
+	 */
+	static void updateImportedResource(HResource& handle, const SPtr<Resource>& resource, const Path& path)
+	{
+		if(resource != nullptr)
+			gResources().update(handle, resource);
+		else if(handle.isLoaded(false))
+		{
+			SPtr<Resource> loadedResource = ImportCache::loadResource(path);
+			if(loadedResource != nullptr)
+				gResources().update(handle, loadedResource);
+		}
+	}
+
+	/** Returns a hash of the provided import options, based on their serialized contents. */
+	static UINT64 hashImportOptions(const SPtr<ImportOptions>& importOptions)
+	{
+		if(importOptions == nullptr)
+			return 0;
+
+		MemorySerializer serializer;
+
+		UINT32 size = 0;
+		UINT8* data = serializer.encode(importOptions.get(), size);
+		const UINT64 hash = ContentHash::hash(data, size);
+		bs_free(data);
+
+		return hash;
+	}
+
+	/** Combines the source file hash and import options into a fingerprint that uniquely identifies the import output. */
+	static UINT64 getSourceFingerprint(UINT64 sourceHash, const SPtr<ImportOptions>& importOptions)
+	{
+		return ContentHash::combine(sourceHash, hashImportOptions(importOptions));
+	}
+
+	/**
+	 * Checks does the imported resource depend on project files other than its source file, such as shader includes.
+	 * Contents of those files are not a part of the import cache key.
+	 */
+	static bool hasImportDependencies(const Resource& resource)
+	{
+		if (resource.getTypeId() != TID_Shader)
+			return false;
+
+		SPtr<ShaderMetaData> metaData = std::static_pointer_cast<ShaderMetaData>(resource.getMetaData());
+		if (metaData == nullptr)
+			return false;
+
+		for (auto& include : metaData->includes)
+		{
+			// Built-in includes are not a part of the project library
+			if (!include.empty() && include[0] != '$')
+				return true;
+		}
+
+		return false;
 	}
 
 	const Path ProjectLibrary::RESOURCES_DIR = "Resources/";
 	const Path ProjectLibrary::INTERNAL_RESOURCES_DIR = PROJECT_INTERNAL_DIR + GAME_RESOURCES_FOLDER_NAME;
 	const char* ProjectLibrary::LIBRARY_ENTRIES_FILENAME = "ProjectLibrary.asset";
+	const char* ProjectLibrary::LIBRARY_JOURNAL_FILENAME = "ProjectLibrary.journal";
+	const char* ProjectLibrary::RESOURCE_INDEX_FILENAME = "ResourceIndex.dat";
 	const char* ProjectLibrary::RESOURCE_MANIFEST_FILENAME = "ResourceManifest.asset";
+	const UINT32 ProjectLibrary::MIN_DIRECTORIES_PER_SCAN_TASK = 8;
 
 	ProjectLibrary::LibraryEntry::LibraryEntry()
 		:type(LibraryEntryType::Directory), parent(nullptr)
@@ -114,10 +243,61 @@ namespace bs
 		:LibraryEntry(path, name, parent, LibraryEntryType::Directory)
 	{ }
 
+	size_t ProjectLibrary::EntryNameHash::operator()(const String* name) const
+	{
+		// FNV-1a over lower-case characters, matching the case insensitive comparison in EntryNameEqual
+		size_t hash = (size_t)14695981039346656037ULL;
+		for(auto& entry : *name)
+		{
+			hash ^= (size_t)(UINT8)tolower((UINT8)entry);
+			hash *= (size_t)1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	bool ProjectLibrary::EntryNameEqual::operator()(const String* lhs, const String* rhs) const
+	{
+		return Path::comparePathElem(*lhs, *rhs);
+	}
+
+	void ProjectLibrary::DirectoryEntry::addChild(LibraryEntry* child)
+	{
+		mChildren.push_back(child);
+
+		// Erase first, so the key points to the newly added child's name and not to the name of the replaced child
+		mChildLookup.erase(&child->elementName);
+		mChildLookup[&child->elementName] = child;
+	}
+
+	void ProjectLibrary::DirectoryEntry::removeChild(LibraryEntry* child)
+	{
+		const auto iterFind = std::find(mChildren.begin(), mChildren.end(), child);
+		if(iterFind != mChildren.end())
+			mChildren.erase(iterFind);
+
+		// Multiple children might map to the same key on case-sensitive file systems, only remove our own entry
+		const auto iterLookup = mChildLookup.find(&child->elementName);
+		if(iterLookup != mChildLookup.end() && iterLookup->second == child)
+			mChildLookup.erase(iterLookup);
+	}
+
+	ProjectLibrary::LibraryEntry* ProjectLibrary::DirectoryEntry::findChild(const String& name) const
+	{
+		const auto iterFind = mChildLookup.find(&name);
+		if(iterFind != mChildLookup.end())
+			return iterFind->second;
+
+		return nullptr;
+	}
+
 	ProjectLibrary::ProjectLibrary()
 		: mRootEntry(nullptr), mIsLoaded(false)
 	{
 		mRootEntry = bs_new<DirectoryEntry>(mResourcesFolder, mResourcesFolder.getTail(), nullptr);
+		mUUIDIndex = bs_shared_ptr_new<ResourceUUIDIndex>();
+		mSearchIndex = bs_shared_ptr_new<ProjectLibrarySearchIndex>();
+		mDependencyGraph = bs_shared_ptr_new<ResourceDependencyGraph>();
 	}
 
 	ProjectLibrary::~ProjectLibrary()
@@ -138,6 +318,9 @@ namespace bs
 			mRootEntry = bs_new<DirectoryEntry>(mResourcesFolder, mResourcesFolder.getTail(), nullptr);
 		}
 
+		// Report all entry additions/removals once the hierarchy is fully updated
+		beginEntryEventBatch();
+
 		Path pathToSearch = fullPath;
 		LibraryEntry* entry = findEntry(pathToSearch);
 		if (entry == nullptr) // File could be new, try to find parent directory entry
@@ -198,119 +381,213 @@ namespace bs
 			}
 			else
 			{
-				Stack<DirectoryEntry*> todo;
-				todo.push(static_cast<DirectoryEntry*>(entry));
+				// Enumerate the file system on worker threads, then update the hierarchy on this thread
+				Vector<ScannedDirectory> scannedDirectories;
+				scanDirectoryTree(entry->path, scannedDirectories);
+
+				resourcesToImport += applyDirectoryScan(static_cast<DirectoryEntry*>(entry), scannedDirectories);
+			}
+		}
+
+		endEntryEventBatch();
+
+		return resourcesToImport;
+	}
+
+	void ProjectLibrary::scanDirectoryTree(const Path& path, Vector<ScannedDirectory>& output) const
+	{
+		output.clear();
+		output.emplace_back();
+		output.back().path = path;
+
+		const auto scanRange = [this, &output](UINT32 start, UINT32 end)
+		{
+			for(UINT32 i = start; i < end; i++)
+				scanDirectory(output[i]);
+		};
+
+		// Scan one level of the hierarchy at a time, with all directories in the level processed in parallel
+		UINT32 levelStart = 0;
+		while(levelStart < (UINT32)output.size())
+		{
+			const UINT32 levelEnd = (UINT32)output.size();
+			const UINT32 numDirectories = levelEnd - levelStart;
+
+			EditorUtility::runInParallel("ProjectLibraryScan", numDirectories, MIN_DIRECTORIES_PER_SCAN_TASK, 
+				[&scanRange, levelStart](UINT32 start, UINT32 end) { scanRange(levelStart + start, levelStart + end); });
 
-				Vector<Path> childFiles;
-				Vector<Path> childDirectories;
-				Vector<bool> existingEntries;
-				Vector<LibraryEntry*> toDelete;
+			// Allocate entries for the next level. Child directories of a single directory are stored contiguously.
+			for(UINT32 i = levelStart; i < levelEnd; i++)
+			{
+				output[i].firstChild = (UINT32)output.size();
 
-				while(!todo.empty())
+				const UINT32 numChildren = (UINT32)output[i].directories.size();
+				for(UINT32 j = 0; j < numChildren; j++)
 				{
-					DirectoryEntry* currentDir = todo.top();
-					todo.pop();
+					ScannedDirectory child;
+					child.path = output[i].directories[j];
 
-					existingEntries.clear();
-					existingEntries.resize(currentDir->mChildren.size());
-					for(UINT32 i = 0; i < (UINT32)currentDir->mChildren.size(); i++)
-						existingEntries[i] = false;
+					output.push_back(std::move(child));
+				}
+			}
 
-					childFiles.clear();
-					childDirectories.clear();
+			levelStart = levelEnd;
+		}
+	}
 
-					FileSystem::getChildren(currentDir->path, childFiles, childDirectories);
-			
-					for(auto& filePath : childFiles)
-					{
-						if(isMeta(filePath))
-						{
-							Path sourceFilePath = filePath;
-							sourceFilePath.setExtension("");
+	void ProjectLibrary::scanDirectory(ScannedDirectory& directory) const
+	{
+		Vector<Path> childFiles;
+		FileSystem::getChildren(directory.path, childFiles, directory.directories);
 
-							if(!FileSystem::isFile(sourceFilePath))
-							{
-								LOGWRN("Found a .meta file without a corresponding resource. Deleting.");
+		UnorderedSet<String> sourceFileNames;
+		for(auto& filePath : childFiles)
+		{
+			if(!isMeta(filePath))
+				sourceFileNames.insert(filePath.getFilename());
+		}
 
-								FileSystem::remove(filePath);
-							}
-						}
-						else
-						{
-							FileEntry* existingEntry = nullptr;
-							UINT32 idx = 0;
-							for(auto& child : currentDir->mChildren)
-							{
-								if(child->type == LibraryEntryType::File && child->path == filePath)
-								{
-									existingEntries[idx] = true;
-									existingEntry = static_cast<FileEntry*>(child);
-									break;
-								}
+		for(auto& filePath : childFiles)
+		{
+			if(isMeta(filePath))
+			{
+				// Only query the file system if the source file wasn't enumerated (e.g. different case)
+				if(sourceFileNames.find(filePath.getFilename(false)) == sourceFileNames.end())
+				{
+					Path sourceFilePath = filePath;
+					sourceFilePath.setExtension("");
 
-								idx++;
-							}
+					if(!FileSystem::isFile(sourceFilePath))
+						directory.orphanedMetas.push_back(filePath);
+				}
+			}
+			else
+			{
+				ScannedFile scannedFile;
+				scannedFile.path = filePath;
+				scannedFile.lastModifiedTime = FileSystem::getLastModifiedTime(filePath);
+				scannedFile.size = FileSystem::getFileSize(filePath);
 
-							if(existingEntry != nullptr)
-							{
-								if(reimportResourceInternal(existingEntry))
-									resourcesToImport++;
-							}
-							else
-							{
-								addResourceInternal(currentDir, filePath);
-								resourcesToImport++;
-							}
-						}
-					}
+				directory.files.push_back(scannedFile);
+			}
+		}
+	}
 
-					for(auto& dirPath : childDirectories)
-					{
-						DirectoryEntry* existingEntry = nullptr;
-						UINT32 idx = 0;
-						for(auto& child : currentDir->mChildren)
-						{
-							if(child->type == LibraryEntryType::Directory && child->path == dirPath)
-							{
-								existingEntries[idx] = true;
-								existingEntry = static_cast<DirectoryEntry*>(child);
-								break;
-							}
+	UINT32 ProjectLibrary::applyDirectoryScan(DirectoryEntry* rootEntry, Vector<ScannedDirectory>& scannedDirectories)
+	{
+		UINT32 resourcesToImport = 0;
 
-							idx++;
-						}
+		Stack<std::pair<DirectoryEntry*, UINT32>> todo;
+		todo.push(std::make_pair(rootEntry, 0));
 
-						if(existingEntry == nullptr)
-							addDirectoryInternal(currentDir, dirPath);
-					}
+		UnorderedSet<LibraryEntry*> existingEntries;
+		Vector<std::pair<FileEntry*, ScannedFile*>> existingFiles;
+		Vector<const ScannedFile*> newFiles;
+		Vector<UINT32> newDirectories;
+		Vector<LibraryEntry*> toDelete;
 
-					{
-						for(UINT32 i = 0; i < (UINT32)existingEntries.size(); i++)
-						{
-							if(existingEntries[i])
-								continue;
+		while(!todo.empty())
+		{
+			DirectoryEntry* currentDir = todo.top().first;
+			ScannedDirectory& scannedDir = scannedDirectories[todo.top().second];
+			todo.pop();
 
-							toDelete.push_back(currentDir->mChildren[i]);
-						}
+			for(auto& metaPath : scannedDir.orphanedMetas)
+			{
+				LOGWRN("Found a .meta file without a corresponding resource. Deleting.");
 
-						for(auto& child : toDelete)
-						{
-							if(child->type == LibraryEntryType::Directory)
-								deleteDirectoryInternal(static_cast<DirectoryEntry*>(child));
-							else if(child->type == LibraryEntryType::File)
-								deleteResourceInternal(static_cast<FileEntry*>(child));
-						}
+				FileSystem::remove(metaPath);
+			}
 
-						toDelete.clear();
-					}
+			for(auto& scannedFile : scannedDir.files)
+			{
+				LibraryEntry* child = currentDir->findChild(scannedFile.path.getTail());
+				if(child != nullptr && child->type == LibraryEntryType::File)
+				{
+					existingEntries.insert(child);
+					existingFiles.push_back(std::make_pair(static_cast<FileEntry*>(child), &scannedFile));
+				}
+				else
+					newFiles.push_back(&scannedFile);
+			}
 
-					for(auto& child : currentDir->mChildren)
-					{
-						if(child->type == LibraryEntryType::Directory)
-							todo.push(static_cast<DirectoryEntry*>(child));
-					}
+			const UINT32 numChildDirectories = (UINT32)scannedDir.directories.size();
+			for(UINT32 i = 0; i < numChildDirectories; i++)
+			{
+				const UINT32 scannedIdx = scannedDir.firstChild + i;
+
+				LibraryEntry* child = currentDir->findChild(scannedDir.directories[i].getTail());
+				if(child != nullptr && child->type == LibraryEntryType::Directory)
+				{
+					existingEntries.insert(child);
+					todo.push(std::make_pair(static_cast<DirectoryEntry*>(child), scannedIdx));
 				}
+				else
+					newDirectories.push_back(scannedIdx);
+			}
+
+			// Remove deleted entries before adding new ones, in case an entry with the same name changed its type
+			for(auto& child : currentDir->mChildren)
+			{
+				if(existingEntries.find(child) == existingEntries.end())
+					toDelete.push_back(child);
+			}
+
+			for(auto& child : toDelete)
+			{
+				if(child->type == LibraryEntryType::Directory)
+					deleteDirectoryInternal(static_cast<DirectoryEntry*>(child));
+				else if(child->type == LibraryEntryType::File)
+					deleteResourceInternal(static_cast<FileEntry*>(child));
+			}
+
+			for(auto& scannedFile : newFiles)
+			{
+				addResourceInternal(currentDir, scannedFile->path);
+				resourcesToImport++;
+			}
+
+			for(auto& scannedIdx : newDirectories)
+			{
+				DirectoryEntry* newEntry = addDirectoryInternal(currentDir, scannedDirectories[scannedIdx].path);
+				todo.push(std::make_pair(newEntry, scannedIdx));
+			}
+
+			existingEntries.clear();
+			newFiles.clear();
+			newDirectories.clear();
+			toDelete.clear();
+		}
+
+		// Files whose timestamp changed might still have the same contents (e.g. after a VCS checkout). Calculate their
+		// content hashes in parallel, so the up-to-date check below doesn't have to read them one by one.
+		Vector<ScannedFile*> filesToHash;
+		for(auto& entry : existingFiles)
+		{
+			FileEntry* fileEntry = entry.first;
+			ScannedFile* scannedFile = entry.second;
+
+			if(fileEntry->meta == nullptr || fileEntry->meta->getSourceFingerprint() == 0)
+				continue;
+
+			if(!isTimestampUpToDate(fileEntry, scannedFile->lastModifiedTime, scannedFile->size))
+				filesToHash.push_back(scannedFile);
+		}
+
+		EditorUtility::runInParallel("ProjectLibraryHash", (UINT32)filesToHash.size(), 1, 
+			[&filesToHash](UINT32 start, UINT32 end)
+		{
+			for(UINT32 i = start; i < end; i++)
+			{
+				filesToHash[i]->contentHash = ContentHash::hashFile(filesToHash[i]->path);
+				filesToHash[i]->hasContentHash = true;
 			}
+		});
+
+		for(auto& entry : existingFiles)
+		{
+			if(reimportResourceInternal(entry.first, nullptr, false, false, entry.second))
+				resourcesToImport++;
 		}
 
 		return resourcesToImport;
@@ -320,10 +597,10 @@ namespace bs
 		const SPtr<ImportOptions>& importOptions, bool forceReimport)
 	{
 		FileEntry* newResource = bs_new<FileEntry>(filePath, filePath.getTail(), parent);
-		parent->mChildren.push_back(newResource);
+		parent->addChild(newResource);
 
 		reimportResourceInternal(newResource, importOptions, forceReimport);
-		onEntryAdded(newResource->path);
+		notifyEntryAdded(newResource);
 
 		return newResource;
 	}
@@ -331,9 +608,9 @@ namespace bs
 	ProjectLibrary::DirectoryEntry* ProjectLibrary::addDirectoryInternal(DirectoryEntry* parent, const Path& dirPath)
 	{
 		DirectoryEntry* newEntry = bs_new<DirectoryEntry>(dirPath, dirPath.getTail(), parent);
-		parent->mChildren.push_back(newEntry);
+		parent->addChild(newEntry);
 
-		onEntryAdded(newEntry->path);
+		notifyEntryAdded(newEntry);
 		return newEntry;
 	}
 
@@ -355,7 +632,7 @@ namespace bs
 					mResourceManifest->unregisterResource(uuid);
 				}
 
-				mUUIDToPath.erase(uuid);
+				mUUIDIndex->remove(uuid);
 			}
 		}
 
@@ -364,22 +641,23 @@ namespace bs
 			FileSystem::remove(metaPath);
 
 		DirectoryEntry* parent = resource->parent;
-		auto findIter = std::find_if(parent->mChildren.begin(), parent->mChildren.end(), 
-			[&] (const LibraryEntry* entry) { return entry == resource; });
+		parent->removeChild(resource);
 
-		parent->mChildren.erase(findIter);
-
-		Path originalPath = resource->path;
-		onEntryRemoved(originalPath);
+		notifyEntryRemoved(resource);
 
 		const auto iterQueuedImport = mQueuedImports.find(resource);
 		if(iterQueuedImport != mQueuedImports.end())
-			iterQueuedImport->second->canceled = true;
+			iterQueuedImport->second->cancel();
 
+		const UUID uuid = getPrimaryUUID(resource);
 		removeDependencies(resource);
 		bs_delete(resource);
 
-		reimportDependants(originalPath);
+		// Resource is gone, so it won't be reimported as a part of any pending batch. Dependants are re-evaluated below.
+		mPendingDependantReimports.erase(uuid);
+		mDependantReimports.erase(uuid);
+
+		reimportDependants({ uuid });
 	}
 
 	void ProjectLibrary::deleteDirectoryInternal(DirectoryEntry* directory)
@@ -398,19 +676,14 @@ namespace bs
 
 		DirectoryEntry* parent = directory->parent;
 		if(parent != nullptr)
-		{
-			auto findIter = std::find_if(parent->mChildren.begin(), parent->mChildren.end(), 
-				[&] (const LibraryEntry* entry) { return entry == directory; });
-
-			parent->mChildren.erase(findIter);
-		}
+			parent->removeChild(directory);
 
-		onEntryRemoved(directory->path);
+		notifyEntryRemoved(directory);
 		bs_delete(directory);
 	}
 
 	bool ProjectLibrary::reimportResourceInternal(FileEntry* fileEntry, const SPtr<ImportOptions>& importOptions,
-		bool forceReimport, bool pruneResourceMetas)
+		bool forceReimport, bool pruneResourceMetas, const ScannedFile* scanInfo, ImportPriority priority)
 	{
 		Path metaPath = fileEntry->path;
 		metaPath.setFilename(metaPath.getFilename() + ".meta");
@@ -429,23 +702,13 @@ namespace bs
 					const SPtr<ProjectFileMeta>& fileMeta = std::static_pointer_cast<ProjectFileMeta>(loadedMeta);
 					fileEntry->meta = fileMeta;
 
-					auto& resourceMetas = fileEntry->meta->getResourceMetaData();
-
-					if (!resourceMetas.empty())
-					{
-						mUUIDToPath[resourceMetas[0]->getUUID()] = fileEntry->path;
-
-						for (UINT32 i = 1; i < (UINT32)resourceMetas.size(); i++)
-						{
-							const SPtr<ProjectResourceMeta>& entry = resourceMetas[i];
-							mUUIDToPath[entry->getUUID()] = fileEntry->path + entry->getUniqueName();
-						}
-					}
+					registerResourcePaths(fileEntry);
+					mSearchIndex->addEntry(fileEntry);
 				}
 			}
 		}
 
-		if (!isUpToDate(fileEntry) || forceReimport)
+		if (!isUpToDate(fileEntry, scanInfo) || forceReimport)
 		{
 			// Note: If resource is native we just copy it to the internal folder. We could avoid the copy and 
 			// load the resource directly from the Resources folder but that requires complicating library code.
@@ -465,23 +728,34 @@ namespace bs
 			SPtr<QueuedImport> queuedImport = bs_shared_ptr_new<QueuedImport>();
 			queuedImport->filePath = fileEntry->path;
 			queuedImport->importOptions = curImportOptions;
+			queuedImport->importOptionsHash = hashImportOptions(curImportOptions);
 			queuedImport->pruneMetas = pruneResourceMetas;
 			queuedImport->native = isNativeResource;
 
-			// If import is already queued for this file make the tasks dependant so they don't execute at the same time, 
-			// and so they execute in the proper order
+			// If import is already queued for this file it is superseded by this one, so cancel it. If it is already
+			// running make the tasks dependant so they don't write the same outputs at the same time. If it hasn't
+			// started it will exit as soon as it runs, so there is no need to wait for it (and potentially for all
+			// the lower priority imports queued before it). We still need to wait for whatever it was waiting on.
 			SPtr<Task> dependency;
 
 			const auto iterFind = mQueuedImports.find(fileEntry);
 			if (iterFind != mQueuedImports.end())
 			{
-				dependency = iterFind->second->importTask;
+				const SPtr<QueuedImport>& previousImport = iterFind->second;
+				if (previousImport->cancel())
+					dependency = previousImport->importTask;
+				else
+					dependency = previousImport->dependency;
 
-				// Note: We should cancel the task here so it doesn't run unnecessarily. But if the task is already
-				// running it shouldn't be canceled as dependencies still need to wait on it (since cancelling a
-				// running task doesn't actually stop it). Yet there is currently no good wait to check if task
-				// is currently running. 
+				priority = std::max(priority, previousImport->priority);
+				mNumQueuedImports[(UINT32)previousImport->priority]--;
 			}
+
+			queuedImport->dependency = dependency;
+			queuedImport->priority = priority;
+
+			const TaskPriority taskPriority = priority == ImportPriority::Interactive ? TaskPriority::High : 
+				TaskPriority::Normal;
 				
 			// Needs to be pass a weak pointer to worker methods since internally it holds a reference to the task itself, 
 			// and we can't have the task closure holding a reference back, otherwise it leaks
@@ -499,63 +773,163 @@ namespace bs
 
 				// Perform import, register the resources and their UUID in the QueuedImport structure and save the
 				// resource on disk
-				const auto importAsync = [queuedImportWeak, &projectFolder = mProjectFolder, &mutex = mQueuedImportMutex]()
+				const auto importAsync = [queuedImportWeak, &projectFolder = mProjectFolder, &mutex = mQueuedImportMutex,
+					importCache = mImportCache]()
 				{
+					// Import might have been superseded before it got a chance to run
 					SPtr<QueuedImport> queuedImport = queuedImportWeak.lock();
+					if(queuedImport == nullptr || !queuedImport->start())
+						return;
+
+					queuedImport->sourceHash = ContentHash::hashFile(queuedImport->filePath);
+					queuedImport->sourceSize = FileSystem::getFileSize(queuedImport->filePath);
+
+					if(queuedImport->canceled)
+						return;
+
+					ImportCacheKey cacheKey;
+					cacheKey.sourceHash = queuedImport->sourceHash;
+					cacheKey.importOptionsHash = queuedImport->importOptionsHash;
+					cacheKey.extension = queuedImport->filePath.getExtension();
+					cacheKey.importerVersion = ImportCache::getImporterVersion(cacheKey.extension);
+
+					// Unreadable source files produce an empty hash, in which case the cache cannot be used
+					const bool useCache = importCache != nullptr && queuedImport->sourceHash != 0;
+
+					// Finds or assigns the UUID of the sub-resource with the provided name, and records its import data
+					const auto registerResource = [&queuedImport, &mutex](QueuedImportResource importResource)
+					{
+						Path::stripInvalid(importResource.name);
+
+						// Any access to queuedImport->resources must be locked
+						Lock lock(mutex);
+
+						auto iterFind = std::find_if(queuedImport->resources.begin(), queuedImport->resources.end(),
+							[&importResource](const QueuedImportResource& entry)
+						{
+							return entry.name == importResource.name;
+						});
+
+						if (iterFind != queuedImport->resources.end())
+							importResource.uuid = iterFind->uuid;
+						else
+						{
+							queuedImport->resources.push_back(importResource);
+							iterFind = queuedImport->resources.end() - 1;
+						}
+
+						if (importResource.uuid.empty())
+							importResource.uuid = UUIDGenerator::generateRandom();
+
+						*iterFind = std::move(importResource);
+						return iterFind->uuid;
+					};
+
+					Path outputPath = projectFolder;
+					outputPath.append(INTERNAL_RESOURCES_DIR);
+
+					// Check if identical data was imported before, in which case we can skip the import and just copy
+					// the previous outputs as they are
+					Vector<ImportCacheEntry> cachedEntries;
+					if(useCache && importCache->find(cacheKey, cachedEntries))
+					{
+						if (!FileSystem::isDirectory(outputPath))
+							FileSystem::createDir(outputPath);
+
+						for(auto& cachedEntry : cachedEntries)
+						{
+							if(queuedImport->canceled)
+								return;
+
+							QueuedImportResource importResource(cachedEntry.name, nullptr, UUID::EMPTY);
+							importResource.cachedMeta = cachedEntry.meta;
+							importResource.icons = cachedEntry.meta->getPreviewIcons();
+
+							const UUID uuid = registerResource(std::move(importResource));
+
+							outputPath.setFilename(uuid.toString() + ".asset");
+							FileSystem::copy(cachedEntry.path, outputPath, true);
+						}
+
+						return;
+					}
+
+					bool removeCachedData;
+					const SPtr<ImportOptions> importOptions = getImportOptionsWithCPUData(queuedImport->importOptions,
+						removeCachedData);
 
 					Vector<SubResourceRaw> importedResources = gImporter()._importAll(queuedImport->filePath, 
-						queuedImport->importOptions);
+						importOptions);
 
-					if (!importedResources.empty())
+					// Resources referencing other resources are not cached, as the references are UUIDs specific to
+					// this project. Neither are resources with import dependencies, as the cache key only accounts for
+					// the source file itself.
+					bool storeInCache = useCache;
+					Vector<ImportCacheEntry> entriesToCache;
+
+					for (auto& entry : importedResources)
 					{
-						Path outputPath = projectFolder;
-						outputPath.append(INTERNAL_RESOURCES_DIR);
+						if (!canSaveImported(*entry.value))
+						{
+							LOGERR("Cannot import \"" + queuedImport->filePath.toString() + "\" without a render API. "
+								"Import it in the editor first.");
 
+							queuedImport->failed = true;
+							return;
+						}
+					}
+
+					if (!importedResources.empty())
+					{
 						if (!FileSystem::isDirectory(outputPath))
 							FileSystem::createDir(outputPath);
 
 						for (auto& entry : importedResources)
 						{
-							String subresourceName = entry.name;
-							Path::stripInvalid(subresourceName);
+							// Outputs of a canceled import are never used, so don't waste time saving them
+							if(queuedImport->canceled)
+								return;
 
-							UUID uuid;
-							{
-								// Any access to queuedImport->resources must be locked
-								Lock lock(mutex);
+							const ProjectResourceIcons icons = generatePreviewIcons(*entry.value);
 
-								auto iterFind = std::find_if(queuedImport->resources.begin(), queuedImport->resources.end(),
-									[&subresourceName](const QueuedImportResource& importResource)
-								{
-									return importResource.name == subresourceName;
-								});
+							if(removeCachedData && entry.value->getTypeId() == TID_Texture)
+								entry.value = removeCPUCachedData(std::static_pointer_cast<Texture>(entry.value));
 
-								if (iterFind != queuedImport->resources.end())
-									iterFind->resource = entry.value;
-								else
-								{
-									queuedImport->resources.push_back(QueuedImportResource(entry.name, entry.value,
-										UUID::EMPTY));
+							QueuedImportResource importResource(entry.name, entry.value, UUID::EMPTY);
+							importResource.icons = icons;
+							importResource.dependencies = getReferencedUUIDs(*entry.value);
 
-									iterFind = queuedImport->resources.end() - 1;
-								}
+							const bool isCacheable = importResource.dependencies.empty() && 
+								!hasImportDependencies(*entry.value);
 
-								if (iterFind->uuid.empty())
-									iterFind->uuid = UUIDGenerator::generateRandom();
+							const UUID uuid = registerResource(std::move(importResource));
 
-								uuid = iterFind->uuid;
-							}
+							outputPath.setFilename(uuid.toString() + ".asset");
+							gResources()._save(entry.value, outputPath, true);
 
-							const String uuidStr = uuid.toString();
+							if(storeInCache)
+							{
+								if(isCacheable)
+								{
+									ImportCacheEntry cacheEntry;
+									cacheEntry.name = entry.name;
+									cacheEntry.path = outputPath;
+									cacheEntry.meta = ProjectResourceMeta::create(entry.name, UUID::EMPTY,
+										entry.value->getTypeId(), icons, entry.value->getMetaData());
 
-							outputPath.setFilename(uuidStr + ".asset");
-							gResources()._save(entry.value, outputPath, true);
+									entriesToCache.push_back(cacheEntry);
+								}
+								else
+									storeInCache = false;
+							}
 						}
+
+						if(storeInCache)
+							importCache->store(cacheKey, entriesToCache);
 					}
 				};
 
-				queuedImport->importTask = Task::create("ProjectLibraryImport", importAsync, TaskPriority::Normal,
-					dependency);
+				queuedImport->importTask = Task::create("ProjectLibraryImport", importAsync, taskPriority, dependency);
 			}
 			else
 			{
@@ -569,11 +943,30 @@ namespace bs
 
 				const auto importAsync = [queuedImportWeak, &projectFolder = mProjectFolder, &mutex = mQueuedImportMutex]()
 				{
+					// Import might have been superseded before it got a chance to run
+					SPtr<QueuedImport> queuedImport = queuedImportWeak.lock();
+					if(queuedImport == nullptr || !queuedImport->start())
+						return;
+
+					queuedImport->sourceHash = ContentHash::hashFile(queuedImport->filePath);
+					queuedImport->sourceSize = FileSystem::getFileSize(queuedImport->filePath);
+
+					if(queuedImport->canceled)
+						return;
+
 					// Don't load dependencies because we don't need them, but also because they might not be in the
 					// manifest which would screw up their UUIDs.
-					SPtr<QueuedImport> queuedImport = queuedImportWeak.lock();
 					HResource resource = gResources().load(queuedImport->filePath, ResourceLoadFlag::KeepSourceData);
 
+					if (resource && !canSaveImported(*resource.getInternalPtr()))
+					{
+						LOGERR("Cannot import \"" + queuedImport->filePath.toString() + "\" without a render API. "
+							"Import it in the editor first.");
+
+						queuedImport->failed = true;
+						return;
+					}
+
 					if (resource)
 					{
 						Path outputPath = projectFolder;
@@ -582,12 +975,15 @@ namespace bs
 						if (!FileSystem::isDirectory(outputPath))
 							FileSystem::createDir(outputPath);
 
+						QueuedImportResource importResource("primary", resource.getInternalPtr(), resource.getUUID());
+						importResource.icons = generatePreviewIcons(*resource.getInternalPtr());
+						importResource.dependencies = getReferencedUUIDs(*resource.getInternalPtr());
+
 						{
 							// Any access to queuedImport->resources must be locked
 							Lock lock(mutex);
 
-							queuedImport->resources.push_back(QueuedImportResource("primary", resource.getInternalPtr(),
-								resource.getUUID()));
+							queuedImport->resources.push_back(importResource);
 						}
 
 						const String uuidStr = resource.getUUID().toString();
@@ -597,13 +993,14 @@ namespace bs
 					}
 				};
 
-				queuedImport->importTask = Task::create("ProjectLibraryImport", importAsync, TaskPriority::Normal,
-					dependency);
+				queuedImport->importTask = Task::create("ProjectLibraryImport", importAsync, taskPriority, dependency);
 			}
 
 			TaskScheduler::instance().addTask(queuedImport->importTask);
 
 			mQueuedImports[fileEntry] = queuedImport;
+			mNumQueuedImports[(UINT32)priority]++;
+
 			fileEntry->lastUpdateTime = std::time(nullptr);
 
 			return true;
@@ -614,6 +1011,11 @@ namespace bs
 
 	void ProjectLibrary::_finishQueuedImports(bool wait)
 	{
+		// Dependants are only reimported after all finished imports are processed, so that dependants shared by multiple
+		// imports are reimported just once
+		Vector<UUID> changedResources;
+		Vector<UUID> reimportedDependants;
+
 		for(auto iter = mQueuedImports.begin(); iter != mQueuedImports.end();)
 		{
 			SPtr<QueuedImport> queuedImport = iter->second;
@@ -632,6 +1034,8 @@ namespace bs
 			FileEntry* fileEntry = iter->first;
 			iter = mQueuedImports.erase(iter);
 
+			mNumQueuedImports[(UINT32)queuedImport->priority]--;
+
 			// We wait on canceled task to finish and then just discard the results because any dependant tasks need to be
 			// aware this tasks exists, so we can't just remove it straight away.
 			if(queuedImport->canceled)
@@ -640,6 +1044,13 @@ namespace bs
 				continue;
 			}
 
+			// Failed imports don't update the meta-data, so the file remains out of date and is imported again later
+			if(queuedImport->failed)
+			{
+				mNumFailedImports++;
+				continue;
+			}
+
 			Path metaPath = fileEntry->path;
 			metaPath.setFilename(metaPath.getFilename() + ".meta");
 
@@ -648,8 +1059,10 @@ namespace bs
 				fileEntry->meta = ProjectFileMeta::create(queuedImport->importOptions);
 			else // Existing meta-file, which needs to be updated
 			{
-				// Remove existing dependencies (they will be re-added later)
+				// Remove existing dependencies and UUID mappings (they will be re-added later), so sub-resources that no
+				// longer exist don't remain in the UUID index
 				removeDependencies(fileEntry);
+				unregisterResourcePaths(fileEntry);
 
 				existingMetas = fileEntry->meta->getAllResourceMetaData();
 
@@ -666,12 +1079,13 @@ namespace bs
 			{
 				// Entries with no resources are sub-resources that used to exist in this file, but haven't been imported
 				// this time
-				if(!entry.resource)
+				if(!entry.resource && !entry.cachedMeta)
 					continue;
 
 				Path::stripInvalid(entry.name);
+				internalResourcesPath.setFilename(entry.uuid.toString() + ".asset");
 
-				const ProjectResourceIcons icons = generatePreviewIcons(*entry.resource);
+				const ProjectResourceIcons& icons = entry.icons;
 
 				bool foundMeta = false;
 				for (auto iterMeta = existingMetas.begin(); iterMeta != existingMetas.end(); ++iterMeta)
@@ -685,10 +1099,11 @@ namespace bs
 						assert(entry.uuid == metaEntry->getUUID());
 
 						HResource importedResource = gResources()._getResourceHandle(metaEntry->getUUID());
-
-						gResources().update(importedResource, entry.resource);
+						updateImportedResource(importedResource, entry.resource, internalResourcesPath);
 
 						metaEntry->setPreviewIcons(icons);
+						metaEntry->mDependencies = entry.dependencies;
+						metaEntry->mHasDependencies = true;
 						fileEntry->meta->add(metaEntry);
 
 						iterMeta = existingMetas.erase(iterMeta);
@@ -708,15 +1123,30 @@ namespace bs
 						importedResource = gResources()._getResourceHandle(entry.uuid);
 						gResources().update(importedResource, entry.resource);
 					}
-					else
+					else if(entry.resource)
 						importedResource = gResources()._createResourceHandle(entry.resource, entry.uuid);
+					else // Copied from the import cache, resource will be loaded from the copy when requested
+						importedResource = gResources()._getResourceHandle(entry.uuid);
+
+					SPtr<ResourceMetaData> subMeta;
+					UINT32 typeId;
+					if(entry.resource)
+					{
+						subMeta = entry.resource->getMetaData();
+						typeId = entry.resource->getTypeId();
+					}
+					else
+					{
+						subMeta = entry.cachedMeta->getResourceMetaData();
+						typeId = entry.cachedMeta->getTypeID();
+					}
 
-					SPtr<ResourceMetaData> subMeta = entry.resource->getMetaData();
-					const UINT32 typeId = entry.resource->getTypeId();
 					const UUID& UUID = importedResource.getUUID();
 
 					SPtr<ProjectResourceMeta> resMeta = ProjectResourceMeta::create(entry.name, UUID, typeId,
 						icons, subMeta);
+					resMeta->mDependencies = entry.dependencies;
+					resMeta->mHasDependencies = true;
 					fileEntry->meta->add(resMeta);
 				}
 
@@ -729,36 +1159,53 @@ namespace bs
 				}
 
 				// Update UUID to path mapping
-				if(isFirst)
-					mUUIDToPath[entry.uuid] = fileEntry->path;
-				else
-					mUUIDToPath[entry.uuid] = fileEntry->path + entry.name;
+				const String relativePath = fileEntry->path.getRelative(mResourcesFolder).toString();
+				mUUIDIndex->set(entry.uuid, relativePath, isFirst ? StringUtil::BLANK : entry.name);
 
 				isFirst = false;
 
 				// Register path in manifest
-				const String uuidStr = entry.uuid.toString();
-
-				internalResourcesPath.setFilename(uuidStr + ".asset");
 				mResourceManifest->registerResource(entry.uuid, internalResourcesPath);
 			}
 
+			// Remember the source contents so identical files don't need to be reimported, regardless of their timestamp
+			fileEntry->meta->mSourceFingerprint = ContentHash::combine(queuedImport->sourceHash,
+				queuedImport->importOptionsHash);
+			fileEntry->meta->mSourceSize = queuedImport->sourceSize;
+
 			// Save the meta file
 			FileEncoder fs(metaPath);
 			fs.encode(fileEntry->meta.get());
 
-			// Register any dependencies this resource depends on
+			markEntryDirty(fileEntry->path);
+
+			// Resource types might have changed
+			mSearchIndex->addEntry(fileEntry);
+
+			// Register any dependencies this resource depends on, and any resources that were waiting for this one
 			addDependencies(fileEntry);
+			resolveDependencies(fileEntry);
 
 			// Notify the outside world import is doen
 			onEntryImported(fileEntry->path);
 
-			// Queue any resources dependant on this one for import
-			reimportDependants(fileEntry->path);
+			// If the import was a part of an earlier invalidation batch, the resources depending on it have already been
+			// found and are just waiting for it to finish
+			const UUID uuid = getPrimaryUUID(fileEntry);
+			if(mDependantReimports.find(uuid) != mDependantReimports.end())
+				reimportedDependants.push_back(uuid);
+			else
+				changedResources.push_back(uuid);
 		}
+
+		for(auto& entry : reimportedDependants)
+			finishDependantReimport(entry);
+
+		// Queue any resources dependant on the imported ones for import
+		reimportDependants(changedResources);
 	}
 
-	bool ProjectLibrary::isUpToDate(FileEntry* resource) const
+	bool ProjectLibrary::isUpToDate(FileEntry* resource, const ScannedFile* scanInfo)
 	{
 		if(resource->meta == nullptr)
 		{
@@ -781,145 +1228,111 @@ namespace bs
 			}
 		}
 
-		const std::time_t lastModifiedTime = FileSystem::getLastModifiedTime(resource->path);
-		return lastModifiedTime <= resource->lastUpdateTime;
-	}
+		std::time_t lastModifiedTime;
+		UINT64 size;
+		if(scanInfo != nullptr)
+		{
+			lastModifiedTime = scanInfo->lastModifiedTime;
+			size = scanInfo->size;
+		}
+		else
+		{
+			lastModifiedTime = FileSystem::getLastModifiedTime(resource->path);
+			size = FileSystem::getFileSize(resource->path);
+		}
 
-	Vector<ProjectLibrary::LibraryEntry*> ProjectLibrary::search(const String& pattern)
-	{
-		return search(pattern, {});
-	}
+		if(isTimestampUpToDate(resource, lastModifiedTime, size))
+			return true;
 
-	Vector<ProjectLibrary::LibraryEntry*> ProjectLibrary::search(const String& pattern, const Vector<UINT32>& typeIds)
-	{
-		Vector<LibraryEntry*> foundEntries;
+		// Timestamp changed, but contents might not have. Compare content fingerprints, if available.
+		if(resource->meta == nullptr || resource->meta->getSourceFingerprint() == 0)
+			return false;
 
-		std::regex escape("[.^$|()\\[\\]{}*+?\\\\]");
-		String replace("\\\\&");
-		String escapedPattern = std::regex_replace(pattern, escape, replace, std::regex_constants::match_default | std::regex_constants::format_sed);
+		UINT64 sourceHash;
+		if(scanInfo != nullptr && scanInfo->hasContentHash)
+			sourceHash = scanInfo->contentHash;
+		else
+			sourceHash = ContentHash::hashFile(resource->path);
 
-		// For some reason MSVC stdlib implementation requires a different pattern than stdlib one
-#if BS_PLATFORM == BS_PLATFORM_WIN32
-		std::regex wildcard("\\\\\\*");
-#else
-		std::regex wildcard("\\\\\\\\\\*");
-#endif
-		String wildcardReplace(".*");
-		String searchPattern = std::regex_replace(escapedPattern, wildcard, ".*");
+		const UINT64 fingerprint = getSourceFingerprint(sourceHash, resource->meta->getImportOptions());
+		if(fingerprint != resource->meta->getSourceFingerprint())
+			return false;
 
-		std::regex searchRegex(searchPattern, std::regex_constants::ECMAScript | std::regex_constants::icase);
+		// Contents are identical, remember the new timestamp so following checks can skip hashing
+		resource->lastUpdateTime = std::max(resource->lastUpdateTime, lastModifiedTime);
+		markEntryDirty(resource->path);
 
-		Stack<DirectoryEntry*> todo;
-		todo.push(mRootEntry);
-		while (!todo.empty())
-		{
-			DirectoryEntry* dirEntry = todo.top();
-			todo.pop();
+		return true;
+	}
 
-			for (auto& child : dirEntry->mChildren)
-			{
-				if (std::regex_match(child->elementName, searchRegex))
-				{
-					if (typeIds.size() == 0)
-						foundEntries.push_back(child);
-					else
-					{
-						if (child->type == LibraryEntryType::File)
-						{
-							FileEntry* childFileEntry = static_cast<FileEntry*>(child);
-							if (childFileEntry->meta != nullptr)
-							{
-								auto& resourceMetas = childFileEntry->meta->getResourceMetaData();
-								for (auto& typeId : typeIds)
-								{
-									bool found = false;
-									for (auto& resMeta : resourceMetas)
-									{
-										if (resMeta->getTypeID() == typeId)
-										{
-											foundEntries.push_back(child);
-											found = true;
-											break;
-										}
-									}
-
-									if (found)
-										break;
-								}
-							}
-						}
-					}
-				}
+	bool ProjectLibrary::isTimestampUpToDate(const FileEntry* resource, std::time_t lastModifiedTime, UINT64 size) const
+	{
+		if(lastModifiedTime > resource->lastUpdateTime)
+			return false;
 
-				if (child->type == LibraryEntryType::Directory)
-				{
-					DirectoryEntry* childDirEntry = static_cast<DirectoryEntry*>(child);
-					todo.push(childDirEntry);
-				}
-			}
-		}
+		if(resource->meta != nullptr && resource->meta->getSourceSize() != 0)
+			return resource->meta->getSourceSize() == size;
 
-		std::sort(foundEntries.begin(), foundEntries.end(), 
-			[&](const LibraryEntry* a, const LibraryEntry* b) 
-		{ 
-			return a->elementName.compare(b->elementName) < 0;
-		});
+		return true;
+	}
 
-		return foundEntries;
+	Vector<ProjectLibrary::LibraryEntry*> ProjectLibrary::search(const String& pattern)
+	{
+		return search(pattern, {});
+	}
+
+	Vector<ProjectLibrary::LibraryEntry*> ProjectLibrary::search(const String& pattern, const Vector<UINT32>& typeIds)
+	{
+		return mSearchIndex->search(pattern, typeIds);
 	}
 
 	ProjectLibrary::LibraryEntry* ProjectLibrary::findEntry(const Path& path) const
 	{
-		Path fullPath = path;
-		if (fullPath.isAbsolute())
+		// Only make a copy of the path if it needs to be made absolute
+		Path absolutePath;
+		const Path* fullPath = &path;
+		if (path.isAbsolute())
 		{
-			if (!mResourcesFolder.includes(fullPath))
+			if (!mResourcesFolder.includes(path))
 				return nullptr;
 		}
 		else
-			fullPath.makeAbsolute(mResourcesFolder);
+		{
+			absolutePath = path;
+			absolutePath.makeAbsolute(mResourcesFolder);
 
-		Path relPath = fullPath.getRelative(mRootEntry->path);
-		UINT32 numElems = relPath.getNumDirectories() + (relPath.isFile() ? 1 : 0);
-		UINT32 idx = 0;
+			fullPath = &absolutePath;
+		}
 
-		LibraryEntry* current = mRootEntry;
-		while (current != nullptr)
-		{
-			if (idx == numElems)
-				return current;
+		// Walk the path elements below the root directly, rather than building a relative path
+		const UINT32 rootDepth = mRootEntry->path.getNumDirectories();
+		const UINT32 numDirectories = fullPath->getNumDirectories();
+		if (numDirectories < rootDepth)
+			return fullPath->isFile() && numDirectories + 1 == rootDepth ? mRootEntry : nullptr;
 
-			String curElem;
-			if (relPath.isFile() && idx == (numElems - 1))
-				curElem = relPath.getFilename();
-			else
-				curElem = relPath[idx];
+		const UINT32 numElems = numDirectories - rootDepth + (fullPath->isFile() ? 1 : 0);
 
-			if (current->type == LibraryEntryType::Directory)
-			{
-				DirectoryEntry* dirEntry = static_cast<DirectoryEntry*>(current);
-				current = nullptr;
-				for (auto& child : dirEntry->mChildren)
-				{
-					if (Path::comparePathElem(curElem, child->elementName))
-					{
-						idx++;
-						current = child;
-						break;
-					}
-				}
-			}
-			else // Found file
+		LibraryEntry* current = mRootEntry;
+		for (UINT32 idx = 0; idx < numElems; idx++)
+		{
+			if (current->type == LibraryEntryType::File)
 			{
 				// If this is next to last element, next entry is assumed to be a sub-resource name, which we ignore
 				if (idx == (numElems - 1))
 					return current;
-				else
-					break; // Not a valid path
+
+				return nullptr; // Not a valid path
 			}
+
+			const bool isFilename = fullPath->isFile() && idx == (numElems - 1);
+			const String& curElem = isFilename ? fullPath->getTail() : (*fullPath)[rootDepth + idx];
+
+			current = static_cast<DirectoryEntry*>(current)->findChild(curElem);
+			if (current == nullptr)
+				return nullptr;
 		}
 
-		return nullptr;
+		return current;
 	}
 
 	bool ProjectLibrary::isSubresource(const Path& path) const
@@ -973,19 +1386,14 @@ namespace bs
 			else // Entry not a subresource
 			{
 				DirectoryEntry* dirEntry = static_cast<DirectoryEntry*>(entry);
-				for (auto& child : dirEntry->mChildren)
+				LibraryEntry* child = dirEntry->findChild(path.getTail());
+				if (child != nullptr && child->type == LibraryEntryType::File)
 				{
-					if (Path::comparePathElem(path.getTail(), child->elementName))
-					{
-						if (child->type == LibraryEntryType::File)
-						{
-							FileEntry* fileEntry = static_cast<FileEntry*>(child);
-							if (fileEntry->meta == nullptr)
-								return nullptr;
+					FileEntry* fileEntry = static_cast<FileEntry*>(child);
+					if (fileEntry->meta == nullptr)
+						return nullptr;
 
-							return fileEntry->meta->getResourceMetaData()[0];
-						}
-					}
+					return fileEntry->meta->getResourceMetaData()[0];
 				}
 
 				return nullptr;
@@ -1006,14 +1414,120 @@ namespace bs
 		}
 	}
 
+	Vector<UUID> ProjectLibrary::getResourceDependencies(const UUID& uuid, bool recursive)
+	{
+		if (!recursive)
+			return getDirectResourceDependencies(uuid);
+
+		// Depth first, outputting each resource once all of its dependencies have been output
+		struct PendingResource
+		{
+			UUID uuid;
+			Vector<UUID> dependencies;
+			UINT32 nextDependency;
+		};
+
+		Vector<UUID> output;
+		UnorderedSet<UUID> visited = { uuid };
+
+		Vector<PendingResource> todo;
+		todo.push_back({ uuid, getDirectResourceDependencies(uuid), 0 });
+
+		while (!todo.empty())
+		{
+			PendingResource& current = todo.back();
+			if (current.nextDependency < (UINT32)current.dependencies.size())
+			{
+				const UUID dependency = current.dependencies[current.nextDependency++];
+				if (visited.insert(dependency).second)
+					todo.push_back({ dependency, getDirectResourceDependencies(dependency), 0 });
+			}
+			else
+			{
+				if (current.uuid != uuid)
+					output.push_back(current.uuid);
+
+				todo.pop_back();
+			}
+		}
+
+		return output;
+	}
+
+	Vector<UUID> ProjectLibrary::getDirectResourceDependencies(const UUID& uuid)
+	{
+		SPtr<ProjectResourceMeta> resMeta = findResourceMeta(uuid);
+		if (resMeta != nullptr && resMeta->hasDependencies())
+			return resMeta->getDependencies();
+
+		// Built-in resource, or a resource imported before dependencies were recorded in its meta-data
+		Path assetPath;
+		if (!gResources().getFilePathFromUUID(uuid, assetPath))
+			return Vector<UUID>();
+
+		Vector<UUID> dependencies = gResources().getDependencies(assetPath);
+
+		// Remember them for the rest of the session. They are persisted next time the resource is imported.
+		if (resMeta != nullptr)
+		{
+			resMeta->mDependencies = dependencies;
+			resMeta->mHasDependencies = true;
+		}
+
+		return dependencies;
+	}
+
+	Vector<UUID> ProjectLibrary::getReferencedUUIDs(IReflectable& resource)
+	{
+		Vector<ResourceDependency> dependencies = Utility::findResourceDependencies(resource);
+
+		Vector<UUID> output;
+		output.reserve(dependencies.size());
+
+		for (auto& dependency : dependencies)
+			output.push_back(dependency.resource.getUUID());
+
+		return output;
+	}
+
 	Path ProjectLibrary::uuidToPath(const UUID& uuid) const
 	{
-		auto iterFind = mUUIDToPath.find(uuid);
+		String filePath;
+		String subresourceName;
+		if (!mUUIDIndex->find(uuid, filePath, subresourceName))
+			return Path::BLANK;
 
-		if (iterFind != mUUIDToPath.end())
-			return iterFind->second;
+		Path output = filePath;
+		output.makeAbsolute(mResourcesFolder);
+
+		if (!subresourceName.empty())
+			output = output + subresourceName;
 
-		return Path::BLANK;
+		return output;
+	}
+
+	SPtr<ProjectResourceMeta> ProjectLibrary::findResourceMeta(const UUID& uuid) const
+	{
+		String filePath;
+		String subresourceName;
+		if (!mUUIDIndex->find(uuid, filePath, subresourceName))
+			return nullptr;
+
+		LibraryEntry* entry = findEntry(filePath);
+		if (entry == nullptr || entry->type != LibraryEntryType::File)
+			return nullptr;
+
+		FileEntry* fileEntry = static_cast<FileEntry*>(entry);
+		if (fileEntry->meta == nullptr)
+			return nullptr;
+
+		for (auto& resMeta : fileEntry->meta->getResourceMetaData())
+		{
+			if (resMeta->getUUID() == uuid)
+				return resMeta;
+		}
+
+		return nullptr;
 	}
 
 	void ProjectLibrary::createEntry(const HResource& resource, const Path& path)
@@ -1125,41 +1639,18 @@ namespace bs
 			}
 			else // Just moving internally
 			{
-				onEntryRemoved(oldEntry->path);
+				notifyEntryRemoved(oldEntry);
 
+				// Note: Dependencies are keyed by UUID, which doesn't change when moving, so they remain valid
 				FileEntry* fileEntry = nullptr;
 				if (oldEntry->type == LibraryEntryType::File)
-				{
 					fileEntry = static_cast<FileEntry*>(oldEntry);
-					removeDependencies(fileEntry);
-
-					// Update uuid <-> path mapping
-					if(fileEntry->meta != nullptr)
-					{
-						auto& resourceMetas = fileEntry->meta->getResourceMetaData();
-
-						if (resourceMetas.size() > 0)
-						{
-							mUUIDToPath[resourceMetas[0]->getUUID()] = newFullPath;
-
-							for (UINT32 i = 1; i < (UINT32)resourceMetas.size(); i++)
-							{
-								SPtr<ProjectResourceMeta> resMeta = resourceMetas[i];
-
-								const UUID& UUID = resMeta->getUUID();
-								mUUIDToPath[UUID] = newFullPath + resMeta->getUniqueName();
-							}
-						}
-					}
-				}
 
 				if(FileSystem::isFile(oldMetaPath))
 					FileSystem::move(oldMetaPath, newMetaPath);
 
 				DirectoryEntry* parent = oldEntry->parent;
-				auto findIter = std::find(parent->mChildren.begin(), parent->mChildren.end(), oldEntry);
-				if(findIter != parent->mChildren.end())
-					parent->mChildren.erase(findIter);
+				parent->removeChild(oldEntry);
 
 				Path parentPath = newFullPath.getParent();
 
@@ -1175,10 +1666,10 @@ namespace bs
 				if(newEntryParent == nullptr) // New path parent doesn't exist, so we need to create the hierarchy
 					createInternalParentHierarchy(newFullPath, &newHierarchyParent, &newEntryParent);
 
-				newEntryParent->mChildren.push_back(oldEntry);
 				oldEntry->parent = newEntryParent;
 				oldEntry->path = newFullPath;
 				oldEntry->elementName = newFullPath.getTail();
+				newEntryParent->addChild(oldEntry);
 
 				if(oldEntry->type == LibraryEntryType::Directory) // Update child paths
 				{
@@ -1198,16 +1689,28 @@ namespace bs
 
 							if(child->type == LibraryEntryType::Directory)
 								todo.push(child);
+							else // Update uuid <-> path mapping
+							{
+								registerResourcePaths(static_cast<FileEntry*>(child));
+								updatePreviewIconsSource(static_cast<FileEntry*>(child));
+							}
 						}
 					}
 				}
+				else // Update uuid <-> path mapping
+				{
+					registerResourcePaths(fileEntry);
+					updatePreviewIconsSource(fileEntry);
+				}
 
-				onEntryAdded(oldEntry->path);
+				notifyEntryAdded(oldEntry);
 
 				if (fileEntry != nullptr)
 				{
-					reimportDependants(oldFullPath);
-					reimportDependants(newFullPath);
+					// Resources referencing the old path need to be reimported, and resources referencing the new path
+					// can now be resolved
+					resolveDependencies(fileEntry);
+					reimportDependants({ getPrimaryUUID(fileEntry) });
 				}
 			}
 		}
@@ -1338,7 +1841,8 @@ namespace bs
 			if (entry->type == LibraryEntryType::File)
 			{
 				FileEntry* resEntry = static_cast<FileEntry*>(entry);
-				reimportResourceInternal(resEntry, importOptions, forceReimport);
+				reimportResourceInternal(resEntry, importOptions, forceReimport, false, nullptr, 
+					ImportPriority::Interactive);
 			}
 		}
 	}
@@ -1361,6 +1865,8 @@ namespace bs
 
 		FileEncoder fs(metaPath);
 		fs.encode(resEntry->meta.get());
+
+		markEntryDirty(resEntry->path);
 	}
 
 	void ProjectLibrary::setUserData(const Path& path, const SPtr<IReflectable>& userData)
@@ -1383,6 +1889,8 @@ namespace bs
 
 		FileEncoder fs(metaPath);
 		fs.encode(fileEntry->meta.get());
+
+		markEntryDirty(fileEntry->path);
 	}
 
 	Vector<ProjectLibrary::FileEntry*> ProjectLibrary::getResourcesForBuild() const
@@ -1419,7 +1927,34 @@ namespace bs
 	{
 		SPtr<ProjectResourceMeta> meta = findResourceMeta(path);
 		if (meta == nullptr)
-			return HResource();
+		{
+			// Resource might not have been imported yet, in which case import it ahead of any background imports
+			LibraryEntry* entry = findEntry(path);
+			if (entry == nullptr || entry->type != LibraryEntryType::File)
+				return HResource();
+
+			FileEntry* fileEntry = static_cast<FileEntry*>(entry);
+			if (fileEntry->meta != nullptr)
+				return HResource();
+
+			auto iterFind = mQueuedImports.find(fileEntry);
+			if (iterFind == mQueuedImports.end() || 
+				(iterFind->second->priority == ImportPriority::Background && !iterFind->second->started))
+			{
+				reimportResourceInternal(fileEntry, nullptr, true, false, nullptr, ImportPriority::Interactive);
+				iterFind = mQueuedImports.find(fileEntry);
+			}
+
+			if (iterFind == mQueuedImports.end())
+				return HResource();
+
+			iterFind->second->importTask->wait();
+			_finishQueuedImports();
+
+			meta = findResourceMeta(path);
+			if (meta == nullptr)
+				return HResource();
+		}
 
 		ResourceLoadFlags loadFlags = ResourceLoadFlag::Default | ResourceLoadFlag::KeepSourceData;
 
@@ -1504,9 +2039,21 @@ namespace bs
 		clearEntries();
 		mRootEntry = bs_new<DirectoryEntry>(mResourcesFolder, mResourcesFolder.getTail(), nullptr);
 
-		mDependencies.clear();
+		mDependencyGraph->clear();
+		mUnresolvedDependencies.clear();
+		mPendingDependantReimports.clear();
+		mDependantReimports.clear();
+
 		gResources().unregisterResourceManifest(mResourceManifest);
 		mResourceManifest = nullptr;
+
+		mJournal = nullptr;
+		mUUIDIndex->clear();
+		mSearchIndex->clear();
+		mDirtyEntries.clear();
+		mDirtyEntryLookup.clear();
+		mNumFailedImports = 0;
+
 		mIsLoaded = false;
 	}
 
@@ -1554,55 +2101,104 @@ namespace bs
 		if (!mIsLoaded)
 			return;
 
-		// Make all paths relative before saving
-		makeEntriesRelative();		
-		SPtr<ProjectLibraryEntries> libEntries = ProjectLibraryEntries::create(*mRootEntry);
+		if(mJournal->needsCompaction())
+		{
+			// Rewrite the journal from scratch, with a single record per entry
+			Vector<ProjectLibraryJournalEntry> journalEntries;
+			getJournalEntries(mRootEntry, journalEntries);
+
+			mJournal->compact(journalEntries);
+
+			// Entries from the old single-file format have been transferred to the journal and are no longer needed
+			Path libraryEntriesPath = mProjectFolder;
+			libraryEntriesPath.append(PROJECT_INTERNAL_DIR);
+			libraryEntriesPath.append(LIBRARY_ENTRIES_FILENAME);
 
-		Path libraryEntriesPath = mProjectFolder;
-		libraryEntriesPath.append(PROJECT_INTERNAL_DIR);
-		libraryEntriesPath.append(LIBRARY_ENTRIES_FILENAME);
+			if(FileSystem::exists(libraryEntriesPath))
+				FileSystem::remove(libraryEntriesPath);
+		}
+		else
+		{
+			// Only record the entries that changed since the last save
+			Vector<ProjectLibraryJournalEntry> journalEntries;
+			for(auto& path : mDirtyEntries)
+			{
+				LibraryEntry* entry = findEntry(path);
+				if(entry != nullptr)
+				{
+					journalEntries.clear();
+					getJournalEntries(entry, journalEntries);
+
+					for(auto& journalEntry : journalEntries)
+						mJournal->writeUpdate(journalEntry);
+				}
+				else
+					mJournal->writeRemove(path.getRelative(mResourcesFolder).toString());
+			}
 
-		FileEncoder fs(libraryEntriesPath);
-		fs.encode(libEntries.get());
+			mJournal->flush();
+		}
 
-		// Restore absolute entry paths
-		makeEntriesAbsolute();
+		mDirtyEntries.clear();
+		mDirtyEntryLookup.clear();
 
 		Path resourceManifestPath = mProjectFolder;
 		resourceManifestPath.append(PROJECT_INTERNAL_DIR);
 		resourceManifestPath.append(RESOURCE_MANIFEST_FILENAME);
 
 		ResourceManifest::save(mResourceManifest, resourceManifestPath, mProjectFolder);
+
+		if(mUUIDIndex->isDirty())
+		{
+			Path resourceIndexPath = mProjectFolder;
+			resourceIndexPath.append(PROJECT_INTERNAL_DIR);
+			resourceIndexPath.append(RESOURCE_INDEX_FILENAME);
+
+			mUUIDIndex->save(resourceIndexPath);
+		}
 	}
 
-	void ProjectLibrary::loadLibrary()
+	void ProjectLibrary::loadLibrary(const Path& projectFolder)
 	{
 		unloadLibrary();
 
-		mProjectFolder = gEditorApplication().getProjectPath();
+		mProjectFolder = projectFolder;
 		mResourcesFolder = mProjectFolder;
 		mResourcesFolder.append(RESOURCES_DIR);
 
 		mRootEntry = bs_new<DirectoryEntry>(mResourcesFolder, mResourcesFolder.getTail(), nullptr);
 
-		Path libraryEntriesPath = mProjectFolder;
-		libraryEntriesPath.append(PROJECT_INTERNAL_DIR);
-		libraryEntriesPath.append(LIBRARY_ENTRIES_FILENAME);
+		Path libraryJournalPath = mProjectFolder;
+		libraryJournalPath.append(PROJECT_INTERNAL_DIR);
+		libraryJournalPath.append(LIBRARY_JOURNAL_FILENAME);
 
-		if(FileSystem::exists(libraryEntriesPath))
+		mJournal = bs_shared_ptr_new<ProjectLibraryJournal>(libraryJournalPath);
+
+		Vector<ProjectLibraryJournalEntry> journalEntries;
+		if(mJournal->read(journalEntries))
+			restoreJournalEntries(journalEntries);
+		else
 		{
-			FileDecoder fs(libraryEntriesPath);
-			SPtr<ProjectLibraryEntries> libEntries = std::static_pointer_cast<ProjectLibraryEntries>(fs.decode());
+			// No journal, fall back to entries stored in the old single-file format (if any)
+			Path libraryEntriesPath = mProjectFolder;
+			libraryEntriesPath.append(PROJECT_INTERNAL_DIR);
+			libraryEntriesPath.append(LIBRARY_ENTRIES_FILENAME);
 
-			*mRootEntry = libEntries->getRootEntry();
-			for(auto& child : mRootEntry->mChildren)
-				child->parent = mRootEntry;
+			if(FileSystem::exists(libraryEntriesPath))
+			{
+				FileDecoder fs(libraryEntriesPath);
+				SPtr<ProjectLibraryEntries> libEntries = std::static_pointer_cast<ProjectLibraryEntries>(fs.decode());
 
-			mRootEntry->parent = nullptr;
-		}
+				*mRootEntry = libEntries->getRootEntry();
+				for(auto& child : mRootEntry->mChildren)
+					child->parent = mRootEntry;
 
-		// Entries are stored relative to project folder, but we want their absolute paths now
-		makeEntriesAbsolute();
+				mRootEntry->parent = nullptr;
+			}
+
+			// Entries are stored relative to project folder, but we want their absolute paths now
+			makeEntriesAbsolute();
+		}
 
 		// Load resource manifest
 		Path resourceManifestPath = mProjectFolder;
@@ -1616,11 +2212,19 @@ namespace bs
 
 		gResources().registerResourceManifest(mResourceManifest);
 
+		// Load the UUID index. If not available it will be rebuilt from meta files.
+		Path resourceIndexPath = mProjectFolder;
+		resourceIndexPath.append(PROJECT_INTERNAL_DIR);
+		resourceIndexPath.append(RESOURCE_INDEX_FILENAME);
+
+		const bool hasUUIDIndex = mUUIDIndex->load(resourceIndexPath);
+
 		// Load all meta files
 		Stack<DirectoryEntry*> todo;
 		todo.push(mRootEntry);
 
 		Vector<LibraryEntry*> deletedEntries;
+		Vector<FileEntry*> loadedFileEntries;
 
 		while(!todo.empty())
 		{
@@ -1635,6 +2239,7 @@ namespace bs
 					
 					if (FileSystem::isFile(resEntry->path))
 					{
+						bool isMetaLoadedFromDisk = false;
 						if (resEntry->meta == nullptr)
 						{
 							Path metaPath = resEntry->path;
@@ -1649,30 +2254,22 @@ namespace bs
 								{
 									SPtr<ProjectFileMeta> fileMeta = std::static_pointer_cast<ProjectFileMeta>(loadedMeta);
 									resEntry->meta = fileMeta;
-								}
-							}
-						}
-
-						if (resEntry->meta != nullptr)
-						{
-							auto& resourceMetas = resEntry->meta->getResourceMetaData();
-
-							if (resourceMetas.size() > 0)
-							{
-								mUUIDToPath[resourceMetas[0]->getUUID()] = resEntry->path;
 
-								for (UINT32 i = 1; i < (UINT32)resourceMetas.size(); i++)
-								{
-									SPtr<ProjectResourceMeta> entry = resourceMetas[i];
-									mUUIDToPath[entry->getUUID()] = resEntry->path + entry->getUniqueName();
+									// Make sure the journal contains the up-to-date meta-data
+									markEntryDirty(resEntry->path);
+									isMetaLoadedFromDisk = true;
 								}
 							}
 						}
 
-						addDependencies(resEntry);
+						// Meta-data loaded from disk might have changed since the index was saved
+						if (isMetaLoadedFromDisk)
+							registerResourcePaths(resEntry);
 					}
 					else
 						deletedEntries.push_back(resEntry);
+
+					loadedFileEntries.push_back(resEntry);
 				}
 				else if(child->type == LibraryEntryType::Directory)
 				{
@@ -1684,6 +2281,30 @@ namespace bs
 			}
 		}
 
+		// The index is saved separately from the journal and the meta files, so it might not match them if the editor
+		// didn't shut down cleanly, or if meta files were changed outside of the editor. Make sure it contains exactly
+		// the resources of the loaded entries, and rebuild it otherwise.
+		bool isUUIDIndexValid = hasUUIDIndex;
+		UINT32 numResources = 0;
+		for (auto& fileEntry : loadedFileEntries)
+		{
+			if (!isUUIDIndexValid)
+				break;
+
+			isUUIDIndexValid = areResourcePathsRegistered(fileEntry);
+
+			if (fileEntry->meta != nullptr)
+				numResources += (UINT32)fileEntry->meta->getResourceMetaData().size();
+		}
+
+		if (!isUUIDIndexValid || numResources != mUUIDIndex->getNumEntries())
+		{
+			mUUIDIndex->clear();
+
+			for (auto& fileEntry : loadedFileEntries)
+				registerResourcePaths(fileEntry);
+		}
+
 		// Remove entries that no longer have corresponding files
 		for (auto& deletedEntry : deletedEntries)
 		{
@@ -1709,7 +2330,7 @@ namespace bs
 			auto processFile = [&](const Path& file)
 			{
 				UUID uuid = UUID(file.getFilename(false));
-				if (mUUIDToPath.find(uuid) == mUUIDToPath.end())
+				if (!mUUIDIndex->contains(uuid))
 				{
 					mResourceManifest->unregisterResource(uuid);
 					toDelete.push_back(file);
@@ -1724,6 +2345,36 @@ namespace bs
 				FileSystem::remove(entry);
 		}
 
+		// Entries restored from disk are not reported through notifyEntryAdded, so index them all at once
+		mSearchIndex->clear();
+
+		Vector<FileEntry*> fileEntries;
+		Stack<DirectoryEntry*> searchTodo;
+		searchTodo.push(mRootEntry);
+
+		while(!searchTodo.empty())
+		{
+			DirectoryEntry* curDir = searchTodo.top();
+			searchTodo.pop();
+
+			for(auto& child : curDir->mChildren)
+			{
+				mSearchIndex->addEntry(child);
+
+				if(child->type == LibraryEntryType::Directory)
+					searchTodo.push(static_cast<DirectoryEntry*>(child));
+				else
+					fileEntries.push_back(static_cast<FileEntry*>(child));
+			}
+		}
+
+		// Dependencies can only be resolved once meta-data of all the entries is available
+		mDependencyGraph->clear();
+		mUnresolvedDependencies.clear();
+
+		for(auto& entry : fileEntries)
+			addDependencies(entry);
+
 		mIsLoaded = true;
 	}
 
@@ -1767,7 +2418,17 @@ namespace bs
 				SPtr<ShaderMetaData> metaData = std::static_pointer_cast<ShaderMetaData>(resMeta->getResourceMetaData());
 
 				for (auto& include : metaData->includes)
-					output.push_back(include);
+				{
+					// Built-in includes are not a part of the project library
+					if (!include.empty() && include[0] == '$')
+						continue;
+
+					Path includePath = include;
+					if (!includePath.isAbsolute())
+						includePath.makeAbsolute(mResourcesFolder);
+
+					output.push_back(includePath);
+				}
 			}
 		}
 
@@ -1776,47 +2437,399 @@ namespace bs
 
 	void ProjectLibrary::addDependencies(const FileEntry* entry)
 	{
-		Vector<Path> dependencies = getImportDependencies(entry);
-		for (auto& dependency : dependencies)
-			mDependencies[dependency].push_back(entry->path);
+		const UUID uuid = getPrimaryUUID(entry);
+		if (uuid.empty())
+			return;
+
+		Vector<UUID> dependencyUUIDs;
+		for (auto& dependency : getImportDependencies(entry))
+		{
+			UUID dependencyUUID;
+
+			LibraryEntry* dependencyEntry = findEntry(dependency);
+			if (dependencyEntry != nullptr && dependencyEntry->type == LibraryEntryType::File)
+				dependencyUUID = getPrimaryUUID(static_cast<FileEntry*>(dependencyEntry));
+
+			// Dependency doesn't exist or wasn't imported yet, remember the path so it can be resolved later
+			if (dependencyUUID.empty())
+				mUnresolvedDependencies[dependency].insert(uuid);
+			else
+				dependencyUUIDs.push_back(dependencyUUID);
+		}
+
+		mDependencyGraph->setDependencies(uuid, dependencyUUIDs);
 	}
 
 	void ProjectLibrary::removeDependencies(const FileEntry* entry)
 	{
-		Vector<Path> dependencies = getImportDependencies(entry);
-		for (auto& dependency : dependencies)
+		const UUID uuid = getPrimaryUUID(entry);
+		if (uuid.empty())
+			return;
+
+		mDependencyGraph->removeDependencies(uuid);
+
+		for (auto& dependency : getImportDependencies(entry))
+		{
+			const auto iterFind = mUnresolvedDependencies.find(dependency);
+			if (iterFind == mUnresolvedDependencies.end())
+				continue;
+
+			iterFind->second.erase(uuid);
+			if (iterFind->second.empty())
+				mUnresolvedDependencies.erase(iterFind);
+		}
+	}
+
+	void ProjectLibrary::resolveDependencies(const FileEntry* entry)
+	{
+		const auto iterFind = mUnresolvedDependencies.find(entry->path);
+		if (iterFind == mUnresolvedDependencies.end())
+			return;
+
+		const UnorderedSet<UUID> dependants = std::move(iterFind->second);
+		mUnresolvedDependencies.erase(iterFind);
+
+		for (auto& dependant : dependants)
 		{
-			Vector<Path>& curDependencies = mDependencies[dependency];
-			auto iterRemove = std::remove_if(curDependencies.begin(), curDependencies.end(),
-				[&](const Path& x)
+			FileEntry* dependantEntry = findFileEntry(dependant);
+			if (dependantEntry == nullptr)
+				continue;
+
+			removeDependencies(dependantEntry);
+			addDependencies(dependantEntry);
+		}
+	}
+
+	void ProjectLibrary::reimportDependants(const Vector<UUID>& resources)
+	{
+		if (resources.empty())
+			return;
+
+		// Every affected resource is reimported once, after all of its dependencies that are also being reimported
+		// finish. Resources whose dependencies are not being reimported are queued straight away, in parallel.
+		const Vector<UUID> dependants = mDependencyGraph->getTransitiveDependants(resources);
+		const UnorderedSet<UUID> batch(dependants.begin(), dependants.end());
+
+		for (auto& dependant : dependants)
+		{
+			UINT32 numPendingDependencies = 0;
+			for (auto& dependency : mDependencyGraph->getDependencies(dependant))
+			{
+				if (batch.find(dependency) != batch.end() ||
+					mPendingDependantReimports.find(dependency) != mPendingDependantReimports.end() ||
+					mDependantReimports.find(dependency) != mDependantReimports.end())
+				{
+					numPendingDependencies++;
+				}
+			}
+
+			if (numPendingDependencies > 0)
+				mPendingDependantReimports[dependant] = numPendingDependencies;
+			else
+			{
+				mPendingDependantReimports.erase(dependant);
+				queueDependantReimport(dependant);
+			}
+		}
+	}
+
+	void ProjectLibrary::queueDependantReimport(const UUID& uuid)
+	{
+		FileEntry* entry = findFileEntry(uuid);
+		if (entry != nullptr)
+		{
+			SPtr<ImportOptions> importOptions;
+			if (entry->meta != nullptr)
+				importOptions = entry->meta->getImportOptions();
+
+			if (reimportResourceInternal(entry, importOptions, true))
+			{
+				mDependantReimports.insert(uuid);
+				return;
+			}
+		}
+
+		// Nothing to wait for, release the dependants right away
+		finishDependantReimport(uuid);
+	}
+
+	void ProjectLibrary::finishDependantReimport(const UUID& uuid)
+	{
+		mDependantReimports.erase(uuid);
+
+		for (auto& dependant : mDependencyGraph->getDependants(uuid))
+		{
+			const auto iterFind = mPendingDependantReimports.find(dependant);
+			if (iterFind == mPendingDependantReimports.end())
+				continue;
+
+			if (--iterFind->second == 0)
 			{
-				return x == entry->path;
-			});
+				mPendingDependantReimports.erase(iterFind);
+				queueDependantReimport(dependant);
+			}
+		}
+	}
+
+	ProjectLibrary::FileEntry* ProjectLibrary::findFileEntry(const UUID& uuid) const
+	{
+		String filePath;
+		String subresourceName;
+		if (!mUUIDIndex->find(uuid, filePath, subresourceName))
+			return nullptr;
+
+		LibraryEntry* entry = findEntry(Path(filePath));
+		if (entry == nullptr || entry->type != LibraryEntryType::File)
+			return nullptr;
+
+		return static_cast<FileEntry*>(entry);
+	}
+
+	UUID ProjectLibrary::getPrimaryUUID(const FileEntry* entry)
+	{
+		if (entry->meta == nullptr)
+			return UUID::EMPTY;
+
+		auto& resourceMetas = entry->meta->getResourceMetaData();
+		if (resourceMetas.empty())
+			return UUID::EMPTY;
+
+		return resourceMetas[0]->getUUID();
+	}
+
+	void ProjectLibrary::beginEntryEventBatch()
+	{
+		mEntryEventBatchDepth++;
+	}
+
+	void ProjectLibrary::endEntryEventBatch()
+	{
+		assert(mEntryEventBatchDepth > 0);
+
+		mEntryEventBatchDepth--;
+		if(mEntryEventBatchDepth > 0)
+			return;
+
+		// Move the data out first, as listeners are allowed to modify the library
+		Vector<Path> removedEntries = std::move(mBatchedRemovedEntries);
+		Vector<Path> addedEntries;
+		addedEntries.reserve(mBatchedAddedEntries.size());
+
+		for(auto& entry : mBatchedAddedEntries)
+			addedEntries.push_back(entry->path);
+
+		mBatchedRemovedEntries.clear();
+		mBatchedAddedEntries.clear();
+		mBatchedAddedEntryLookup.clear();
+
+		for(auto& path : removedEntries)
+			onEntryRemoved(path);
+
+		for(auto& path : addedEntries)
+			onEntryAdded(path);
+	}
+
+	void ProjectLibrary::notifyEntryAdded(LibraryEntry* entry)
+	{
+		markEntryDirty(entry->path);
+		mSearchIndex->addEntry(entry);
 
-			curDependencies.erase(iterRemove, curDependencies.end());
+		if(mEntryEventBatchDepth == 0)
+		{
+			onEntryAdded(entry->path);
+			return;
 		}
+
+		if(mBatchedAddedEntryLookup.insert(entry).second)
+			mBatchedAddedEntries.push_back(entry);
 	}
 
-	void ProjectLibrary::reimportDependants(const Path& entryPath)
+	void ProjectLibrary::notifyEntryRemoved(LibraryEntry* entry)
 	{
-		auto iterFind = mDependencies.find(entryPath);
-		if (iterFind == mDependencies.end())
+		markEntryDirty(entry->path);
+		mSearchIndex->removeEntry(entry);
+
+		if(mEntryEventBatchDepth == 0)
+		{
+			onEntryRemoved(entry->path);
 			return;
+		}
 
-		// Make a copy since we might modify this list during reimport
-		Vector<Path> dependencies = iterFind->second;
-		for (auto& dependency : dependencies)
+		// Entry was added during this batch, so the outside world never saw it
+		if(mBatchedAddedEntryLookup.erase(entry) > 0)
 		{
-			LibraryEntry* entry = findEntry(dependency);
-			if (entry != nullptr && entry->type == LibraryEntryType::File)
+			const auto iterFind = std::find(mBatchedAddedEntries.begin(), mBatchedAddedEntries.end(), entry);
+			if(iterFind != mBatchedAddedEntries.end())
+				mBatchedAddedEntries.erase(iterFind);
+
+			return;
+		}
+
+		mBatchedRemovedEntries.push_back(entry->path);
+	}
+
+	void ProjectLibrary::registerResourcePaths(FileEntry* fileEntry)
+	{
+		if(fileEntry->meta == nullptr)
+			return;
+
+		const String relativePath = fileEntry->path.getRelative(mResourcesFolder).toString();
+
+		auto& resourceMetas = fileEntry->meta->getResourceMetaData();
+		for(UINT32 i = 0; i < (UINT32)resourceMetas.size(); i++)
+		{
+			// First resource is the primary resource, and is referenced by the file path alone
+			const String& subresourceName = i == 0 ? StringUtil::BLANK : resourceMetas[i]->getUniqueName();
+			mUUIDIndex->set(resourceMetas[i]->getUUID(), relativePath, subresourceName);
+		}
+	}
+
+	void ProjectLibrary::unregisterResourcePaths(FileEntry* fileEntry)
+	{
+		if(fileEntry->meta == nullptr)
+			return;
+
+		for(auto& resourceMeta : fileEntry->meta->getAllResourceMetaData())
+			mUUIDIndex->remove(resourceMeta->getUUID());
+	}
+
+	bool ProjectLibrary::areResourcePathsRegistered(FileEntry* fileEntry) const
+	{
+		if(fileEntry->meta == nullptr)
+			return true;
+
+		const String relativePath = fileEntry->path.getRelative(mResourcesFolder).toString();
+
+		auto& resourceMetas = fileEntry->meta->getResourceMetaData();
+		for(UINT32 i = 0; i < (UINT32)resourceMetas.size(); i++)
+		{
+			String filePath;
+			String subresourceName;
+			if(!mUUIDIndex->find(resourceMetas[i]->getUUID(), filePath, subresourceName))
+				return false;
+
+			const String& expectedName = i == 0 ? StringUtil::BLANK : resourceMetas[i]->getUniqueName();
+			if(filePath != relativePath || subresourceName != expectedName)
+				return false;
+		}
+
+		return true;
+	}
+
+	void ProjectLibrary::updatePreviewIconsSource(FileEntry* fileEntry)
+	{
+		if(fileEntry->meta == nullptr)
+			return;
+
+		const Path metaPath = getMetaPath(fileEntry->path);
+		for(auto& resourceMeta : fileEntry->meta->getAllResourceMetaData())
+		{
+			if(!resourceMeta->mPreviewIconsSource.isEmpty())
+				resourceMeta->mPreviewIconsSource = metaPath;
+		}
+	}
+
+	void ProjectLibrary::markEntryDirty(const Path& path)
+	{
+		if(mDirtyEntryLookup.insert(path).second)
+			mDirtyEntries.push_back(path);
+	}
+
+	void ProjectLibrary::getJournalEntries(LibraryEntry* entry, Vector<ProjectLibraryJournalEntry>& output) const
+	{
+		Stack<LibraryEntry*> todo;
+		todo.push(entry);
+
+		while(!todo.empty())
+		{
+			LibraryEntry* curEntry = todo.top();
+			todo.pop();
+
+			// Root is implicit and not stored in the journal
+			if(curEntry != mRootEntry)
 			{
-				FileEntry* resEntry = static_cast<FileEntry*>(entry);
+				ProjectLibraryJournalEntry journalEntry;
+				journalEntry.path = curEntry->path.getRelative(mResourcesFolder).toString();
+				journalEntry.type = curEntry->type;
+
+				if(curEntry->type == LibraryEntryType::File)
+				{
+					FileEntry* fileEntry = static_cast<FileEntry*>(curEntry);
+					journalEntry.lastUpdateTime = fileEntry->lastUpdateTime;
+
+					if(fileEntry->meta != nullptr)
+					{
+						const Path metaPath = getMetaPath(fileEntry->path);
+						if(FileSystem::isFile(metaPath))
+						{
+							journalEntry.meta = fileEntry->meta;
+							journalEntry.metaModifiedTime = FileSystem::getLastModifiedTime(metaPath);
+						}
+					}
+				}
 
-				SPtr<ImportOptions> importOptions;
-				if (resEntry->meta != nullptr)
-					importOptions = resEntry->meta->getImportOptions();
+				output.push_back(journalEntry);
+			}
+
+			// Children pushed in reverse, so parents are always output before their children, in child order
+			if(curEntry->type == LibraryEntryType::Directory)
+			{
+				DirectoryEntry* dirEntry = static_cast<DirectoryEntry*>(curEntry);
+				for(auto iter = dirEntry->mChildren.rbegin(); iter != dirEntry->mChildren.rend(); ++iter)
+					todo.push(*iter);
+			}
+		}
+	}
+
+	void ProjectLibrary::restoreJournalEntries(const Vector<ProjectLibraryJournalEntry>& entries)
+	{
+		UnorderedMap<String, DirectoryEntry*> directories;
+		directories[StringUtil::BLANK] = mRootEntry;
+
+		// Entries are sorted so that parents always precede their children
+		for(auto& entry : entries)
+		{
+			const String key = ProjectLibraryJournal::getKey(entry.path);
+			const String::size_type separatorIdx = key.find_last_of('/');
+			const String parentKey = separatorIdx == String::npos ? StringUtil::BLANK : key.substr(0, separatorIdx);
+
+			// Parent is missing, the entry will be re-added by the next modification check if it still exists
+			const auto iterFind = directories.find(parentKey);
+			if(iterFind == directories.end())
+				continue;
+
+			DirectoryEntry* parent = iterFind->second;
+
+			Path fullPath = entry.path;
+			fullPath.makeAbsolute(mResourcesFolder);
+
+			if(entry.type == LibraryEntryType::Directory)
+			{
+				DirectoryEntry* dirEntry = bs_new<DirectoryEntry>(fullPath, fullPath.getTail(), parent);
+				parent->addChild(dirEntry);
+
+				directories[key] = dirEntry;
+			}
+			else
+			{
+				FileEntry* fileEntry = bs_new<FileEntry>(fullPath, fullPath.getTail(), parent);
+				fileEntry->lastUpdateTime = entry.lastUpdateTime;
+
+				// Only use the stored meta-data if the .meta file wasn't modified externally (e.g. by version control)
+				if(entry.meta != nullptr)
+				{
+					const Path metaPath = getMetaPath(fullPath);
+					if(FileSystem::isFile(metaPath) && FileSystem::getLastModifiedTime(metaPath) == entry.metaModifiedTime)
+					{
+						fileEntry->meta = entry.meta;
+
+						// Preview icons aren't stored in the journal, load them from the .meta file when first needed
+						for(auto& resourceMeta : entry.meta->getAllResourceMetaData())
+							resourceMeta->mPreviewIconsSource = metaPath;
+					}
+				}
 
-				reimportResourceInternal(resEntry, importOptions, true);
+				parent->addChild(fileEntry);
 			}
 		}
 	}
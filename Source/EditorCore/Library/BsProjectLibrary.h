@@ -5,6 +5,7 @@
 #include "BsEditorPrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Threading/BsAsyncOp.h"
+#include "Library/BsProjectResourceMeta.h"
 
 namespace bs
 {
@@ -31,6 +32,14 @@ namespace bs
 			Directory
 		};
 
+		/** Determines in which order queued imports are processed. */
+		enum class ImportPriority
+		{
+			Background, /**< Bulk imports, such as those triggered by detected file modifications. */
+			Interactive, /**< Imports explicitly requested by the user. Processed ahead of background imports. */
+			Count // Keep at end
+		};
+
 		/**	A generic library entry that may be a file or a folder depending on its type. */
 		struct LibraryEntry
 		{
@@ -54,13 +63,39 @@ namespace bs
 			std::time_t lastUpdateTime; /**< Timestamp of when we last imported the resource. */
 		};
 
+		/** Hashes entry names case-insensitively, without creating any temporary strings. */
+		struct EntryNameHash
+		{
+			size_t operator()(const String* name) const;
+		};
+
+		/** Compares entry names case-insensitively, without creating any temporary strings. */
+		struct EntryNameEqual
+		{
+			bool operator()(const String* lhs, const String* rhs) const;
+		};
+
 		/**	A library entry representing a folder that contains other entries. */
 		struct DirectoryEntry : public LibraryEntry
 		{
 			DirectoryEntry();
 			DirectoryEntry(const Path& path, const String& name, DirectoryEntry* parent);
 
+			/** Registers a new child entry with this directory. Child's element name must be set before calling. */
+			void addChild(LibraryEntry* child);
+
+			/** Unregisters a child entry from this directory. The entry itself is not destroyed. */
+			void removeChild(LibraryEntry* child);
+
+			/** Attempts to find an immediate child with the specified name. Comparison is case insensitive. */
+			LibraryEntry* findChild(const String& name) const;
+
 			Vector<LibraryEntry*> mChildren; /**< Child files or folders. */
+			/**
+			 * Child files or folders, keyed by the child's own element name. Keys point directly to the names stored in
+			 * the child entries, so no strings are copied when adding, removing or looking up children.
+			 */
+			UnorderedMap<const String*, LibraryEntry*, EntryNameHash, EntryNameEqual> mChildLookup;
 		};
 
 	public:
@@ -105,6 +140,28 @@ namespace bs
 		 */
 		SPtr<ProjectResourceMeta> findResourceMeta(const Path& path) const;
 
+		/**
+		 * Attempts to a find a meta information for a resource with the specified UUID.
+		 *
+		 * @param[in]	uuid	UUID of the resource or sub-resource.
+		 * @return				Found meta information for the resource, or null if not found.
+		 */
+		SPtr<ProjectResourceMeta> findResourceMeta(const UUID& uuid) const;
+
+		/**
+		 * Returns resources referenced by the resource with the specified UUID, as recorded in the resource meta-data
+		 * when the resource was last imported or saved. Unlike import dependencies, these are the resources that must
+		 * be loaded alongside the resource. Asset files are only read for built-in resources, and for resources
+		 * imported before references were recorded.
+		 *
+		 * @param[in]	uuid		UUID of the resource or sub-resource.
+		 * @param[in]	recursive	If true, resources referenced by the referenced resources are returned as well. Each
+		 *							resource is then listed after all the resources it references, unless they reference
+		 *							each other in a cycle.
+		 * @return					UUIDs of the referenced resources. Doesn't include the resource itself.
+		 */
+		Vector<UUID> getResourceDependencies(const UUID& uuid, bool recursive = false);
+
 		/**
 		 * Searches the library for a pattern and returns all entries matching it.
 		 *
@@ -177,7 +234,8 @@ namespace bs
 		void deleteEntry(const Path& path);
 
 		/**
-		 * Triggers a reimport of a resource using the provided import options, if needed.
+		 * Triggers a reimport of a resource using the provided import options, if needed. The import is processed ahead
+		 * of any queued background imports.
 		 *
 		 * @param[in]	path			Path to the resource to reimport, absolute or relative to resources folder.
 		 * @param[in]	importOptions	Optional import options to use when importing the resource. Caller must ensure the
@@ -212,7 +270,8 @@ namespace bs
 		Vector<FileEntry*> getResourcesForBuild() const;
 
 		/**
-		 * Loads a resource at the specified path, synchronously.
+		 * Loads a resource at the specified path, synchronously. If the resource hasn't been imported yet, it is imported
+		 * ahead of any queued background imports and the method waits until the import finishes.
 		 *
 		 * @param[in]	path	Path of the resource, absolute or relative to resources folder. If a sub-resource within
 		 *						a file is needed, append the name of the subresource to the path 
@@ -227,6 +286,22 @@ namespace bs
 		/** Returns the number of resources currently queued for import. */
 		UINT32 getInProgressImportCount() const { return (UINT32)mQueuedImports.size(); }
 
+		/** Returns the number of resources currently queued for import with the specified priority. */
+		UINT32 getInProgressImportCount(ImportPriority priority) const { return mNumQueuedImports[(UINT32)priority]; }
+
+		/** Returns the number of imports that failed since the project was loaded. Failed files remain out of date. */
+		UINT32 getFailedImportCount() const { return mNumFailedImports; }
+
+		/**
+		 * Assigns a cache that will be used for storing and retrieving import outputs. When set, resources whose source
+		 * data and import options match a previous import will be retrieved from the cache instead of being imported.
+		 * Set to null to disable caching.
+		 */
+		void setImportCache(const SPtr<ImportCache>& cache) { mImportCache = cache; }
+
+		/** Returns the cache used for storing import outputs, if any. */
+		const SPtr<ImportCache>& getImportCache() const { return mImportCache; }
+
 		/**
 		 * Saves all the project library data so it may be restored later, at the default save location in the project
 		 * folder. Project must be loaded when calling this.
@@ -235,9 +310,11 @@ namespace bs
 
 		/**
 		 * Loads previously saved project library data from the default save location in the project folder. Nothing is
-		 * loaded if it doesn't exist.Project must be loaded when calling this.
+		 * loaded if it doesn't exist.
+		 *
+		 * @param[in]	projectFolder	Root folder of the project to load the library for.
 		 */
-		void loadLibrary();
+		void loadLibrary(const Path& projectFolder);
 
 		/**	Clears all library data. */
 		void unloadLibrary();
@@ -271,7 +348,10 @@ namespace bs
 		static const Path RESOURCES_DIR;
 		static const Path INTERNAL_RESOURCES_DIR;
 	private:
-		/** Name/resource pair for a single imported resource. */
+		friend class EditorTestSuite;
+		friend class EditorBenchmarks;
+
+		/** Name/resource pair for a single imported resource, along with its preview icons. */
 		struct QueuedImportResource
 		{
 			QueuedImportResource(String name, SPtr<Resource> resource, const UUID& uuid)
@@ -281,18 +361,62 @@ namespace bs
 			String name;
 			SPtr<Resource> resource;
 			UUID uuid;
+			ProjectResourceIcons icons; /**< Generated on the import thread, alongside the resource. */
+			Vector<UUID> dependencies; /**< Resources referenced by the resource. */
+
+			/** 
+			 * Meta-data of the resource, if it was copied from the import cache. Such resources are not decoded, so 
+			 * @p resource is null.
+			 */
+			SPtr<ProjectResourceMeta> cachedMeta;
+		};
+
+		/** Information about a single file found during a modification scan. */
+		struct ScannedFile
+		{
+			Path path;
+			std::time_t lastModifiedTime = 0;
+			UINT64 size = 0;
+			UINT64 contentHash = 0; /**< Hash of the file contents. Only valid if hasContentHash is true. */
+			bool hasContentHash = false;
+		};
+
+		/** Contents of a single directory found during a modification scan. */
+		struct ScannedDirectory
+		{
+			Path path;
+			Vector<ScannedFile> files;
+			Vector<Path> directories;
+			Vector<Path> orphanedMetas; /**< .meta files that have no corresponding resource file. */
+			UINT32 firstChild = 0; /**< Index of the first child directory in the scan output. */
 		};
 
 		/** Information about an asynchronously queued import. */
 		struct QueuedImport
 		{
+			/** Marks the import as started. Returns false if the import was canceled, in which case it shouldn't run. */
+			bool start() { started = true; return !canceled; }
+
+			/** 
+			 * Requests the import to be canceled. A running import stops at the next opportunity. Returns true if the
+			 * import already started running.
+			 */
+			bool cancel() { canceled = true; return started; }
+
 			Path filePath;
 			SPtr<Task> importTask;
+			SPtr<Task> dependency; /**< Task that must finish before this import can run, if any. */
 			SPtr<ImportOptions> importOptions;
 			Vector<QueuedImportResource> resources;
+			UINT64 sourceHash = 0;
+			UINT64 sourceSize = 0;
+			UINT64 importOptionsHash = 0;
+			ImportPriority priority = ImportPriority::Background;
 			bool pruneMetas = false;
-			bool canceled = false;
 			bool native = false;
+			bool failed = false; /**< Set by the import task if the imported resources cannot be saved. */
+			std::atomic<bool> started { false };
+			std::atomic<bool> canceled { false };
 		};
 
 		/**
@@ -349,10 +473,52 @@ namespace bs
 		 *									resources are eventually restored, references to them will remain valid. If you
 		 *									feel that you need to clear this data, set this to true but be aware that you
 		 *									might need to re-apply those references.
+		 * @param[in]	scanInfo			Optional information about the file gathered during a modification scan.
+		 * @param[in]	priority			Priority to queue the import with. If an import of the same file is already
+		 *									queued it is canceled, and the higher of the two priorities is used.
 		 * @return							Returns true if the resource was queued for import, false otherwise.
 		 */
 		bool reimportResourceInternal(FileEntry* file, const SPtr<ImportOptions>& importOptions = nullptr, 
-			bool forceReimport = false, bool pruneResourceMetas = false);
+			bool forceReimport = false, bool pruneResourceMetas = false, const ScannedFile* scanInfo = nullptr,
+			ImportPriority priority = ImportPriority::Background);
+
+		/**
+		 * Enumerates the file system hierarchy starting at the provided directory. Directories are processed in parallel
+		 * using the task scheduler. Library entries are not accessed.
+		 *
+		 * @param[in]	path	Absolute path to the directory to scan.
+		 * @param[out]	output	Scanned directories, with the root directory being the first element.
+		 */
+		void scanDirectoryTree(const Path& path, Vector<ScannedDirectory>& output) const;
+
+		/** Enumerates contents of a single directory. Safe to call from worker threads. */
+		void scanDirectory(ScannedDirectory& directory) const;
+
+		/**
+		 * Updates the library hierarchy to match the results of a directory scan. Adds new entries, removes deleted ones
+		 * and queues modified resources for import.
+		 *
+		 * @param[in]	rootEntry			Entry corresponding to the first directory in @p scannedDirectories.
+		 * @param[in]	scannedDirectories	Output of scanDirectoryTree().
+		 * @return							Number of resources that were queued for import.
+		 */
+		UINT32 applyDirectoryScan(DirectoryEntry* rootEntry, Vector<ScannedDirectory>& scannedDirectories);
+
+		/** 
+		 * Starts an entry event batch. While a batch is active onEntryAdded and onEntryRemoved events are not triggered
+		 * immediately, but are instead reported once the outermost batch ends. Every entry is still reported
+		 * individually, including the contents of added or removed directories. Batches can be nested.
+		 */
+		void beginEntryEventBatch();
+
+		/** Ends an entry event batch started with beginEntryEventBatch(). */
+		void endEntryEventBatch();
+
+		/** Triggers the onEntryAdded event, or queues it if an event batch is active. */
+		void notifyEntryAdded(LibraryEntry* entry);
+
+		/** Triggers the onEntryRemoved event, or queues it if an event batch is active. Entry must still be valid. */
+		void notifyEntryRemoved(LibraryEntry* entry);
 
 		/**
 		 * Creates a full hierarchy of directory entries up to the provided directory, if any are needed.
@@ -363,8 +529,18 @@ namespace bs
 		 */
 		void createInternalParentHierarchy(const Path& fullPath, DirectoryEntry** newHierarchyRoot, DirectoryEntry** newHierarchyLeaf);
 
-		/**	Checks has a file been modified since the last import. */
-		bool isUpToDate(FileEntry* file) const;
+		/**	
+		 * Checks has a file been modified since the last import. Files with a changed timestamp are still considered up 
+		 * to date if their content fingerprint matches the one recorded during the last import. If @p scanInfo is 
+		 * provided, file information retrieved during a modification scan is used instead of querying the file system.
+		 */
+		bool isUpToDate(FileEntry* file, const ScannedFile* scanInfo = nullptr);
+
+		/** 
+		 * Performs a cheap up-to-date check using only the file modification time and size. Files failing this check
+		 * might still have unchanged contents.
+		 */
+		bool isTimestampUpToDate(const FileEntry* file, std::time_t lastModifiedTime, UINT64 size) const;
 
 		/**	Checks is the resource a native engine resource that doesn't require importing. */
 		bool isNative(const Path& path) const;
@@ -381,19 +557,49 @@ namespace bs
 		bool isMeta(const Path& fullPath) const;
 
 		/**
-		 * Returns a set of resource paths that are dependent on the provided resource entry. (for example a shader file
-		 * might be dependent on shader include file).
+		 * Returns absolute paths of resources the provided resource entry depends on, as declared by the importer (for 
+		 * example a shader file might be dependent on shader include file).
 		 */
 		Vector<Path> getImportDependencies(const FileEntry* entry);
 
-		/**	Registers any import dependencies for the specified resource. */
+		/** Returns resources directly referenced by the specified resource. See getResourceDependencies(). */
+		Vector<UUID> getDirectResourceDependencies(const UUID& uuid);
+
+		/** Returns UUIDs of all resources referenced by the provided resource object. Can be called from any thread. */
+		static Vector<UUID> getReferencedUUIDs(IReflectable& resource);
+
+		/**	
+		 * Registers any import dependencies for the specified resource in the dependency graph. Dependencies that are
+		 * not imported yet are remembered by path, and resolved by resolveDependencies() once they are.
+		 */
 		void addDependencies(const FileEntry* entry);
 
 		/**	Removes any import dependencies for the specified resource. */
 		void removeDependencies(const FileEntry* entry);
 
-		/**	Finds dependants resource for the specified resource entry and reimports them. */
-		void reimportDependants(const Path& entryPath);
+		/** Registers dependencies of resources that were waiting for the provided entry to be imported. */
+		void resolveDependencies(const FileEntry* entry);
+
+		/**	
+		 * Finds all resources that directly or indirectly depend on the provided resources and reimports them. Each 
+		 * resource is reimported once, and only after the resources it depends on finish reimporting.
+		 */
+		void reimportDependants(const Vector<UUID>& resources);
+
+		/** Queues a reimport of a resource found by reimportDependants(). */
+		void queueDependantReimport(const UUID& uuid);
+
+		/** 
+		 * Notifies the system a reimport queued by queueDependantReimport() finished, queuing any resources that were
+		 * waiting on it.
+		 */
+		void finishDependantReimport(const UUID& uuid);
+
+		/** Finds the file entry containing the resource with the specified UUID. */
+		FileEntry* findFileEntry(const UUID& uuid) const;
+
+		/** Returns the UUID of the primary resource in the file, or an empty UUID if the file wasn't imported. */
+		static UUID getPrimaryUUID(const FileEntry* entry);
 
 		/**	Makes all library entry paths relative to the current resources folder. */
 		void makeEntriesRelative();
@@ -407,8 +613,32 @@ namespace bs
 		/** Deletes all library entries. */
 		void clearEntries();
 
+		/** Registers UUIDs of all resources in the file with the UUID index, mapping them to the file's current path. */
+		void registerResourcePaths(FileEntry* fileEntry);
+
+		/** Removes UUIDs of all resources in the file, both active and inactive, from the UUID index. */
+		void unregisterResourcePaths(FileEntry* fileEntry);
+
+		/** Checks are all active resources in the file registered in the UUID index, under the file's current path. */
+		bool areResourcePathsRegistered(FileEntry* fileEntry) const;
+
+		/** Points preview icons that weren't loaded yet to the file's current .meta file, after the file was moved. */
+		void updatePreviewIconsSource(FileEntry* fileEntry);
+
+		/** Marks the entry at the specified path as modified, so it gets written to the journal on the next save. */
+		void markEntryDirty(const Path& path);
+
+		/** Creates journal entries for the provided library entry and, if it's a directory, all of its children. */
+		void getJournalEntries(LibraryEntry* entry, Vector<ProjectLibraryJournalEntry>& output) const;
+
+		/** Rebuilds the library entry hierarchy from entries read from the journal. */
+		void restoreJournalEntries(const Vector<ProjectLibraryJournalEntry>& entries);
+
 		static const char* LIBRARY_ENTRIES_FILENAME;
+		static const char* LIBRARY_JOURNAL_FILENAME;
+		static const char* RESOURCE_INDEX_FILENAME;
 		static const char* RESOURCE_MANIFEST_FILENAME;
+		static const UINT32 MIN_DIRECTORIES_PER_SCAN_TASK;
 
 		SPtr<ResourceManifest> mResourceManifest;
 		DirectoryEntry* mRootEntry;
@@ -418,9 +648,25 @@ namespace bs
 
 		Mutex mQueuedImportMutex;
 		UnorderedMap<FileEntry*, SPtr<QueuedImport>> mQueuedImports;
-
-		UnorderedMap<Path, Vector<Path>> mDependencies;
-		UnorderedMap<UUID, Path> mUUIDToPath;
+		UINT32 mNumQueuedImports[(UINT32)ImportPriority::Count] = { 0 };
+		UINT32 mNumFailedImports = 0;
+		SPtr<ImportCache> mImportCache;
+
+		SPtr<ResourceDependencyGraph> mDependencyGraph;
+		UnorderedMap<Path, UnorderedSet<UUID>> mUnresolvedDependencies; /**< Dependants, keyed by missing dependency. */
+		UnorderedMap<UUID, UINT32> mPendingDependantReimports; /**< Dependants waiting, with number of pending dependencies. */
+		UnorderedSet<UUID> mDependantReimports; /**< Dependants currently being reimported. */
+		SPtr<ResourceUUIDIndex> mUUIDIndex;
+		SPtr<ProjectLibrarySearchIndex> mSearchIndex;
+
+		UINT32 mEntryEventBatchDepth = 0;
+		Vector<Path> mBatchedRemovedEntries;
+		Vector<LibraryEntry*> mBatchedAddedEntries;
+		UnorderedSet<LibraryEntry*> mBatchedAddedEntryLookup;
+
+		SPtr<ProjectLibraryJournal> mJournal;
+		Vector<Path> mDirtyEntries;
+		UnorderedSet<Path> mDirtyEntryLookup;
 	};
 
 	/**	Provides easy access to ProjectLibrary. */
@@ -0,0 +1,370 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Library/BsProjectLibraryJournal.h"
+#include "Library/BsProjectResourceMeta.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Utility/BsContentHash.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	/** Types of records stored in the journal. */
+	enum class JournalRecordType : UINT8
+	{
+		Update,
+		Remove
+	};
+
+	template<class T>
+	static void writeJournalValue(Vector<UINT8>& buffer, const T& value)
+	{
+		const UINT8* data = (const UINT8*)&value;
+		buffer.insert(buffer.end(), data, data + sizeof(T));
+	}
+
+	static void writeJournalString(Vector<UINT8>& buffer, const String& value)
+	{
+		writeJournalValue(buffer, (UINT32)value.size());
+		buffer.insert(buffer.end(), value.begin(), value.end());
+	}
+
+	/** Reads data from a journal record, keeping track of the read position and making sure reads stay in bounds. */
+	class ProjectLibraryJournalReader
+	{
+	public:
+		ProjectLibraryJournalReader(const UINT8* data, UINT32 size)
+			:mData(data), mSize(size)
+		{ }
+
+		template<class T>
+		bool read(T& value)
+		{
+			if(mOffset + sizeof(T) > mSize)
+				return false;
+
+			memcpy(&value, mData + mOffset, sizeof(T));
+			mOffset += sizeof(T);
+
+			return true;
+		}
+
+		bool read(String& value)
+		{
+			UINT32 length;
+			if(!read(length) || mOffset + length > mSize)
+				return false;
+
+			value.assign((const char*)mData + mOffset, length);
+			mOffset += length;
+
+			return true;
+		}
+
+		const UINT8* skip(UINT32 size)
+		{
+			if(mOffset + size > mSize)
+				return nullptr;
+
+			const UINT8* output = mData + mOffset;
+			mOffset += size;
+
+			return output;
+		}
+
+	private:
+		const UINT8* mData;
+		UINT32 mSize;
+		UINT32 mOffset = 0;
+	};
+
+	const UINT32 ProjectLibraryJournal::MAGIC = 0x4A4C5342; // "BSLJ"
+	const UINT32 ProjectLibraryJournal::VERSION = 2;
+	const UINT32 ProjectLibraryJournal::MIN_RECORDS_BEFORE_COMPACTION = 1024;
+
+	ProjectLibraryJournal::ProjectLibraryJournal(const Path& path)
+		:mPath(path)
+	{ }
+
+	bool ProjectLibraryJournal::read(Vector<ProjectLibraryJournalEntry>& entries)
+	{
+		mIsValid = false;
+		mNumSnapshotRecords = 0;
+		mNumAppendedRecords = 0;
+
+		SPtr<DataStream> stream = FileSystem::openFile(mPath, true);
+		if(stream == nullptr)
+			return false;
+
+		// Read everything in one go, records are small and there are many of them
+		const UINT32 fileSize = (UINT32)stream->size();
+		Vector<UINT8> fileData(fileSize);
+		if(fileSize > 0)
+			stream->read(fileData.data(), fileSize);
+
+		stream->close();
+
+		ProjectLibraryJournalReader fileReader(fileData.data(), fileSize);
+
+		UINT32 magic = 0;
+		UINT32 version = 0;
+		if(!fileReader.read(magic) || !fileReader.read(version) || magic != MAGIC || version != VERSION)
+			return false;
+
+		Map<String, ProjectLibraryJournalEntry> replayedEntries;
+		MemorySerializer serializer;
+
+		UINT32 numRecords = 0;
+		bool isTruncated = false;
+		while(true)
+		{
+			UINT32 payloadSize;
+			if(!fileReader.read(payloadSize))
+				break;
+
+			UINT64 checksum = 0;
+			const UINT8* payloadData = nullptr;
+			if(fileReader.read(checksum))
+				payloadData = fileReader.skip(payloadSize);
+
+			if(payloadData == nullptr || ContentHash::hash(payloadData, payloadSize) != checksum)
+			{
+				isTruncated = true;
+				break;
+			}
+
+			ProjectLibraryJournalReader reader(payloadData, payloadSize);
+
+			UINT8 recordType;
+			String path;
+			if(!reader.read(recordType) || !reader.read(path))
+			{
+				isTruncated = true;
+				break;
+			}
+
+			const String key = getKey(path);
+			if((JournalRecordType)recordType == JournalRecordType::Update)
+			{
+				ProjectLibraryJournalEntry entry;
+				entry.path = path;
+
+				UINT8 entryType;
+				UINT64 lastUpdateTime;
+				UINT64 metaModifiedTime;
+				UINT32 metaSize;
+				if(!reader.read(entryType) || !reader.read(lastUpdateTime) || !reader.read(metaModifiedTime) ||
+					!reader.read(metaSize))
+				{
+					isTruncated = true;
+					break;
+				}
+
+				entry.type = (ProjectLibrary::LibraryEntryType)entryType;
+				entry.lastUpdateTime = (std::time_t)lastUpdateTime;
+				entry.metaModifiedTime = (std::time_t)metaModifiedTime;
+
+				if(metaSize > 0)
+				{
+					const UINT8* metaData = reader.skip(metaSize);
+					if(metaData == nullptr)
+					{
+						isTruncated = true;
+						break;
+					}
+
+					SPtr<IReflectable> meta = serializer.decode(const_cast<UINT8*>(metaData), metaSize);
+					if(meta != nullptr && meta->isDerivedFrom(ProjectFileMeta::getRTTIStatic()))
+						entry.meta = std::static_pointer_cast<ProjectFileMeta>(meta);
+				}
+
+				replayedEntries[key] = entry;
+			}
+			else
+			{
+				// Remove the entry and everything below it
+				replayedEntries.erase(key);
+
+				const String prefix = key + "/";
+				auto iter = replayedEntries.lower_bound(prefix);
+				while(iter != replayedEntries.end() && iter->first.compare(0, prefix.size(), prefix) == 0)
+					iter = replayedEntries.erase(iter);
+			}
+
+			numRecords++;
+		}
+
+		if(isTruncated)
+			LOGWRN("Project library journal \"" + mPath.toString() + "\" is corrupt. Entries following the corrupt record were discarded.");
+
+		// Keys are ordered, and a parent's key is always a prefix of its children's keys, so parents come first
+		entries.reserve(entries.size() + replayedEntries.size());
+		for(auto& entry : replayedEntries)
+			entries.push_back(entry.second);
+
+		mNumSnapshotRecords = (UINT32)replayedEntries.size();
+		mNumAppendedRecords = numRecords - std::min(numRecords, mNumSnapshotRecords);
+
+		// A corrupt tail cannot be appended to, since the following records would never be read
+		mIsValid = !isTruncated;
+		return true;
+	}
+
+	void ProjectLibraryJournal::writeUpdate(const ProjectLibraryJournalEntry& entry)
+	{
+		Vector<UINT8> payload;
+		encodeUpdate(payload, entry);
+
+		appendRecord(mQueuedRecords, payload);
+		mNumQueuedRecords++;
+	}
+
+	void ProjectLibraryJournal::writeRemove(const String& path)
+	{
+		Vector<UINT8> payload;
+		writeJournalValue(payload, (UINT8)JournalRecordType::Remove);
+		writeJournalString(payload, path);
+
+		appendRecord(mQueuedRecords, payload);
+		mNumQueuedRecords++;
+	}
+
+	void ProjectLibraryJournal::flush()
+	{
+		if(mQueuedRecords.empty())
+			return;
+
+		SPtr<DataStream> stream = FileSystem::openFile(mPath, false);
+		if(stream == nullptr)
+		{
+			LOGWRN("Unable to open the project library journal \"" + mPath.toString() + "\" for writing.");
+			return;
+		}
+
+		stream->seek(stream->size());
+		stream->write(mQueuedRecords.data(), mQueuedRecords.size());
+		stream->close();
+
+		mNumAppendedRecords += mNumQueuedRecords;
+		mNumQueuedRecords = 0;
+		mQueuedRecords.clear();
+	}
+
+	void ProjectLibraryJournal::compact(const Vector<ProjectLibraryJournalEntry>& entries)
+	{
+		mQueuedRecords.clear();
+		mNumQueuedRecords = 0;
+
+		Vector<UINT8> data;
+		writeJournalValue(data, MAGIC);
+		writeJournalValue(data, VERSION);
+
+		Vector<UINT8> payload;
+		for(auto& entry : entries)
+		{
+			payload.clear();
+			encodeUpdate(payload, entry);
+
+			appendRecord(data, payload);
+		}
+
+		// Write to a temporary file first so the existing journal remains intact if the write fails
+		Path tempPath = mPath;
+		tempPath.setFilename(mPath.getFilename() + ".tmp");
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(tempPath);
+		if(stream == nullptr)
+		{
+			LOGWRN("Unable to create the project library journal \"" + tempPath.toString() + "\".");
+			return;
+		}
+
+		stream->write(data.data(), data.size());
+		stream->close();
+
+		FileSystem::move(tempPath, mPath, true);
+
+		mNumSnapshotRecords = (UINT32)entries.size();
+		mNumAppendedRecords = 0;
+		mIsValid = true;
+	}
+
+	bool ProjectLibraryJournal::needsCompaction() const
+	{
+		if(!mIsValid)
+			return true;
+
+		return mNumAppendedRecords > std::max(mNumSnapshotRecords, MIN_RECORDS_BEFORE_COMPACTION);
+	}
+
+	String ProjectLibraryJournal::getKey(const String& path)
+	{
+		String key = path;
+		std::replace(key.begin(), key.end(), '\\', '/');
+
+		while(!key.empty() && key.back() == '/')
+			key.pop_back();
+
+		StringUtil::toLowerCase(key);
+		return key;
+	}
+
+	void ProjectLibraryJournal::appendRecord(Vector<UINT8>& buffer, const Vector<UINT8>& payload)
+	{
+		writeJournalValue(buffer, (UINT32)payload.size());
+		writeJournalValue(buffer, ContentHash::hash(payload.data(), payload.size()));
+		buffer.insert(buffer.end(), payload.begin(), payload.end());
+	}
+
+	void ProjectLibraryJournal::encodeUpdate(Vector<UINT8>& payload, const ProjectLibraryJournalEntry& entry)
+	{
+		writeJournalValue(payload, (UINT8)JournalRecordType::Update);
+		writeJournalString(payload, entry.path);
+		writeJournalValue(payload, (UINT8)entry.type);
+		writeJournalValue(payload, (UINT64)entry.lastUpdateTime);
+		writeJournalValue(payload, (UINT64)entry.metaModifiedTime);
+
+		if(entry.meta != nullptr)
+		{
+			SPtr<ProjectFileMeta> meta = stripPreviewIcons(*entry.meta);
+			MemorySerializer serializer;
+
+			UINT32 metaSize = 0;
+			UINT8* metaData = serializer.encode(meta.get(), metaSize);
+
+			writeJournalValue(payload, metaSize);
+			payload.insert(payload.end(), metaData, metaData + metaSize);
+
+			bs_free(metaData);
+		}
+		else
+			writeJournalValue(payload, (UINT32)0);
+	}
+
+	SPtr<ProjectFileMeta> ProjectLibraryJournal::stripPreviewIcons(const ProjectFileMeta& meta)
+	{
+		auto stripIcons = [](const Vector<SPtr<ProjectResourceMeta>>& resourceMetas)
+		{
+			Vector<SPtr<ProjectResourceMeta>> output;
+			output.reserve(resourceMetas.size());
+
+			for(auto& entry : resourceMetas)
+			{
+				SPtr<ProjectResourceMeta> copy = bs_shared_ptr_new<ProjectResourceMeta>(*entry);
+				copy->mPreviewIcons = ProjectResourceIcons();
+				copy->mPreviewIconsSource = Path::BLANK;
+
+				output.push_back(copy);
+			}
+
+			return output;
+		};
+
+		SPtr<ProjectFileMeta> output = bs_shared_ptr_new<ProjectFileMeta>(meta);
+		output->mResourceMetaData = stripIcons(meta.mResourceMetaData);
+		output->mInactiveResourceMetaData = stripIcons(meta.mInactiveResourceMetaData);
+
+		return output;
+	}
+}
@@ -0,0 +1,96 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Library/BsProjectLibrary.h"
+
+namespace bs
+{
+	/** @addtogroup Library-Internal
+	 *  @{
+	 */
+
+	/** State of a single library entry, as stored in the journal. */
+	struct ProjectLibraryJournalEntry
+	{
+		String path; /**< Path to the entry, relative to the resources folder. */
+		ProjectLibrary::LibraryEntryType type = ProjectLibrary::LibraryEntryType::File;
+		std::time_t lastUpdateTime = 0;
+		std::time_t metaModifiedTime = 0; /**< Timestamp of the .meta file at the time @p meta was recorded. */
+		SPtr<ProjectFileMeta> meta;
+	};
+
+	/**
+	 * Persists ProjectLibrary entries as an append-only log of update and remove records. Saving only appends records
+	 * for entries that changed, while loading reads the entire log in a single sequential read and replays it. The log
+	 * is periodically compacted into a snapshot containing a single record per entry.
+	 *
+	 * Each record is check-summed, so a partially written record (e.g. due to a crash during save) is detected and the
+	 * log is replayed only up to that point.
+	 *
+	 * Resource preview icons are not stored in the journal, since they are large and encoding them requires a read-back
+	 * of the texture data. They remain stored in the .meta files instead.
+	 */
+	class ProjectLibraryJournal
+	{
+	public:
+		ProjectLibraryJournal(const Path& path);
+
+		/**
+		 * Reads the journal and replays all of its records.
+		 *
+		 * @param[out]	entries		Final state of all the entries in the journal, sorted so that each directory comes
+		 *							before its children.
+		 * @return					False if the journal doesn't exist or isn't a valid journal file.
+		 */
+		bool read(Vector<ProjectLibraryJournalEntry>& entries);
+
+		/** Queues a record that adds a new entry, or replaces the existing entry with the same path. */
+		void writeUpdate(const ProjectLibraryJournalEntry& entry);
+
+		/** Queues a record that removes the entry at the specified path, and all of its children. */
+		void writeRemove(const String& path);
+
+		/** Appends all queued records to the journal file. */
+		void flush();
+
+		/**
+		 * Replaces the contents of the journal with a snapshot consisting of the provided entries. Any queued records
+		 * are discarded.
+		 */
+		void compact(const Vector<ProjectLibraryJournalEntry>& entries);
+
+		/**
+		 * Checks if the journal should be compacted instead of appended to. This is true if the journal doesn't exist
+		 * yet, is corrupt, or if it grew considerably since the last compaction.
+		 */
+		bool needsCompaction() const;
+
+		/** Converts an entry path into a form usable for comparing paths, by normalizing separators and case. */
+		static String getKey(const String& path);
+
+	private:
+		/** Appends a record with the provided contents to the provided buffer. */
+		static void appendRecord(Vector<UINT8>& buffer, const Vector<UINT8>& payload);
+
+		/** Encodes the update record for the provided entry. */
+		static void encodeUpdate(Vector<UINT8>& payload, const ProjectLibraryJournalEntry& entry);
+
+		/** Creates a copy of the provided meta-data, without any resource preview icons. */
+		static SPtr<ProjectFileMeta> stripPreviewIcons(const ProjectFileMeta& meta);
+
+		static const UINT32 MAGIC;
+		static const UINT32 VERSION;
+		static const UINT32 MIN_RECORDS_BEFORE_COMPACTION;
+
+		Path mPath;
+		Vector<UINT8> mQueuedRecords;
+		UINT32 mNumQueuedRecords = 0;
+		UINT32 mNumSnapshotRecords = 0;
+		UINT32 mNumAppendedRecords = 0;
+		bool mIsValid = false;
+	};
+
+	/** @} */
+}
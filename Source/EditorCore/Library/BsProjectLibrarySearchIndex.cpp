@@ -0,0 +1,260 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Library/BsProjectLibrarySearchIndex.h"
+#include "Library/BsProjectResourceMeta.h"
+
+namespace bs
+{
+	/** Minimum number of entry slots before removed slots are considered for compaction. */
+	static constexpr UINT32 MIN_ENTRIES_BEFORE_COMPACTION = 1024;
+
+	void ProjectLibrarySearchIndex::addEntry(ProjectLibrary::LibraryEntry* entry)
+	{
+		if(mEntryIds.find(entry) != mEntryIds.end())
+			removeEntry(entry);
+
+		IndexedEntry indexedEntry;
+		indexedEntry.entry = entry;
+		indexedEntry.name = entry->elementName;
+		StringUtil::toLowerCase(indexedEntry.name);
+		indexedEntry.trigrams = getTrigrams(indexedEntry.name);
+
+		if(entry->type == ProjectLibrary::LibraryEntryType::File)
+		{
+			ProjectLibrary::FileEntry* fileEntry = static_cast<ProjectLibrary::FileEntry*>(entry);
+			if(fileEntry->meta != nullptr)
+			{
+				for(auto& resMeta : fileEntry->meta->getResourceMetaData())
+				{
+					const UINT32 typeId = resMeta->getTypeID();
+					if(std::find(indexedEntry.typeIds.begin(), indexedEntry.typeIds.end(), typeId) == indexedEntry.typeIds.end())
+						indexedEntry.typeIds.push_back(typeId);
+				}
+			}
+		}
+
+		// Ids only ever increase, so posting lists remain sorted when appending
+		const UINT32 id = (UINT32)mEntries.size();
+		for(auto& trigram : indexedEntry.trigrams)
+			mTrigramPostings[trigram].push_back(id);
+
+		for(auto& typeId : indexedEntry.typeIds)
+			mTypePostings[typeId].push_back(id);
+
+		mEntries.push_back(std::move(indexedEntry));
+		mEntryIds[entry] = id;
+	}
+
+	void ProjectLibrarySearchIndex::removeEntry(ProjectLibrary::LibraryEntry* entry)
+	{
+		const auto iterFind = mEntryIds.find(entry);
+		if(iterFind == mEntryIds.end())
+			return;
+
+		const UINT32 id = iterFind->second;
+		mEntryIds.erase(iterFind);
+
+		IndexedEntry& indexedEntry = mEntries[id];
+		for(auto& trigram : indexedEntry.trigrams)
+		{
+			auto iterPostings = mTrigramPostings.find(trigram);
+			removeId(iterPostings->second, id);
+
+			if(iterPostings->second.empty())
+				mTrigramPostings.erase(iterPostings);
+		}
+
+		for(auto& typeId : indexedEntry.typeIds)
+		{
+			auto iterPostings = mTypePostings.find(typeId);
+			removeId(iterPostings->second, id);
+
+			if(iterPostings->second.empty())
+				mTypePostings.erase(iterPostings);
+		}
+
+		indexedEntry = IndexedEntry();
+
+		if(mEntries.size() > MIN_ENTRIES_BEFORE_COMPACTION && mEntryIds.size() < mEntries.size() / 2)
+			compact();
+	}
+
+	void ProjectLibrarySearchIndex::clear()
+	{
+		mEntries.clear();
+		mEntryIds.clear();
+		mTrigramPostings.clear();
+		mTypePostings.clear();
+	}
+
+	Vector<ProjectLibrary::LibraryEntry*> ProjectLibrarySearchIndex::search(const String& pattern,
+		const Vector<UINT32>& typeIds) const
+	{
+		Vector<ProjectLibrary::LibraryEntry*> output;
+
+		String lowerPattern = pattern;
+		StringUtil::toLowerCase(lowerPattern);
+
+		// Every trigram in the literal parts of the pattern must be present in the matching names
+		Vector<const Vector<UINT32>*> postingLists;
+		const Vector<String> segments = StringUtil::split(lowerPattern, "*");
+		for(auto& segment : segments)
+		{
+			for(auto& trigram : getTrigrams(segment))
+			{
+				const auto iterFind = mTrigramPostings.find(trigram);
+				if(iterFind == mTrigramPostings.end())
+					return output;
+
+				postingLists.push_back(&iterFind->second);
+			}
+		}
+
+		Vector<UINT32> typeCandidates;
+		if(!typeIds.empty())
+		{
+			for(auto& typeId : typeIds)
+			{
+				const auto iterFind = mTypePostings.find(typeId);
+				if(iterFind != mTypePostings.end())
+					typeCandidates.insert(typeCandidates.end(), iterFind->second.begin(), iterFind->second.end());
+			}
+
+			std::sort(typeCandidates.begin(), typeCandidates.end());
+			typeCandidates.erase(std::unique(typeCandidates.begin(), typeCandidates.end()), typeCandidates.end());
+
+			postingLists.push_back(&typeCandidates);
+		}
+
+		auto testCandidate = [&lowerPattern, &output, this](UINT32 id)
+		{
+			const IndexedEntry& indexedEntry = mEntries[id];
+			if(indexedEntry.entry != nullptr && matchWildcard(lowerPattern, indexedEntry.name))
+				output.push_back(indexedEntry.entry);
+		};
+
+		if(postingLists.empty())
+		{
+			// Nothing to narrow the search down with, test all entries
+			for(UINT32 i = 0; i < (UINT32)mEntries.size(); i++)
+				testCandidate(i);
+		}
+		else
+		{
+			// Intersect starting with the smallest list, so the intermediate results remain small
+			std::sort(postingLists.begin(), postingLists.end(),
+				[](const Vector<UINT32>* a, const Vector<UINT32>* b) { return a->size() < b->size(); });
+
+			Vector<UINT32> candidates = *postingLists[0];
+			Vector<UINT32> intersection;
+			for(UINT32 i = 1; i < (UINT32)postingLists.size() && !candidates.empty(); i++)
+			{
+				intersection.clear();
+				std::set_intersection(candidates.begin(), candidates.end(), postingLists[i]->begin(),
+					postingLists[i]->end(), std::back_inserter(intersection));
+
+				std::swap(candidates, intersection);
+			}
+
+			for(auto& id : candidates)
+				testCandidate(id);
+		}
+
+		std::sort(output.begin(), output.end(),
+			[](const ProjectLibrary::LibraryEntry* a, const ProjectLibrary::LibraryEntry* b)
+		{
+			return a->elementName.compare(b->elementName) < 0;
+		});
+
+		return output;
+	}
+
+	bool ProjectLibrarySearchIndex::matchWildcard(const String& pattern, const String& value)
+	{
+		UINT32 patternIdx = 0;
+		UINT32 valueIdx = 0;
+
+		// Position of the last encountered wildcard, and the value position it was matched from
+		UINT32 wildcardIdx = (UINT32)-1;
+		UINT32 wildcardValueIdx = 0;
+
+		const UINT32 patternLength = (UINT32)pattern.size();
+		const UINT32 valueLength = (UINT32)value.size();
+		while(valueIdx < valueLength)
+		{
+			if(patternIdx < patternLength && pattern[patternIdx] == '*')
+			{
+				wildcardIdx = patternIdx++;
+				wildcardValueIdx = valueIdx;
+			}
+			else if(patternIdx < patternLength && pattern[patternIdx] == value[valueIdx])
+			{
+				patternIdx++;
+				valueIdx++;
+			}
+			else if(wildcardIdx != (UINT32)-1)
+			{
+				// Backtrack, letting the last wildcard consume one more character
+				patternIdx = wildcardIdx + 1;
+				valueIdx = ++wildcardValueIdx;
+			}
+			else
+				return false;
+		}
+
+		while(patternIdx < patternLength && pattern[patternIdx] == '*')
+			patternIdx++;
+
+		return patternIdx == patternLength;
+	}
+
+	Vector<UINT32> ProjectLibrarySearchIndex::getTrigrams(const String& value)
+	{
+		Vector<UINT32> output;
+		if(value.size() < 3)
+			return output;
+
+		output.reserve(value.size() - 2);
+		for(UINT32 i = 0; i + 3 <= (UINT32)value.size(); i++)
+		{
+			const UINT32 trigram = (UINT32)(UINT8)value[i] | ((UINT32)(UINT8)value[i + 1] << 8) |
+				((UINT32)(UINT8)value[i + 2] << 16);
+
+			output.push_back(trigram);
+		}
+
+		std::sort(output.begin(), output.end());
+		output.erase(std::unique(output.begin(), output.end()), output.end());
+
+		return output;
+	}
+
+	void ProjectLibrarySearchIndex::removeId(Vector<UINT32>& ids, UINT32 id)
+	{
+		const auto iterFind = std::lower_bound(ids.begin(), ids.end(), id);
+		if(iterFind != ids.end() && *iterFind == id)
+			ids.erase(iterFind);
+	}
+
+	void ProjectLibrarySearchIndex::compact()
+	{
+		Vector<IndexedEntry> entries = std::move(mEntries);
+		clear();
+
+		for(auto& indexedEntry : entries)
+		{
+			if(indexedEntry.entry == nullptr)
+				continue;
+
+			const UINT32 id = (UINT32)mEntries.size();
+			for(auto& trigram : indexedEntry.trigrams)
+				mTrigramPostings[trigram].push_back(id);
+
+			for(auto& typeId : indexedEntry.typeIds)
+				mTypePostings[typeId].push_back(id);
+
+			mEntryIds[indexedEntry.entry] = id;
+			mEntries.push_back(std::move(indexedEntry));
+		}
+	}
+}
@@ -0,0 +1,82 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Library/BsProjectLibrary.h"
+
+namespace bs
+{
+	/** @addtogroup Library-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Index used for quickly searching ProjectLibrary entries by name and resource type. Names are indexed by trigrams
+	 * (sequences of three consecutive characters), so only entries that contain all the trigrams of a search pattern
+	 * need to be tested against it. Resource types are indexed using per-type lists of entries containing resources of
+	 * that type.
+	 *
+	 * Index must be kept up to date by notifying it whenever an entry is added, removed or its meta-data changes.
+	 */
+	class BS_ED_EXPORT ProjectLibrarySearchIndex
+	{
+	public:
+		/**
+		 * Adds a new entry to the index, or updates an existing entry if the entry's name or resource types changed.
+		 * Children of directory entries are not added automatically.
+		 */
+		void addEntry(ProjectLibrary::LibraryEntry* entry);
+
+		/** Removes an entry from the index. Children of directory entries are not removed automatically. */
+		void removeEntry(ProjectLibrary::LibraryEntry* entry);
+
+		/** Removes all entries from the index. */
+		void clear();
+
+		/**
+		 * Searches the index for entries with names matching the provided pattern.
+		 *
+		 * @param[in]	pattern	Pattern to search for. Use wildcard * to match any character(s). Case insensitive.
+		 * @param[in]	typeIds	If not empty, only file entries containing at least one resource with one of the provided
+		 *						RTTI type IDs are returned.
+		 * @return				Entries matching the pattern, sorted by name.
+		 */
+		Vector<ProjectLibrary::LibraryEntry*> search(const String& pattern, const Vector<UINT32>& typeIds) const;
+
+		/** Returns the number of entries in the index. */
+		UINT32 getNumEntries() const { return (UINT32)mEntryIds.size(); }
+
+		/**
+		 * Checks if the value matches the provided pattern, where the * character in the pattern matches any number of
+		 * characters. Comparison is case sensitive.
+		 */
+		static bool matchWildcard(const String& pattern, const String& value);
+
+	private:
+		/** Information about a single entry in the index. */
+		struct IndexedEntry
+		{
+			ProjectLibrary::LibraryEntry* entry = nullptr; /**< Null if the entry was removed. */
+			String name; /**< Lower-case entry name. */
+			Vector<UINT32> trigrams;
+			Vector<UINT32> typeIds;
+		};
+
+		/** Returns unique trigrams of the provided string. */
+		static Vector<UINT32> getTrigrams(const String& value);
+
+		/** Removes an id from a sorted list of ids. */
+		static void removeId(Vector<UINT32>& ids, UINT32 id);
+
+		/** Re-assigns ids to all live entries in order to get rid of removed ones. */
+		void compact();
+
+		Vector<IndexedEntry> mEntries;
+		UnorderedMap<ProjectLibrary::LibraryEntry*, UINT32> mEntryIds;
+		UnorderedMap<UINT32, Vector<UINT32>> mTrigramPostings;
+		UnorderedMap<UINT32, Vector<UINT32>> mTypePostings;
+	};
+
+	/** @} */
+}
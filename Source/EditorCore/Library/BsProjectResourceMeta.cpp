@@ -3,6 +3,8 @@
 #include "Library/BsProjectResourceMeta.h"
 #include "RTTI/BsProjectResourceMetaRTTI.h"
 #include "String/BsUnicode.h"
+#include "FileSystem/BsFileSystem.h"
+#include "Serialization/BsFileSerializer.h"
 
 namespace bs
 {
@@ -29,6 +31,45 @@ namespace bs
 		return meta;
 	}
 
+	const ProjectResourceIcons& ProjectResourceMeta::getPreviewIcons() const
+	{
+		if(!mPreviewIconsSource.isEmpty())
+			loadPreviewIcons();
+
+		return mPreviewIcons;
+	}
+
+	void ProjectResourceMeta::setPreviewIcons(const ProjectResourceIcons& icons)
+	{
+		mPreviewIcons = icons;
+		mPreviewIconsSource = Path::BLANK;
+	}
+
+	void ProjectResourceMeta::loadPreviewIcons() const
+	{
+		const Path metaPath = mPreviewIconsSource;
+		mPreviewIconsSource = Path::BLANK;
+
+		if(!FileSystem::isFile(metaPath))
+			return;
+
+		FileDecoder fs(metaPath);
+		SPtr<IReflectable> loadedMeta = fs.decode();
+
+		if(loadedMeta == nullptr || !loadedMeta->isDerivedFrom(ProjectFileMeta::getRTTIStatic()))
+			return;
+
+		SPtr<ProjectFileMeta> fileMeta = std::static_pointer_cast<ProjectFileMeta>(loadedMeta);
+		for(auto& entry : fileMeta->getAllResourceMetaData())
+		{
+			if(entry->getUUID() == mUUID)
+			{
+				mPreviewIcons = entry->mPreviewIcons;
+				break;
+			}
+		}
+	}
+
 	SPtr<ProjectResourceMeta> ProjectResourceMeta::createEmpty()
 	{
 		return bs_shared_ptr_new<ProjectResourceMeta>(ConstructPrivately());
@@ -59,10 +59,10 @@ namespace bs
 		UINT32 getTypeID() const { return mTypeId; }
 
 		/** @copydoc setPreviewIcons() */
-		const ProjectResourceIcons& getPreviewIcons() const { return mPreviewIcons; }
+		const ProjectResourceIcons& getPreviewIcons() const;
 
 		/* A set of icons used for displaying a preview of the resource's contents. */
-		void setPreviewIcons(const ProjectResourceIcons& icons) { mPreviewIcons = icons; }
+		void setPreviewIcons(const ProjectResourceIcons& icons);
 
 		/** 
 		 * Returns additional data attached to the resource meta by the user. This is non-specific data and can contain
@@ -70,15 +70,36 @@ namespace bs
 		 */
 		SPtr<IReflectable> getUserData() const { return mUserData; }
 
+		/**
+		 * Returns UUIDs of resources directly referenced by this resource, as recorded when the resource was last
+		 * imported. Only valid if hasDependencies() returns true.
+		 */
+		const Vector<UUID>& getDependencies() const { return mDependencies; }
+
+		/** Checks were the referenced resources recorded. False for meta-data from before they were recorded. */
+		bool hasDependencies() const { return mHasDependencies; }
+
 	private:
 		friend class ProjectLibrary;
+		friend class ProjectLibraryJournal;
+
+		/** Loads the preview icons from the .meta file at mPreviewIconsSource. */
+		void loadPreviewIcons() const;
 
 		WString mName;
 		UUID mUUID;
 		SPtr<ResourceMetaData> mResourceMeta;
 		UINT32 mTypeId = 0;
-		ProjectResourceIcons mPreviewIcons;
+		mutable ProjectResourceIcons mPreviewIcons;
 		SPtr<IReflectable> mUserData;
+		Vector<UUID> mDependencies;
+		bool mHasDependencies = false;
+
+		/** 
+		 * Path to the .meta file to load the preview icons from, if they haven't been loaded yet. Set for meta-data
+		 * restored from the library journal, which doesn't store the icons.
+		 */
+		mutable Path mPreviewIconsSource;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
@@ -146,6 +167,15 @@ namespace bs
 		/** Determines if this resource will always be included in the build, regardless if it's being referenced or not. */
 		void setIncludeInBuild(bool include) { mIncludeInBuild = include; }
 
+		/** 
+		 * Returns a fingerprint of the source file contents combined with the import options, as recorded during the 
+		 * last import. Zero if unknown.
+		 */
+		UINT64 getSourceFingerprint() const { return mSourceFingerprint; }
+
+		/** Returns the size of the source file in bytes, as recorded during the last import. Zero if unknown. */
+		UINT64 getSourceSize() const { return mSourceSize; }
+
 		/** Checks does the file contain a resource with the specified type id. */
 		bool hasTypeId(UINT32 typeId) const;
 
@@ -154,11 +184,14 @@ namespace bs
 
 	private:
 		friend class ProjectLibrary;
+		friend class ProjectLibraryJournal;
 
 		Vector<SPtr<ProjectResourceMeta>> mResourceMetaData;
 		Vector<SPtr<ProjectResourceMeta>> mInactiveResourceMetaData;
 		SPtr<ImportOptions> mImportOptions;
 		bool mIncludeInBuild;
+		UINT64 mSourceFingerprint = 0;
+		UINT64 mSourceSize = 0;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
@@ -0,0 +1,147 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Library/BsResourceDependencyGraph.h"
+
+namespace bs
+{
+	void ResourceDependencyGraph::setDependencies(const UUID& dependant, const Vector<UUID>& dependencies)
+	{
+		removeDependencies(dependant);
+
+		if(dependencies.empty())
+			return;
+
+		Node& node = mNodes[dependant];
+		for(auto& dependency : dependencies)
+		{
+			if(dependency == dependant || !node.dependencies.insert(dependency).second)
+				continue;
+
+			mNodes[dependency].dependants.insert(dependant);
+		}
+	}
+
+	void ResourceDependencyGraph::removeDependencies(const UUID& dependant)
+	{
+		const auto iterFind = mNodes.find(dependant);
+		if(iterFind == mNodes.end())
+			return;
+
+		for(auto& dependency : iterFind->second.dependencies)
+		{
+			const auto iterDependency = mNodes.find(dependency);
+			if(iterDependency == mNodes.end())
+				continue;
+
+			iterDependency->second.dependants.erase(dependant);
+			removeIfUnused(iterDependency);
+		}
+
+		iterFind->second.dependencies.clear();
+		removeIfUnused(iterFind);
+	}
+
+	Vector<UUID> ResourceDependencyGraph::getDependants(const UUID& dependency) const
+	{
+		const auto iterFind = mNodes.find(dependency);
+		if(iterFind == mNodes.end())
+			return Vector<UUID>();
+
+		return Vector<UUID>(iterFind->second.dependants.begin(), iterFind->second.dependants.end());
+	}
+
+	Vector<UUID> ResourceDependencyGraph::getDependencies(const UUID& dependant) const
+	{
+		const auto iterFind = mNodes.find(dependant);
+		if(iterFind == mNodes.end())
+			return Vector<UUID>();
+
+		return Vector<UUID>(iterFind->second.dependencies.begin(), iterFind->second.dependencies.end());
+	}
+
+	Vector<UUID> ResourceDependencyGraph::getTransitiveDependants(const Vector<UUID>& resources) const
+	{
+		// Find every resource reachable by following the dependant edges
+		const UnorderedSet<UUID> sources(resources.begin(), resources.end());
+		UnorderedSet<UUID> affected;
+
+		Vector<UUID> todo = resources;
+		while(!todo.empty())
+		{
+			const UUID current = todo.back();
+			todo.pop_back();
+
+			const auto iterFind = mNodes.find(current);
+			if(iterFind == mNodes.end())
+				continue;
+
+			for(auto& dependant : iterFind->second.dependants)
+			{
+				if(sources.find(dependant) == sources.end() && affected.insert(dependant).second)
+					todo.push_back(dependant);
+			}
+		}
+
+		// Sort topologically, only considering dependencies that are part of the affected set
+		UnorderedMap<UUID, UINT32> numPendingDependencies;
+		Vector<UUID> ready;
+		for(auto& entry : affected)
+		{
+			UINT32 numDependencies = 0;
+			for(auto& dependency : mNodes.find(entry)->second.dependencies)
+			{
+				if(affected.find(dependency) != affected.end())
+					numDependencies++;
+			}
+
+			if(numDependencies == 0)
+				ready.push_back(entry);
+			else
+				numPendingDependencies[entry] = numDependencies;
+		}
+
+		Vector<UUID> output;
+		output.reserve(affected.size());
+
+		while(output.size() < affected.size())
+		{
+			// Only happens if there is a cycle, in which case break it by releasing any of the remaining resources
+			if(ready.empty())
+			{
+				const auto iterRelease = numPendingDependencies.begin();
+				ready.push_back(iterRelease->first);
+				numPendingDependencies.erase(iterRelease);
+			}
+
+			const UUID current = ready.back();
+			ready.pop_back();
+
+			output.push_back(current);
+			for(auto& dependant : mNodes.find(current)->second.dependants)
+			{
+				const auto iterPending = numPendingDependencies.find(dependant);
+				if(iterPending == numPendingDependencies.end())
+					continue;
+
+				if(--iterPending->second == 0)
+				{
+					ready.push_back(dependant);
+					numPendingDependencies.erase(iterPending);
+				}
+			}
+		}
+
+		return output;
+	}
+
+	void ResourceDependencyGraph::clear()
+	{
+		mNodes.clear();
+	}
+
+	void ResourceDependencyGraph::removeIfUnused(UnorderedMap<UUID, Node>::iterator iter)
+	{
+		if(iter->second.dependencies.empty() && iter->second.dependants.empty())
+			mNodes.erase(iter);
+	}
+}
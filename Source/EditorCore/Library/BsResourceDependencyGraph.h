@@ -0,0 +1,61 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Library-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Graph of import dependencies between resources, keyed by resource UUID. A resource depends on another if importing
+	 * it requires the other resource (for example a shader depends on the shader includes it uses), meaning it needs to
+	 * be reimported whenever the other resource changes.
+	 *
+	 * The graph is expected to be acyclic. If cycles are present anyway they are broken arbitrarily when ordering
+	 * dependants.
+	 */
+	class ResourceDependencyGraph
+	{
+	public:
+		/** Sets the resources the specified resource depends on, replacing any previously set dependencies. */
+		void setDependencies(const UUID& dependant, const Vector<UUID>& dependencies);
+
+		/** Removes all dependencies of the specified resource. Resources depending on it are not affected. */
+		void removeDependencies(const UUID& dependant);
+
+		/** Returns resources that directly depend on the specified resource. */
+		Vector<UUID> getDependants(const UUID& dependency) const;
+
+		/** Returns resources the specified resource directly depends on. */
+		Vector<UUID> getDependencies(const UUID& dependant) const;
+
+		/**
+		 * Finds all resources that directly or indirectly depend on any of the provided resources. Output is sorted in
+		 * topological order, so every resource comes after all the resources it depends on. Provided resources
+		 * themselves are not included in the output.
+		 */
+		Vector<UUID> getTransitiveDependants(const Vector<UUID>& resources) const;
+
+		/** Removes all resources from the graph. */
+		void clear();
+
+	private:
+		/** Edges of a single resource in the graph. */
+		struct Node
+		{
+			UnorderedSet<UUID> dependencies;
+			UnorderedSet<UUID> dependants;
+		};
+
+		/** Removes the node if it has no edges left. */
+		void removeIfUnused(UnorderedMap<UUID, Node>::iterator iter);
+
+		UnorderedMap<UUID, Node> mNodes;
+	};
+
+	/** @} */
+}
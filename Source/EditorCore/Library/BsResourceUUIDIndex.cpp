@@ -0,0 +1,312 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Library/BsResourceUUIDIndex.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	static_assert(sizeof(UUID) == 16, "UUID is expected to be 16 bytes in size.");
+
+	const UINT32 ResourceUUIDIndex::MAGIC = 0x58444955; // "UIDX"
+	const UINT32 ResourceUUIDIndex::VERSION = 1;
+
+	bool ResourceUUIDIndex::find(const UUID& uuid, String& filePath, String& subresourceName) const
+	{
+		const auto iterFind = mOverlay.find(uuid);
+		if(iterFind != mOverlay.end())
+		{
+			if(iterFind->second.removed)
+				return false;
+
+			filePath = mOverlayStrings[iterFind->second.pathId];
+			subresourceName = mOverlayStrings[iterFind->second.nameId];
+			return true;
+		}
+
+		const Entry* entry = findLoaded(uuid);
+		if(entry == nullptr)
+			return false;
+
+		filePath = getLoadedString(entry->pathId);
+		subresourceName = getLoadedString(entry->nameId);
+		return true;
+	}
+
+	bool ResourceUUIDIndex::contains(const UUID& uuid) const
+	{
+		const auto iterFind = mOverlay.find(uuid);
+		if(iterFind != mOverlay.end())
+			return !iterFind->second.removed;
+
+		return findLoaded(uuid) != nullptr;
+	}
+
+	void ResourceUUIDIndex::set(const UUID& uuid, const String& filePath, const String& subresourceName)
+	{
+		OverlayEntry& entry = mOverlay[uuid];
+		entry.pathId = internOverlayString(filePath);
+		entry.nameId = internOverlayString(subresourceName);
+		entry.removed = false;
+	}
+
+	void ResourceUUIDIndex::remove(const UUID& uuid)
+	{
+		if(findLoaded(uuid) != nullptr)
+			mOverlay[uuid].removed = true;
+		else
+			mOverlay.erase(uuid);
+	}
+
+	UINT32 ResourceUUIDIndex::getNumEntries() const
+	{
+		UINT32 numEntries = mNumEntries;
+		for(auto& entry : mOverlay)
+		{
+			// Removed overlay entries always refer to loaded entries, as others are removed from the overlay directly
+			if(entry.second.removed)
+				numEntries--;
+			else if(findLoaded(entry.first) == nullptr)
+				numEntries++;
+		}
+
+		return numEntries;
+	}
+
+	void ResourceUUIDIndex::clear()
+	{
+		mData.clear();
+		mData.shrink_to_fit();
+
+		mEntries = nullptr;
+		mStringOffsets = nullptr;
+		mStringData = nullptr;
+		mNumEntries = 0;
+		mNumStrings = 0;
+		mStringDataSize = 0;
+
+		mOverlay.clear();
+		mOverlayStrings.clear();
+		mOverlayStringLookup.clear();
+	}
+
+	bool ResourceUUIDIndex::load(const Path& path)
+	{
+		clear();
+
+		SPtr<DataStream> stream = FileSystem::openFile(path, true);
+		if(stream == nullptr)
+			return false;
+
+		mData.resize(stream->size());
+		if(!mData.empty())
+			stream->read(mData.data(), mData.size());
+
+		stream->close();
+
+		if(!parseData())
+		{
+			LOGWRN("Resource UUID index \"" + path.toString() + "\" is not valid and will be rebuilt.");
+
+			clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	void ResourceUUIDIndex::save(const Path& path)
+	{
+		Vector<Entry> entries;
+		entries.reserve(mNumEntries + mOverlay.size());
+
+		Vector<String> strings;
+		UnorderedMap<String, UINT32> stringLookup;
+		auto intern = [&strings, &stringLookup](const String& value)
+		{
+			const auto iterFind = stringLookup.find(value);
+			if(iterFind != stringLookup.end())
+				return iterFind->second;
+
+			const UINT32 id = (UINT32)strings.size();
+			strings.push_back(value);
+			stringLookup[value] = id;
+
+			return id;
+		};
+
+		// Merge the loaded entries with the overlay, overlay entries take precedence
+		for(UINT32 i = 0; i < mNumEntries; i++)
+		{
+			UUID uuid;
+			memcpy(&uuid, mEntries[i].uuid, sizeof(uuid));
+
+			if(mOverlay.find(uuid) != mOverlay.end())
+				continue;
+
+			Entry entry;
+			memcpy(entry.uuid, mEntries[i].uuid, sizeof(entry.uuid));
+			entry.pathId = intern(getLoadedString(mEntries[i].pathId));
+			entry.nameId = intern(getLoadedString(mEntries[i].nameId));
+
+			entries.push_back(entry);
+		}
+
+		for(auto& overlayEntry : mOverlay)
+		{
+			if(overlayEntry.second.removed)
+				continue;
+
+			Entry entry;
+			memcpy(entry.uuid, &overlayEntry.first, sizeof(entry.uuid));
+			entry.pathId = intern(mOverlayStrings[overlayEntry.second.pathId]);
+			entry.nameId = intern(mOverlayStrings[overlayEntry.second.nameId]);
+
+			entries.push_back(entry);
+		}
+
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+		{
+			return memcmp(a.uuid, b.uuid, sizeof(a.uuid)) < 0;
+		});
+
+		// Build the data block: header, entries, string offsets (one extra for the end of the last string), string data
+		Header header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.numEntries = (UINT32)entries.size();
+		header.numStrings = (UINT32)strings.size();
+
+		Vector<UINT32> stringOffsets;
+		stringOffsets.reserve(strings.size() + 1);
+
+		UINT32 stringDataSize = 0;
+		for(auto& entry : strings)
+		{
+			stringOffsets.push_back(stringDataSize);
+			stringDataSize += (UINT32)entry.size();
+		}
+
+		stringOffsets.push_back(stringDataSize);
+
+		Vector<UINT8> data;
+		data.reserve(sizeof(Header) + entries.size() * sizeof(Entry) + stringOffsets.size() * sizeof(UINT32) +
+			stringDataSize);
+
+		const UINT8* headerData = (const UINT8*)&header;
+		data.insert(data.end(), headerData, headerData + sizeof(header));
+
+		const UINT8* entryData = (const UINT8*)entries.data();
+		data.insert(data.end(), entryData, entryData + entries.size() * sizeof(Entry));
+
+		const UINT8* offsetData = (const UINT8*)stringOffsets.data();
+		data.insert(data.end(), offsetData, offsetData + stringOffsets.size() * sizeof(UINT32));
+
+		for(auto& entry : strings)
+			data.insert(data.end(), entry.begin(), entry.end());
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if(stream != nullptr)
+		{
+			stream->write(data.data(), data.size());
+			stream->close();
+		}
+		else
+			LOGWRN("Unable to save the resource UUID index to \"" + path.toString() + "\".");
+
+		// The merged block becomes the new base for queries
+		mOverlay.clear();
+		mOverlayStrings.clear();
+		mOverlayStringLookup.clear();
+
+		mData = std::move(data);
+		parseData();
+	}
+
+	const ResourceUUIDIndex::Entry* ResourceUUIDIndex::findLoaded(const UUID& uuid) const
+	{
+		if(mNumEntries == 0)
+			return nullptr;
+
+		UINT8 key[16];
+		memcpy(key, &uuid, sizeof(key));
+
+		const Entry* end = mEntries + mNumEntries;
+		const Entry* iterFind = std::lower_bound(mEntries, end, key, [](const Entry& entry, const UINT8* value)
+		{
+			return memcmp(entry.uuid, value, sizeof(entry.uuid)) < 0;
+		});
+
+		if(iterFind == end || memcmp(iterFind->uuid, key, sizeof(key)) != 0)
+			return nullptr;
+
+		return iterFind;
+	}
+
+	String ResourceUUIDIndex::getLoadedString(UINT32 id) const
+	{
+		if(id >= mNumStrings)
+			return StringUtil::BLANK;
+
+		const UINT32 start = mStringOffsets[id];
+		const UINT32 end = mStringOffsets[id + 1];
+		if(start > end || end > mStringDataSize)
+			return StringUtil::BLANK;
+
+		return String(mStringData + start, end - start);
+	}
+
+	UINT32 ResourceUUIDIndex::internOverlayString(const String& value)
+	{
+		const auto iterFind = mOverlayStringLookup.find(value);
+		if(iterFind != mOverlayStringLookup.end())
+			return iterFind->second;
+
+		const UINT32 id = (UINT32)mOverlayStrings.size();
+		mOverlayStrings.push_back(value);
+		mOverlayStringLookup[value] = id;
+
+		return id;
+	}
+
+	bool ResourceUUIDIndex::parseData()
+	{
+		mEntries = nullptr;
+		mStringOffsets = nullptr;
+		mStringData = nullptr;
+		mNumEntries = 0;
+		mNumStrings = 0;
+		mStringDataSize = 0;
+
+		const UINT64 size = mData.size();
+		if(size < sizeof(Header))
+			return false;
+
+		Header header;
+		memcpy(&header, mData.data(), sizeof(header));
+
+		if(header.magic != MAGIC || header.version != VERSION)
+			return false;
+
+		const UINT64 entriesOffset = sizeof(Header);
+		const UINT64 offsetsOffset = entriesOffset + (UINT64)header.numEntries * sizeof(Entry);
+		const UINT64 stringsOffset = offsetsOffset + ((UINT64)header.numStrings + 1) * sizeof(UINT32);
+		if(stringsOffset > size)
+			return false;
+
+		const UINT32* stringOffsets = (const UINT32*)(mData.data() + offsetsOffset);
+		const UINT32 stringDataSize = stringOffsets[header.numStrings];
+		if(stringsOffset + stringDataSize > size)
+			return false;
+
+		mEntries = (const Entry*)(mData.data() + entriesOffset);
+		mStringOffsets = stringOffsets;
+		mStringData = (const char*)(mData.data() + stringsOffset);
+		mNumEntries = header.numEntries;
+		mNumStrings = header.numStrings;
+		mStringDataSize = stringDataSize;
+
+		return true;
+	}
+}
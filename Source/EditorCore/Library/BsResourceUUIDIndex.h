@@ -0,0 +1,113 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Library-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Maps resource UUIDs to the files they are stored in, and the names of the sub-resources within those files.
+	 *
+	 * The bulk of the index is kept in a single memory block with the same layout as the index file: a sorted array of
+	 * fixed size entries followed by a table of interned path strings. The block is read from disk in one go and queried
+	 * directly using binary search, without any deserialization. Modifications made after the index was loaded are kept
+	 * in a small overlay, and are merged into the main block when the index is saved.
+	 */
+	class ResourceUUIDIndex
+	{
+	public:
+		/**
+		 * Finds the file the resource with the specified UUID is stored in.
+		 *
+		 * @param[in]	uuid				UUID of the resource to look up.
+		 * @param[out]	filePath			Path to the file containing the resource, as provided to set().
+		 * @param[out]	subresourceName		Name of the sub-resource within the file, or empty for the primary resource.
+		 * @return							True if the UUID was found.
+		 */
+		bool find(const UUID& uuid, String& filePath, String& subresourceName) const;
+
+		/** Checks does the index contain the specified UUID. */
+		bool contains(const UUID& uuid) const;
+
+		/** Registers a resource with the specified UUID, or updates the location of an existing resource. */
+		void set(const UUID& uuid, const String& filePath, const String& subresourceName);
+
+		/** Removes the resource with the specified UUID from the index. */
+		void remove(const UUID& uuid);
+
+		/** Returns the number of resources in the index. */
+		UINT32 getNumEntries() const;
+
+		/** Checks if the index was modified since it was last loaded or saved. */
+		bool isDirty() const { return !mOverlay.empty(); }
+
+		/** Removes all entries from the index. */
+		void clear();
+
+		/** Loads the index from the specified file. Returns false if the file doesn't exist or isn't valid. */
+		bool load(const Path& path);
+
+		/** Saves the index to the specified file. Any modifications made since loading are merged in. */
+		void save(const Path& path);
+
+	private:
+		/** Fixed size entry, as stored in the index data block. */
+		struct Entry
+		{
+			UINT8 uuid[16];
+			UINT32 pathId;
+			UINT32 nameId;
+		};
+
+		/** Header at the start of the index data block. */
+		struct Header
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 numEntries;
+			UINT32 numStrings;
+		};
+
+		/** Modification made since the index was loaded. */
+		struct OverlayEntry
+		{
+			UINT32 pathId = 0; /**< Index into mOverlayStrings. */
+			UINT32 nameId = 0; /**< Index into mOverlayStrings. */
+			bool removed = false;
+		};
+
+		/** Finds an entry in the loaded index data block using binary search. Returns null if not found. */
+		const Entry* findLoaded(const UUID& uuid) const;
+
+		/** Returns an interned string from the loaded index data block. */
+		String getLoadedString(UINT32 id) const;
+
+		/** Interns a string for use by overlay entries and returns its id. */
+		UINT32 internOverlayString(const String& value);
+
+		/** Validates the loaded data block and sets up pointers to its sections. */
+		bool parseData();
+
+		static const UINT32 MAGIC;
+		static const UINT32 VERSION;
+
+		Vector<UINT8> mData;
+		const Entry* mEntries = nullptr;
+		const UINT32* mStringOffsets = nullptr;
+		const char* mStringData = nullptr;
+		UINT32 mNumEntries = 0;
+		UINT32 mNumStrings = 0;
+		UINT32 mStringDataSize = 0;
+
+		UnorderedMap<UUID, OverlayEntry> mOverlay;
+		Vector<String> mOverlayStrings;
+		UnorderedMap<String, UINT32> mOverlayStringLookup;
+	};
+
+	/** @} */
+}
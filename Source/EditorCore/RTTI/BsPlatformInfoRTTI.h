@@ -24,6 +24,11 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(windowedWidth, 4)
 			BS_RTTI_MEMBER_PLAIN(windowedHeight, 5)
 			BS_RTTI_MEMBER_PLAIN(debug, 6)
+			BS_RTTI_MEMBER_PLAIN(packResources, 7)
+			BS_RTTI_MEMBER_PLAIN(compressTextures, 8)
+			BS_RTTI_MEMBER_PLAIN(textureMipsToSkip, 9)
+			BS_RTTI_MEMBER_PLAIN(stripMeshTangents, 10)
+			BS_RTTI_MEMBER_PLAIN(stripCPUCachedData, 11)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -170,7 +170,7 @@ namespace bs
 					memory = rttiReadElem(*childResEntry, memory);
 
 					childResEntry->parent = &data;
-					data.mChildren.push_back(childResEntry);
+					data.addChild(childResEntry);
 				}
 				else if(childType == bs::ProjectLibrary::LibraryEntryType::Directory)
 				{
@@ -178,7 +178,7 @@ namespace bs
 					memory = rttiReadElem(*childDirEntry, memory);
 
 					childDirEntry->parent = &data;
-					data.mChildren.push_back(childDirEntry);
+					data.addChild(childDirEntry);
 				}
 			}
 
@@ -26,15 +26,19 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mTypeId, 2)
 			BS_RTTI_MEMBER_REFLPTR(mResourceMeta, 3)
 			BS_RTTI_MEMBER_REFLPTR(mUserData, 4)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mDependencies, 13)
+			BS_RTTI_MEMBER_PLAIN(mHasDependencies, 14)
 		BS_END_RTTI_MEMBERS
 
 		// We want to store textures directly in this object rather than referencing them externally, so we need to strip
-		// away resource handles before saving them, and restore afterwards
+		// away resource handles before saving them, and restore afterwards. Icons not loaded yet are loaded first, so
+		// they don't get lost when the meta-data is saved again.
 #define GETTER_SETTER_ICON(icon)																						\
 		SPtr<Texture> get##icon(ProjectResourceMeta* obj)																\
 		{																												\
-			if(obj->mPreviewIcons.icon.isLoaded(false))																	\
-				return obj->mPreviewIcons.icon.getInternalPtr();														\
+			const ProjectResourceIcons& icons = obj->getPreviewIcons();													\
+			if(icons.icon.isLoaded(false))																				\
+				return icons.icon.getInternalPtr();																		\
 																														\
 			return nullptr;																								\
 		}																												\
@@ -99,6 +103,8 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mIncludeInBuild, 4)
 			BS_RTTI_MEMBER_REFLPTR_ARRAY(mResourceMetaData, 5)
 			BS_RTTI_MEMBER_REFLPTR_ARRAY(mInactiveResourceMetaData, 6)
+			BS_RTTI_MEMBER_PLAIN(mSourceFingerprint, 7)
+			BS_RTTI_MEMBER_PLAIN(mSourceSize, 8)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -0,0 +1,122 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsVector4.h"
+#include "Image/BsColor.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Editor-Internal
+	 *  @{
+	 */
+
+	/** Unit shapes that gizmos are drawn with. Each gizmo shape is an instance of one of these, with its own transform. */
+	enum class GizmoPrimitive
+	{
+		SolidCube, SolidSphere, SolidCone, SolidDisc, WireCube, WireSphere, WireCone, WireDisc, WireArc, Count
+	};
+
+	/** Data of a single instance of a gizmo primitive, in the exact layout it is provided to the GPU in. */
+	struct GizmoInstance
+	{
+		Matrix4 transform; /**< Transforms the unit primitive into world space. */
+		Vector4 params; /**< x, y - arc start and length in radians. z - 1 for arcs. w - 1 if the gizmo is pickable. */
+		UINT32 color; /**< Gizmo color in RGBA format. */
+	};
+
+	/** Vertices and indices of a unit gizmo primitive. */
+	struct GizmoPrimitiveGeometry
+	{
+		Vector<Vector3> positions;
+		Vector<Vector3> normals; /**< Only provided for solid primitives. */
+		Vector<UINT32> indices; /**< Triangle list for solid primitives and line list for wire primitives. */
+	};
+
+	/**
+	 * Assembles per-instance data for gizmo primitives on the CPU, grouped by primitive so each group can be rendered with
+	 * a single instanced draw call.
+	 *
+	 * Unit primitives are centered at the origin and have a radius of one, with discs, cones and arcs facing the positive
+	 * Z axis. Cones extend from their base at the origin to their tip at Z = 1. Arc vertices store their relative
+	 * position along the arc in X, which the vertex program maps onto the unit circle using the instance parameters.
+	 */
+	class BS_ED_EXPORT GizmoInstanceBuffer
+	{
+	public:
+		/**
+		 * Registers a new instance of a primitive.
+		 *
+		 * @param[in]	primitive	Type of the primitive to draw.
+		 * @param[in]	transform	Transform from the unit primitive into world space.
+		 * @param[in]	color		Color to draw the primitive with.
+		 * @param[in]	gizmoIdx	Index of the gizmo the primitive belongs to, used for picking.
+		 * @param[in]	pickable	Determines is the instance rendered during picking.
+		 * @param[in]	startAngle	Angle at which the arc starts. Only relevant for arcs.
+		 * @param[in]	amountAngle	Length of the arc. Only relevant for arcs.
+		 */
+		void add(GizmoPrimitive primitive, const Matrix4& transform, const Color& color, UINT32 gizmoIdx, bool pickable,
+			Degree startAngle = Degree(0.0f), Degree amountAngle = Degree(0.0f));
+
+		/** Removes all instances. */
+		void clear();
+
+		/** Returns all instances of the specified primitive, in the order they were added. */
+		const Vector<GizmoInstance>& getInstances(GizmoPrimitive primitive) const
+		{
+			return mInstances[(UINT32)primitive];
+		}
+
+		/** Returns gizmo indices of all instances of the specified primitive, in the same order as getInstances(). */
+		const Vector<UINT32>& getGizmoIndices(GizmoPrimitive primitive) const
+		{
+			return mGizmoIndices[(UINT32)primitive];
+		}
+
+		/** Returns the total number of instances of all primitives. */
+		UINT32 getNumInstances() const;
+
+		/**
+		 * Generates per-instance colors for the picking pass.
+		 *
+		 * @param[in]	primitive			Primitive whose instances to generate the colors for.
+		 * @param[in]	idxToColorCallback	Callback that assigns a unique color to each gizmo index.
+		 * @param[out]	output				Colors in RGBA format, in the same order as getInstances().
+		 */
+		void getPickingColors(GizmoPrimitive primitive, const std::function<Color(UINT32)>& idxToColorCallback,
+			Vector<UINT32>& output) const;
+
+		/** Returns the transform that maps the unit cube onto an axis aligned cuboid. */
+		static Matrix4 getCubeTransform(const Vector3& position, const Vector3& extents);
+
+		/** Returns the transform that maps the unit sphere onto a sphere. */
+		static Matrix4 getSphereTransform(const Vector3& position, float radius);
+
+		/** Returns the transform that maps the unit cone onto a cone. */
+		static Matrix4 getConeTransform(const Vector3& base, const Vector3& normal, float height, float radius,
+			const Vector2& scale);
+
+		/** Returns the transform that maps the unit disc or arc onto a disc or arc with the specified orientation. */
+		static Matrix4 getDiscTransform(const Vector3& position, const Vector3& normal, float radius);
+
+		/** Checks is the primitive rendered as solid geometry, or as lines. */
+		static bool isSolid(GizmoPrimitive primitive);
+
+		/** Generates the geometry of a unit primitive. */
+		static void generateGeometry(GizmoPrimitive primitive, GizmoPrimitiveGeometry& output);
+
+	private:
+		/**
+		 * Returns a transform whose Z axis points along the normal, with the remaining axes derived from the normal so
+		 * that arc angles are measured consistently. Each axis is scaled by the matching component of @p scale.
+		 */
+		static Matrix4 getOrientedTransform(const Vector3& position, const Vector3& normal, const Vector3& scale);
+
+		Vector<GizmoInstance> mInstances[(UINT32)GizmoPrimitive::Count];
+		Vector<UINT32> mGizmoIndices[(UINT32)GizmoPrimitive::Count];
+	};
+
+	/** @} */
+}
@@ -11,6 +11,7 @@
 #include "Utility/BsDrawHelper.h"
 #include "Renderer/BsParamBlocks.h"
 #include "Renderer/BsRendererExtension.h"
+#include "Scene/BsGizmoInstanceBuffer.h"
 
 namespace bs
 {
@@ -46,9 +47,34 @@ namespace bs
 		 */
 		void startGizmo(const HSceneObject& gizmoParent);
 
-		/**	Ends gizmo creation. Must be called after a matching startGizmo(). */
+		/**
+		 * Starts creation of a retained gizmo. Works like startGizmo() except that the draw calls issued until the
+		 * matching endGizmo() are cached. Later calls with the same key re-emit the cached draw calls as long as the
+		 * world transform of the parent scene object and the provided version remain the same, and the geometry of the
+		 * cached draw calls is kept in persistent meshes instead of being rebuilt every frame.
+		 *
+		 * @param[in]	gizmoParent	Scene object this gizmo is attached to. Selecting the gizmo will select this scene object.
+		 * @param[in]	key			Unique identifier of the gizmo, for example the instance ID of the component it draws.
+		 * @param[in]	version		Value that must change whenever any state the gizmo depends on changes, other than the
+		 *							parent scene object's transform.
+		 * @return					True if the gizmo needs to be drawn. False if the cached draw calls were emitted instead,
+		 *							in which case no draw calls should be issued. Must be followed by a matching endGizmo()
+		 *							in both cases.
+		 */
+		bool startRetainedGizmo(const HSceneObject& gizmoParent, UINT64 key, UINT64 version);
+
+		/**	Ends gizmo creation. Must be called after a matching startGizmo() or startRetainedGizmo(). */
 		void endGizmo();
 
+		/**
+		 * Discards the cached draw calls of a retained gizmo, ensuring it gets drawn on the next call to
+		 * startRetainedGizmo() with the same key.
+		 */
+		void invalidateRetainedGizmo(UINT64 key);
+
+		/** Discards the cached draw calls and persistent meshes of all retained gizmos. */
+		void clearRetainedGizmos();
+
 		/**	Changes the color of any further gizmo draw calls. */
 		void setColor(const Color& color);
 
@@ -240,6 +266,12 @@ namespace bs
 		 */
 		HSceneObject getSceneObject(UINT32 gizmoIdx);
 
+		/** Returns the number of gizmos drawn since the last call to clearGizmos(). */
+		UINT32 getNumGizmos() const { return mCurrentIdx; }
+
+		/** Checks are there any gizmos that can be selected by the user. */
+		bool hasPickableGizmos() const;
+
 		/** @name Internal
 		 *  @{
 		 */
@@ -371,6 +403,56 @@ namespace bs
 			UINT32 fontSize;
 		};
 
+		/** Draw calls issued by a single retained gizmo, grouped by gizmo type. */
+		struct RetainedDrawCalls
+		{
+			Vector<CubeData> solidCubes;
+			Vector<CubeData> wireCubes;
+			Vector<SphereData> solidSpheres;
+			Vector<SphereData> wireSpheres;
+			Vector<ConeData> solidCones;
+			Vector<ConeData> wireCones;
+			Vector<LineData> lines;
+			Vector<LineListData> lineLists;
+			Vector<DiscData> solidDiscs;
+			Vector<DiscData> wireDiscs;
+			Vector<WireArcData> wireArcs;
+			Vector<WireMeshData> wireMeshes;
+			Vector<FrustumData> frustums;
+			Vector<IconData> icons;
+			Vector<TextData> text;
+		};
+
+		/**
+		 * Draw call of a retained gizmo issued in the current frame, referencing the cached draw call rather than
+		 * holding a copy of its data.
+		 */
+		struct RetainedDrawCallRef
+		{
+			UINT64 key; /**< Key of the retained gizmo. */
+			UINT32 drawCallIdx; /**< Index of the draw call in the gizmo's RetainedDrawCalls list of its type. */
+			UINT32 idx; /**< Index of the draw call in the current frame, as with CommonData::idx. */
+		};
+
+		/** Cached state of a gizmo started through startRetainedGizmo(). */
+		struct RetainedGizmo
+		{
+			RetainedDrawCalls drawCalls;
+			Matrix4 worldTransform;
+			UINT64 version;
+			UINT64 lastUsedFrame;
+			UINT32 batchIdx;
+		};
+
+		/** A group of retained gizmos whose geometry is stored in the same set of persistent meshes. */
+		struct RetainedBatch
+		{
+			DrawHelper* drawHelper;
+			Vector<DrawHelper::ShapeMeshData> meshes;
+			Vector<UINT64> gizmos;
+			bool dirty;
+		};
+
 		/**	Stores how many icons use a specific texture. */
 		struct IconRenderData
 		{
@@ -404,6 +486,16 @@ namespace bs
 			SPtr<ct::Material> textMat;
 			SPtr<ct::Material> pickingMat;
 			SPtr<ct::Material> alphaPickingMat;
+			SPtr<ct::Material> instancedSolidMat;
+			SPtr<ct::Material> instancedLineMat;
+			SPtr<ct::Material> instancedPickingMat;
+			SPtr<ct::Mesh> primitiveMeshes[(UINT32)GizmoPrimitive::Count];
+		};
+
+		/** Per-instance picking colors of gizmo primitives, in the same order as in GizmoInstanceBuffer. */
+		struct InstancePickingData
+		{
+			Vector<UINT32> colors[(UINT32)GizmoPrimitive::Count];
 		};
 
 		typedef Vector<IconRenderData> IconRenderDataVec;
@@ -443,6 +535,46 @@ namespace bs
 		void calculateIconColors(const Color& tint, const SPtr<Camera>& camera, UINT32 iconHeight, bool fixedScale,
 			Color& normalColor, Color& fadedColor);
 
+		/** Appends copies of cached draw calls to the current frame's gizmo data, assigning them new indices. */
+		template<class T>
+		void emitRetained(const Vector<T>& drawCalls, Vector<T>& output);
+
+		/**
+		 * Appends references to cached draw calls of the retained gizmo with the provided key to the current frame's
+		 * gizmo data, assigning them new indices. Used for draw calls that are expensive to copy.
+		 */
+		void emitRetainedRefs(UINT64 key, UINT32 count, Vector<RetainedDrawCallRef>& output);
+
+		/**
+		 * Returns the cached draw call referenced by @p ref, from the provided list of the gizmo's draw calls. Returns
+		 * null if the gizmo was discarded or re-recorded since the reference was emitted.
+		 */
+		template<class T>
+		const T* findRetained(const RetainedDrawCallRef& ref, Vector<T> RetainedDrawCalls::* drawCalls) const;
+
+		/** Checks is any of the referenced cached draw calls pickable. */
+		template<class T>
+		bool containsPickableRetained(const Vector<RetainedDrawCallRef>& refs, 
+			Vector<T> RetainedDrawCalls::* drawCalls) const;
+
+		/** Registers instances for all cube, sphere, cone, disc and arc gizmos drawn since the last clearGizmos(). */
+		void queueInstances(GizmoInstanceBuffer& output) const;
+
+		/**
+		 * Queues cached draw calls of a retained gizmo to the provided draw helper. Only shapes that aren't drawn as
+		 * instanced primitives are queued.
+		 */
+		void queueRetained(DrawHelper& drawHelper, const RetainedDrawCalls& drawCalls);
+
+		/**
+		 * Discards retained gizmos that weren't started since the last call to clearGizmos(), and rebuilds persistent
+		 * meshes for any batches whose contents changed.
+		 */
+		void updateRetainedBatches();
+
+		/** Removes a retained gizmo from its batch, marking the batch for rebuild. */
+		void removeFromBatch(UINT64 key, RetainedGizmo& gizmo);
+
 		static const UINT32 VERTEX_BUFFER_GROWTH;
 		static const UINT32 INDEX_BUFFER_GROWTH;
 		static const UINT32 SPHERE_QUALITY;
@@ -450,6 +582,7 @@ namespace bs
 		static const float MAX_ICON_RANGE;
 		static const UINT32 OPTIMAL_ICON_SIZE;
 		static const float ICON_TEXEL_WORLD_SIZE;
+		static const UINT32 RETAINED_BATCH_SIZE;
 
 		typedef Set<IconData, std::function<bool(const IconData&, const IconData&)>> IconSet;
 
@@ -479,16 +612,26 @@ namespace bs
 		Vector<FrustumData> mFrustumData;
 		Vector<IconData> mIconData;
 		Vector<TextData> mTextData;
+		Vector<RetainedDrawCallRef> mRetainedLineLists;
+		Vector<RetainedDrawCallRef> mRetainedWireMeshes;
+		Vector<RetainedDrawCallRef> mRetainedText;
 		Map<UINT32, HSceneObject> mIdxToSceneObjectMap;
 
+		UnorderedMap<UINT64, RetainedGizmo> mRetainedGizmos;
+		Vector<RetainedBatch> mRetainedBatches;
+		RetainedGizmo* mRecordedGizmo;
+		UINT64 mFrameIdx;
+
 		Vector<DrawHelper::ShapeMeshData> mActiveMeshes;
 
 		SPtr<Mesh> mIconMesh;
+		SPtr<GizmoInstanceBuffer> mInstances;
 
 		SPtr<ct::GizmoRenderer> mGizmoRenderer;
 
 		// Immutable
 		SPtr<VertexDataDesc> mIconVertexDesc;
+		SPtr<Mesh> mPrimitiveMeshes[(UINT32)GizmoPrimitive::Count];
 
 		// Transient
 		struct SortedIconData
@@ -551,12 +694,26 @@ namespace bs
 		 * @param[in]	meshes				Meshes to render.
 		 * @param[in]	iconMesh			Mesh containing icon meshes.
 		 * @param[in]	iconRenderData		Icon render data outlining which parts of the icon mesh use which textures.
+		 * @param[in]	pickingData			Picking colors for the instanced primitives provided to the last
+		 *									updateData() call. Only relevant when rendering with picking materials.
 		 * @param[in]	usePickingMaterial	If true, meshes will be rendered using a special picking materials, otherwise
 		 *									they'll be rendered using normal drawing materials.
 		 */
 		void renderData(const SPtr<Camera>& camera, Vector<GizmoManager::MeshRenderData>& meshes, 
 			const SPtr<MeshBase>& iconMesh, const GizmoManager::IconRenderDataVecPtr& iconRenderData, 
-			bool usePickingMaterial);
+			const SPtr<GizmoManager::InstancePickingData>& pickingData, bool usePickingMaterial);
+
+		/**
+		 * Renders all instanced gizmo primitives provided to the last updateData() call, issuing one draw call per
+		 * primitive type. Expects the relevant parameter block buffer to already be populated.
+		 *
+		 * @param[in]	pickingData			Picking colors for each instance. Only relevant for picking.
+		 * @param[in]	usePickingMaterial	Should the primitives be rendered normally or for picking.
+		 */
+		void renderInstances(const SPtr<GizmoManager::InstancePickingData>& pickingData, bool usePickingMaterial);
+
+		/** Writes per-instance data into a vertex buffer, recreating the buffer if it is too small to hold it. */
+		static void writeInstanceData(SPtr<VertexBuffer>& buffer, UINT32 vertexSize, UINT32 count, const void* data);
 
 		/**
 		 * Renders the icon gizmo mesh using the provided parameters.
@@ -577,17 +734,21 @@ namespace bs
 		 * @param[in]	meshes			Meshes to render.
 		 * @param[in]	iconMesh		Mesh containing icon meshes.
 		 * @param[in]	iconRenderData	Icon render data outlining which parts of the icon mesh use which textures.
+		 * @param[in]	instances		Instances of gizmo primitives to render.
 		 */
 		void updateData(const SPtr<Camera>& camera, const Vector<GizmoManager::MeshRenderData>& meshes, 
-			const SPtr<MeshBase>& iconMesh,  const GizmoManager::IconRenderDataVecPtr& iconRenderData);
+			const SPtr<MeshBase>& iconMesh,  const GizmoManager::IconRenderDataVecPtr& iconRenderData,
+			const SPtr<GizmoInstanceBuffer>& instances);
 
 		static const float PICKING_ALPHA_CUTOFF;
+		static const UINT32 MIN_INSTANCE_BUFFER_SIZE;
 
 		SPtr<Camera> mCamera;
 
 		Vector<GizmoManager::MeshRenderData> mMeshes;
 		SPtr<MeshBase> mIconMesh;
 		GizmoManager::IconRenderDataVecPtr mIconRenderData;
+		SPtr<GizmoInstanceBuffer> mInstances;
 
 		Vector<SPtr<GpuParamsSet>> mMeshParamSets[(UINT32)GizmoMeshType::Count];
 		Vector<SPtr<GpuParamsSet>> mIconParamSets;
@@ -598,10 +759,23 @@ namespace bs
 		SPtr<GpuParamBlockBuffer> mMeshPickingParamBuffer;
 		SPtr<GpuParamBlockBuffer> mIconPickingParamBuffer;
 
+		SPtr<VertexBuffer> mInstanceBuffers[(UINT32)GizmoPrimitive::Count];
+		SPtr<VertexBuffer> mInstancePickingBuffers[(UINT32)GizmoPrimitive::Count];
+		SPtr<GpuParamsSet> mInstancedParamSets[2];
+		SPtr<GpuParamsSet> mInstancedPickingParamSet;
+
 		// Immutable
 		SPtr<Material> mMeshMaterials[(UINT32)GizmoMeshType::Count];
 		SPtr<Material> mIconMaterial;
 		SPtr<Material> mPickingMaterials[2];
+
+		// Indexed by 0 for solid and 1 for wire primitives
+		SPtr<Material> mInstancedMaterials[2];
+		SPtr<VertexDeclaration> mInstanceDeclarations[2];
+		SPtr<VertexDeclaration> mInstancePickingDeclarations[2];
+
+		SPtr<Material> mInstancedPickingMaterial;
+		SPtr<Mesh> mPrimitiveMeshes[(UINT32)GizmoPrimitive::Count];
 	};
 
 	/** @} */
@@ -0,0 +1,116 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "Math/BsAABox.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Editor
+	 *  @{
+	 */
+
+	/** Object hit by a ray cast against a SceneBVH. */
+	struct SceneBVHRayHit
+	{
+		UINT32 id; /**< Identifier of the object, as returned by SceneBVH::add(). */
+		float distance; /**< Distance along the ray at which the ray enters the object bounds. */
+	};
+
+	/**
+	 * Bounding volume hierarchy over a set of axis aligned boxes, used for quickly finding scene objects intersecting a
+	 * ray or a volume.
+	 *
+	 * The hierarchy is persistent. Moving an object refits only the nodes above it, while added and removed objects are
+	 * tracked separately until enough of them accumulate to warrant a rebuild. Rebuilds happen lazily on the next query.
+	 */
+	class BS_ED_EXPORT SceneBVH
+	{
+		/** Single node in the hierarchy. Leaf nodes reference a range of objects, other nodes have exactly two children. */
+		struct Node
+		{
+			AABox bounds;
+			UINT32 parent;
+			UINT32 children; /**< Index of the first child. The second child immediately follows it. */
+			UINT32 start; /**< First entry in mLeafObjects referenced by the leaf. */
+			UINT32 count; /**< Number of objects referenced by the leaf, zero for non-leaf nodes. */
+		};
+
+		/** Single object registered with the hierarchy. */
+		struct Object
+		{
+			AABox bounds;
+			UINT32 node; /**< Leaf node containing the object, or INVALID_INDEX if not yet part of the hierarchy. */
+			bool active;
+		};
+
+	public:
+		/** Registers a new object with the provided world bounds. Returns an identifier used for referencing the object. */
+		UINT32 add(const AABox& bounds);
+
+		/** Updates the world bounds of an existing object. */
+		void update(UINT32 id, const AABox& bounds);
+
+		/** Removes an object from the hierarchy. Its identifier may be reused by objects added later. */
+		void remove(UINT32 id);
+
+		/** Removes all objects from the hierarchy. */
+		void clear();
+
+		/** Returns the bounds of an object, as last provided to add() or update(). */
+		const AABox& getBounds(UINT32 id) const { return mObjects[id].bounds; }
+
+		/** Returns the number of objects registered with the hierarchy. */
+		UINT32 getNumObjects() const { return mNumActive; }
+
+		/**
+		 * Finds all objects whose bounds are intersected by the ray.
+		 *
+		 * @param[in]	ray		Ray to test, in world space.
+		 * @param[out]	output	Objects hit by the ray, sorted from nearest to farthest.
+		 */
+		void rayCast(const Ray& ray, Vector<SceneBVHRayHit>& output);
+
+		/**
+		 * Finds all objects whose bounds intersect the volume.
+		 *
+		 * @param[in]	volume	Volume to test, in world space. Plane normals are expected to point inwards.
+		 * @param[out]	output	Identifiers of objects intersecting the volume, in no particular order.
+		 */
+		void intersect(const ConvexVolume& volume, Vector<UINT32>& output);
+
+		/** Rebuilds the hierarchy from scratch, including all added and removed objects. */
+		void rebuild();
+
+		/**
+		 * Tests a ray against a box. Returns true if they intersect, in which case distance receives the distance along the
+		 * ray at which it enters the box, or zero if the ray starts inside the box.
+		 */
+		static bool intersects(const Ray& ray, const AABox& box, float& distance);
+
+	private:
+		/** Rebuilds the hierarchy if enough objects were added or removed since the last build. */
+		void rebuildIfNeeded();
+
+		/** Builds a sub-tree over the objects in the provided range of mLeafObjects, storing it in the provided node. */
+		void build(UINT32 nodeIdx, UINT32 start, UINT32 end);
+
+		/** Recalculates the bounds of the node and its ancestors. */
+		void refit(UINT32 nodeIdx);
+
+		static const UINT32 MAX_OBJECTS_PER_LEAF;
+		static const UINT32 INVALID_INDEX;
+
+		Vector<Object> mObjects;
+		Vector<Node> mNodes;
+		Vector<UINT32> mLeafObjects;
+		Vector<UINT32> mPending;
+		Vector<UINT32> mFreeIds;
+		Vector<UINT32> mRemoved;
+		UINT32 mNumActive = 0;
+		UINT32 mNumUpdated = 0;
+	};
+
+	/** @} */
+}
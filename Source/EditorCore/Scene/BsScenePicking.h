@@ -5,8 +5,11 @@
 #include "BsEditorPrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Math/BsMatrix4.h"
+#include "Math/BsVector2I.h"
 #include "RenderAPI/BsGpuParam.h"
 #include "Renderer/BsParamBlocks.h"
+#include "Scene/BsSceneBVH.h"
+#include "Threading/BsAsyncOp.h"
 
 namespace bs
 {
@@ -24,20 +27,81 @@ namespace bs
 	/** Contains the results of a scene picking action. */
 	struct PickResults
 	{
-		Vector<UINT32> objects;
+		Vector<UINT32> objects; /**< Full 32-bit identifiers of the picked elements, sorted by the area they cover. */
 		Vector3 normal;
 		float depth;
 	};
 
+	/** Single element found by a scene picking action. */
+	struct PickedElement
+	{
+		HSceneObject sceneObject; /**< Scene object the element belongs to. */
+
+		/**
+		 * Sub-mesh of the scene object's renderable that was picked, or ScenePicking::WHOLE_OBJECT if the pick only
+		 * identified the object. Area picks resolved from bounds and gizmos always report the whole object.
+		 */
+		UINT32 subMesh;
+	};
+
 	namespace ct { class ScenePicking; }
 
-	/**	Handles picking of scene objects with a pointer in scene view. */
+	/** Picking operation started with ScenePicking::pickObjectsAsync(). */
+	class BS_ED_EXPORT ScenePickOperation
+	{
+	public:
+		/** Checks have the results of the operation become available. */
+		bool isComplete() const { return mIsComplete; }
+
+		/** Returns the picked scene objects, in the same order as ScenePicking::pickObjects(). Valid once complete. */
+		const Vector<HSceneObject>& getObjects() const { return mObjects; }
+
+		/**
+		 * Returns the picked elements, in the same order as the objects. Unlike getObjects() a scene object can appear
+		 * multiple times, once for each of its sub-meshes that was picked. Valid once complete.
+		 */
+		const Vector<PickedElement>& getElements() const { return mElements; }
+
+		/**
+		 * Returns the position and normal under the pointer, in the same form as ScenePicking::pickObjects(). Valid once
+		 * complete, if the operation was started with snap data requested.
+		 */
+		const SnapData& getSnapData() const { return mSnapData; }
+
+	private:
+		friend class ScenePicking;
+
+		bool mIsComplete = false;
+		Vector<HSceneObject> mObjects;
+		Vector<PickedElement> mElements;
+		SnapData mSnapData;
+		std::function<void(const ScenePickOperation&)> mCallback;
+
+		// State of the rendered part of the pick, if any
+		bool mGatherSnapData = false;
+		AsyncOp mAsyncOp;
+		SPtr<Camera> mCamera;
+		Vector2I mPosition;
+		Vector<PickedElement> mIndexToElement;
+		Vector<PickedElement> mCPUElements;
+	};
+
+	/**
+	 * Handles picking of scene objects with a pointer in scene view.
+	 *
+	 * Renderables are tracked in a bounding volume hierarchy that is kept up to date between picks. Single point picks
+	 * cast a ray against the hierarchy and then against the triangles of the candidate meshes, and area picks find all
+	 * renderables whose bounds intersect the selected area. Both happen on the CPU without waiting on the core thread.
+	 * Picking falls back to rendering the candidates with unique colors and reading them back only for meshes without CPU
+	 * cached data. Gizmos are always picked by rendering them.
+	 */
 	class BS_ED_EXPORT ScenePicking : public Module<ScenePicking>
 	{
-		/**	Contains information about a single pickable item (mesh). */
+		/**	Contains information about a single pickable item (sub-mesh). */
 		struct RenderablePickData
 		{
 			SPtr<ct::Mesh> mesh;
+			UINT32 subMesh;
 			UINT32 index;
 			Matrix4 wvpTransform;
 			bool alpha;
@@ -49,6 +113,9 @@ namespace bs
 		ScenePicking();
 		~ScenePicking();
 
+		/** Sub-mesh index reported by PickedElement when a pick identifies a scene object but not its sub-mesh. */
+		static const UINT32 WHOLE_OBJECT;
+
 		/**
 		 * Attempts to find a single nearest scene object under the provided position and area.
 		 *
@@ -79,18 +146,117 @@ namespace bs
 		Vector<HSceneObject> pickObjects(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area, 
 			Vector<HSceneObject>& ignoreRenderables, SnapData* data = nullptr);
 
+		/**
+		 * Starts finding all scene objects under the provided position and area, without waiting for the results. Picks
+		 * that can be resolved on the CPU complete immediately, while picks that need to render the scene complete a frame
+		 * or two later, once the core thread has rendered and read them back.
+		 *
+		 * @param[in]	cam					Camera to perform the picking from.
+		 * @param[in]	position			Pointer position relative to the camera viewport, in pixels.
+		 * @param[in]	area				Width/height of the checked area in pixels. Use (1, 1) if you want the exact
+		 *									position under the pointer.
+		 * @param[in]	ignoreRenderables	A list of objects that should be ignored during scene picking.
+		 * @param[in]	callback			Optional callback triggered from update() once the results are available. Always
+		 *									triggered after this method returns, even if the pick completes immediately.
+		 * @param[in]	gatherSnapData		Determines should the operation record the position and normal under the
+		 *									pointer.
+		 * @return							Operation that can be polled for the results.
+		 */
+		SPtr<ScenePickOperation> pickObjectsAsync(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area,
+			const Vector<HSceneObject>& ignoreRenderables, 
+			const std::function<void(const ScenePickOperation&)>& callback = nullptr, bool gatherSnapData = false);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Completes asynchronous picks whose results have become available, and triggers their callbacks. Must be called
+		 * once per frame.
+		 *
+		 * @note	Internal method.
+		 */
+		void update();
+
+		/** @} */
+
 	private:
 		friend class ct::ScenePicking;
 
 		typedef Set<RenderablePickData, std::function<bool(const RenderablePickData&, const RenderablePickData&)>> RenderableSet;
 
-		/**	Encodes a pickable object identifier to a unique color. */
+		/** Renderable registered with the picking hierarchy. */
+		struct PickableRenderable
+		{
+			HRenderable renderable;
+			HMesh mesh;
+			Matrix4 worldTransform;
+			UINT32 transformHash; /**< SceneObject::getTransformHash() at the time the transform was recorded. */
+			UINT32 hierarchyId;
+			UINT64 lastUpdateFrame; /**< Last frame the renderable was found in the scene. */
+		};
+
+		/**
+		 * Registers new renderables with the picking hierarchy, refits ones whose transform or mesh changed and removes
+		 * destroyed ones.
+		 */
+		void updateHierarchy();
+
+		/** Returns the world space bounds of the renderable's mesh. */
+		static AABox getWorldBounds(const PickableRenderable& entry);
+
+		/**
+		 * Picks the scene, on the CPU where possible. Completes the operation if no rendering is needed, otherwise queues
+		 * the rendering on the core thread and leaves the operation to be completed by completePick().
+		 */
+		SPtr<ScenePickOperation> startPick(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area,
+			const Vector<HSceneObject>& ignoreRenderables, bool gatherSnapData);
+
+		/**
+		 * Queues rendering of the provided renderables along with any pickable gizmos, each with a unique color, followed
+		 * by a readback of the colors under the picked area.
+		 *
+		 * @param[in]	operation		Operation to store the rendering state in.
+		 * @param[in]	cam				Camera to perform the picking from.
+		 * @param[in]	position		Pointer position relative to the camera viewport, in pixels.
+		 * @param[in]	area			Width/height of the checked area in pixels.
+		 * @param[in]	candidates		Hierarchy identifiers of the renderables to render.
+		 */
+		void queueRenderedPick(ScenePickOperation& operation, const SPtr<Camera>& cam, const Vector2I& position,
+			const Vector2I& area, const Vector<UINT32>& candidates);
+
+		/**
+		 * Completes an operation queued with queueRenderedPick() by translating the read back colors into scene objects.
+		 * The core thread must have finished processing the operation.
+		 */
+		void completePick(ScenePickOperation& operation);
+
+		/** Builds a world space volume containing everything visible through the provided area of the viewport. */
+		static ConvexVolume getPickVolume(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area);
+
+		/** Stores the elements and the unique scene objects they belong to as the results of the operation. */
+		static void setResults(ScenePickOperation& operation, const Vector<PickedElement>& elements);
+
+		/**
+		 * Encodes a pickable object identifier to a unique color. All four 8-bit channels are used, so any 32-bit
+		 * identifier except NO_OBJECT_INDEX can be encoded.
+		 */
 		static Color encodeIndex(UINT32 index);
 
 		/** Decodes a color into a unique object identifier. Color should have initially been encoded with encodeIndex(). */
 		static UINT32 decodeIndex(Color color);
 
+		/** Identifier of the color the picking target is cleared to, meaning no object was rendered at that pixel. */
+		static const UINT32 NO_OBJECT_INDEX;
+
 		ct::ScenePicking* mCore;
+
+		SceneBVH mHierarchy;
+		UnorderedMap<UINT64, PickableRenderable> mRenderables;
+		Vector<UINT64> mHierarchyIdToRenderable;
+		UINT64 mLastUpdateFrame = (UINT64)-1;
+
+		Vector<SPtr<ScenePickOperation>> mPendingOperations;
 	};
 
 	/** @} */
@@ -151,9 +317,31 @@ namespace bs
 	private:
 		friend class bs::ScenePicking;
 
+		/** Render texture used for a picking pass, along with the properties it was created with. */
+		struct PickingTarget
+		{
+			UINT32 width;
+			UINT32 height;
+			PixelFormat colorFormat;
+			PixelFormat depthFormat;
+			SPtr<RenderTexture> renderTexture;
+			UINT64 lastUsed;
+		};
+
+		/**
+		 * Returns a render texture with color, normals and depth surfaces of the provided size and formats. Targets are
+		 * pooled, so repeated picks in viewports of the same size reuse them without any allocations.
+		 */
+		SPtr<RenderTexture> getPickingTarget(UINT32 width, UINT32 height, PixelFormat colorFormat,
+			PixelFormat depthFormat);
+
 		static const float ALPHA_CUTOFF;
+		static const UINT32 MAX_POOLED_TARGETS;
+		static const UINT64 POOLED_TARGET_LIFETIME; /**< Number of picks after which an unused target is released. */
 
 		SPtr<RenderTexture> mPickingTexture;
+		Vector<PickingTarget> mTargetPool;
+		UINT64 mNumPicks = 0;
 
 		SPtr<Material> mMaterials[6];
 		Vector<SPtr<GpuParamsSet>> mParamSets[6];
@@ -0,0 +1,324 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Scene/BsGizmoInstanceBuffer.h"
+#include "Math/BsQuaternion.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	static_assert(sizeof(GizmoInstance) == 84, "GizmoInstance must be tightly packed as it is copied directly to the GPU.");
+
+	/** Number of line segments used for approximating circles. */
+	static const UINT32 CIRCLE_SEGMENTS = 32;
+
+	/** Number of line segments used for approximating arcs. */
+	static const UINT32 ARC_SEGMENTS = 32;
+
+	/** Number of horizontal bands the solid sphere is split into. */
+	static const UINT32 SPHERE_RINGS = 12;
+
+	/** Number of vertical slices the solid sphere is split into. */
+	static const UINT32 SPHERE_SEGMENTS = 24;
+
+	/** Returns a point on the unit circle in the XY plane. */
+	static Vector3 getCirclePoint(UINT32 segment, UINT32 numSegments)
+	{
+		float angle = Math::TWO_PI * segment / (float)numSegments;
+		return Vector3(Math::cos(angle), Math::sin(angle), 0.0f);
+	}
+
+	/** Appends a unit circle lying in the plane spanned by the two provided axes, as a closed list of lines. */
+	static void addWireCircle(GizmoPrimitiveGeometry& output, UINT32 axis0, UINT32 axis1)
+	{
+		UINT32 start = (UINT32)output.positions.size();
+		for (UINT32 i = 0; i < CIRCLE_SEGMENTS; i++)
+		{
+			Vector3 point = getCirclePoint(i, CIRCLE_SEGMENTS);
+
+			Vector3 position = Vector3::ZERO;
+			position[axis0] = point.x;
+			position[axis1] = point.y;
+
+			output.positions.push_back(position);
+			output.indices.push_back(start + i);
+			output.indices.push_back(start + (i + 1) % CIRCLE_SEGMENTS);
+		}
+	}
+
+	/** Appends a unit disc in the XY plane, as a triangle fan with the provided normal. */
+	static void addSolidDisc(GizmoPrimitiveGeometry& output, const Vector3& normal)
+	{
+		UINT32 center = (UINT32)output.positions.size();
+		output.positions.push_back(Vector3::ZERO);
+		output.normals.push_back(normal);
+
+		for (UINT32 i = 0; i < CIRCLE_SEGMENTS; i++)
+		{
+			output.positions.push_back(getCirclePoint(i, CIRCLE_SEGMENTS));
+			output.normals.push_back(normal);
+
+			output.indices.push_back(center);
+			output.indices.push_back(center + 1 + i);
+			output.indices.push_back(center + 1 + (i + 1) % CIRCLE_SEGMENTS);
+		}
+	}
+
+	void GizmoInstanceBuffer::add(GizmoPrimitive primitive, const Matrix4& transform, const Color& color,
+		UINT32 gizmoIdx, bool pickable, Degree startAngle, Degree amountAngle)
+	{
+		GizmoInstance instance;
+		instance.transform = transform;
+		instance.color = color.getAsRGBA();
+
+		if (primitive == GizmoPrimitive::WireArc)
+			instance.params = Vector4(startAngle.valueRadians(), amountAngle.valueRadians(), 1.0f, 0.0f);
+		else
+			instance.params = Vector4::ZERO;
+
+		instance.params.w = pickable ? 1.0f : 0.0f;
+
+		mInstances[(UINT32)primitive].push_back(instance);
+		mGizmoIndices[(UINT32)primitive].push_back(gizmoIdx);
+	}
+
+	void GizmoInstanceBuffer::clear()
+	{
+		for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+		{
+			mInstances[i].clear();
+			mGizmoIndices[i].clear();
+		}
+	}
+
+	UINT32 GizmoInstanceBuffer::getNumInstances() const
+	{
+		UINT32 numInstances = 0;
+		for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+			numInstances += (UINT32)mInstances[i].size();
+
+		return numInstances;
+	}
+
+	void GizmoInstanceBuffer::getPickingColors(GizmoPrimitive primitive,
+		const std::function<Color(UINT32)>& idxToColorCallback, Vector<UINT32>& output) const
+	{
+		const Vector<UINT32>& gizmoIndices = mGizmoIndices[(UINT32)primitive];
+
+		output.resize(gizmoIndices.size());
+		for (UINT32 i = 0; i < (UINT32)gizmoIndices.size(); i++)
+			output[i] = idxToColorCallback(gizmoIndices[i]).getAsRGBA();
+	}
+
+	Matrix4 GizmoInstanceBuffer::getCubeTransform(const Vector3& position, const Vector3& extents)
+	{
+		return Matrix4::TRS(position, Quaternion::IDENTITY, extents);
+	}
+
+	Matrix4 GizmoInstanceBuffer::getSphereTransform(const Vector3& position, float radius)
+	{
+		return Matrix4::TRS(position, Quaternion::IDENTITY, Vector3(radius, radius, radius));
+	}
+
+	Matrix4 GizmoInstanceBuffer::getConeTransform(const Vector3& base, const Vector3& normal, float height, float radius,
+		const Vector2& scale)
+	{
+		return getOrientedTransform(base, normal, Vector3(radius * scale.x, radius * scale.y, height));
+	}
+
+	Matrix4 GizmoInstanceBuffer::getDiscTransform(const Vector3& position, const Vector3& normal, float radius)
+	{
+		return getOrientedTransform(position, normal, Vector3(radius, radius, radius));
+	}
+
+	Matrix4 GizmoInstanceBuffer::getOrientedTransform(const Vector3& position, const Vector3& normal,
+		const Vector3& scale)
+	{
+		Vector3 zAxis = Vector3::normalize(normal);
+
+		Vector3 xAxis;
+		if (Math::abs(zAxis.dot(Vector3::UNIT_Z)) <= 0.95f)
+			xAxis = zAxis.cross(Vector3::UNIT_Z);
+		else
+			xAxis = zAxis.cross(Vector3::UNIT_Y);
+
+		xAxis.normalize();
+		Vector3 yAxis = zAxis.cross(xAxis);
+
+		return Matrix4(
+			xAxis.x * scale.x, yAxis.x * scale.y, zAxis.x * scale.z, position.x,
+			xAxis.y * scale.x, yAxis.y * scale.y, zAxis.y * scale.z, position.y,
+			xAxis.z * scale.x, yAxis.z * scale.y, zAxis.z * scale.z, position.z,
+			0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	bool GizmoInstanceBuffer::isSolid(GizmoPrimitive primitive)
+	{
+		switch (primitive)
+		{
+		case GizmoPrimitive::SolidCube:
+		case GizmoPrimitive::SolidSphere:
+		case GizmoPrimitive::SolidCone:
+		case GizmoPrimitive::SolidDisc:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void GizmoInstanceBuffer::generateGeometry(GizmoPrimitive primitive, GizmoPrimitiveGeometry& output)
+	{
+		output.positions.clear();
+		output.normals.clear();
+		output.indices.clear();
+
+		switch (primitive)
+		{
+		case GizmoPrimitive::SolidCube:
+			// Separate vertices for each face, so each can have its own normal
+			for (UINT32 axis = 0; axis < 3; axis++)
+			{
+				UINT32 tangentAxis = (axis + 1) % 3;
+				UINT32 bitangentAxis = (axis + 2) % 3;
+
+				for (float sign : { -1.0f, 1.0f })
+				{
+					Vector3 normal = Vector3::ZERO;
+					normal[axis] = sign;
+
+					UINT32 start = (UINT32)output.positions.size();
+					const float corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+					for (auto& corner : corners)
+					{
+						Vector3 position = normal;
+						position[tangentAxis] = corner[0];
+						position[bitangentAxis] = corner[1];
+
+						output.positions.push_back(position);
+						output.normals.push_back(normal);
+					}
+
+					output.indices.insert(output.indices.end(),
+						{ start, start + 1, start + 2, start, start + 2, start + 3 });
+				}
+			}
+			break;
+		case GizmoPrimitive::SolidSphere:
+			for (UINT32 ring = 0; ring <= SPHERE_RINGS; ring++)
+			{
+				float polar = Math::PI * ring / (float)SPHERE_RINGS;
+				for (UINT32 segment = 0; segment <= SPHERE_SEGMENTS; segment++)
+				{
+					float azimuth = Math::TWO_PI * segment / (float)SPHERE_SEGMENTS;
+					Vector3 position(
+						Math::sin(polar) * Math::cos(azimuth),
+						Math::sin(polar) * Math::sin(azimuth),
+						Math::cos(polar));
+
+					output.positions.push_back(position);
+					output.normals.push_back(position);
+				}
+			}
+
+			for (UINT32 ring = 0; ring < SPHERE_RINGS; ring++)
+			{
+				UINT32 top = ring * (SPHERE_SEGMENTS + 1);
+				UINT32 bottom = top + SPHERE_SEGMENTS + 1;
+
+				for (UINT32 segment = 0; segment < SPHERE_SEGMENTS; segment++)
+				{
+					output.indices.insert(output.indices.end(),
+					{
+						top + segment, bottom + segment, bottom + segment + 1,
+						top + segment, bottom + segment + 1, top + segment + 1
+					});
+				}
+			}
+			break;
+		case GizmoPrimitive::SolidCone:
+			// Sides, with a separate tip vertex per segment so the normals follow the slope
+			for (UINT32 i = 0; i < CIRCLE_SEGMENTS; i++)
+			{
+				Vector3 point = getCirclePoint(i, CIRCLE_SEGMENTS);
+
+				output.positions.push_back(point);
+				output.normals.push_back(Vector3::normalize(Vector3(point.x, point.y, 1.0f)));
+			}
+
+			for (UINT32 i = 0; i < CIRCLE_SEGMENTS; i++)
+			{
+				Vector3 point = getCirclePoint(i * 2 + 1, CIRCLE_SEGMENTS * 2);
+
+				output.positions.push_back(Vector3::UNIT_Z);
+				output.normals.push_back(Vector3::normalize(Vector3(point.x, point.y, 1.0f)));
+
+				output.indices.push_back(i);
+				output.indices.push_back((i + 1) % CIRCLE_SEGMENTS);
+				output.indices.push_back(CIRCLE_SEGMENTS + i);
+			}
+
+			addSolidDisc(output, -Vector3::UNIT_Z);
+			break;
+		case GizmoPrimitive::SolidDisc:
+			addSolidDisc(output, Vector3::UNIT_Z);
+			break;
+		case GizmoPrimitive::WireCube:
+			// Corner index bits represent positive X, Y and Z sides
+			for (UINT32 i = 0; i < 8; i++)
+			{
+				output.positions.push_back(Vector3(
+					(i & 1) ? 1.0f : -1.0f,
+					(i & 2) ? 1.0f : -1.0f,
+					(i & 4) ? 1.0f : -1.0f));
+			}
+
+			for (UINT32 i = 0; i < 8; i++)
+			{
+				for (UINT32 bit = 1; bit < 8; bit <<= 1)
+				{
+					if ((i & bit) != 0)
+						continue;
+
+					output.indices.push_back(i);
+					output.indices.push_back(i | bit);
+				}
+			}
+			break;
+		case GizmoPrimitive::WireSphere:
+			addWireCircle(output, 0, 1);
+			addWireCircle(output, 0, 2);
+			addWireCircle(output, 1, 2);
+			break;
+		case GizmoPrimitive::WireCone:
+		{
+			addWireCircle(output, 0, 1);
+
+			UINT32 tip = (UINT32)output.positions.size();
+			output.positions.push_back(Vector3::UNIT_Z);
+
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				output.indices.push_back(i * CIRCLE_SEGMENTS / 4);
+				output.indices.push_back(tip);
+			}
+		}
+			break;
+		case GizmoPrimitive::WireDisc:
+			addWireCircle(output, 0, 1);
+			break;
+		case GizmoPrimitive::WireArc:
+			for (UINT32 i = 0; i <= ARC_SEGMENTS; i++)
+			{
+				output.positions.push_back(Vector3(i / (float)ARC_SEGMENTS, 0.0f, 0.0f));
+
+				if (i > 0)
+				{
+					output.indices.push_back(i - 1);
+					output.indices.push_back(i);
+				}
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
@@ -18,6 +18,8 @@
 #include "Renderer/BsRendererUtility.h"
 #include "Renderer/BsRendererManager.h"
 #include "Utility/BsDrawHelper.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "RenderAPI/BsVertexDeclaration.h"
 
 using namespace std::placeholders;
 
@@ -28,11 +30,41 @@ namespace bs
 	const float GizmoManager::MAX_ICON_RANGE = 500.0f;
 	const UINT32 GizmoManager::OPTIMAL_ICON_SIZE = 64;
 	const float GizmoManager::ICON_TEXEL_WORLD_SIZE = 0.05f;
+	const UINT32 GizmoManager::RETAINED_BATCH_SIZE = 256;
+
+	/**
+	 * Creates the vertex layout used for rendering gizmo primitives. Stream 0 contains the unit primitive geometry,
+	 * stream 1 the per-instance data in the GizmoInstance layout and stream 2 per-instance picking colors.
+	 *
+	 * @param[in]	solid		Determines is the layout for solid primitives, which also require normals.
+	 * @param[in]	numStreams	Number of streams to include, in range [1, 3].
+	 */
+	static SPtr<VertexDataDesc> createPrimitiveVertexDesc(bool solid, UINT32 numStreams)
+	{
+		SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+
+		if (solid)
+			vertexDesc->addVertElem(VET_FLOAT3, VES_NORMAL);
+
+		if (numStreams > 1)
+		{
+			// Transform rows, followed by instance parameters
+			for (UINT32 i = 0; i < 5; i++)
+				vertexDesc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 1 + i, 1, 1);
+
+			vertexDesc->addVertElem(VET_COLOR, VES_COLOR, 1, 1, 1);
+		}
+
+		if (numStreams > 2)
+			vertexDesc->addVertElem(VET_COLOR, VES_COLOR, 2, 2, 1);
+
+		return vertexDesc;
+	}
 
 	GizmoManager::GizmoManager()
 		: mPickable(false), mCurrentIdx(0), mTransformDirty(false), mColorDirty(false), mDrawHelper(nullptr)
-		, mPickingDrawHelper(nullptr)
-		
+		, mPickingDrawHelper(nullptr), mRecordedGizmo(nullptr), mFrameIdx(0)
 	{
 		mTransform = Matrix4::IDENTITY;
 		mDrawHelper = bs_new<DrawHelper>();
@@ -51,6 +83,9 @@ namespace bs
 		HMaterial textMaterial = BuiltinEditorResources::instance().createTextGizmoMat();
 		HMaterial pickingMaterial = BuiltinEditorResources::instance().createGizmoPickingMat();
 		HMaterial alphaPickingMaterial = BuiltinEditorResources::instance().createAlphaGizmoPickingMat();
+		HMaterial instancedSolidMaterial = BuiltinEditorResources::instance().createInstancedSolidGizmoMat();
+		HMaterial instancedLineMaterial = BuiltinEditorResources::instance().createInstancedLineGizmoMat();
+		HMaterial instancedPickingMaterial = BuiltinEditorResources::instance().createInstancedGizmoPickingMat();
 
 		CoreInitData initData;
 
@@ -61,6 +96,43 @@ namespace bs
 		initData.textMat = textMaterial->getCore();
 		initData.pickingMat = pickingMaterial->getCore();
 		initData.alphaPickingMat = alphaPickingMaterial->getCore();
+		initData.instancedSolidMat = instancedSolidMaterial->getCore();
+		initData.instancedLineMat = instancedLineMaterial->getCore();
+		initData.instancedPickingMat = instancedPickingMaterial->getCore();
+
+		// Unit primitives that all cube, sphere, cone, disc and arc gizmos are rendered as instances of
+		for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+		{
+			bool solid = GizmoInstanceBuffer::isSolid((GizmoPrimitive)i);
+
+			GizmoPrimitiveGeometry geometry;
+			GizmoInstanceBuffer::generateGeometry((GizmoPrimitive)i, geometry);
+
+			UINT32 numVertices = (UINT32)geometry.positions.size();
+			UINT32 numIndices = (UINT32)geometry.indices.size();
+
+			SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(numVertices, numIndices,
+				createPrimitiveVertexDesc(solid, 1));
+
+			auto positionIter = meshData->getVec3DataIter(VES_POSITION);
+			for (auto& position : geometry.positions)
+				positionIter.addValue(position);
+
+			if (solid)
+			{
+				auto normalIter = meshData->getVec3DataIter(VES_NORMAL);
+				for (auto& normal : geometry.normals)
+					normalIter.addValue(normal);
+			}
+
+			memcpy(meshData->getIndices32(), geometry.indices.data(), numIndices * sizeof(UINT32));
+
+			MESH_DESC meshDesc;
+			meshDesc.subMeshes.push_back(SubMesh(0, numIndices, solid ? DOT_TRIANGLE_LIST : DOT_LINE_LIST));
+
+			mPrimitiveMeshes[i] = Mesh::_createPtr(meshData, meshDesc);
+			initData.primitiveMeshes[i] = mPrimitiveMeshes[i]->getCore();
+		}
 
 		mGizmoRenderer = RendererExtension::create<ct::GizmoRenderer>(initData);
 	}
@@ -68,6 +140,7 @@ namespace bs
 	GizmoManager::~GizmoManager()
 	{
 		mActiveMeshes.clear();
+		clearRetainedGizmos();
 
 		bs_delete(mDrawHelper);
 		bs_delete(mPickingDrawHelper);
@@ -91,9 +164,106 @@ namespace bs
 		}
 	}
 
+	bool GizmoManager::startRetainedGizmo(const HSceneObject& gizmoParent, UINT64 key, UINT64 version)
+	{
+		startGizmo(gizmoParent);
+
+		const Matrix4& worldTransform = gizmoParent->getWorldMatrix();
+
+		auto iterFind = mRetainedGizmos.find(key);
+		if (iterFind != mRetainedGizmos.end())
+		{
+			RetainedGizmo& gizmo = iterFind->second;
+			gizmo.lastUsedFrame = mFrameIdx;
+
+			if (gizmo.version == version && gizmo.worldTransform == worldTransform)
+			{
+				const RetainedDrawCalls& drawCalls = gizmo.drawCalls;
+
+				emitRetained(drawCalls.solidCubes, mSolidCubeData);
+				emitRetained(drawCalls.wireCubes, mWireCubeData);
+				emitRetained(drawCalls.solidSpheres, mSolidSphereData);
+				emitRetained(drawCalls.wireSpheres, mWireSphereData);
+				emitRetained(drawCalls.solidCones, mSolidConeData);
+				emitRetained(drawCalls.wireCones, mWireConeData);
+				emitRetained(drawCalls.lines, mLineData);
+				emitRetainedRefs(key, (UINT32)drawCalls.lineLists.size(), mRetainedLineLists);
+				emitRetained(drawCalls.solidDiscs, mSolidDiscData);
+				emitRetained(drawCalls.wireDiscs, mWireDiscData);
+				emitRetained(drawCalls.wireArcs, mWireArcData);
+				emitRetainedRefs(key, (UINT32)drawCalls.wireMeshes.size(), mRetainedWireMeshes);
+				emitRetained(drawCalls.frustums, mFrustumData);
+				emitRetained(drawCalls.icons, mIconData);
+				emitRetainedRefs(key, (UINT32)drawCalls.text.size(), mRetainedText);
+
+				return false;
+			}
+
+			gizmo.drawCalls = RetainedDrawCalls();
+			mRetainedBatches[gizmo.batchIdx].dirty = true;
+
+			mRecordedGizmo = &gizmo;
+		}
+		else
+		{
+			// Newer batches are the ones most likely to have free space, so search from the back
+			UINT32 batchIdx = (UINT32)mRetainedBatches.size();
+			for (UINT32 i = batchIdx; i > 0; i--)
+			{
+				if (mRetainedBatches[i - 1].gizmos.size() < RETAINED_BATCH_SIZE)
+				{
+					batchIdx = i - 1;
+					break;
+				}
+			}
+
+			if (batchIdx == (UINT32)mRetainedBatches.size())
+			{
+				mRetainedBatches.push_back(RetainedBatch());
+				mRetainedBatches.back().drawHelper = bs_new<DrawHelper>();
+			}
+
+			RetainedBatch& batch = mRetainedBatches[batchIdx];
+			batch.gizmos.push_back(key);
+			batch.dirty = true;
+
+			RetainedGizmo& gizmo = mRetainedGizmos[key];
+			gizmo.lastUsedFrame = mFrameIdx;
+			gizmo.batchIdx = batchIdx;
+
+			mRecordedGizmo = &gizmo;
+		}
+
+		mRecordedGizmo->version = version;
+		mRecordedGizmo->worldTransform = worldTransform;
+
+		return true;
+	}
+
 	void GizmoManager::endGizmo()
 	{
 		mActiveSO = nullptr;
+		mRecordedGizmo = nullptr;
+	}
+
+	void GizmoManager::invalidateRetainedGizmo(UINT64 key)
+	{
+		auto iterFind = mRetainedGizmos.find(key);
+		if (iterFind == mRetainedGizmos.end())
+			return;
+
+		removeFromBatch(key, iterFind->second);
+		mRetainedGizmos.erase(iterFind);
+	}
+
+	void GizmoManager::clearRetainedGizmos()
+	{
+		for (auto& batch : mRetainedBatches)
+			bs_delete(batch.drawHelper);
+
+		mRetainedBatches.clear();
+		mRetainedGizmos.clear();
+		mRecordedGizmo = nullptr;
 	}
 
 	void GizmoManager::setColor(const Color& color)
@@ -125,7 +295,9 @@ namespace bs
 		cubeData.sceneObject = mActiveSO;
 		cubeData.pickable = mPickable;
 
-		mDrawHelper->cube(position, extents);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.solidCubes.push_back(cubeData);
+
 		mIdxToSceneObjectMap[cubeData.idx] = mActiveSO;
 	}
 
@@ -142,7 +314,9 @@ namespace bs
 		sphereData.sceneObject = mActiveSO;
 		sphereData.pickable = mPickable;
 
-		mDrawHelper->sphere(position, radius);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.solidSpheres.push_back(sphereData);
+
 		mIdxToSceneObjectMap[sphereData.idx] = mActiveSO;
 	}
 
@@ -153,6 +327,8 @@ namespace bs
 
 		coneData.idx = mCurrentIdx++;
 		coneData.base = base;
+		coneData.normal = normal;
+		coneData.height = height;
 		coneData.radius = radius;
 		coneData.color = mColor;
 		coneData.transform = mTransform;
@@ -160,7 +336,9 @@ namespace bs
 		coneData.pickable = mPickable;
 		coneData.scale = scale;
 
-		mDrawHelper->cone(base, normal, height, radius, scale);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.solidCones.push_back(coneData);
+
 		mIdxToSceneObjectMap[coneData.idx] = mActiveSO;
 	}
 
@@ -178,7 +356,9 @@ namespace bs
 		discData.sceneObject = mActiveSO;
 		discData.pickable = mPickable;
 
-		mDrawHelper->disc(position, normal, radius);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.solidDiscs.push_back(discData);
+
 		mIdxToSceneObjectMap[discData.idx] = mActiveSO;
 	}
 
@@ -195,7 +375,9 @@ namespace bs
 		cubeData.sceneObject = mActiveSO;
 		cubeData.pickable = mPickable;
 
-		mDrawHelper->wireCube(position, extents);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.wireCubes.push_back(cubeData);
+
 		mIdxToSceneObjectMap[cubeData.idx] = mActiveSO;
 	}
 
@@ -212,7 +394,9 @@ namespace bs
 		sphereData.sceneObject = mActiveSO;
 		sphereData.pickable = mPickable;
 
-		mDrawHelper->wireSphere(position, radius);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.wireSpheres.push_back(sphereData);
+
 		mIdxToSceneObjectMap[sphereData.idx] = mActiveSO;
 	}
 
@@ -259,6 +443,8 @@ namespace bs
 
 		coneData.idx = mCurrentIdx++;
 		coneData.base = base;
+		coneData.normal = normal;
+		coneData.height = height;
 		coneData.radius = radius;
 		coneData.color = mColor;
 		coneData.transform = mTransform;
@@ -266,7 +452,9 @@ namespace bs
 		coneData.pickable = mPickable;
 		coneData.scale = scale;
 
-		mDrawHelper->wireCone(base, normal, height, radius, scale);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.wireCones.push_back(coneData);
+
 		mIdxToSceneObjectMap[coneData.idx] = mActiveSO;
 	}
 
@@ -283,7 +471,11 @@ namespace bs
 		lineData.sceneObject = mActiveSO;
 		lineData.pickable = mPickable;
 
-		mDrawHelper->line(start, end);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.lines.push_back(lineData);
+		else
+			mDrawHelper->line(start, end);
+
 		mIdxToSceneObjectMap[lineData.idx] = mActiveSO;
 	}
 
@@ -299,7 +491,11 @@ namespace bs
 		lineListData.sceneObject = mActiveSO;
 		lineListData.pickable = mPickable;
 
-		mDrawHelper->lineList(linePoints);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.lineLists.push_back(lineListData);
+		else
+			mDrawHelper->lineList(linePoints);
+
 		mIdxToSceneObjectMap[lineListData.idx] = mActiveSO;
 	}
 
@@ -317,7 +513,9 @@ namespace bs
 		wireDiscData.sceneObject = mActiveSO;
 		wireDiscData.pickable = mPickable;
 
-		mDrawHelper->wireDisc(position, normal, radius);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.wireDiscs.push_back(wireDiscData);
+
 		mIdxToSceneObjectMap[wireDiscData.idx] = mActiveSO;
 	}
 
@@ -338,7 +536,9 @@ namespace bs
 		wireArcData.sceneObject = mActiveSO;
 		wireArcData.pickable = mPickable;
 
-		mDrawHelper->wireArc(position, normal, radius, startAngle, amountAngle);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.wireArcs.push_back(wireArcData);
+
 		mIdxToSceneObjectMap[wireArcData.idx] = mActiveSO;
 	}
 
@@ -354,7 +554,11 @@ namespace bs
 		wireMeshData.sceneObject = mActiveSO;
 		wireMeshData.pickable = mPickable;
 
-		mDrawHelper->wireMesh(meshData);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.wireMeshes.push_back(wireMeshData);
+		else
+			mDrawHelper->wireMesh(meshData);
+
 		mIdxToSceneObjectMap[wireMeshData.idx] = mActiveSO;
 	}
 
@@ -374,7 +578,11 @@ namespace bs
 		frustumData.sceneObject = mActiveSO;
 		frustumData.pickable = mPickable;
 
-		mDrawHelper->frustum(position, aspect, FOV, near, far);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.frustums.push_back(frustumData);
+		else
+			mDrawHelper->frustum(position, aspect, FOV, near, far);
+
 		mIdxToSceneObjectMap[frustumData.idx] = mActiveSO;
 	}
 
@@ -392,6 +600,9 @@ namespace bs
 		iconData.sceneObject = mActiveSO;
 		iconData.pickable = mPickable;
 
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.icons.push_back(iconData);
+
 		mIdxToSceneObjectMap[iconData.idx] = mActiveSO;
 	}
 
@@ -414,10 +625,222 @@ namespace bs
 		textData.sceneObject = mActiveSO;
 		textData.pickable = mPickable;
 
-		mDrawHelper->text(position, text, myFont, fontSize);
+		if (mRecordedGizmo != nullptr)
+			mRecordedGizmo->drawCalls.text.push_back(textData);
+		else
+			mDrawHelper->text(position, text, myFont, fontSize);
+
 		mIdxToSceneObjectMap[textData.idx] = mActiveSO;
 	}
 
+	template<class T>
+	void GizmoManager::emitRetained(const Vector<T>& drawCalls, Vector<T>& output)
+	{
+		for (auto& entry : drawCalls)
+		{
+			output.push_back(entry);
+
+			T& newEntry = output.back();
+			newEntry.idx = mCurrentIdx++;
+			newEntry.sceneObject = mActiveSO;
+
+			mIdxToSceneObjectMap[newEntry.idx] = mActiveSO;
+		}
+	}
+
+	void GizmoManager::emitRetainedRefs(UINT64 key, UINT32 count, Vector<RetainedDrawCallRef>& output)
+	{
+		for (UINT32 i = 0; i < count; i++)
+		{
+			RetainedDrawCallRef ref;
+			ref.key = key;
+			ref.drawCallIdx = i;
+			ref.idx = mCurrentIdx++;
+
+			output.push_back(ref);
+			mIdxToSceneObjectMap[ref.idx] = mActiveSO;
+		}
+	}
+
+	template<class T>
+	const T* GizmoManager::findRetained(const RetainedDrawCallRef& ref, Vector<T> RetainedDrawCalls::* drawCalls) const
+	{
+		auto iterFind = mRetainedGizmos.find(ref.key);
+		if (iterFind == mRetainedGizmos.end())
+			return nullptr;
+
+		const Vector<T>& entries = iterFind->second.drawCalls.*drawCalls;
+		if (ref.drawCallIdx >= (UINT32)entries.size())
+			return nullptr;
+
+		return &entries[ref.drawCallIdx];
+	}
+
+	template<class T>
+	bool GizmoManager::containsPickableRetained(const Vector<RetainedDrawCallRef>& refs,
+		Vector<T> RetainedDrawCalls::* drawCalls) const
+	{
+		for (auto& ref : refs)
+		{
+			const T* entry = findRetained(ref, drawCalls);
+			if (entry != nullptr && entry->pickable)
+				return true;
+		}
+
+		return false;
+	}
+
+	void GizmoManager::queueInstances(GizmoInstanceBuffer& output) const
+	{
+		for (auto& entry : mSolidCubeData)
+		{
+			output.add(GizmoPrimitive::SolidCube,
+				entry.transform * GizmoInstanceBuffer::getCubeTransform(entry.position, entry.extents),
+				entry.color, entry.idx, entry.pickable);
+		}
+
+		for (auto& entry : mWireCubeData)
+		{
+			output.add(GizmoPrimitive::WireCube,
+				entry.transform * GizmoInstanceBuffer::getCubeTransform(entry.position, entry.extents),
+				entry.color, entry.idx, entry.pickable);
+		}
+
+		for (auto& entry : mSolidSphereData)
+		{
+			output.add(GizmoPrimitive::SolidSphere,
+				entry.transform * GizmoInstanceBuffer::getSphereTransform(entry.position, entry.radius),
+				entry.color, entry.idx, entry.pickable);
+		}
+
+		for (auto& entry : mWireSphereData)
+		{
+			output.add(GizmoPrimitive::WireSphere,
+				entry.transform * GizmoInstanceBuffer::getSphereTransform(entry.position, entry.radius),
+				entry.color, entry.idx, entry.pickable);
+		}
+
+		for (auto& entry : mSolidConeData)
+		{
+			Matrix4 coneTransform = GizmoInstanceBuffer::getConeTransform(entry.base, entry.normal, entry.height,
+				entry.radius, entry.scale);
+
+			output.add(GizmoPrimitive::SolidCone, entry.transform * coneTransform, entry.color, entry.idx,
+				entry.pickable);
+		}
+
+		for (auto& entry : mWireConeData)
+		{
+			Matrix4 coneTransform = GizmoInstanceBuffer::getConeTransform(entry.base, entry.normal, entry.height,
+				entry.radius, entry.scale);
+
+			output.add(GizmoPrimitive::WireCone, entry.transform * coneTransform, entry.color, entry.idx,
+				entry.pickable);
+		}
+
+		for (auto& entry : mSolidDiscData)
+		{
+			output.add(GizmoPrimitive::SolidDisc,
+				entry.transform * GizmoInstanceBuffer::getDiscTransform(entry.position, entry.normal, entry.radius),
+				entry.color, entry.idx, entry.pickable);
+		}
+
+		for (auto& entry : mWireDiscData)
+		{
+			output.add(GizmoPrimitive::WireDisc,
+				entry.transform * GizmoInstanceBuffer::getDiscTransform(entry.position, entry.normal, entry.radius),
+				entry.color, entry.idx, entry.pickable);
+		}
+
+		for (auto& entry : mWireArcData)
+		{
+			output.add(GizmoPrimitive::WireArc,
+				entry.transform * GizmoInstanceBuffer::getDiscTransform(entry.position, entry.normal, entry.radius),
+				entry.color, entry.idx, entry.pickable, entry.startAngle, entry.amountAngle);
+		}
+	}
+
+	void GizmoManager::queueRetained(DrawHelper& drawHelper, const RetainedDrawCalls& drawCalls)
+	{
+		for (auto& entry : drawCalls.lines)
+		{
+			drawHelper.setColor(entry.color);
+			drawHelper.setTransform(entry.transform);
+			drawHelper.line(entry.start, entry.end);
+		}
+
+		for (auto& entry : drawCalls.lineLists)
+		{
+			drawHelper.setColor(entry.color);
+			drawHelper.setTransform(entry.transform);
+			drawHelper.lineList(entry.linePoints);
+		}
+
+		for (auto& entry : drawCalls.wireMeshes)
+		{
+			drawHelper.setColor(entry.color);
+			drawHelper.setTransform(entry.transform);
+			drawHelper.wireMesh(entry.meshData);
+		}
+
+		for (auto& entry : drawCalls.frustums)
+		{
+			drawHelper.setColor(entry.color);
+			drawHelper.setTransform(entry.transform);
+			drawHelper.frustum(entry.position, entry.aspect, entry.FOV, entry.near, entry.far);
+		}
+
+		for (auto& entry : drawCalls.text)
+		{
+			drawHelper.setColor(entry.color);
+			drawHelper.setTransform(entry.transform);
+			drawHelper.text(entry.position, entry.text, entry.font, entry.fontSize);
+		}
+
+		// Icons are camera dependent and get rebuilt every frame from mIconData in buildIconMesh(), while primitive
+		// shapes are re-emitted into the per-frame data and instanced in queueInstances()
+	}
+
+	void GizmoManager::removeFromBatch(UINT64 key, RetainedGizmo& gizmo)
+	{
+		RetainedBatch& batch = mRetainedBatches[gizmo.batchIdx];
+
+		auto iterFind = std::find(batch.gizmos.begin(), batch.gizmos.end(), key);
+		std::swap(*iterFind, batch.gizmos.back());
+		batch.gizmos.pop_back();
+
+		batch.dirty = true;
+	}
+
+	void GizmoManager::updateRetainedBatches()
+	{
+		// Drop gizmos that weren't drawn this frame (e.g. their component was destroyed or deselected)
+		for (auto iter = mRetainedGizmos.begin(); iter != mRetainedGizmos.end();)
+		{
+			if (iter->second.lastUsedFrame != mFrameIdx)
+			{
+				removeFromBatch(iter->first, iter->second);
+				iter = mRetainedGizmos.erase(iter);
+			}
+			else
+				++iter;
+		}
+
+		for (auto& batch : mRetainedBatches)
+		{
+			if (!batch.dirty)
+				continue;
+
+			batch.drawHelper->clear();
+			for (auto& key : batch.gizmos)
+				queueRetained(*batch.drawHelper, mRetainedGizmos[key].drawCalls);
+
+			// Retained geometry is shared between cameras, so it cannot be depth sorted for a particular one
+			batch.meshes = batch.drawHelper->buildMeshes(DrawHelper::SortType::None, nullptr);
+			batch.dirty = false;
+		}
+	}
+
 	Vector<GizmoManager::MeshRenderData> GizmoManager::createMeshProxyData(const Vector<DrawHelper::ShapeMeshData>& meshData)
 	{
 		Vector<MeshRenderData> proxyData;
@@ -445,7 +868,18 @@ namespace bs
 		mActiveMeshes.clear();
 		mActiveMeshes = mDrawHelper->buildMeshes(DrawHelper::SortType::BackToFront, camera.get());
 
+		updateRetainedBatches();
+
+		mInstances = bs_shared_ptr_new<GizmoInstanceBuffer>();
+		queueInstances(*mInstances);
+
 		Vector<MeshRenderData> proxyData = createMeshProxyData(mActiveMeshes);
+		for (auto& batch : mRetainedBatches)
+		{
+			Vector<MeshRenderData> batchProxyData = createMeshProxyData(batch.meshes);
+			proxyData.insert(proxyData.end(), batchProxyData.begin(), batchProxyData.end());
+		}
+
 		IconRenderDataVecPtr iconRenderData;
 		mIconMesh = buildIconMesh(camera, mIconData, false, iconRenderData);
 
@@ -456,7 +890,7 @@ namespace bs
 		ct::GizmoRenderer* renderer = mGizmoRenderer.get();
 
 		gCoreThread().queueCommand(std::bind(&ct::GizmoRenderer::updateData, renderer, camera->getCore(),
-			proxyData, iconMesh, iconRenderData));
+			proxyData, iconMesh, iconRenderData, mInstances));
 	}
 
 	void GizmoManager::renderForPicking(const SPtr<Camera>& camera, std::function<Color(UINT32)> idxToColorCallback)
@@ -466,72 +900,14 @@ namespace bs
 
 		mPickingDrawHelper->clear();
 
-		for (auto& cubeDataEntry : mSolidCubeData)
-		{
-			if (!cubeDataEntry.pickable)
-				continue;
-
-			mPickingDrawHelper->setColor(idxToColorCallback(cubeDataEntry.idx));
-			mPickingDrawHelper->setTransform(cubeDataEntry.transform);
-
-			mPickingDrawHelper->cube(cubeDataEntry.position, cubeDataEntry.extents);
-		}
-
-		for (auto& cubeDataEntry : mWireCubeData)
-		{
-			if (!cubeDataEntry.pickable)
-				continue;
-
-			mPickingDrawHelper->setColor(idxToColorCallback(cubeDataEntry.idx));
-			mPickingDrawHelper->setTransform(cubeDataEntry.transform);
-
-			mPickingDrawHelper->wireCube(cubeDataEntry.position, cubeDataEntry.extents);
-		}
-
-		for (auto& sphereDataEntry : mSolidSphereData)
-		{
-			if (!sphereDataEntry.pickable)
-				continue;
-
-			mPickingDrawHelper->setColor(idxToColorCallback(sphereDataEntry.idx));
-			mPickingDrawHelper->setTransform(sphereDataEntry.transform);
-
-			mPickingDrawHelper->sphere(sphereDataEntry.position, sphereDataEntry.radius);
-		}
-
-		for (auto& sphereDataEntry : mWireSphereData)
-		{
-			if (!sphereDataEntry.pickable)
-				continue;
-
-			mPickingDrawHelper->setColor(idxToColorCallback(sphereDataEntry.idx));
-			mPickingDrawHelper->setTransform(sphereDataEntry.transform);
-
-			mPickingDrawHelper->wireSphere(sphereDataEntry.position, sphereDataEntry.radius);
-		}
-
-		for (auto& coneDataEntry : mSolidConeData)
+		// Primitives reuse the instance data from the last update, and only need a picking color per instance
+		SPtr<InstancePickingData> instancePickingData;
+		if (mInstances != nullptr)
 		{
-			if (!coneDataEntry.pickable)
-				continue;
-
-			mPickingDrawHelper->setColor(idxToColorCallback(coneDataEntry.idx));
-			mPickingDrawHelper->setTransform(coneDataEntry.transform);
-
-			mPickingDrawHelper->cone(coneDataEntry.base, coneDataEntry.normal, coneDataEntry.radius, coneDataEntry.radius, 
-				coneDataEntry.scale);
-		}
-
-		for (auto& coneDataEntry : mWireConeData)
-		{
-			if (!coneDataEntry.pickable)
-				continue;
-
-			mPickingDrawHelper->setColor(idxToColorCallback(coneDataEntry.idx));
-			mPickingDrawHelper->setTransform(coneDataEntry.transform);
+			instancePickingData = bs_shared_ptr_new<InstancePickingData>();
 
-			mPickingDrawHelper->wireCone(coneDataEntry.base, coneDataEntry.normal, coneDataEntry.radius, coneDataEntry.radius,
-				coneDataEntry.scale);
+			for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+				mInstances->getPickingColors((GizmoPrimitive)i, idxToColorCallback, instancePickingData->colors[i]);
 		}
 
 		for (auto& lineDataEntry : mLineData)
@@ -556,49 +932,39 @@ namespace bs
 			mPickingDrawHelper->lineList(lineListDataEntry.linePoints);
 		}
 
-		for (auto& discDataEntry : mSolidDiscData)
+		for (auto& ref : mRetainedLineLists)
 		{
-			if (!discDataEntry.pickable)
+			const LineListData* lineListDataEntry = findRetained(ref, &RetainedDrawCalls::lineLists);
+			if (lineListDataEntry == nullptr || !lineListDataEntry->pickable)
 				continue;
 
-			mPickingDrawHelper->setColor(idxToColorCallback(discDataEntry.idx));
-			mPickingDrawHelper->setTransform(discDataEntry.transform);
+			mPickingDrawHelper->setColor(idxToColorCallback(ref.idx));
+			mPickingDrawHelper->setTransform(lineListDataEntry->transform);
 
-			mPickingDrawHelper->disc(discDataEntry.position, discDataEntry.normal, discDataEntry.radius);
+			mPickingDrawHelper->lineList(lineListDataEntry->linePoints);
 		}
 
-		for (auto& discDataEntry : mWireDiscData)
-		{
-			if (!discDataEntry.pickable)
-				continue;
-
-			mPickingDrawHelper->setColor(idxToColorCallback(discDataEntry.idx));
-			mPickingDrawHelper->setTransform(discDataEntry.transform);
-
-			mPickingDrawHelper->wireDisc(discDataEntry.position, discDataEntry.normal, discDataEntry.radius);
-		}
-
-		for (auto& wireArcDataEntry : mWireArcData)
+		for (auto& wireMeshData : mWireMeshData)
 		{
-			if (!wireArcDataEntry.pickable)
+			if (!wireMeshData.pickable)
 				continue;
 
-			mPickingDrawHelper->setColor(idxToColorCallback(wireArcDataEntry.idx));
-			mPickingDrawHelper->setTransform(wireArcDataEntry.transform);
+			mPickingDrawHelper->setColor(idxToColorCallback(wireMeshData.idx));
+			mPickingDrawHelper->setTransform(wireMeshData.transform);
 
-			mPickingDrawHelper->wireArc(wireArcDataEntry.position, wireArcDataEntry.normal, wireArcDataEntry.radius, 
-				wireArcDataEntry.startAngle, wireArcDataEntry.amountAngle);
+			mPickingDrawHelper->wireMesh(wireMeshData.meshData);
 		}
 
-		for (auto& wireMeshData : mWireMeshData)
+		for (auto& ref : mRetainedWireMeshes)
 		{
-			if (!wireMeshData.pickable)
+			const WireMeshData* wireMeshData = findRetained(ref, &RetainedDrawCalls::wireMeshes);
+			if (wireMeshData == nullptr || !wireMeshData->pickable)
 				continue;
 
-			mPickingDrawHelper->setColor(idxToColorCallback(wireMeshData.idx));
-			mPickingDrawHelper->setTransform(wireMeshData.transform);
+			mPickingDrawHelper->setColor(idxToColorCallback(ref.idx));
+			mPickingDrawHelper->setTransform(wireMeshData->transform);
 
-			mPickingDrawHelper->wireMesh(wireMeshData.meshData);
+			mPickingDrawHelper->wireMesh(wireMeshData->meshData);
 		}
 
 		for (auto& frustumDataEntry : mFrustumData)
@@ -625,6 +991,19 @@ namespace bs
 				textDataEntry.fontSize);
 		}
 
+		for (auto& ref : mRetainedText)
+		{
+			const TextData* textDataEntry = findRetained(ref, &RetainedDrawCalls::text);
+			if (textDataEntry == nullptr || !textDataEntry->pickable)
+				continue;
+
+			mPickingDrawHelper->setColor(idxToColorCallback(ref.idx));
+			mPickingDrawHelper->setTransform(textDataEntry->transform);
+
+			mPickingDrawHelper->text(textDataEntry->position, textDataEntry->text, textDataEntry->font,
+				textDataEntry->fontSize);
+		}
+
 		for (auto& iconDataEntry : mIconData)
 		{
 			if (!iconDataEntry.pickable)
@@ -648,7 +1027,34 @@ namespace bs
 
 		Vector<MeshRenderData> proxyData = createMeshProxyData(meshes);
 		gCoreThread().queueCommand(std::bind(&ct::GizmoRenderer::renderData, renderer, camera->getCore(),
-											 proxyData, iconMeshCore, iconRenderData, true));
+											 proxyData, iconMeshCore, iconRenderData, instancePickingData, true));
+	}
+
+	/** Checks is any of the provided gizmos pickable. */
+	template<class T>
+	static bool containsPickable(const Vector<T>& entries)
+	{
+		for (auto& entry : entries)
+		{
+			if (entry.pickable)
+				return true;
+		}
+
+		return false;
+	}
+
+	bool GizmoManager::hasPickableGizmos() const
+	{
+		return containsPickable(mSolidCubeData) || containsPickable(mWireCubeData) ||
+			containsPickable(mSolidSphereData) || containsPickable(mWireSphereData) ||
+			containsPickable(mSolidConeData) || containsPickable(mWireConeData) ||
+			containsPickable(mLineData) || containsPickable(mLineListData) ||
+			containsPickable(mSolidDiscData) || containsPickable(mWireDiscData) ||
+			containsPickable(mWireArcData) || containsPickable(mWireMeshData) ||
+			containsPickable(mFrustumData) || containsPickable(mTextData) || containsPickable(mIconData) ||
+			containsPickableRetained(mRetainedLineLists, &RetainedDrawCalls::lineLists) ||
+			containsPickableRetained(mRetainedWireMeshes, &RetainedDrawCalls::wireMeshes) ||
+			containsPickableRetained(mRetainedText, &RetainedDrawCalls::text);
 	}
 
 	void GizmoManager::clearGizmos()
@@ -668,23 +1074,28 @@ namespace bs
 		mFrustumData.clear();
 		mTextData.clear();
 		mIconData.clear();
+		mRetainedLineLists.clear();
+		mRetainedWireMeshes.clear();
+		mRetainedText.clear();
 		mIdxToSceneObjectMap.clear();
 
 		mDrawHelper->clear();
 
 		mCurrentIdx = 0;
+		mFrameIdx++;
 	}
 
 	void GizmoManager::clearRenderData()
 	{
 		mActiveMeshes.clear();
 		mIconMesh = nullptr;
+		mInstances = nullptr;
 
 		ct::GizmoRenderer* renderer = mGizmoRenderer.get();
 		IconRenderDataVecPtr iconRenderData = bs_shared_ptr_new<IconRenderDataVec>();
 		
 		gCoreThread().queueCommand(std::bind(&ct::GizmoRenderer::updateData, renderer,
-			nullptr, Vector<MeshRenderData>(), nullptr, iconRenderData));
+			nullptr, Vector<MeshRenderData>(), nullptr, iconRenderData, nullptr));
 	}
 
 	SPtr<Mesh> GizmoManager::buildIconMesh(const SPtr<Camera>& camera, const Vector<IconData>& iconData,
@@ -913,6 +1324,7 @@ namespace bs
 	GizmoPickingParamBlockDef gGizmoPickingParamBlockDef;
 
 	const float GizmoRenderer::PICKING_ALPHA_CUTOFF = 0.5f;
+	const UINT32 GizmoRenderer::MIN_INSTANCE_BUFFER_SIZE = 64;
 
 	GizmoRenderer::GizmoRenderer()
 		:RendererExtension(RenderLocation::PostLightPass, 0)
@@ -932,20 +1344,53 @@ namespace bs
 		mIconMaterial = initData.iconMat;
 		mPickingMaterials[0] = initData.pickingMat;
 		mPickingMaterials[1] = initData.alphaPickingMat;
+		mInstancedMaterials[0] = initData.instancedSolidMat;
+		mInstancedMaterials[1] = initData.instancedLineMat;
+		mInstancedPickingMaterial = initData.instancedPickingMat;
+
+		for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+			mPrimitiveMeshes[i] = initData.primitiveMeshes[i];
 
 		mMeshGizmoBuffer = gGizmoParamBlockDef.createBuffer();
 		mIconGizmoBuffer = gGizmoParamBlockDef.createBuffer();
 		mMeshPickingParamBuffer = gGizmoPickingParamBlockDef.createBuffer();
 		mIconPickingParamBuffer = gGizmoPickingParamBlockDef.createBuffer();
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			bool solid = i == 0;
+
+			mInstanceDeclarations[i] = VertexDeclaration::create(createPrimitiveVertexDesc(solid, 2));
+			mInstancePickingDeclarations[i] = VertexDeclaration::create(createPrimitiveVertexDesc(solid, 3));
+
+			mInstancedParamSets[i] = mInstancedMaterials[i]->createParamsSet();
+			mInstancedParamSets[i]->setParamBlockBuffer("Uniforms", mMeshGizmoBuffer, true);
+		}
+
+		mInstancedPickingParamSet = mInstancedPickingMaterial->createParamsSet();
+		mInstancedPickingParamSet->setParamBlockBuffer("Uniforms", mMeshPickingParamBuffer, true);
 	}
 
 	void GizmoRenderer::updateData(const SPtr<Camera>& camera, const Vector<GizmoManager::MeshRenderData>& meshes,
-		const SPtr<MeshBase>& iconMesh, const GizmoManager::IconRenderDataVecPtr& iconRenderData)
+		const SPtr<MeshBase>& iconMesh, const GizmoManager::IconRenderDataVecPtr& iconRenderData,
+		const SPtr<GizmoInstanceBuffer>& instances)
 	{
 		mCamera = camera;
 		mMeshes = meshes;
 		mIconMesh = iconMesh;
 		mIconRenderData = iconRenderData;
+		mInstances = instances;
+
+		// Upload instance data once, it is then reused by all following render and picking passes
+		if (mInstances != nullptr)
+		{
+			for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+			{
+				const Vector<GizmoInstance>& instanceData = mInstances->getInstances((GizmoPrimitive)i);
+				writeInstanceData(mInstanceBuffers[i], sizeof(GizmoInstance), (UINT32)instanceData.size(),
+					instanceData.data());
+			}
+		}
 
 		// Allocate and assign GPU program parameter objects
 		UINT32 meshCounters[(UINT32)GizmoMeshType::Count];
@@ -1022,11 +1467,12 @@ namespace bs
 
 	void GizmoRenderer::render(const Camera& camera)
 	{
-		renderData(mCamera, mMeshes, mIconMesh, mIconRenderData, false);
+		renderData(mCamera, mMeshes, mIconMesh, mIconRenderData, nullptr, false);
 	}
 
 	void GizmoRenderer::renderData(const SPtr<Camera>& camera, Vector<GizmoManager::MeshRenderData>& meshes,
-		const SPtr<MeshBase>& iconMesh, const GizmoManager::IconRenderDataVecPtr& iconRenderData, bool usePickingMaterial)
+		const SPtr<MeshBase>& iconMesh, const GizmoManager::IconRenderDataVecPtr& iconRenderData,
+		const SPtr<GizmoManager::InstancePickingData>& pickingData, bool usePickingMaterial)
 	{
 		if (camera == nullptr)
 			return;
@@ -1052,6 +1498,8 @@ namespace bs
 			gGizmoParamBlockDef.gInvViewportHeight.set(mMeshGizmoBuffer, invViewportHeight);
 			gGizmoParamBlockDef.gViewportYFlip.set(mMeshGizmoBuffer, viewportYFlip);
 
+			renderInstances(nullptr, false);
+
 			for (auto& entry : meshes)
 			{
 				UINT32 typeIdx = (UINT32)entry.type;
@@ -1104,6 +1552,8 @@ namespace bs
 			gGizmoPickingParamBlockDef.gMatViewProj.set(mMeshPickingParamBuffer, viewProjMat);
 			gGizmoPickingParamBlockDef.gAlphaCutoff.set(mMeshPickingParamBuffer, PICKING_ALPHA_CUTOFF);
 
+			renderInstances(pickingData, true);
+
 			for (auto& entry : meshes)
 			{
 				UINT32 typeIdx = entry.type == GizmoMeshType::Text ? 1 : 0;
@@ -1119,6 +1569,85 @@ namespace bs
 			renderIconGizmos(screenArea, iconMesh, iconRenderData, usePickingMaterial);
 	}
 
+	void GizmoRenderer::renderInstances(const SPtr<GizmoManager::InstancePickingData>& pickingData,
+		bool usePickingMaterial)
+	{
+		if (mInstances == nullptr)
+			return;
+
+		if (usePickingMaterial && pickingData == nullptr)
+			return;
+
+		RenderAPI& rapi = RenderAPI::instance();
+		for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+		{
+			UINT32 numInstances = (UINT32)mInstances->getInstances((GizmoPrimitive)i).size();
+			if (numInstances == 0)
+				continue;
+
+			UINT32 typeIdx = GizmoInstanceBuffer::isSolid((GizmoPrimitive)i) ? 0 : 1;
+			SPtr<Mesh> mesh = mPrimitiveMeshes[i];
+			SPtr<VertexData> vertexData = mesh->getVertexData();
+
+			SPtr<VertexBuffer> vertBuffers[3] = { vertexData->getBuffer(0), mInstanceBuffers[i], nullptr };
+			UINT32 numBuffers = 2;
+
+			if (!usePickingMaterial)
+			{
+				gRendererUtility().setPass(mInstancedMaterials[typeIdx]);
+				gRendererUtility().setPassParams(mInstancedParamSets[typeIdx]);
+
+				rapi.setVertexDeclaration(mInstanceDeclarations[typeIdx]);
+			}
+			else
+			{
+				const Vector<UINT32>& colors = pickingData->colors[i];
+				writeInstanceData(mInstancePickingBuffers[i], sizeof(UINT32), (UINT32)colors.size(), colors.data());
+
+				vertBuffers[2] = mInstancePickingBuffers[i];
+				numBuffers = 3;
+
+				gRendererUtility().setPass(mInstancedPickingMaterial);
+				gRendererUtility().setPassParams(mInstancedPickingParamSet);
+
+				rapi.setVertexDeclaration(mInstancePickingDeclarations[typeIdx]);
+			}
+
+			rapi.setVertexBuffers(0, vertBuffers, numBuffers);
+			rapi.setIndexBuffer(mesh->getIndexBuffer());
+
+			const SubMesh& subMesh = mesh->getProperties().getSubMesh(0);
+			rapi.setDrawOperation(subMesh.drawOp);
+			rapi.drawIndexed(mesh->getIndexOffset() + subMesh.indexOffset, subMesh.indexCount, mesh->getVertexOffset(),
+				vertexData->vertexCount, numInstances);
+
+			mesh->_notifyUsedOnGPU();
+		}
+	}
+
+	void GizmoRenderer::writeInstanceData(SPtr<VertexBuffer>& buffer, UINT32 vertexSize, UINT32 count,
+		const void* data)
+	{
+		if (count == 0)
+			return;
+
+		UINT32 capacity = 0;
+		if (buffer != nullptr)
+			capacity = buffer->getProperties().getNumVertices();
+
+		if (count > capacity)
+		{
+			VERTEX_BUFFER_DESC desc;
+			desc.vertexSize = vertexSize;
+			desc.numVerts = std::max(count, std::max(capacity * 2, MIN_INSTANCE_BUFFER_SIZE));
+			desc.usage = GBU_DYNAMIC;
+
+			buffer = VertexBuffer::create(desc);
+		}
+
+		buffer->writeData(0, count * vertexSize, data, BWT_DISCARD);
+	}
+
 	void GizmoRenderer::renderIconGizmos(Rect2I screenArea, SPtr<MeshBase> mesh, 
 		GizmoManager::IconRenderDataVecPtr renderData, bool usePickingMaterial)
 	{
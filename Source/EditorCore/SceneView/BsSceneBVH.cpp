@@ -0,0 +1,338 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Scene/BsSceneBVH.h"
+#include "Math/BsRay.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	const UINT32 SceneBVH::MAX_OBJECTS_PER_LEAF = 4;
+	const UINT32 SceneBVH::INVALID_INDEX = (UINT32)-1;
+
+	/** Minimum number of added or removed objects before they trigger a rebuild, regardless of hierarchy size. */
+	static const UINT32 MIN_CHANGES_FOR_REBUILD = 32;
+
+	UINT32 SceneBVH::add(const AABox& bounds)
+	{
+		UINT32 id;
+		if (!mFreeIds.empty())
+		{
+			id = mFreeIds.back();
+			mFreeIds.pop_back();
+		}
+		else
+		{
+			id = (UINT32)mObjects.size();
+			mObjects.push_back(Object());
+		}
+
+		Object& object = mObjects[id];
+		object.bounds = bounds;
+		object.node = INVALID_INDEX;
+		object.active = true;
+
+		mPending.push_back(id);
+		mNumActive++;
+
+		return id;
+	}
+
+	void SceneBVH::update(UINT32 id, const AABox& bounds)
+	{
+		Object& object = mObjects[id];
+		object.bounds = bounds;
+
+		if (object.node != INVALID_INDEX)
+		{
+			refit(object.node);
+			mNumUpdated++;
+		}
+	}
+
+	void SceneBVH::remove(UINT32 id)
+	{
+		Object& object = mObjects[id];
+		object.active = false;
+
+		if (object.node != INVALID_INDEX)
+		{
+			// Leaves keep referencing removed objects until the next rebuild, so the id can't be reused before then
+			mRemoved.push_back(id);
+		}
+		else
+		{
+			mPending.erase(std::find(mPending.begin(), mPending.end(), id));
+			mFreeIds.push_back(id);
+		}
+
+		mNumActive--;
+	}
+
+	void SceneBVH::clear()
+	{
+		mObjects.clear();
+		mNodes.clear();
+		mLeafObjects.clear();
+		mPending.clear();
+		mFreeIds.clear();
+		mRemoved.clear();
+		mNumActive = 0;
+		mNumUpdated = 0;
+	}
+
+	void SceneBVH::rayCast(const Ray& ray, Vector<SceneBVHRayHit>& output)
+	{
+		rebuildIfNeeded();
+
+		float distance;
+		for (auto& id : mPending)
+		{
+			if (intersects(ray, mObjects[id].bounds, distance))
+				output.push_back({ id, distance });
+		}
+
+		if (!mNodes.empty())
+		{
+			Vector<UINT32> todo;
+			todo.push_back(0);
+
+			while (!todo.empty())
+			{
+				const Node& node = mNodes[todo.back()];
+				todo.pop_back();
+
+				if (!intersects(ray, node.bounds, distance))
+					continue;
+
+				if (node.count == 0)
+				{
+					todo.push_back(node.children);
+					todo.push_back(node.children + 1);
+					continue;
+				}
+
+				for (UINT32 i = node.start; i < node.start + node.count; i++)
+				{
+					const Object& object = mObjects[mLeafObjects[i]];
+					if (object.active && intersects(ray, object.bounds, distance))
+						output.push_back({ mLeafObjects[i], distance });
+				}
+			}
+		}
+
+		std::sort(output.begin(), output.end(),
+			[](const SceneBVHRayHit& a, const SceneBVHRayHit& b) { return a.distance < b.distance; });
+	}
+
+	void SceneBVH::intersect(const ConvexVolume& volume, Vector<UINT32>& output)
+	{
+		rebuildIfNeeded();
+
+		for (auto& id : mPending)
+		{
+			if (volume.intersects(mObjects[id].bounds))
+				output.push_back(id);
+		}
+
+		if (mNodes.empty())
+			return;
+
+		Vector<UINT32> todo;
+		todo.push_back(0);
+
+		while (!todo.empty())
+		{
+			const Node& node = mNodes[todo.back()];
+			todo.pop_back();
+
+			if (!volume.intersects(node.bounds))
+				continue;
+
+			if (node.count == 0)
+			{
+				todo.push_back(node.children);
+				todo.push_back(node.children + 1);
+				continue;
+			}
+
+			for (UINT32 i = node.start; i < node.start + node.count; i++)
+			{
+				const Object& object = mObjects[mLeafObjects[i]];
+				if (object.active && volume.intersects(object.bounds))
+					output.push_back(mLeafObjects[i]);
+			}
+		}
+	}
+
+	void SceneBVH::rebuild()
+	{
+		for (auto& id : mRemoved)
+		{
+			mObjects[id].node = INVALID_INDEX;
+			mFreeIds.push_back(id);
+		}
+
+		mRemoved.clear();
+		mPending.clear();
+		mNodes.clear();
+		mLeafObjects.clear();
+		mNumUpdated = 0;
+
+		for (UINT32 i = 0; i < (UINT32)mObjects.size(); i++)
+		{
+			if (mObjects[i].active)
+				mLeafObjects.push_back(i);
+		}
+
+		if (mLeafObjects.empty())
+			return;
+
+		mNodes.reserve(mLeafObjects.size() * 2);
+		mNodes.push_back(Node());
+		mNodes[0].parent = INVALID_INDEX;
+
+		build(0, 0, (UINT32)mLeafObjects.size());
+	}
+
+	bool SceneBVH::intersects(const Ray& ray, const AABox& box, float& distance)
+	{
+		const Vector3& origin = ray.getOrigin();
+		const Vector3& direction = ray.getDirection();
+		const Vector3& min = box.getMin();
+		const Vector3& max = box.getMax();
+
+		float enter = 0.0f;
+		float exit = std::numeric_limits<float>::max();
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			if (Math::abs(direction[i]) < 1e-8f)
+			{
+				// Ray is parallel to the slab, it can only hit the box if it starts between the planes
+				if (origin[i] < min[i] || origin[i] > max[i])
+					return false;
+
+				continue;
+			}
+
+			const float invDirection = 1.0f / direction[i];
+			float t0 = (min[i] - origin[i]) * invDirection;
+			float t1 = (max[i] - origin[i]) * invDirection;
+			if (t0 > t1)
+				std::swap(t0, t1);
+
+			enter = std::max(enter, t0);
+			exit = std::min(exit, t1);
+
+			if (enter > exit)
+				return false;
+		}
+
+		distance = enter;
+		return true;
+	}
+
+	void SceneBVH::rebuildIfNeeded()
+	{
+		// Added objects are tested linearly and removed ones still take up space in the leaves, while refitting moved
+		// objects gradually loosens the tree. Rebuild once any of these gets significant compared to the tree size.
+		const UINT32 numChanged = (UINT32)(mPending.size() + mRemoved.size());
+		const UINT32 maxChanged = std::max(MIN_CHANGES_FOR_REBUILD, mNumActive / 8);
+
+		if (numChanged > maxChanged || mNumUpdated > std::max(MIN_CHANGES_FOR_REBUILD, mNumActive))
+			rebuild();
+	}
+
+	void SceneBVH::build(UINT32 nodeIdx, UINT32 start, UINT32 end)
+	{
+		Vector3 min = mObjects[mLeafObjects[start]].bounds.getMin();
+		Vector3 max = mObjects[mLeafObjects[start]].bounds.getMax();
+		Vector3 centerMin = mObjects[mLeafObjects[start]].bounds.getCenter();
+		Vector3 centerMax = centerMin;
+
+		for (UINT32 i = start + 1; i < end; i++)
+		{
+			const AABox& bounds = mObjects[mLeafObjects[i]].bounds;
+			min = Vector3::min(min, bounds.getMin());
+			max = Vector3::max(max, bounds.getMax());
+
+			const Vector3 center = bounds.getCenter();
+			centerMin = Vector3::min(centerMin, center);
+			centerMax = Vector3::max(centerMax, center);
+		}
+
+		mNodes[nodeIdx].bounds = AABox(min, max);
+
+		const UINT32 count = end - start;
+		if (count <= MAX_OBJECTS_PER_LEAF)
+		{
+			mNodes[nodeIdx].children = INVALID_INDEX;
+			mNodes[nodeIdx].start = start;
+			mNodes[nodeIdx].count = count;
+
+			for (UINT32 i = start; i < end; i++)
+				mObjects[mLeafObjects[i]].node = nodeIdx;
+
+			return;
+		}
+
+		// Split at the median object center along the axis in which the centers are spread the most
+		const Vector3 extents = centerMax - centerMin;
+		UINT32 axis = 0;
+		if (extents.y > extents[axis])
+			axis = 1;
+
+		if (extents.z > extents[axis])
+			axis = 2;
+
+		const UINT32 mid = start + count / 2;
+		std::nth_element(mLeafObjects.begin() + start, mLeafObjects.begin() + mid, mLeafObjects.begin() + end,
+			[this, axis](UINT32 a, UINT32 b)
+		{
+			return mObjects[a].bounds.getCenter()[axis] < mObjects[b].bounds.getCenter()[axis];
+		});
+
+		const UINT32 children = (UINT32)mNodes.size();
+		mNodes.push_back(Node());
+		mNodes.push_back(Node());
+
+		mNodes[children].parent = nodeIdx;
+		mNodes[children + 1].parent = nodeIdx;
+
+		mNodes[nodeIdx].children = children;
+		mNodes[nodeIdx].start = 0;
+		mNodes[nodeIdx].count = 0;
+
+		build(children, start, mid);
+		build(children + 1, mid, end);
+	}
+
+	void SceneBVH::refit(UINT32 nodeIdx)
+	{
+		// Removed objects still contribute to the bounds. This keeps leaves from ending up empty, and they get dropped on
+		// the next rebuild anyway.
+		Node& leaf = mNodes[nodeIdx];
+
+		Vector3 min = mObjects[mLeafObjects[leaf.start]].bounds.getMin();
+		Vector3 max = mObjects[mLeafObjects[leaf.start]].bounds.getMax();
+		for (UINT32 i = leaf.start + 1; i < leaf.start + leaf.count; i++)
+		{
+			const AABox& bounds = mObjects[mLeafObjects[i]].bounds;
+			min = Vector3::min(min, bounds.getMin());
+			max = Vector3::max(max, bounds.getMax());
+		}
+
+		leaf.bounds = AABox(min, max);
+
+		UINT32 parentIdx = leaf.parent;
+		while (parentIdx != INVALID_INDEX)
+		{
+			Node& parent = mNodes[parentIdx];
+			const AABox& left = mNodes[parent.children].bounds;
+			const AABox& right = mNodes[parent.children + 1].bounds;
+
+			parent.bounds = AABox(Vector3::min(left.getMin(), right.getMin()), Vector3::max(left.getMax(), right.getMax()));
+			parentIdx = parent.parent;
+		}
+	}
+}
@@ -25,11 +25,19 @@
 #include "Renderer/BsRenderer.h"
 #include "Scene/BsGizmoManager.h"
 #include "Renderer/BsRendererUtility.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "Math/BsRay.h"
+#include "Math/BsPlane.h"
+#include "Utility/BsTime.h"
 
 using namespace std::placeholders;
 
 namespace bs
 {
+	const UINT32 ScenePicking::WHOLE_OBJECT = (UINT32)-1;
+	const UINT32 ScenePicking::NO_OBJECT_INDEX = 0xFFFFFFFF;
+
 	ScenePicking::ScenePicking()
 	{
 		mCore = bs_new<ct::ScenePicking>();
@@ -68,10 +76,419 @@ namespace bs
 		return selectedObjects[0];
 	}
 
+	/** Possible outcomes of testing a ray against the triangles of a mesh. */
+	enum class MeshRayCastResult
+	{
+		Hit, Miss, NoData
+	};
+
+	/**
+	 * Tests a ray against all triangles of a mesh, using the mesh data cached on the CPU. Returns NoData if the mesh has
+	 * no cached data or it cannot be interpreted as triangles. Both sides of the triangles are tested.
+	 *
+	 * @param[in]	mesh		Mesh to test.
+	 * @param[in]	ray			Ray in mesh local space.
+	 * @param[out]	distance	Distance along the ray to the nearest hit.
+	 * @param[out]	normal		Local space normal of the nearest triangle hit, facing the ray origin.
+	 * @param[out]	subMeshIdx	Index of the sub-mesh containing the nearest triangle hit.
+	 */
+	static MeshRayCastResult rayCastMesh(const HMesh& mesh, const Ray& ray, float& distance, Vector3& normal,
+		UINT32& subMeshIdx)
+	{
+		SPtr<MeshData> meshData = mesh->getCachedData();
+		if (meshData == nullptr || !meshData->getVertexDesc()->hasElement(VES_POSITION))
+			return MeshRayCastResult::NoData;
+
+		const MeshProperties& props = mesh->getProperties();
+		for (UINT32 i = 0; i < props.getNumSubMeshes(); i++)
+		{
+			if (props.getSubMesh(i).drawOp != DOT_TRIANGLE_LIST)
+				return MeshRayCastResult::NoData;
+		}
+
+		const UINT8* positions = meshData->getElementData(VES_POSITION);
+		const UINT32 stride = meshData->getVertexDesc()->getVertexStride(0);
+		const bool use32BitIndices = meshData->getIndexType() == IT_32BIT;
+		const UINT32* indices32 = use32BitIndices ? meshData->getIndices32() : nullptr;
+		const UINT16* indices16 = use32BitIndices ? nullptr : meshData->getIndices16();
+
+		auto getPosition = [&](UINT32 index)
+		{
+			const UINT32 vertexIdx = use32BitIndices ? indices32[index] : indices16[index];
+
+			Vector3 position;
+			memcpy(&position, positions + vertexIdx * stride, sizeof(position));
+			return position;
+		};
+
+		const Vector3& origin = ray.getOrigin();
+		const Vector3& direction = ray.getDirection();
+
+		bool hit = false;
+		distance = std::numeric_limits<float>::max();
+		for (UINT32 i = 0; i < props.getNumSubMeshes(); i++)
+		{
+			const SubMesh& subMesh = props.getSubMesh(i);
+			for (UINT32 j = subMesh.indexOffset; j + 2 < subMesh.indexOffset + subMesh.indexCount; j += 3)
+			{
+				const Vector3 a = getPosition(j);
+				const Vector3 edge1 = getPosition(j + 1) - a;
+				const Vector3 edge2 = getPosition(j + 2) - a;
+
+				const Vector3 p = direction.cross(edge2);
+				const float det = edge1.dot(p);
+				if (Math::abs(det) < 1e-12f)
+					continue;
+
+				const float invDet = 1.0f / det;
+				const Vector3 s = origin - a;
+				const float u = s.dot(p) * invDet;
+				if (u < 0.0f || u > 1.0f)
+					continue;
+
+				const Vector3 q = s.cross(edge1);
+				const float v = direction.dot(q) * invDet;
+				if (v < 0.0f || u + v > 1.0f)
+					continue;
+
+				const float t = edge2.dot(q) * invDet;
+				if (t < 0.0f || t >= distance)
+					continue;
+
+				distance = t;
+				normal = Vector3::normalize(edge1.cross(edge2));
+				subMeshIdx = i;
+				hit = true;
+			}
+		}
+
+		if (!hit)
+			return MeshRayCastResult::Miss;
+
+		if (normal.dot(direction) > 0.0f)
+			normal = -normal;
+
+		return MeshRayCastResult::Hit;
+	}
+
 	Vector<HSceneObject> ScenePicking::pickObjects(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area, 
 		Vector<HSceneObject>& ignoreRenderables, SnapData* data)
 	{
-		auto comparePickElement = [&] (const ScenePicking::RenderablePickData& a, const ScenePicking::RenderablePickData& b)
+		SPtr<ScenePickOperation> operation = startPick(cam, position, area, ignoreRenderables, data != nullptr);
+		if (!operation->isComplete())
+		{
+			// Results are needed right away, so submit the queued picking commands and wait for the core thread
+			gCoreThread().submit(true);
+			completePick(*operation);
+		}
+
+		if (data != nullptr)
+			*data = operation->getSnapData();
+
+		return operation->getObjects();
+	}
+
+	SPtr<ScenePickOperation> ScenePicking::pickObjectsAsync(const SPtr<Camera>& cam, const Vector2I& position,
+		const Vector2I& area, const Vector<HSceneObject>& ignoreRenderables,
+		const std::function<void(const ScenePickOperation&)>& callback, bool gatherSnapData)
+	{
+		SPtr<ScenePickOperation> operation = startPick(cam, position, area, ignoreRenderables, gatherSnapData);
+		operation->mCallback = callback;
+
+		mPendingOperations.push_back(operation);
+		return operation;
+	}
+
+	void ScenePicking::update()
+	{
+		Vector<SPtr<ScenePickOperation>> completedOperations;
+		for (auto iter = mPendingOperations.begin(); iter != mPendingOperations.end();)
+		{
+			SPtr<ScenePickOperation> operation = *iter;
+			if (!operation->isComplete())
+			{
+				if (!operation->mAsyncOp.hasCompleted())
+				{
+					++iter;
+					continue;
+				}
+
+				completePick(*operation);
+			}
+
+			completedOperations.push_back(operation);
+			iter = mPendingOperations.erase(iter);
+		}
+
+		// Triggered separately, as callbacks are allowed to start new picks
+		for (auto& operation : completedOperations)
+		{
+			if (operation->mCallback)
+				operation->mCallback(*operation);
+		}
+	}
+
+	SPtr<ScenePickOperation> ScenePicking::startPick(const SPtr<Camera>& cam, const Vector2I& position,
+		const Vector2I& area, const Vector<HSceneObject>& ignoreRenderables, bool gatherSnapData)
+	{
+		SPtr<ScenePickOperation> operation = bs_shared_ptr_new<ScenePickOperation>();
+		operation->mGatherSnapData = gatherSnapData;
+
+		updateHierarchy();
+
+		UnorderedSet<UINT64> ignored;
+		for (auto& so : ignoreRenderables)
+		{
+			if (!so.isDestroyed())
+				ignored.insert(so->getInstanceId());
+		}
+
+		auto isIgnored = [&](UINT32 hierarchyId)
+		{
+			const PickableRenderable& entry = mRenderables[mHierarchyIdToRenderable[hierarchyId]];
+			return ignored.find(entry.renderable->SO()->getInstanceId()) != ignored.end();
+		};
+
+		Vector<PickedElement> results;
+
+		// Candidates without CPU mesh data, that need to be rendered to find out if they're under the pointer
+		Vector<UINT32> renderedCandidates;
+
+		if (area.x <= 1 && area.y <= 1)
+		{
+			const Ray ray = cam->screenPointToRay(position);
+
+			Vector<SceneBVHRayHit> hits;
+			mHierarchy.rayCast(ray, hits);
+
+			float closestDistance = std::numeric_limits<float>::max();
+			Vector3 closestPosition;
+			Vector3 closestNormal;
+			HSceneObject closestSO;
+			UINT32 closestSubMesh = 0;
+			UINT32 closestId = 0;
+
+			Vector<SceneBVHRayHit> noDataHits;
+
+			// Hits are sorted by the distance to their bounds, so no object past the closest triangle hit can be nearer
+			for (auto& hit : hits)
+			{
+				if (hit.distance > closestDistance)
+					break;
+
+				if (isIgnored(hit.id))
+					continue;
+
+				const PickableRenderable& entry = mRenderables[mHierarchyIdToRenderable[hit.id]];
+
+				Ray localRay = ray;
+				localRay.transformAffine(entry.worldTransform.inverseAffine());
+
+				float localDistance;
+				Vector3 localNormal;
+				UINT32 subMesh;
+				const MeshRayCastResult result = rayCastMesh(entry.mesh, localRay, localDistance, localNormal, subMesh);
+				if (result == MeshRayCastResult::NoData)
+				{
+					noDataHits.push_back(hit);
+					continue;
+				}
+
+				if (result == MeshRayCastResult::Miss)
+					continue;
+
+				const Vector3 worldPosition = entry.worldTransform.multiplyAffine(localRay.getPoint(localDistance));
+				const float distance = worldPosition.distance(ray.getOrigin());
+				if (distance < closestDistance)
+				{
+					closestDistance = distance;
+					closestPosition = worldPosition;
+					closestNormal = localNormal;
+					closestSO = entry.renderable->SO();
+					closestSubMesh = subMesh;
+					closestId = hit.id;
+				}
+			}
+
+			// Only objects whose bounds are nearer than the closest triangle hit can be in front of it
+			for (auto& hit : noDataHits)
+			{
+				if (hit.distance <= closestDistance)
+					renderedCandidates.push_back(hit.id);
+			}
+
+			// The closest object found on the CPU is rendered with them, so the depth test decides which one is in front
+			if (!renderedCandidates.empty() && closestSO != nullptr)
+				renderedCandidates.push_back(closestId);
+
+			if (renderedCandidates.empty() && closestSO != nullptr)
+			{
+				results.push_back({ closestSO, closestSubMesh });
+
+				if (gatherSnapData)
+				{
+					operation->mSnapData.pickPosition = closestPosition;
+					operation->mSnapData.normal = closestNormal;
+				}
+			}
+		}
+		else
+		{
+			Vector<UINT32> candidates;
+			mHierarchy.intersect(getPickVolume(cam, position, area), candidates);
+
+			UnorderedSet<UINT64> added;
+			for (auto& id : candidates)
+			{
+				if (isIgnored(id))
+					continue;
+
+				HSceneObject so = mRenderables[mHierarchyIdToRenderable[id]].renderable->SO();
+				if (added.insert(so->getInstanceId()).second)
+					results.push_back({ so, WHOLE_OBJECT });
+			}
+		}
+
+		if (!renderedCandidates.empty())
+		{
+			queueRenderedPick(*operation, cam, position, area, renderedCandidates);
+			return operation;
+		}
+
+		// Gizmos don't have CPU side geometry and still need to be rendered. They are drawn over the scene, so they take
+		// precedence over renderables. Snapping only cares about scene geometry, so it skips them.
+		if (!gatherSnapData && GizmoManager::instance().hasPickableGizmos())
+		{
+			operation->mCPUElements = results;
+			queueRenderedPick(*operation, cam, position, area, Vector<UINT32>());
+
+			return operation;
+		}
+
+		setResults(*operation, results);
+		operation->mIsComplete = true;
+
+		return operation;
+	}
+
+	void ScenePicking::updateHierarchy()
+	{
+		// The scene doesn't report created or removed components, so renderables are only looked up once per frame. Any
+		// further picks in the same frame just refit the tracked renderables whose transform or mesh changed.
+		const UINT64 frameIdx = gTime().getFrameIdx();
+		if (frameIdx != mLastUpdateFrame)
+		{
+			mLastUpdateFrame = frameIdx;
+
+			Vector<HRenderable> renderables = gSceneManager().findComponents<CRenderable>(true);
+			for (auto& renderable : renderables)
+			{
+				auto iterFind = mRenderables.find(renderable.getInstanceId());
+				if (iterFind != mRenderables.end())
+				{
+					iterFind->second.lastUpdateFrame = frameIdx;
+					continue;
+				}
+
+				HMesh mesh = renderable->getMesh();
+				if (!mesh.isLoaded())
+					continue;
+
+				const HSceneObject& so = renderable->SO();
+
+				PickableRenderable entry;
+				entry.renderable = renderable;
+				entry.mesh = mesh;
+				entry.worldTransform = so->getWorldMatrix();
+				entry.transformHash = so->getTransformHash();
+				entry.hierarchyId = mHierarchy.add(getWorldBounds(entry));
+				entry.lastUpdateFrame = frameIdx;
+
+				if (entry.hierarchyId >= (UINT32)mHierarchyIdToRenderable.size())
+					mHierarchyIdToRenderable.resize(entry.hierarchyId + 1);
+
+				mHierarchyIdToRenderable[entry.hierarchyId] = renderable.getInstanceId();
+				mRenderables[renderable.getInstanceId()] = entry;
+			}
+		}
+
+		for (auto iter = mRenderables.begin(); iter != mRenderables.end();)
+		{
+			PickableRenderable& entry = iter->second;
+
+			// Renderables that were destroyed, disabled or lost their mesh since the last lookup
+			HMesh mesh;
+			if (entry.lastUpdateFrame == mLastUpdateFrame && !entry.renderable.isDestroyed())
+				mesh = entry.renderable->getMesh();
+
+			if (!mesh.isLoaded())
+			{
+				mHierarchy.remove(entry.hierarchyId);
+				iter = mRenderables.erase(iter);
+				continue;
+			}
+
+			const HSceneObject& so = entry.renderable->SO();
+			const UINT32 transformHash = so->getTransformHash();
+			if (entry.mesh != mesh || entry.transformHash != transformHash)
+			{
+				entry.mesh = mesh;
+				entry.worldTransform = so->getWorldMatrix();
+				entry.transformHash = transformHash;
+				mHierarchy.update(entry.hierarchyId, getWorldBounds(entry));
+			}
+
+			++iter;
+		}
+	}
+
+	AABox ScenePicking::getWorldBounds(const PickableRenderable& entry)
+	{
+		AABox bounds = entry.mesh->getProperties().getBounds().getBox();
+		bounds.transformAffine(entry.worldTransform);
+
+		return bounds;
+	}
+
+	ConvexVolume ScenePicking::getPickVolume(const SPtr<Camera>& cam, const Vector2I& position, const Vector2I& area)
+	{
+		const Ray corners[4] =
+		{
+			cam->screenPointToRay(position),
+			cam->screenPointToRay(Vector2I(position.x + area.x, position.y)),
+			cam->screenPointToRay(Vector2I(position.x + area.x, position.y + area.y)),
+			cam->screenPointToRay(Vector2I(position.x, position.y + area.y))
+		};
+
+		const Ray center = cam->screenPointToRay(Vector2I(position.x + area.x / 2, position.y + area.y / 2));
+		const Vector3 inside = center.getPoint(1.0f);
+
+		// Side planes go through the rays of two neighboring corners. Orthographic rays are parallel, so each plane is
+		// defined by the origin of one ray and points along both rays.
+		Vector<Plane> planes;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			const Ray& a = corners[i];
+			const Ray& b = corners[(i + 1) % 4];
+
+			Plane plane(a.getOrigin(), a.getPoint(1.0f), b.getPoint(1.0f));
+			if (plane.getDistance(inside) < 0.0f)
+				plane = Plane(-plane.normal, -plane.d);
+
+			planes.push_back(plane);
+		}
+
+		const ConvexVolume& frustum = cam->getWorldFrustum();
+		planes.push_back(frustum.getPlane(FRUSTUM_PLANE_NEAR));
+		planes.push_back(frustum.getPlane(FRUSTUM_PLANE_FAR));
+
+		return ConvexVolume(planes);
+	}
+
+	void ScenePicking::queueRenderedPick(ScenePickOperation& operation, const SPtr<Camera>& cam,
+		const Vector2I& position, const Vector2I& area, const Vector<UINT32>& candidates)
+	{
+		auto comparePickElement = [] (const ScenePicking::RenderablePickData& a, const ScenePicking::RenderablePickData& b)
 		{
 			// Sort by alpha setting first, then by cull mode, then by index
 			if (a.alpha == b.alpha)
@@ -87,123 +504,131 @@ namespace bs
 
 		Matrix4 viewProjMatrix = cam->getProjectionMatrixRS() * cam->getViewMatrix();
 
-		Vector<HRenderable> renderables = gSceneManager().findComponents<CRenderable>(true);
-		RenderableSet pickData(comparePickElement);
-		Map<UINT32, HSceneObject> idxToRenderable;
+		SPtr<RenderableSet> pickData = bs_shared_ptr_new<RenderableSet>(comparePickElement);
+		Vector<PickedElement>& indexToElement = operation.mIndexToElement;
 
-		for (auto& renderable : renderables)
+		for (auto& candidate : candidates)
 		{
+			const PickableRenderable& entry = mRenderables[mHierarchyIdToRenderable[candidate]];
+			const HRenderable& renderable = entry.renderable;
+			const HMesh& mesh = entry.mesh;
 			HSceneObject so = renderable->SO();
 
-			HMesh mesh = renderable->getMesh();
-			if (!mesh.isLoaded())
-				continue;
-
-			bool found = false;
-			for (UINT32 i = 0; i < (UINT32)ignoreRenderables.size(); i++)
+			for (UINT32 i = 0; i < mesh->getProperties().getNumSubMeshes(); i++)
 			{
-				if (ignoreRenderables[i] == so)
-				{
-					found = true;
-					break;
-				}
-			}
-			
-			if (found)
-				continue;
+				UINT32 idx = (UINT32)pickData->size();
 
-			Bounds worldBounds = mesh->getProperties().getBounds();
-			Matrix4 worldTransform = so->getWorldMatrix();
-			worldBounds.transformAffine(worldTransform);
+				bool useAlphaShader = false;
+				SPtr<RasterizerState> rasterizerState = RasterizerState::getDefault();
 
-			const ConvexVolume& frustum = cam->getWorldFrustum();
-			if (frustum.intersects(worldBounds.getSphere()))
-			{
-				// More precise with the box
-				if (frustum.intersects(worldBounds.getBox()))
+				HMaterial originalMat = renderable->getMaterial(i);
+				if (originalMat != nullptr && originalMat->getNumPasses() > 0)
 				{
-					for (UINT32 i = 0; i < mesh->getProperties().getNumSubMeshes(); i++)
+					SPtr<Pass> firstPass = originalMat->getPass(0); // Note: We only ever check the first pass, problem?
+					const auto& pipelineState = firstPass->getGraphicsPipelineState();
+					if(pipelineState)
 					{
-						UINT32 idx = (UINT32)pickData.size();
+						useAlphaShader = firstPass->hasBlending();
 
-						bool useAlphaShader = false;
-						SPtr<RasterizerState> rasterizerState = RasterizerState::getDefault();
-
-						HMaterial originalMat = renderable->getMaterial(i);
-						if (originalMat != nullptr && originalMat->getNumPasses() > 0)
-						{
-							SPtr<Pass> firstPass = originalMat->getPass(0); // Note: We only ever check the first pass, problem?
-							const auto& pipelineState = firstPass->getGraphicsPipelineState();
-							if(pipelineState)
-							{
-								useAlphaShader = firstPass->hasBlending();
-
-								if (pipelineState->getRasterizerState() == nullptr)
-									rasterizerState = RasterizerState::getDefault();
-								else
-									rasterizerState = pipelineState->getRasterizerState();
-							}
-						}
+						if (pipelineState->getRasterizerState() == nullptr)
+							rasterizerState = RasterizerState::getDefault();
+						else
+							rasterizerState = pipelineState->getRasterizerState();
+					}
+				}
 
-						CullingMode cullMode = rasterizerState->getProperties().getCullMode();
+				CullingMode cullMode = rasterizerState->getProperties().getCullMode();
 
-						HTexture mainTexture;
-						if (useAlphaShader)
-							mainTexture = originalMat->getTexture("gAlbedoTex");
+				HTexture mainTexture;
+				if (useAlphaShader)
+					mainTexture = originalMat->getTexture("gAlbedoTex");
 
-						idxToRenderable[idx] = so;
+				indexToElement.push_back({ so, i });
 
-						Matrix4 wvpTransform = viewProjMatrix * worldTransform;
-						pickData.insert({ mesh->getCore(), idx, wvpTransform, useAlphaShader, cullMode, mainTexture });
-					}
-				}
+				Matrix4 wvpTransform = viewProjMatrix * entry.worldTransform;
+				pickData->insert({ mesh->getCore(), i, idx, wvpTransform, useAlphaShader, cullMode, mainTexture });
 			}
 		}
 
-		UINT32 firstGizmoIdx = (UINT32)pickData.size();
+		UINT32 firstGizmoIdx = (UINT32)pickData->size();
 
+		// The set is shared with the command, so it stays alive until the core thread gets to it
+		ct::ScenePicking* core = mCore;
 		SPtr<ct::RenderTarget> target = cam->getViewport()->getTarget()->getCore();
-		gCoreThread().queueCommand(std::bind(&ct::ScenePicking::corePickingBegin, mCore, target,
-			cam->getViewport()->getArea(), std::cref(pickData), position, area));
+		Rect2 viewportArea = cam->getViewport()->getArea();
+		gCoreThread().queueCommand([core, target, viewportArea, pickData, position, area]()
+		{
+			core->corePickingBegin(target, viewportArea, *pickData, position, area);
+		});
 
-		GizmoManager::instance().renderForPicking(cam, [&](UINT32 inputIdx) { return encodeIndex(firstGizmoIdx + inputIdx); });
+		GizmoManager& gizmoManager = GizmoManager::instance();
+		gizmoManager.renderForPicking(cam, [&](UINT32 inputIdx) { return encodeIndex(firstGizmoIdx + inputIdx); });
 
-		AsyncOp op = gCoreThread().queueReturnCommand(std::bind(&ct::ScenePicking::corePickingEnd, mCore, target,
-			cam->getViewport()->getArea(), position, area, data != nullptr, _1));
-		gCoreThread().submit(true);
+		// Gizmos are redrawn every frame, so remember which object each one belongs to at the time of the pick
+		for (UINT32 i = 0; i < gizmoManager.getNumGizmos(); i++)
+			indexToElement.push_back({ gizmoManager.getSceneObject(i), WHOLE_OBJECT });
 
-		assert(op.hasCompleted());
+		operation.mCamera = cam;
+		operation.mPosition = position;
+		operation.mAsyncOp = gCoreThread().queueReturnCommand(std::bind(&ct::ScenePicking::corePickingEnd, mCore, target,
+			viewportArea, position, area, operation.mGatherSnapData, _1));
+	}
 
-		PickResults pickResults = op.getReturnValue<PickResults>();
-		if (data != nullptr)
+	void ScenePicking::completePick(ScenePickOperation& operation)
+	{
+		assert(operation.mAsyncOp.hasCompleted());
+
+		PickResults pickResults = operation.mAsyncOp.getReturnValue<PickResults>();
+		if (operation.mGatherSnapData)
+		{
+			operation.mSnapData.pickPosition = operation.mCamera->screenToWorldPointDeviceDepth(operation.mPosition,
+				pickResults.depth);
+			operation.mSnapData.normal = pickResults.normal;
+		}
+
+		Vector<PickedElement> elements;
+		for (auto& selectedObjectIdx : pickResults.objects)
 		{
-			data->pickPosition = cam->screenToWorldPointDeviceDepth(position, pickResults.depth);
-			data->normal = pickResults.normal;
+			if (selectedObjectIdx >= (UINT32)operation.mIndexToElement.size())
+				continue;
+
+			const PickedElement& element = operation.mIndexToElement[selectedObjectIdx];
+			if (element.sceneObject)
+				elements.push_back(element);
 		}
 
-		Vector<UINT32> selectedObjects = pickResults.objects;
-		Vector<HSceneObject> results;
+		elements.insert(elements.end(), operation.mCPUElements.begin(), operation.mCPUElements.end());
+		setResults(operation, elements);
+
+		operation.mIsComplete = true;
+		operation.mCamera = nullptr;
+		operation.mIndexToElement.clear();
+		operation.mCPUElements.clear();
+	}
+
+	void ScenePicking::setResults(ScenePickOperation& operation, const Vector<PickedElement>& elements)
+	{
+		operation.mElements.clear();
+		operation.mObjects.clear();
 
-		for (auto& selectedObjectIdx : selectedObjects)
+		for (auto& element : elements)
 		{
-			if (selectedObjectIdx < firstGizmoIdx)
+			auto isSame = [&element](const PickedElement& other)
 			{
-				auto iterFind = idxToRenderable.find(selectedObjectIdx);
+				return other.sceneObject == element.sceneObject && other.subMesh == element.subMesh;
+			};
 
-				if (iterFind != idxToRenderable.end())
-					results.push_back(iterFind->second);
-			}
-			else
-			{
-				UINT32 gizmoIdx = selectedObjectIdx - firstGizmoIdx;
+			if (std::find_if(operation.mElements.begin(), operation.mElements.end(), isSame) != operation.mElements.end())
+				continue;
 
-				HSceneObject so = GizmoManager::instance().getSceneObject(gizmoIdx);
-				if (so)
-					results.push_back(so);
+			operation.mElements.push_back(element);
+
+			if (std::find(operation.mObjects.begin(), operation.mObjects.end(), element.sceneObject) ==
+				operation.mObjects.end())
+			{
+				operation.mObjects.push_back(element.sceneObject);
 			}
 		}
-
-		return results;
 	}
 
 	Color ScenePicking::encodeIndex(UINT32 index)
@@ -212,9 +637,9 @@ namespace bs
 		encoded.r = (index & 0xFF) / 255.0f;
 		encoded.g = ((index >> 8) & 0xFF) / 255.0f;
 		encoded.b = ((index >> 16) & 0xFF) / 255.0f;
-		encoded.a = 1.0f;
+		encoded.a = ((index >> 24) & 0xFF) / 255.0f;
 
-		if (((index >> 24) & 0xFF))
+		if (index == NO_OBJECT_INDEX)
 			LOGERR("Index when picking out of valid range.");
 
 		return encoded;
@@ -225,13 +650,16 @@ namespace bs
 		UINT32 r = Math::roundToInt(color.r * 255.0f);
 		UINT32 g = Math::roundToInt(color.g * 255.0f);
 		UINT32 b = Math::roundToInt(color.b * 255.0f);
+		UINT32 a = Math::roundToInt(color.a * 255.0f);
 
-		return (r & 0xFF) | ((g & 0xFF) << 8) | ((b & 0xFF) << 16);
+		return (r & 0xFF) | ((g & 0xFF) << 8) | ((b & 0xFF) << 16) | ((a & 0xFF) << 24);
 	}
 
 	namespace ct
 	{
 	const float ScenePicking::ALPHA_CUTOFF = 0.5f;
+	const UINT32 ScenePicking::MAX_POOLED_TARGETS = 4;
+	const UINT64 ScenePicking::POOLED_TARGET_LIFETIME = 64;
 
 	PickingParamBlockDef gPickingParamBlockDef;
 
@@ -252,29 +680,10 @@ namespace bs
 
 		SPtr<RenderTexture> rtt = std::static_pointer_cast<RenderTexture>(target);
 
-		SPtr<Texture> outputTexture = rtt->getColorTexture(0);
-		TextureProperties outputTextureProperties = outputTexture->getProperties();
-
-		TEXTURE_DESC normalTexDesc;
-		normalTexDesc.type = TEX_TYPE_2D;
-		normalTexDesc.width = outputTextureProperties.getWidth();
-		normalTexDesc.height = outputTextureProperties.getHeight();
-		normalTexDesc.format = PF_RG11B10F;
-		normalTexDesc.usage = TU_RENDERTARGET;
-
-		SPtr<Texture> normalsTexture = Texture::create(normalTexDesc);
-		SPtr<Texture> depthTexture = rtt->getDepthStencilTexture();
-
-		RENDER_TEXTURE_DESC pickingMRT;
-		pickingMRT.colorSurfaces[0].face = 0;
-		pickingMRT.colorSurfaces[0].texture = outputTexture;
-		pickingMRT.colorSurfaces[1].face = 0;
-		pickingMRT.colorSurfaces[1].texture = normalsTexture;
-
-		pickingMRT.depthStencilSurface.face = 0;
-		pickingMRT.depthStencilSurface.texture = depthTexture;
-		
-		mPickingTexture = RenderTexture::create(pickingMRT);
+		const TextureProperties& colorProps = rtt->getColorTexture(0)->getProperties();
+		const TextureProperties& depthProps = rtt->getDepthStencilTexture()->getProperties();
+		mPickingTexture = getPickingTarget(colorProps.getWidth(), colorProps.getHeight(), colorProps.getFormat(),
+			depthProps.getFormat());
 
 		rs.setRenderTarget(mPickingTexture);
 		rs.setViewport(viewportArea);
@@ -354,10 +763,8 @@ namespace bs
 			UINT32 renderableIdx = renderableIndices[idx];
 			gRendererUtility().setPassParams(mParamSets[typeIdx][renderableIdx]);
 
-			UINT32 numSubmeshes = renderable.mesh->getProperties().getNumSubMeshes();
-
-			for (UINT32 i = 0; i < numSubmeshes; i++)
-				gRendererUtility().draw(renderable.mesh, renderable.mesh->getProperties().getSubMesh(i));
+			// Each sub-mesh has its own identifier, so the pick can report which one was hit
+			gRendererUtility().draw(renderable.mesh, renderable.mesh->getProperties().getSubMesh(renderable.subMesh));
 
 			idx++;
 		}
@@ -365,6 +772,75 @@ namespace bs
 		bs_stack_free(renderableIndices);
 	}
 
+	SPtr<RenderTexture> ScenePicking::getPickingTarget(UINT32 width, UINT32 height, PixelFormat colorFormat,
+		PixelFormat depthFormat)
+	{
+		mNumPicks++;
+
+		// Targets not used by recent picks belong to viewports that were resized or closed since
+		for (auto iter = mTargetPool.begin(); iter != mTargetPool.end();)
+		{
+			if (mNumPicks - iter->lastUsed > POOLED_TARGET_LIFETIME)
+				iter = mTargetPool.erase(iter);
+			else
+				++iter;
+		}
+
+		for (auto& entry : mTargetPool)
+		{
+			if (entry.width == width && entry.height == height && entry.colorFormat == colorFormat &&
+				entry.depthFormat == depthFormat)
+			{
+				entry.lastUsed = mNumPicks;
+				return entry.renderTexture;
+			}
+		}
+
+		// Once the pool is full, replace the least recently used target
+		if (mTargetPool.size() >= MAX_POOLED_TARGETS)
+		{
+			auto iterOldest = std::min_element(mTargetPool.begin(), mTargetPool.end(),
+				[](const PickingTarget& a, const PickingTarget& b) { return a.lastUsed < b.lastUsed; });
+
+			mTargetPool.erase(iterOldest);
+		}
+
+		TEXTURE_DESC colorTexDesc;
+		colorTexDesc.type = TEX_TYPE_2D;
+		colorTexDesc.width = width;
+		colorTexDesc.height = height;
+		colorTexDesc.format = colorFormat;
+		colorTexDesc.usage = TU_RENDERTARGET;
+
+		TEXTURE_DESC normalTexDesc = colorTexDesc;
+		normalTexDesc.format = PF_RG11B10F;
+
+		TEXTURE_DESC depthTexDesc = colorTexDesc;
+		depthTexDesc.format = depthFormat;
+		depthTexDesc.usage = TU_DEPTHSTENCIL;
+
+		PickingTarget target;
+		target.width = width;
+		target.height = height;
+		target.colorFormat = colorFormat;
+		target.depthFormat = depthFormat;
+		target.lastUsed = mNumPicks;
+
+		RENDER_TEXTURE_DESC pickingMRT;
+		pickingMRT.colorSurfaces[0].face = 0;
+		pickingMRT.colorSurfaces[0].texture = Texture::create(colorTexDesc);
+		pickingMRT.colorSurfaces[1].face = 0;
+		pickingMRT.colorSurfaces[1].texture = Texture::create(normalTexDesc);
+
+		pickingMRT.depthStencilSurface.face = 0;
+		pickingMRT.depthStencilSurface.texture = Texture::create(depthTexDesc);
+
+		target.renderTexture = RenderTexture::create(pickingMRT);
+		mTargetPool.push_back(target);
+
+		return target.renderTexture;
+	}
+
 	void ScenePicking::corePickingEnd(const SPtr<RenderTarget>& target, const Rect2& viewportArea, 
 		const Vector2I& position, const Vector2I& area, bool gatherSnapData, AsyncOp& asyncOp)
 	{
@@ -388,7 +864,7 @@ namespace bs
 		{
 			mPickingTexture = nullptr;
 
-			asyncOp._completeOperation(Vector<UINT32>());
+			asyncOp._completeOperation(PickResults());
 			return;
 		}
 
@@ -419,7 +895,7 @@ namespace bs
 				Color color = outputPixelData->getColorAt(x, y);
 				UINT32 index = bs::ScenePicking::decodeIndex(color);
 
-				if (index == 0x00FFFFFF) // Nothing selected
+				if (index == bs::ScenePicking::NO_OBJECT_INDEX) // Nothing selected
 					continue;
 
 				auto iterFind = selectionScores.find(index);
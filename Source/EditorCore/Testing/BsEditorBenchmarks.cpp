@@ -0,0 +1,143 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Testing/BsEditorBenchmarks.h"
+#include "Library/BsProjectLibrary.h"
+#include "Utility/BsTimer.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	void EditorBenchmarks::run()
+	{
+		benchmarkLibraryEntryLookup();
+	}
+
+	void EditorBenchmarks::benchmarkLibraryEntryLookup()
+	{
+		// Lookup as performed before directories had a child map, used as a baseline
+		auto findChildLinear = [](const ProjectLibrary::DirectoryEntry* dirEntry, const String& name)
+		{
+			for(auto& child : dirEntry->mChildren)
+			{
+				if(Path::comparePathElem(name, child->elementName))
+					return child;
+			}
+
+			return (ProjectLibrary::LibraryEntry*)nullptr;
+		};
+
+		auto findChildHashed = [](const ProjectLibrary::DirectoryEntry* dirEntry, const String& name)
+		{
+			return dirEntry->findChild(name);
+		};
+
+		// Wide hierarchy: a single directory with many files
+		static constexpr UINT32 NUM_WIDE_ENTRIES = 10000;
+
+		ProjectLibrary::DirectoryEntry wideRoot("Resources/", "Resources", nullptr);
+		Vector<String> wideNames;
+		for(UINT32 i = 0; i < NUM_WIDE_ENTRIES; i++)
+		{
+			String name = "File" + toString(i) + ".asset";
+			wideRoot.addChild(bs_new<ProjectLibrary::FileEntry>(Path("Resources/" + name), name, &wideRoot));
+
+			// Look up using a different case than the entries were registered with
+			StringUtil::toUpperCase(name);
+			wideNames.push_back(name);
+		}
+
+		Timer timer;
+		UINT32 numFoundLinear = 0;
+		for(auto& name : wideNames)
+			numFoundLinear += findChildLinear(&wideRoot, name) != nullptr ? 1 : 0;
+
+		const UINT64 wideLinearTime = timer.getMicroseconds();
+
+		timer.reset();
+		UINT32 numFoundHashed = 0;
+		for(auto& name : wideNames)
+			numFoundHashed += findChildHashed(&wideRoot, name) != nullptr ? 1 : 0;
+
+		const UINT64 wideHashedTime = timer.getMicroseconds();
+
+		for(auto& child : wideRoot.mChildren)
+			bs_delete(static_cast<ProjectLibrary::FileEntry*>(child));
+
+		// Deep hierarchy: a chain of directories, each also containing a few sibling files
+		static constexpr UINT32 NUM_DEEP_LEVELS = 20;
+		static constexpr UINT32 NUM_SIBLINGS = 16;
+		static constexpr UINT32 NUM_DEEP_ITERATIONS = 1000;
+
+		ProjectLibrary::DirectoryEntry deepRoot("Resources/", "Resources", nullptr);
+		Vector<ProjectLibrary::FileEntry*> deepFiles;
+		Vector<ProjectLibrary::DirectoryEntry*> deepDirectories;
+		Vector<String> deepNames;
+
+		String currentPath = "Resources/";
+		ProjectLibrary::DirectoryEntry* current = &deepRoot;
+		for(UINT32 i = 0; i < NUM_DEEP_LEVELS; i++)
+		{
+			for(UINT32 j = 0; j < NUM_SIBLINGS; j++)
+			{
+				const String name = "Sibling" + toString(j);
+				auto sibling = bs_new<ProjectLibrary::FileEntry>(Path(currentPath + name), name, current);
+
+				current->addChild(sibling);
+				deepFiles.push_back(sibling);
+			}
+
+			const String name = "Level" + toString(i);
+			currentPath += name + "/";
+
+			auto child = bs_new<ProjectLibrary::DirectoryEntry>(Path(currentPath), name, current);
+			current->addChild(child);
+
+			deepDirectories.push_back(child);
+			deepNames.push_back(name);
+
+			current = child;
+		}
+
+		auto findDeep = [&deepRoot, &deepNames](auto findChildFunc)
+		{
+			ProjectLibrary::LibraryEntry* entry = &deepRoot;
+			for(auto& name : deepNames)
+			{
+				if(entry == nullptr || entry->type != ProjectLibrary::LibraryEntryType::Directory)
+					return (ProjectLibrary::LibraryEntry*)nullptr;
+
+				entry = findChildFunc(static_cast<ProjectLibrary::DirectoryEntry*>(entry), name);
+			}
+
+			return entry;
+		};
+
+		timer.reset();
+		UINT32 numFoundDeepLinear = 0;
+		for(UINT32 i = 0; i < NUM_DEEP_ITERATIONS; i++)
+			numFoundDeepLinear += findDeep(findChildLinear) == current ? 1 : 0;
+
+		const UINT64 deepLinearTime = timer.getMicroseconds();
+
+		timer.reset();
+		UINT32 numFoundDeepHashed = 0;
+		for(UINT32 i = 0; i < NUM_DEEP_ITERATIONS; i++)
+			numFoundDeepHashed += findDeep(findChildHashed) == current ? 1 : 0;
+
+		const UINT64 deepHashedTime = timer.getMicroseconds();
+
+		for(auto& entry : deepFiles)
+			bs_delete(entry);
+
+		for(auto& entry : deepDirectories)
+			bs_delete(entry);
+
+		// Found counts are reported so the lookups can't be optimized away, and so a broken lookup is easy to spot
+		LOGDBG("Library entry lookup, " + toString(NUM_WIDE_ENTRIES) + " wide: " + toString(wideLinearTime) +
+			" us linear (" + toString(numFoundLinear) + " found), " + toString(wideHashedTime) + " us hashed (" +
+			toString(numFoundHashed) + " found). " + toString(NUM_DEEP_LEVELS) + " deep, " +
+			toString(NUM_DEEP_ITERATIONS) + " times: " + toString(deepLinearTime) + " us linear (" +
+			toString(numFoundDeepLinear) + " found), " + toString(deepHashedTime) + " us hashed (" +
+			toString(numFoundDeepHashed) + " found).");
+	}
+}
@@ -0,0 +1,34 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Testing-Editor
+	 *  @{
+	 */
+	/** @cond TEST */
+
+	/**
+	 * Contains a set of microbenchmarks for the editor. Unlike the unit tests they don't pass or fail, and only log their
+	 * timings. They are not run automatically.
+	 */
+	class BS_ED_EXPORT EditorBenchmarks
+	{
+	public:
+		/** Runs all the benchmarks and logs their results. */
+		static void run();
+
+	private:
+		/**
+		 * Compares project library child entry lookup against the linear scan it replaced, on a 10k entry wide and a 20
+		 * level deep directory hierarchy.
+		 */
+		static void benchmarkLibraryEntryLookup();
+	};
+
+	/** @endcond */
+	/** @} */
+}
@@ -14,7 +14,24 @@
 #include "Resources/BsResources.h"
 #include "Scene/BsPrefabDiff.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 #include "Scene/BsSceneManager.h"
+#include "Utility/BsContentHash.h"
+#include "Library/BsProjectLibrarySearchIndex.h"
+#include "Library/BsResourceDependencyGraph.h"
+#include "Library/BsProjectLibraryJournal.h"
+#include "Library/BsProjectResourceMeta.h"
+#include "Library/BsResourceUUIDIndex.h"
+#include "Library/BsProjectLibrary.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsIconGenerator.h"
+#include "Build/BsBuildManifest.h"
+#include "Scene/BsSceneBVH.h"
+#include "Scene/BsGizmoInstanceBuffer.h"
+#include "Math/BsRay.h"
+#include "Math/BsConvexVolume.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsTexture.h"
 
 namespace bs
 {
@@ -405,6 +422,26 @@ namespace bs
 		return TestComponentD::getRTTIStatic();
 	}
 
+	/** Reads the entire contents of a file used by a test. */
+	static Vector<UINT8> readTestFile(const Path& path)
+	{
+		SPtr<DataStream> stream = FileSystem::openFile(path, true);
+
+		Vector<UINT8> data(stream->size());
+		stream->read(data.data(), data.size());
+		stream->close();
+
+		return data;
+	}
+
+	/** Replaces the contents of a file used by a test, e.g. with a corrupted version of the contents. */
+	static void writeTestFile(const Path& path, const Vector<UINT8>& data)
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		stream->write(data.data(), data.size());
+		stream->close();
+	}
+
 	EditorTestSuite::EditorTestSuite()
 	{
 		BS_ADD_TEST(EditorTestSuite::SceneObjectRecord_UndoRedo);
@@ -413,6 +450,17 @@ namespace bs
 		BS_ADD_TEST(EditorTestSuite::TestPrefabComplex);
 		BS_ADD_TEST(EditorTestSuite::TestPrefabDiff);
 		BS_ADD_TEST(EditorTestSuite::TestFrameAlloc);
+		BS_ADD_TEST(EditorTestSuite::TestContentHash);
+		BS_ADD_TEST(EditorTestSuite::TestLibrarySearchIndex);
+		BS_ADD_TEST(EditorTestSuite::TestLibraryEntryLookup);
+		BS_ADD_TEST(EditorTestSuite::TestResourceDependencyGraph);
+		BS_ADD_TEST(EditorTestSuite::TestProjectLibraryJournal);
+		BS_ADD_TEST(EditorTestSuite::TestResourceUUIDIndex);
+		BS_ADD_TEST(EditorTestSuite::TestImportCancellation);
+		BS_ADD_TEST(EditorTestSuite::TestIconDownsample);
+		BS_ADD_TEST(EditorTestSuite::TestBuildManifestDiff);
+		BS_ADD_TEST(EditorTestSuite::TestSceneBVH);
+		BS_ADD_TEST(EditorTestSuite::TestGizmoInstanceBuffer);
 	}
 
 	void EditorTestSuite::SceneObjectRecord_UndoRedo()
@@ -807,4 +855,934 @@ namespace bs
 		alloc.free(a13);
 		alloc.clear();
 	}
+
+	void EditorTestSuite::TestContentHash()
+	{
+		// Reference XXH64 values
+		BS_TEST_ASSERT(ContentHash::hash(nullptr, 0) == 0xEF46DB3751D8E999ULL);
+		BS_TEST_ASSERT(ContentHash::hash("abc", 3) == 0x44BC2CF5AD770999ULL);
+
+		UINT8 data[100];
+		for(UINT32 i = 0; i < 100; i++)
+			data[i] = (UINT8)(i * 7 + 3);
+
+		const UINT64 fullHash = ContentHash::hash(data, sizeof(data));
+
+		// Incremental hashing must match, regardless of how the data is split
+		ContentHash incremental;
+		incremental.update(data, 5);
+		incremental.update(data + 5, 40);
+		incremental.update(data + 45, 1);
+		incremental.update(data + 46, 54);
+
+		BS_TEST_ASSERT(incremental.digest() == fullHash);
+
+		data[50]++;
+		BS_TEST_ASSERT(ContentHash::hash(data, sizeof(data)) != fullHash);
+		BS_TEST_ASSERT(ContentHash::combine(1, 2) != ContentHash::combine(2, 1));
+	}
+
+	void EditorTestSuite::TestLibrarySearchIndex()
+	{
+		BS_TEST_ASSERT(ProjectLibrarySearchIndex::matchWildcard("*", ""));
+		BS_TEST_ASSERT(ProjectLibrarySearchIndex::matchWildcard("a*c", "abbc"));
+		BS_TEST_ASSERT(!ProjectLibrarySearchIndex::matchWildcard("a*c", "abcd"));
+		BS_TEST_ASSERT(ProjectLibrarySearchIndex::matchWildcard("*b*b", "abab"));
+
+		ProjectLibrary::DirectoryEntry root("Resources/", "Resources", nullptr);
+		ProjectLibrary::FileEntry texture("Resources/Brick.png", "Brick.png", &root);
+		ProjectLibrary::FileEntry mesh("Resources/BrickWall.fbx", "BrickWall.fbx", &root);
+		ProjectLibrary::FileEntry script("Resources/Wall.cs", "Wall.cs", &root);
+
+		ProjectLibrarySearchIndex index;
+		index.addEntry(&texture);
+		index.addEntry(&mesh);
+		index.addEntry(&script);
+
+		// Matches are case insensitive and sorted by name
+		Vector<ProjectLibrary::LibraryEntry*> found = index.search("*brick*", {});
+		BS_TEST_ASSERT(found.size() == 2);
+		BS_TEST_ASSERT(found[0] == &texture && found[1] == &mesh);
+
+		BS_TEST_ASSERT(index.search("*", {}).size() == 3);
+		BS_TEST_ASSERT(index.search("*wall*", {}).size() == 2);
+		BS_TEST_ASSERT(index.search("wall*", {}).size() == 1);
+		BS_TEST_ASSERT(index.search("*stone*", {}).empty());
+
+		// Entries without meta-data contain no resources of any type
+		BS_TEST_ASSERT(index.search("*", { TID_Texture }).empty());
+
+		index.removeEntry(&mesh);
+		found = index.search("*brick*", {});
+		BS_TEST_ASSERT(found.size() == 1 && found[0] == &texture);
+
+		// Renamed entries are re-added
+		script.elementName = "Stone.cs";
+		index.addEntry(&script);
+		BS_TEST_ASSERT(index.search("*wall*", {}).empty());
+		BS_TEST_ASSERT(index.search("*stone*", {}).size() == 1);
+	}
+
+	void EditorTestSuite::TestLibraryEntryLookup()
+	{
+		// Lookup as performed before directories had a child map, used as a reference
+		auto findChildLinear = [](const ProjectLibrary::DirectoryEntry* dirEntry, const String& name)
+		{
+			for(auto& child : dirEntry->mChildren)
+			{
+				if(Path::comparePathElem(name, child->elementName))
+					return child;
+			}
+
+			return (ProjectLibrary::LibraryEntry*)nullptr;
+		};
+
+		auto findChildHashed = [](const ProjectLibrary::DirectoryEntry* dirEntry, const String& name)
+		{
+			return dirEntry->findChild(name);
+		};
+
+		// Wide hierarchy: a single directory with many files
+		static constexpr UINT32 NUM_WIDE_ENTRIES = 10000;
+
+		ProjectLibrary::DirectoryEntry wideRoot("Resources/", "Resources", nullptr);
+		Vector<String> wideNames;
+		for(UINT32 i = 0; i < NUM_WIDE_ENTRIES; i++)
+		{
+			String name = "File" + toString(i) + ".asset";
+			wideRoot.addChild(bs_new<ProjectLibrary::FileEntry>(Path("Resources/" + name), name, &wideRoot));
+
+			// Look up using a different case than the entries were registered with
+			StringUtil::toUpperCase(name);
+			wideNames.push_back(name);
+		}
+
+		UINT32 numFound = 0;
+		for(auto& name : wideNames)
+		{
+			ProjectLibrary::LibraryEntry* entry = findChildHashed(&wideRoot, name);
+			if(entry != nullptr && entry == findChildLinear(&wideRoot, name))
+				numFound++;
+		}
+
+		BS_TEST_ASSERT(numFound == NUM_WIDE_ENTRIES);
+		BS_TEST_ASSERT(wideRoot.findChild("File10000.asset") == nullptr);
+
+		// Removed entries can no longer be found, and lookups of the remaining entries are unaffected
+		ProjectLibrary::LibraryEntry* removedEntry = wideRoot.findChild("File0.asset");
+		wideRoot.removeChild(removedEntry);
+		bs_delete(static_cast<ProjectLibrary::FileEntry*>(removedEntry));
+
+		BS_TEST_ASSERT(wideRoot.findChild("File0.asset") == nullptr);
+		BS_TEST_ASSERT(wideRoot.findChild("file1.asset") != nullptr);
+
+		for(auto& child : wideRoot.mChildren)
+			bs_delete(static_cast<ProjectLibrary::FileEntry*>(child));
+
+		// Deep hierarchy: a chain of directories, each also containing a few sibling files
+		static constexpr UINT32 NUM_DEEP_LEVELS = 20;
+		static constexpr UINT32 NUM_SIBLINGS = 16;
+
+		ProjectLibrary::DirectoryEntry deepRoot("Resources/", "Resources", nullptr);
+		Vector<ProjectLibrary::FileEntry*> deepFiles;
+		Vector<ProjectLibrary::DirectoryEntry*> deepDirectories;
+		Vector<String> deepNames;
+
+		String currentPath = "Resources/";
+		ProjectLibrary::DirectoryEntry* current = &deepRoot;
+		for(UINT32 i = 0; i < NUM_DEEP_LEVELS; i++)
+		{
+			for(UINT32 j = 0; j < NUM_SIBLINGS; j++)
+			{
+				const String name = "Sibling" + toString(j);
+				auto sibling = bs_new<ProjectLibrary::FileEntry>(Path(currentPath + name), name, current);
+
+				current->addChild(sibling);
+				deepFiles.push_back(sibling);
+			}
+
+			const String name = "Level" + toString(i);
+			currentPath += name + "/";
+
+			auto child = bs_new<ProjectLibrary::DirectoryEntry>(Path(currentPath), name, current);
+			current->addChild(child);
+
+			deepDirectories.push_back(child);
+			deepNames.push_back(name);
+
+			current = child;
+		}
+
+		auto findDeep = [&deepRoot, &deepNames](auto findChildFunc)
+		{
+			ProjectLibrary::LibraryEntry* entry = &deepRoot;
+			for(auto& name : deepNames)
+			{
+				if(entry == nullptr || entry->type != ProjectLibrary::LibraryEntryType::Directory)
+					return (ProjectLibrary::LibraryEntry*)nullptr;
+
+				entry = findChildFunc(static_cast<ProjectLibrary::DirectoryEntry*>(entry), name);
+			}
+
+			return entry;
+		};
+
+		ProjectLibrary::LibraryEntry* found = findDeep(findChildHashed);
+		BS_TEST_ASSERT(found != nullptr && found == current);
+		BS_TEST_ASSERT(found == findDeep(findChildLinear));
+
+		for(auto& entry : deepFiles)
+			bs_delete(entry);
+
+		for(auto& entry : deepDirectories)
+			bs_delete(entry);
+	}
+
+	void EditorTestSuite::TestResourceDependencyGraph()
+	{
+		// Include chain (a <- b <- c), a diamond (a <- d, a <- e, d & e <- f) and an unrelated resource (g <- h)
+		const UUID a = UUIDGenerator::generateRandom();
+		const UUID b = UUIDGenerator::generateRandom();
+		const UUID c = UUIDGenerator::generateRandom();
+		const UUID d = UUIDGenerator::generateRandom();
+		const UUID e = UUIDGenerator::generateRandom();
+		const UUID f = UUIDGenerator::generateRandom();
+		const UUID g = UUIDGenerator::generateRandom();
+		const UUID h = UUIDGenerator::generateRandom();
+
+		ResourceDependencyGraph graph;
+		graph.setDependencies(b, { a });
+		graph.setDependencies(c, { b });
+		graph.setDependencies(d, { a });
+		graph.setDependencies(e, { a });
+		graph.setDependencies(f, { d, e });
+		graph.setDependencies(h, { g });
+
+		auto indexOf = [](const Vector<UUID>& values, const UUID& value)
+		{
+			return (UINT32)(std::find(values.begin(), values.end(), value) - values.begin());
+		};
+
+		// Every dependant is reported exactly once, after all of its dependencies
+		Vector<UUID> dependants = graph.getTransitiveDependants({ a });
+		BS_TEST_ASSERT(dependants.size() == 5);
+		BS_TEST_ASSERT(indexOf(dependants, b) < indexOf(dependants, c));
+		BS_TEST_ASSERT(indexOf(dependants, d) < indexOf(dependants, f));
+		BS_TEST_ASSERT(indexOf(dependants, e) < indexOf(dependants, f));
+		BS_TEST_ASSERT(indexOf(dependants, h) == (UINT32)dependants.size());
+
+		// Changed resources are not reported, even if they depend on each other
+		dependants = graph.getTransitiveDependants({ a, b });
+		BS_TEST_ASSERT(dependants.size() == 4);
+		BS_TEST_ASSERT(indexOf(dependants, b) == (UINT32)dependants.size());
+
+		// Replacing dependencies removes the old edges
+		graph.setDependencies(f, { g });
+		BS_TEST_ASSERT(graph.getTransitiveDependants({ a }).size() == 4);
+		BS_TEST_ASSERT(graph.getTransitiveDependants({ g }).size() == 2);
+
+		graph.removeDependencies(h);
+		BS_TEST_ASSERT(graph.getDependants(g).size() == 1);
+
+		// Cycles don't prevent the remaining dependants from being reported
+		graph.setDependencies(a, { c });
+		BS_TEST_ASSERT(graph.getTransitiveDependants({ d }).empty());
+		BS_TEST_ASSERT(graph.getTransitiveDependants({ b }).size() == 4);
+	}
+
+	void EditorTestSuite::TestProjectLibraryJournal()
+	{
+		Path journalPath = FileSystem::getTempDirectoryPath();
+		journalPath.setFilename("TestProjectLibraryJournal.asset");
+
+		if(FileSystem::exists(journalPath))
+			FileSystem::remove(journalPath);
+
+		using EntryType = ProjectLibrary::LibraryEntryType;
+
+		auto createEntry = [](const String& path, EntryType type, const SPtr<ProjectFileMeta>& meta)
+		{
+			ProjectLibraryJournalEntry entry;
+			entry.path = path;
+			entry.type = type;
+			entry.lastUpdateTime = 100;
+			entry.metaModifiedTime = 200;
+			entry.meta = meta;
+
+			return entry;
+		};
+
+		auto readPaths = [](ProjectLibraryJournal& journal)
+		{
+			Vector<String> paths;
+
+			Vector<ProjectLibraryJournalEntry> entries;
+			if(journal.read(entries))
+			{
+				for(auto& entry : entries)
+					paths.push_back(entry.path);
+			}
+
+			return paths;
+		};
+
+		// Preview icons are kept in the .meta files, and must not end up in the journal
+		const UUID uuid = UUIDGenerator::generateRandom();
+		ProjectResourceIcons icons;
+		icons.icon16 = Texture::create(PixelData::create(16, 16, 1, PF_RGBA8));
+
+		SPtr<ProjectFileMeta> meta = ProjectFileMeta::create(nullptr);
+		meta->add(ProjectResourceMeta::create("x", uuid, TID_Texture, icons, nullptr));
+
+		ProjectLibraryJournal journal(journalPath);
+		BS_TEST_ASSERT(readPaths(journal).empty());
+		BS_TEST_ASSERT(journal.needsCompaction());
+
+		// Snapshot, sorted so parents precede their children
+		journal.compact({
+			createEntry("A", EntryType::Directory, nullptr),
+			createEntry("A/x.png", EntryType::File, meta),
+			createEntry("AB", EntryType::Directory, nullptr),
+			createEntry("AB/y.png", EntryType::File, nullptr),
+			createEntry("b.png", EntryType::File, nullptr)
+		});
+
+		BS_TEST_ASSERT(!journal.needsCompaction());
+		BS_TEST_ASSERT(meta->getResourceMetaData()[0]->getPreviewIcons().icon16.isLoaded(false));
+
+		Vector<ProjectLibraryJournalEntry> entries;
+		BS_TEST_ASSERT(journal.read(entries));
+		BS_TEST_ASSERT(entries.size() == 5);
+		if(entries.size() == 5)
+		{
+			BS_TEST_ASSERT(entries[0].path == "A" && entries[0].type == EntryType::Directory);
+			BS_TEST_ASSERT(entries[1].path == "A/x.png" && entries[1].type == EntryType::File);
+			BS_TEST_ASSERT(entries[1].lastUpdateTime == 100 && entries[1].metaModifiedTime == 200);
+			BS_TEST_ASSERT(entries[4].path == "b.png" && entries[4].meta == nullptr);
+
+			const SPtr<ProjectFileMeta>& readMeta = entries[1].meta;
+			BS_TEST_ASSERT(readMeta != nullptr && readMeta->getResourceMetaData().size() == 1);
+			if(readMeta != nullptr && readMeta->getResourceMetaData().size() == 1)
+			{
+				const SPtr<ProjectResourceMeta>& resourceMeta = readMeta->getResourceMetaData()[0];
+				BS_TEST_ASSERT(resourceMeta->getUUID() == uuid);
+				BS_TEST_ASSERT(resourceMeta->getTypeID() == TID_Texture);
+				BS_TEST_ASSERT(!resourceMeta->getPreviewIcons().icon16.isLoaded(false));
+			}
+		}
+
+		// Appended records replay over the snapshot. Removing a directory (regardless of case) removes its children,
+		// but not entries that merely share a name prefix.
+		journal.writeUpdate(createEntry("A/z.png", EntryType::File, nullptr));
+		journal.writeUpdate(createEntry("b.png", EntryType::File, meta));
+		journal.writeRemove("a");
+		journal.writeUpdate(createEntry("C", EntryType::Directory, nullptr));
+		journal.flush();
+
+		Vector<String> expectedPaths = { "AB", "AB/y.png", "b.png", "C" };
+		BS_TEST_ASSERT(readPaths(journal) == expectedPaths);
+		BS_TEST_ASSERT(!journal.needsCompaction());
+
+		entries.clear();
+		journal.read(entries);
+		BS_TEST_ASSERT(entries.size() == 4 && entries[2].meta != nullptr);
+
+		// A partially written record at the end is discarded, along with anything following it
+		const Vector<UINT8> validData = readTestFile(journalPath);
+
+		journal.writeUpdate(createEntry("D", EntryType::Directory, nullptr));
+		journal.flush();
+
+		Vector<UINT8> data = readTestFile(journalPath);
+		BS_TEST_ASSERT(data.size() > validData.size());
+
+		data.resize(data.size() - 3);
+		writeTestFile(journalPath, data);
+
+		BS_TEST_ASSERT(readPaths(journal) == expectedPaths);
+		BS_TEST_ASSERT(journal.needsCompaction());
+
+		// Same for a record whose contents don't match its checksum
+		data = readTestFile(journalPath);
+		data.resize(validData.size());
+		writeTestFile(journalPath, data);
+
+		journal.writeUpdate(createEntry("D", EntryType::Directory, nullptr));
+		journal.flush();
+
+		data = readTestFile(journalPath);
+		data.back() ^= 0xFF;
+		writeTestFile(journalPath, data);
+
+		BS_TEST_ASSERT(readPaths(journal) == expectedPaths);
+		BS_TEST_ASSERT(journal.needsCompaction());
+
+		// Compaction rewrites the journal with a single record per entry, and can be appended to again
+		entries.clear();
+		journal.read(entries);
+		journal.compact(entries);
+
+		BS_TEST_ASSERT(!journal.needsCompaction());
+		BS_TEST_ASSERT(readTestFile(journalPath).size() < validData.size());
+		BS_TEST_ASSERT(readPaths(journal) == expectedPaths);
+
+		journal.writeUpdate(createEntry("D", EntryType::Directory, nullptr));
+		journal.flush();
+
+		expectedPaths.push_back("D");
+		BS_TEST_ASSERT(readPaths(journal) == expectedPaths);
+
+		FileSystem::remove(journalPath);
+	}
+
+	void EditorTestSuite::TestResourceUUIDIndex()
+	{
+		Path indexPath = FileSystem::getTempDirectoryPath();
+		indexPath.setFilename("TestResourceUUIDIndex.asset");
+
+		if(FileSystem::exists(indexPath))
+			FileSystem::remove(indexPath);
+
+		const UUID a = UUIDGenerator::generateRandom();
+		const UUID b = UUIDGenerator::generateRandom();
+		const UUID c = UUIDGenerator::generateRandom();
+		const UUID d = UUIDGenerator::generateRandom();
+
+		auto isAt = [](const ResourceUUIDIndex& index, const UUID& uuid, const String& path, const String& name)
+		{
+			String filePath;
+			String subresourceName;
+			if(!index.find(uuid, filePath, subresourceName))
+				return false;
+
+			return filePath == path && subresourceName == name;
+		};
+
+		ResourceUUIDIndex index;
+		BS_TEST_ASSERT(!index.load(indexPath));
+		BS_TEST_ASSERT(!index.isDirty());
+
+		// Entries that were never saved are removed from the overlay entirely
+		index.set(a, "Textures/a.png", "");
+		index.set(b, "Meshes/b.fbx", "Mesh");
+		index.set(c, "Meshes/b.fbx", "Animation");
+		index.set(d, "d.asset", "");
+		index.remove(d);
+
+		BS_TEST_ASSERT(index.isDirty());
+		BS_TEST_ASSERT(isAt(index, a, "Textures/a.png", ""));
+		BS_TEST_ASSERT(isAt(index, c, "Meshes/b.fbx", "Animation"));
+		BS_TEST_ASSERT(!index.contains(d));
+		BS_TEST_ASSERT(index.getNumEntries() == 3);
+
+		index.save(indexPath);
+		BS_TEST_ASSERT(!index.isDirty());
+		BS_TEST_ASSERT(isAt(index, b, "Meshes/b.fbx", "Mesh"));
+
+		ResourceUUIDIndex loadedIndex;
+		BS_TEST_ASSERT(loadedIndex.load(indexPath));
+		BS_TEST_ASSERT(!loadedIndex.isDirty());
+		BS_TEST_ASSERT(isAt(loadedIndex, a, "Textures/a.png", ""));
+		BS_TEST_ASSERT(isAt(loadedIndex, b, "Meshes/b.fbx", "Mesh"));
+		BS_TEST_ASSERT(isAt(loadedIndex, c, "Meshes/b.fbx", "Animation"));
+		BS_TEST_ASSERT(!loadedIndex.contains(d));
+		BS_TEST_ASSERT(loadedIndex.getNumEntries() == 3);
+
+		// Modifications overlay the loaded entries, taking precedence over them
+		loadedIndex.set(a, "Textures/Moved/a.png", "");
+		loadedIndex.remove(b);
+		loadedIndex.set(d, "d.asset", "");
+
+		BS_TEST_ASSERT(loadedIndex.isDirty());
+		BS_TEST_ASSERT(isAt(loadedIndex, a, "Textures/Moved/a.png", ""));
+		BS_TEST_ASSERT(!loadedIndex.contains(b));
+		BS_TEST_ASSERT(isAt(loadedIndex, c, "Meshes/b.fbx", "Animation"));
+		BS_TEST_ASSERT(isAt(loadedIndex, d, "d.asset", ""));
+		BS_TEST_ASSERT(loadedIndex.getNumEntries() == 3);
+
+		// Re-adding a removed entry restores it
+		loadedIndex.set(b, "Meshes/b2.fbx", "Mesh");
+		BS_TEST_ASSERT(isAt(loadedIndex, b, "Meshes/b2.fbx", "Mesh"));
+		BS_TEST_ASSERT(loadedIndex.getNumEntries() == 4);
+		loadedIndex.remove(b);
+
+		// Saving merges the overlay into the loaded entries
+		loadedIndex.save(indexPath);
+		BS_TEST_ASSERT(!loadedIndex.isDirty());
+		BS_TEST_ASSERT(isAt(loadedIndex, a, "Textures/Moved/a.png", ""));
+		BS_TEST_ASSERT(!loadedIndex.contains(b));
+
+		BS_TEST_ASSERT(index.load(indexPath));
+		BS_TEST_ASSERT(isAt(index, a, "Textures/Moved/a.png", ""));
+		BS_TEST_ASSERT(!index.contains(b));
+		BS_TEST_ASSERT(isAt(index, c, "Meshes/b.fbx", "Animation"));
+		BS_TEST_ASSERT(isAt(index, d, "d.asset", ""));
+
+		// Files cut short anywhere, whether in the header, the entries or the strings, are rejected
+		const Vector<UINT8> validData = readTestFile(indexPath);
+		for(UINT32 size : { 0U, 8U, 40U, (UINT32)validData.size() - 1 })
+		{
+			writeTestFile(indexPath, Vector<UINT8>(validData.begin(), validData.begin() + size));
+
+			BS_TEST_ASSERT(!index.load(indexPath));
+			BS_TEST_ASSERT(!index.contains(a) && !index.isDirty());
+		}
+
+		// String data extending past the end of the file is rejected. The last string offset (following the 16 byte
+		// header, 24 byte entries and other offsets) marks the end of the string data.
+		UINT32 numEntries;
+		UINT32 numStrings;
+		memcpy(&numEntries, validData.data() + 8, sizeof(numEntries));
+		memcpy(&numStrings, validData.data() + 12, sizeof(numStrings));
+		BS_TEST_ASSERT(numEntries == 3);
+
+		Vector<UINT8> data = validData;
+		const UINT32 stringDataSize = (UINT32)validData.size();
+		memcpy(data.data() + 16 + numEntries * 24 + numStrings * 4, &stringDataSize, sizeof(stringDataSize));
+		writeTestFile(indexPath, data);
+		BS_TEST_ASSERT(!index.load(indexPath));
+
+		// Files that aren't an index at all are rejected
+		data = validData;
+		data[0] ^= 0xFF;
+		writeTestFile(indexPath, data);
+		BS_TEST_ASSERT(!index.load(indexPath));
+
+		// A valid file can still be loaded after a failed load
+		writeTestFile(indexPath, validData);
+		BS_TEST_ASSERT(index.load(indexPath));
+		BS_TEST_ASSERT(isAt(index, d, "d.asset", ""));
+
+		FileSystem::remove(indexPath);
+	}
+
+	void EditorTestSuite::TestImportCancellation()
+	{
+		Path projectPath = FileSystem::getTempDirectoryPath();
+		projectPath.append("TestImportCancellation/");
+
+		if(FileSystem::exists(projectPath))
+			FileSystem::remove(projectPath);
+
+		const Path resourcesPath = Path::combine(projectPath, ProjectLibrary::RESOURCES_DIR);
+		const Path internalResourcesPath = Path::combine(projectPath, ProjectLibrary::INTERNAL_RESOURCES_DIR);
+		FileSystem::createDir(resourcesPath);
+
+		Path sourcePath = resourcesPath;
+		sourcePath.append("Test.txt");
+
+		const String sourceContents = "Test";
+		const Vector<UINT8> sourceData(sourceContents.begin(), sourceContents.end());
+		writeTestFile(sourcePath, sourceData);
+
+		auto countOutputs = [&internalResourcesPath]()
+		{
+			UINT32 count = 0;
+			if(FileSystem::exists(internalResourcesPath))
+				FileSystem::iterate(internalResourcesPath, [&count](const Path&) { count++; return true; });
+
+			return count;
+		};
+
+		// Uses a library separate from the editor's, so the test doesn't depend on, or affect, the open project
+		ProjectLibrary library;
+		library.loadLibrary(projectPath);
+
+		ProjectLibrary::FileEntry* fileEntry = bs_new<ProjectLibrary::FileEntry>(sourcePath, sourcePath.getTail(),
+			library.mRootEntry);
+		library.mRootEntry->addChild(fileEntry);
+
+		// Stands in for an import of the same file that is already running. Imports queued after it must wait for it, so
+		// they can be superseded or canceled before they get a chance to run.
+		auto queueRunningImport = [&library, fileEntry](const SPtr<Task>& task)
+		{
+			SPtr<ProjectLibrary::QueuedImport> runningImport = bs_shared_ptr_new<ProjectLibrary::QueuedImport>();
+			runningImport->importTask = task;
+			runningImport->start();
+
+			library.mQueuedImports[fileEntry] = runningImport;
+			library.mNumQueuedImports[(UINT32)ProjectLibrary::ImportPriority::Background]++;
+
+			return runningImport;
+		};
+
+		SPtr<Task> blocker = Task::create("TestImportBlocker", []() { });
+		SPtr<ProjectLibrary::QueuedImport> runningImport = queueRunningImport(blocker);
+
+		// Running imports are canceled and waited on
+		BS_TEST_ASSERT(library.reimportResourceInternal(fileEntry, nullptr, true));
+		SPtr<ProjectLibrary::QueuedImport> supersededImport = library.mQueuedImports[fileEntry];
+
+		BS_TEST_ASSERT(runningImport->canceled);
+		BS_TEST_ASSERT(supersededImport->dependency == blocker);
+
+		// Imports that haven't started are canceled but not waited on, instead the new import waits on their dependency
+		library.reimport(sourcePath, nullptr, true);
+		SPtr<ProjectLibrary::QueuedImport> finalImport = library.mQueuedImports[fileEntry];
+
+		BS_TEST_ASSERT(supersededImport->canceled);
+		BS_TEST_ASSERT(finalImport != supersededImport && !finalImport->canceled);
+		BS_TEST_ASSERT(finalImport->dependency == blocker);
+		BS_TEST_ASSERT(library.getInProgressImportCount() == 1);
+		BS_TEST_ASSERT(library.getInProgressImportCount(ProjectLibrary::ImportPriority::Interactive) == 1);
+		BS_TEST_ASSERT(library.getInProgressImportCount(ProjectLibrary::ImportPriority::Background) == 0);
+
+		TaskScheduler::instance().addTask(blocker);
+		library._finishQueuedImports(true);
+		supersededImport->importTask->wait();
+
+		// The superseded import exits before doing any work, only the final import writes outputs and meta-data
+		BS_TEST_ASSERT(supersededImport->started && supersededImport->sourceHash == 0);
+		BS_TEST_ASSERT(finalImport->sourceHash != 0);
+		BS_TEST_ASSERT(library.getInProgressImportCount() == 0);
+		BS_TEST_ASSERT(FileSystem::isFile(library.getMetaPath(sourcePath)));
+		BS_TEST_ASSERT(countOutputs() == 1);
+
+		// Deleting the file cancels its queued import. The file is restored before the import is unblocked, so an
+		// import that wasn't properly canceled would write its outputs.
+		blocker = Task::create("TestImportBlocker", []() { });
+		queueRunningImport(blocker);
+
+		BS_TEST_ASSERT(library.reimportResourceInternal(fileEntry, nullptr, true));
+		SPtr<ProjectLibrary::QueuedImport> canceledImport = library.mQueuedImports[fileEntry];
+
+		library.deleteEntry(sourcePath);
+		BS_TEST_ASSERT(canceledImport->canceled);
+
+		writeTestFile(sourcePath, sourceData);
+
+		TaskScheduler::instance().addTask(blocker);
+		library._finishQueuedImports(true);
+
+		BS_TEST_ASSERT(canceledImport->started && canceledImport->sourceHash == 0);
+		BS_TEST_ASSERT(library.getInProgressImportCount() == 0);
+		BS_TEST_ASSERT(!FileSystem::exists(library.getMetaPath(sourcePath)));
+		BS_TEST_ASSERT(countOutputs() == 0);
+
+		library.unloadLibrary();
+		FileSystem::remove(projectPath);
+	}
+
+	void EditorTestSuite::TestIconDownsample()
+	{
+		// 3x2 source, so the last column is sampled twice
+		SPtr<PixelData> source = PixelData::create(3, 2, 1, PF_RGBA8);
+		const UINT8 sourceData[] =
+		{
+			0, 10, 255, 255,	4, 20, 255, 255,	100, 0, 0, 0,
+			8, 30, 255, 255,	12, 40, 255, 255,	200, 0, 0, 0
+		};
+		memcpy(source->getData(), sourceData, sizeof(sourceData));
+
+		SPtr<PixelData> dest = PixelData::create(1, 1, 1, PF_RGBA8);
+		IconGenerator::downsample(*source, *dest);
+
+		const UINT8* destData = dest->getData();
+		BS_TEST_ASSERT(destData[0] == 6);
+		BS_TEST_ASSERT(destData[1] == 25);
+		BS_TEST_ASSERT(destData[2] == 255);
+		BS_TEST_ASSERT(destData[3] == 255);
+
+		// Wide enough to be processed several pixels at a time, with an odd pixel left over at the end of each row
+		SPtr<PixelData> wideSource = PixelData::create(11, 2, 1, PF_RGBA8);
+		UINT8* wideSourceData = wideSource->getData();
+		for (UINT32 i = 0; i < 11 * 2 * 4; i++)
+			wideSourceData[i] = (UINT8)(i * 7);
+
+		SPtr<PixelData> wideDest = PixelData::create(5, 1, 1, PF_RGBA8);
+		IconGenerator::downsample(*wideSource, *wideDest);
+
+		for (UINT32 x = 0; x < 5; x++)
+		{
+			for (UINT32 c = 0; c < 4; c++)
+			{
+				const UINT32 top = x * 8 + c;
+				const UINT32 bottom = top + 11 * 4;
+				const UINT32 sum = wideSourceData[top] + wideSourceData[top + 4] + wideSourceData[bottom] + 
+					wideSourceData[bottom + 4];
+
+				BS_TEST_ASSERT(wideDest->getData()[x * 4 + c] == (sum + 2) / 4);
+			}
+		}
+
+		// BC1 block with a white and a black endpoint, with every pixel two thirds of the way towards white
+		SPtr<PixelData> compressed = PixelData::create(4, 4, 1, PF_BC1);
+		const UINT8 blockData[] = { 0xFF, 0xFF, 0x00, 0x00, 0xAA, 0xAA, 0xAA, 0xAA };
+		memcpy(compressed->getData(), blockData, sizeof(blockData));
+
+		SPtr<PixelData> decompressed = IconGenerator::decompress(*compressed);
+		BS_TEST_ASSERT(decompressed != nullptr && decompressed->getFormat() == PF_RGBA8);
+		BS_TEST_ASSERT(decompressed->getData()[0] == 170 && decompressed->getData()[3] == 255);
+		BS_TEST_ASSERT(decompressed->getData()[15 * 4 + 2] == 170);
+
+		// Sizes that are half of another requested size are produced from it
+		SPtr<PixelData> icon = PixelData::create(64, 64, 1, PF_RGBA8);
+		memset(icon->getData(), 128, 64 * 64 * 4);
+
+		Map<UINT32, SPtr<PixelData>> icons = IconGenerator::generate(*icon, { 16, 32, 48 });
+		BS_TEST_ASSERT(icons.size() == 3);
+
+		for (auto& entry : icons)
+		{
+			BS_TEST_ASSERT(entry.second->getWidth() == entry.first && entry.second->getHeight() == entry.first);
+			BS_TEST_ASSERT(entry.second->getData()[0] == 128);
+		}
+	}
+
+	void EditorTestSuite::TestBuildManifestDiff()
+	{
+		BuildManifest oldManifest;
+		oldManifest.add("Game.exe", 100, 1);
+		oldManifest.add("Resources/a.asset", 10, 2);
+		oldManifest.add("Resources/b.asset", 20, 3);
+		oldManifest.add("Resources/c.asset", 30, 4);
+
+		BuildManifest newManifest;
+		newManifest.add("Resources/d.asset", 40, 5);
+		newManifest.add("Resources/c.asset", 30, 6);
+		newManifest.add("Resources/a.asset", 10, 2);
+		newManifest.add("Game.exe", 100, 1);
+
+		BuildManifestDiff diff = BuildManifest::diff(oldManifest, newManifest);
+		BS_TEST_ASSERT(diff.added.size() == 1 && diff.added[0] == "Resources/d.asset");
+		BS_TEST_ASSERT(diff.modified.size() == 1 && diff.modified[0] == "Resources/c.asset");
+		BS_TEST_ASSERT(diff.removed.size() == 1 && diff.removed[0] == "Resources/b.asset");
+
+		// Saved manifests must survive a round trip, including paths with whitespace
+		newManifest.add("Data/Some File.txt", 7, 0xFFFFFFFFFFFFFFFFULL);
+
+		Path manifestPath = FileSystem::getTempDirectoryPath();
+		manifestPath.setFilename("TestBuildManifest.txt");
+		BS_TEST_ASSERT(newManifest.save(manifestPath));
+
+		SPtr<BuildManifest> loadedManifest = BuildManifest::load(manifestPath);
+		FileSystem::remove(manifestPath);
+
+		BS_TEST_ASSERT(loadedManifest != nullptr);
+		if (loadedManifest != nullptr)
+		{
+			BuildManifestDiff roundTripDiff = BuildManifest::diff(newManifest, *loadedManifest);
+			BS_TEST_ASSERT(roundTripDiff.added.empty() && roundTripDiff.modified.empty() && roundTripDiff.removed.empty());
+		}
+	}
+
+	void EditorTestSuite::TestSceneBVH()
+	{
+		UINT32 seed = 12345;
+		auto random = [&seed](float min, float max)
+		{
+			seed = seed * 1664525 + 1013904223;
+			return min + (seed >> 8) / (float)(1 << 24) * (max - min);
+		};
+
+		auto randomBox = [&random]()
+		{
+			Vector3 center(random(-100.0f, 100.0f), random(-100.0f, 100.0f), random(-100.0f, 100.0f));
+			Vector3 extents(random(0.1f, 5.0f), random(0.1f, 5.0f), random(0.1f, 5.0f));
+
+			return AABox(center - extents, center + extents);
+		};
+
+		SceneBVH bvh;
+		Map<UINT32, AABox> objects;
+		for (UINT32 i = 0; i < 4000; i++)
+		{
+			AABox bounds = randomBox();
+			objects[bvh.add(bounds)] = bounds;
+		}
+
+		auto compareWithBruteForce = [&]()
+		{
+			BS_TEST_ASSERT(bvh.getNumObjects() == (UINT32)objects.size());
+
+			for (UINT32 i = 0; i < 50; i++)
+			{
+				Vector3 origin(random(-150.0f, 150.0f), random(-150.0f, 150.0f), random(-150.0f, 150.0f));
+				Vector3 target(random(-50.0f, 50.0f), random(-50.0f, 50.0f), random(-50.0f, 50.0f));
+				Ray ray(origin, Vector3::normalize(target - origin));
+
+				Set<UINT32> expected;
+				for (auto& entry : objects)
+				{
+					float distance;
+					if (SceneBVH::intersects(ray, entry.second, distance))
+						expected.insert(entry.first);
+				}
+
+				Vector<SceneBVHRayHit> hits;
+				bvh.rayCast(ray, hits);
+
+				Set<UINT32> found;
+				for (UINT32 j = 0; j < (UINT32)hits.size(); j++)
+				{
+					found.insert(hits[j].id);
+
+					if (j > 0)
+						BS_TEST_ASSERT(hits[j - 1].distance <= hits[j].distance);
+				}
+
+				BS_TEST_ASSERT(found == expected);
+			}
+
+			for (UINT32 i = 0; i < 20; i++)
+			{
+				AABox area = randomBox();
+				area.scale(Vector3(5.0f, 5.0f, 5.0f));
+
+				// Planes of a box shaped volume, facing inwards
+				Vector<Plane> planes =
+				{
+					Plane(Vector3::UNIT_X, area.getMin().x), Plane(-Vector3::UNIT_X, -area.getMax().x),
+					Plane(Vector3::UNIT_Y, area.getMin().y), Plane(-Vector3::UNIT_Y, -area.getMax().y),
+					Plane(Vector3::UNIT_Z, area.getMin().z), Plane(-Vector3::UNIT_Z, -area.getMax().z)
+				};
+
+				ConvexVolume volume(planes);
+
+				Set<UINT32> expected;
+				for (auto& entry : objects)
+				{
+					if (volume.intersects(entry.second))
+						expected.insert(entry.first);
+				}
+
+				Vector<UINT32> ids;
+				bvh.intersect(volume, ids);
+
+				Set<UINT32> found(ids.begin(), ids.end());
+				BS_TEST_ASSERT(found.size() == ids.size());
+				BS_TEST_ASSERT(found == expected);
+			}
+		};
+
+		compareWithBruteForce();
+
+		// Move a portion of the objects, which refits the tree without rebuilding it
+		UINT32 idx = 0;
+		for (auto& entry : objects)
+		{
+			if (idx++ % 10 != 0)
+				continue;
+
+			entry.second = randomBox();
+			bvh.update(entry.first, entry.second);
+		}
+
+		compareWithBruteForce();
+
+		// Add and remove few enough objects to keep them out of the tree, and then enough to trigger a rebuild
+		for (UINT32 numChanges : { 10, 1000 })
+		{
+			for (UINT32 i = 0; i < numChanges; i++)
+			{
+				auto iterRemove = objects.begin();
+				std::advance(iterRemove, (UINT32)random(0.0f, (float)objects.size() - 1.0f));
+
+				bvh.remove(iterRemove->first);
+				objects.erase(iterRemove);
+
+				AABox bounds = randomBox();
+				UINT32 id = bvh.add(bounds);
+
+				BS_TEST_ASSERT(objects.find(id) == objects.end());
+				objects[id] = bounds;
+			}
+
+			compareWithBruteForce();
+		}
+	}
+
+	void EditorTestSuite::TestGizmoInstanceBuffer()
+	{
+		const float tolerance = 0.001f;
+
+		// Unit primitives must map onto the shapes described by the draw call parameters
+		Matrix4 cube = GizmoInstanceBuffer::getCubeTransform(Vector3(1.0f, 2.0f, 3.0f), Vector3(0.5f, 1.0f, 2.0f));
+		BS_TEST_ASSERT(Math::approxEquals(cube.multiplyAffine(Vector3::ONE), Vector3(1.5f, 3.0f, 5.0f), tolerance));
+		BS_TEST_ASSERT(Math::approxEquals(cube.multiplyAffine(-Vector3::ONE), Vector3(0.5f, 1.0f, 1.0f), tolerance));
+
+		Matrix4 sphere = GizmoInstanceBuffer::getSphereTransform(Vector3(-1.0f, 0.0f, 1.0f), 3.0f);
+		Vector3 sphereTop = sphere.multiplyAffine(Vector3::UNIT_Y);
+		BS_TEST_ASSERT(Math::approxEquals(sphereTop, Vector3(-1.0f, 3.0f, 1.0f), tolerance));
+
+		Vector3 normals[] = { Vector3::UNIT_X, -Vector3::UNIT_Y, Vector3::UNIT_Z, -Vector3::UNIT_Z,
+			Vector3::normalize(Vector3(1.0f, 2.0f, -3.0f)) };
+
+		for (auto& normal : normals)
+		{
+			Vector3 base(2.0f, -1.0f, 4.0f);
+
+			Matrix4 cone = GizmoInstanceBuffer::getConeTransform(base, normal, 5.0f, 2.0f, Vector2::ONE);
+			BS_TEST_ASSERT(Math::approxEquals(cone.multiplyAffine(Vector3::UNIT_Z), base + normal * 5.0f, tolerance));
+
+			Matrix4 disc = GizmoInstanceBuffer::getDiscTransform(base, normal, 2.0f);
+			for (auto& point : { Vector3::UNIT_X, Vector3::UNIT_Y, Vector3::normalize(Vector3(1.0f, 1.0f, 0.0f)) })
+			{
+				Vector3 offset = disc.multiplyAffine(point) - base;
+
+				BS_TEST_ASSERT(Math::approxEquals(offset.length(), 2.0f, tolerance));
+				BS_TEST_ASSERT(Math::approxEquals(offset.dot(normal), 0.0f, tolerance));
+			}
+		}
+
+		// Instances are grouped per primitive, preserving the order they were added in
+		GizmoInstanceBuffer buffer;
+		buffer.add(GizmoPrimitive::SolidCube, Matrix4::IDENTITY, Color::Red, 3, true);
+		buffer.add(GizmoPrimitive::WireArc, Matrix4::IDENTITY, Color::Green, 7, false, Degree(90.0f), Degree(-180.0f));
+		buffer.add(GizmoPrimitive::SolidCube, Matrix4::IDENTITY, Color::Blue, 1, false);
+
+		BS_TEST_ASSERT(buffer.getNumInstances() == 3);
+		BS_TEST_ASSERT(buffer.getInstances(GizmoPrimitive::SolidCube).size() == 2);
+		BS_TEST_ASSERT(buffer.getInstances(GizmoPrimitive::WireSphere).empty());
+
+		const Vector<UINT32>& cubeIndices = buffer.getGizmoIndices(GizmoPrimitive::SolidCube);
+		BS_TEST_ASSERT(cubeIndices.size() == 2 && cubeIndices[0] == 3 && cubeIndices[1] == 1);
+
+		const GizmoInstance& firstCube = buffer.getInstances(GizmoPrimitive::SolidCube)[0];
+		BS_TEST_ASSERT(firstCube.color == Color::Red.getAsRGBA());
+		BS_TEST_ASSERT(firstCube.params.z == 0.0f && firstCube.params.w == 1.0f);
+		BS_TEST_ASSERT(buffer.getInstances(GizmoPrimitive::SolidCube)[1].params.w == 0.0f);
+
+		const GizmoInstance& arc = buffer.getInstances(GizmoPrimitive::WireArc)[0];
+		BS_TEST_ASSERT(Math::approxEquals(arc.params.x, Math::HALF_PI, tolerance));
+		BS_TEST_ASSERT(Math::approxEquals(arc.params.y, -Math::PI, tolerance));
+		BS_TEST_ASSERT(arc.params.z == 1.0f && arc.params.w == 0.0f);
+
+		auto idxToColor = [](UINT32 idx) { return Color(idx / 255.0f, 0.0f, 0.0f, 1.0f); };
+
+		Vector<UINT32> pickingColors;
+		buffer.getPickingColors(GizmoPrimitive::SolidCube, idxToColor, pickingColors);
+		BS_TEST_ASSERT(pickingColors.size() == 2);
+		BS_TEST_ASSERT(pickingColors[0] == idxToColor(3).getAsRGBA() && pickingColors[1] == idxToColor(1).getAsRGBA());
+
+		buffer.clear();
+		BS_TEST_ASSERT(buffer.getNumInstances() == 0);
+
+		// Generated geometry must be valid and fit within the unit primitive bounds
+		for (UINT32 i = 0; i < (UINT32)GizmoPrimitive::Count; i++)
+		{
+			GizmoPrimitive primitive = (GizmoPrimitive)i;
+			bool solid = GizmoInstanceBuffer::isSolid(primitive);
+
+			GizmoPrimitiveGeometry geometry;
+			GizmoInstanceBuffer::generateGeometry(primitive, geometry);
+
+			BS_TEST_ASSERT(!geometry.positions.empty() && !geometry.indices.empty());
+			BS_TEST_ASSERT(geometry.indices.size() % (solid ? 3 : 2) == 0);
+			BS_TEST_ASSERT(geometry.normals.size() == (solid ? geometry.positions.size() : 0));
+
+			for (auto& index : geometry.indices)
+				BS_TEST_ASSERT(index < geometry.positions.size());
+
+			for (auto& position : geometry.positions)
+			{
+				BS_TEST_ASSERT(position.x >= -1.0f - tolerance && position.x <= 1.0f + tolerance);
+				BS_TEST_ASSERT(position.y >= -1.0f - tolerance && position.y <= 1.0f + tolerance);
+				BS_TEST_ASSERT(position.z >= -1.0f - tolerance && position.z <= 1.0f + tolerance);
+			}
+
+			for (auto& normal : geometry.normals)
+				BS_TEST_ASSERT(Math::approxEquals(normal.length(), 1.0f, tolerance));
+		}
+	}
 }
\ No newline at end of file
@@ -93,6 +93,39 @@ namespace bs
 
 		/**	Tests the frame allocator. */
 		void TestFrameAlloc();
+
+		/** Tests content hashing, both in one go and incrementally. */
+		void TestContentHash();
+
+		/** Tests searching the project library search index by name patterns. */
+		void TestLibrarySearchIndex();
+
+		/** Tests project library child entry lookup against a linear scan, on wide and deep directory hierarchies. */
+		void TestLibraryEntryLookup();
+
+		/** Tests ordering of transitive dependants in the resource dependency graph. */
+		void TestResourceDependencyGraph();
+
+		/** Tests replaying, appending to, recovering from corruption and compacting the project library journal. */
+		void TestProjectLibraryJournal();
+
+		/** Tests saving, loading and modifying the resource UUID index, and rejecting truncated or corrupt files. */
+		void TestResourceUUIDIndex();
+
+		/** Tests that superseded and canceled project library imports don't run, or write any outputs or meta-data. */
+		void TestImportCancellation();
+
+		/** Tests box filtered downsampling and block decompression used for generating icons. */
+		void TestIconDownsample();
+
+		/** Tests comparing build manifests, and saving and loading them. */
+		void TestBuildManifestDiff();
+
+		/** Tests ray and volume queries on the scene picking hierarchy against a brute force search, as objects change. */
+		void TestSceneBVH();
+
+		/** Tests transforms, grouping and generated geometry of instanced gizmo primitives. */
+		void TestGizmoInstanceBuffer();
 	};
 
 	/** @} */
@@ -110,6 +110,15 @@ namespace bs
 		/**	Creates a material used for picking transparent gizmos. */
 		HMaterial createAlphaGizmoPickingMat() const;
 
+		/**	Creates a material used for rendering instanced solid gizmo primitives. */
+		HMaterial createInstancedSolidGizmoMat() const;
+
+		/**	Creates a material used for rendering instanced wireframe gizmo primitives. */
+		HMaterial createInstancedLineGizmoMat() const;
+
+		/**	Creates a material used for picking instanced gizmo primitives. */
+		HMaterial createInstancedGizmoPickingMat() const;
+
 		/**	Creates a material used for rendering line handles. */
 		HMaterial createLineHandleMat() const;
 
@@ -206,6 +215,9 @@ namespace bs
 		HShader mShaderGizmoPicking;
 		HShader mShaderGizmoAlphaPicking;
 		HShader mShaderGizmoText;
+		HShader mShaderGizmoSolidInstanced;
+		HShader mShaderGizmoLineInstanced;
+		HShader mShaderGizmoPickingInstanced;
 		HShader mShaderHandleSolid;
 		HShader mShaderHandleLine;
 		HShader mShaderHandleClearAlpha;
@@ -288,6 +300,9 @@ namespace bs
 		static const String ShaderGizmoPickingFile;
 		static const String ShaderGizmoPickingAlphaFile;
 		static const String ShaderTextGizmoFile;
+		static const String ShaderSolidGizmoInstancedFile;
+		static const String ShaderLineGizmoInstancedFile;
+		static const String ShaderGizmoPickingInstancedFile;
 		static const String ShaderSelectionFile;
 
 		static const String EmptyShaderCodeFile;
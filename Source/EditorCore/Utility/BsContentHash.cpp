@@ -0,0 +1,194 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Utility/BsContentHash.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+
+namespace bs
+{
+	static constexpr UINT64 PRIME1 = 0x9E3779B185EBCA87ULL;
+	static constexpr UINT64 PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+	static constexpr UINT64 PRIME3 = 0x165667B19E3779F9ULL;
+	static constexpr UINT64 PRIME4 = 0x85EBCA77C2B2AE63ULL;
+	static constexpr UINT64 PRIME5 = 0x27D4EB2F165667C5ULL;
+
+	static constexpr UINT32 FILE_READ_BLOCK_SIZE = 64 * 1024;
+
+	static UINT64 rotateLeft(UINT64 value, UINT32 bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	static UINT64 read64(const UINT8* data)
+	{
+		UINT64 value;
+		memcpy(&value, data, sizeof(value));
+
+		return value;
+	}
+
+	static UINT32 read32(const UINT8* data)
+	{
+		UINT32 value;
+		memcpy(&value, data, sizeof(value));
+
+		return value;
+	}
+
+	static UINT64 hashRound(UINT64 accumulator, UINT64 input)
+	{
+		accumulator += input * PRIME2;
+		accumulator = rotateLeft(accumulator, 31);
+		accumulator *= PRIME1;
+
+		return accumulator;
+	}
+
+	static UINT64 hashMergeRound(UINT64 accumulator, UINT64 value)
+	{
+		accumulator ^= hashRound(0, value);
+		accumulator = accumulator * PRIME1 + PRIME4;
+
+		return accumulator;
+	}
+
+	ContentHash::ContentHash(UINT64 seed)
+		:mSeed(seed)
+	{
+		mAccumulators[0] = seed + PRIME1 + PRIME2;
+		mAccumulators[1] = seed + PRIME2;
+		mAccumulators[2] = seed;
+		mAccumulators[3] = seed - PRIME1;
+	}
+
+	void ContentHash::update(const void* data, UINT64 size)
+	{
+		const UINT8* input = (const UINT8*)data;
+		const UINT8* end = input + size;
+
+		mTotalSize += size;
+
+		// Not enough for a full stripe, just buffer the data
+		if(mBufferSize + size < 32)
+		{
+			memcpy(mBuffer + mBufferSize, input, (size_t)size);
+			mBufferSize += (UINT32)size;
+
+			return;
+		}
+
+		// Complete the buffered stripe first
+		if(mBufferSize > 0)
+		{
+			const UINT32 toCopy = 32 - mBufferSize;
+			memcpy(mBuffer + mBufferSize, input, toCopy);
+
+			for(UINT32 i = 0; i < 4; i++)
+				mAccumulators[i] = hashRound(mAccumulators[i], read64(mBuffer + i * 8));
+
+			input += toCopy;
+			mBufferSize = 0;
+		}
+
+		while((end - input) >= 32)
+		{
+			for(UINT32 i = 0; i < 4; i++)
+				mAccumulators[i] = hashRound(mAccumulators[i], read64(input + i * 8));
+
+			input += 32;
+		}
+
+		if(input < end)
+		{
+			mBufferSize = (UINT32)(end - input);
+			memcpy(mBuffer, input, mBufferSize);
+		}
+	}
+
+	UINT64 ContentHash::digest() const
+	{
+		UINT64 hash;
+		if(mTotalSize >= 32)
+		{
+			hash = rotateLeft(mAccumulators[0], 1) + rotateLeft(mAccumulators[1], 7) +
+				rotateLeft(mAccumulators[2], 12) + rotateLeft(mAccumulators[3], 18);
+
+			for(UINT32 i = 0; i < 4; i++)
+				hash = hashMergeRound(hash, mAccumulators[i]);
+		}
+		else
+			hash = mSeed + PRIME5;
+
+		hash += mTotalSize;
+
+		const UINT8* input = mBuffer;
+		const UINT8* end = mBuffer + mBufferSize;
+
+		while((input + 8) <= end)
+		{
+			hash ^= hashRound(0, read64(input));
+			hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+			input += 8;
+		}
+
+		if((input + 4) <= end)
+		{
+			hash ^= (UINT64)read32(input) * PRIME1;
+			hash = rotateLeft(hash, 23) * PRIME2 + PRIME3;
+			input += 4;
+		}
+
+		while(input < end)
+		{
+			hash ^= (*input) * PRIME5;
+			hash = rotateLeft(hash, 11) * PRIME1;
+			input++;
+		}
+
+		hash ^= hash >> 33;
+		hash *= PRIME2;
+		hash ^= hash >> 29;
+		hash *= PRIME3;
+		hash ^= hash >> 32;
+
+		return hash;
+	}
+
+	UINT64 ContentHash::hash(const void* data, UINT64 size, UINT64 seed)
+	{
+		ContentHash hash(seed);
+		hash.update(data, size);
+
+		return hash.digest();
+	}
+
+	UINT64 ContentHash::hashFile(const Path& path)
+	{
+		SPtr<DataStream> stream = FileSystem::openFile(path, true);
+		if(stream == nullptr)
+			return 0;
+
+		UINT8* buffer = (UINT8*)bs_alloc(FILE_READ_BLOCK_SIZE);
+
+		ContentHash hash;
+		while(!stream->eof())
+		{
+			const size_t numRead = stream->read(buffer, FILE_READ_BLOCK_SIZE);
+			if(numRead == 0)
+				break;
+
+			hash.update(buffer, numRead);
+		}
+
+		bs_free(buffer);
+		stream->close();
+
+		return hash.digest();
+	}
+
+	UINT64 ContentHash::combine(UINT64 a, UINT64 b)
+	{
+		const UINT64 values[] = { a, b };
+		return hash(values, sizeof(values));
+	}
+}
@@ -0,0 +1,46 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Editor
+	 *  @{
+	 */
+
+	/**
+	 * Calculates a fast 64-bit non-cryptographic hash of arbitrary data (using the XXH64 algorithm). Meant for detecting
+	 * changes in file contents, not for security purposes. Data can be provided incrementally.
+	 */
+	class BS_ED_EXPORT ContentHash
+	{
+	public:
+		ContentHash(UINT64 seed = 0);
+
+		/** Appends a block of data to the hash. */
+		void update(const void* data, UINT64 size);
+
+		/** Returns the hash of all the data provided so far. */
+		UINT64 digest() const;
+
+		/** Calculates a hash of a single block of data. */
+		static UINT64 hash(const void* data, UINT64 size, UINT64 seed = 0);
+
+		/** Calculates a hash of the contents of the file at the provided path. Returns 0 if the file cannot be read. */
+		static UINT64 hashFile(const Path& path);
+
+		/** Combines two hash values into one. Order of the values matters. */
+		static UINT64 combine(UINT64 a, UINT64 b);
+
+	private:
+		UINT64 mSeed;
+		UINT64 mAccumulators[4];
+		UINT8 mBuffer[32];
+		UINT32 mBufferSize = 0;
+		UINT64 mTotalSize = 0;
+	};
+
+	/** @} */
+}
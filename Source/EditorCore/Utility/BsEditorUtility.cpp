@@ -3,6 +3,7 @@
 #include "Utility/BsEditorUtility.h"
 #include "Scene/BsSceneObject.h"
 #include "Components/BsCRenderable.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -211,4 +212,33 @@ namespace bs
 			}
 		}
 	}
-}
\ No newline at end of file
+
+	void EditorUtility::runInParallel(const String& name, UINT32 count, UINT32 minItemsPerTask, 
+		const std::function<void(UINT32, UINT32)>& worker)
+	{
+		const UINT32 numTasks = std::min(count / std::max(minItemsPerTask, 1U), (UINT32)BS_THREAD_HARDWARE_CONCURRENCY);
+		if(numTasks <= 1)
+		{
+			worker(0, count);
+			return;
+		}
+
+		const UINT32 itemsPerTask = (count + numTasks - 1) / numTasks;
+
+		Vector<SPtr<Task>> tasks;
+		UINT32 start = 0;
+		for(; (start + itemsPerTask) < count; start += itemsPerTask)
+		{
+			const UINT32 end = start + itemsPerTask;
+			SPtr<Task> task = Task::create(name, [&worker, start, end]() { worker(start, end); }, TaskPriority::High);
+
+			TaskScheduler::instance().addTask(task);
+			tasks.push_back(task);
+		}
+
+		worker(start, count);
+
+		for(auto& task : tasks)
+			task->wait();
+	}
+}
@@ -86,6 +86,20 @@ namespace bs
 		static bool openBrowseDialog(FileDialogType type, const Path& defaultPath, const String& filterList,
 									 Vector<Path>& paths);
 
+		/**
+		 * Splits @p count items into batches and processes them on task scheduler worker threads, blocking until all are
+		 * done. The calling thread processes one of the batches itself. Small workloads are processed on the calling
+		 * thread.
+		 *
+		 * @param[in]	name			Name of the tasks, for debugging purposes.
+		 * @param[in]	count			Total number of items to process.
+		 * @param[in]	minItemsPerTask	Minimum number of items to process in a single task.
+		 * @param[in]	worker			Function processing a range of items, with the start (inclusive) and end 
+		 *								(exclusive) item indices as parameters. Called concurrently from multiple threads.
+		 */
+		static void runInParallel(const String& name, UINT32 count, UINT32 minItemsPerTask, 
+			const std::function<void(UINT32, UINT32)>& worker);
+
 	private:
 		/**
 		 * Retrieves all components containing meshes on the specified object and outputs their bounds.
@@ -0,0 +1,365 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "Utility/BsIconGenerator.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsTexture.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define BS_ICON_GENERATOR_SSE2 1
+#else
+#	define BS_ICON_GENERATOR_SSE2 0
+#endif
+
+namespace bs
+{
+	/** Returns the smallest mip level of the texture that is at least as large as the requested size. */
+	static UINT32 getSourceMipLevel(const TextureProperties& props, UINT32 size)
+	{
+		UINT32 mipLevel = 0;
+		while (mipLevel < props.getNumMipmaps())
+		{
+			const UINT32 mipWidth = std::max(1U, props.getWidth() >> (mipLevel + 1));
+			const UINT32 mipHeight = std::max(1U, props.getHeight() >> (mipLevel + 1));
+
+			if (mipWidth < size || mipHeight < size)
+				break;
+
+			mipLevel++;
+		}
+
+		return mipLevel;
+	}
+
+	/** Expands a 5:6:5 color into 8-bit RGB channels. */
+	static void decodeColor565(UINT16 color, UINT8* output)
+	{
+		const UINT32 r = (color >> 11) & 0x1F;
+		const UINT32 g = (color >> 5) & 0x3F;
+		const UINT32 b = color & 0x1F;
+
+		output[0] = (UINT8)((r << 3) | (r >> 2));
+		output[1] = (UINT8)((g << 2) | (g >> 4));
+		output[2] = (UINT8)((b << 3) | (b >> 2));
+	}
+
+	/**
+	 * Decodes the 8 byte color part of a BC1, BC2 or BC3 block into 16 RGBA8 pixels. Alpha is written only if the block
+	 * uses BC1's three color mode, in which case the fourth color is transparent black.
+	 */
+	static void decodeColorBlock(const UINT8* block, bool allowThreeColorMode, UINT8 (&output)[16][4])
+	{
+		const UINT16 color0 = (UINT16)(block[0] | (block[1] << 8));
+		const UINT16 color1 = (UINT16)(block[2] | (block[3] << 8));
+
+		UINT8 palette[4][4];
+		decodeColor565(color0, palette[0]);
+		decodeColor565(color1, palette[1]);
+		palette[0][3] = 255;
+		palette[1][3] = 255;
+
+		if (color0 > color1 || !allowThreeColorMode)
+		{
+			for (UINT32 c = 0; c < 3; c++)
+			{
+				palette[2][c] = (UINT8)((2 * palette[0][c] + palette[1][c] + 1) / 3);
+				palette[3][c] = (UINT8)((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+			}
+
+			palette[2][3] = 255;
+			palette[3][3] = 255;
+		}
+		else
+		{
+			for (UINT32 c = 0; c < 3; c++)
+			{
+				palette[2][c] = (UINT8)((palette[0][c] + palette[1][c]) / 2);
+				palette[3][c] = 0;
+			}
+
+			palette[2][3] = 255;
+			palette[3][3] = 0;
+		}
+
+		const UINT32 indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((UINT32)block[7] << 24);
+		for (UINT32 i = 0; i < 16; i++)
+		{
+			const UINT32 index = (indices >> (i * 2)) & 0x3;
+			memcpy(output[i], palette[index], 4);
+		}
+	}
+
+	/** Decodes an 8 byte BC4 block (also used for BC3 alpha and BC5 channels) into 16 single channel values. */
+	static void decodeChannelBlock(const UINT8* block, UINT8 (&output)[16])
+	{
+		const UINT32 value0 = block[0];
+		const UINT32 value1 = block[1];
+
+		UINT8 palette[8];
+		palette[0] = (UINT8)value0;
+		palette[1] = (UINT8)value1;
+
+		if (value0 > value1)
+		{
+			for (UINT32 i = 1; i < 7; i++)
+				palette[i + 1] = (UINT8)(((7 - i) * value0 + i * value1 + 3) / 7);
+		}
+		else
+		{
+			for (UINT32 i = 1; i < 5; i++)
+				palette[i + 1] = (UINT8)(((5 - i) * value0 + i * value1 + 2) / 5);
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		UINT64 indices = 0;
+		for (UINT32 i = 0; i < 6; i++)
+			indices |= (UINT64)block[2 + i] << (i * 8);
+
+		for (UINT32 i = 0; i < 16; i++)
+			output[i] = palette[(indices >> (i * 3)) & 0x7];
+	}
+
+	Map<UINT32, SPtr<PixelData>> IconGenerator::generate(const PixelData& source, const Vector<UINT32>& sizes)
+	{
+		Map<UINT32, SPtr<PixelData>> output;
+
+		Set<UINT32> requested(sizes.begin(), sizes.end());
+		requested.erase(0);
+
+		// Go from the largest size down, so that each size is generated before the size half of it
+		for (auto iter = requested.rbegin(); iter != requested.rend(); ++iter)
+		{
+			const UINT32 size = *iter;
+
+			SPtr<PixelData> pixels = PixelData::create(size, size, 1, PF_RGBA8);
+
+			const auto iterFind = output.find(size * 2);
+			if (iterFind != output.end())
+				downsample(*iterFind->second, *pixels);
+			else
+				PixelUtil::scale(source, *pixels);
+
+			output[size] = pixels;
+		}
+
+		return output;
+	}
+
+	SPtr<PixelData> IconGenerator::readCachedPixels(Texture& texture, UINT32 size)
+	{
+		const TextureProperties& props = texture.getProperties();
+		if ((props.getUsage() & TU_CPUCACHED) == 0)
+			return nullptr;
+
+		// No need to read more data than the largest icon requires
+		const UINT32 mipLevel = getSourceMipLevel(props, size);
+
+		SPtr<PixelData> pixels = props.allocBuffer(0, mipLevel);
+		texture.readCachedData(*pixels, 0, mipLevel);
+
+		if (PixelUtil::isCompressed(pixels->getFormat()))
+			pixels = decompress(*pixels);
+
+		if (pixels != nullptr && pixels->getDepth() > 1)
+		{
+			const PixelData firstSlice = pixels->getSubVolume(PixelVolume(0, 0, 0, pixels->getWidth(),
+				pixels->getHeight(), 1));
+
+			SPtr<PixelData> slice = PixelData::create(pixels->getWidth(), pixels->getHeight(), 1, pixels->getFormat());
+			PixelUtil::bulkPixelConversion(firstSlice, *slice);
+
+			pixels = slice;
+		}
+
+		return pixels;
+	}
+
+	SPtr<PixelData> IconGenerator::decompress(const PixelData& source)
+	{
+		const PixelFormat format = source.getFormat();
+
+		UINT32 blockSize;
+		switch (format)
+		{
+		case PF_BC1:
+		case PF_BC1a:
+		case PF_BC4:
+			blockSize = 8;
+			break;
+		case PF_BC2:
+		case PF_BC3:
+		case PF_BC5:
+			blockSize = 16;
+			break;
+		default:
+			return nullptr;
+		}
+
+		const UINT32 width = source.getWidth();
+		const UINT32 height = source.getHeight();
+		const UINT32 depth = source.getDepth();
+		const UINT32 numBlocksX = (width + 3) / 4;
+		const UINT32 numBlocksY = (height + 3) / 4;
+
+		SPtr<PixelData> output = PixelData::create(width, height, depth, PF_RGBA8);
+
+		const UINT8* srcData = source.getData();
+		UINT8* dstData = output->getData();
+
+		for (UINT32 z = 0; z < depth; z++)
+		{
+			for (UINT32 blockY = 0; blockY < numBlocksY; blockY++)
+			{
+				for (UINT32 blockX = 0; blockX < numBlocksX; blockX++)
+				{
+					const UINT8* block = srcData +
+						((z * numBlocksY + blockY) * numBlocksX + blockX) * blockSize;
+
+					UINT8 pixels[16][4];
+					switch (format)
+					{
+					case PF_BC1:
+					case PF_BC1a:
+						decodeColorBlock(block, true, pixels);
+						break;
+					case PF_BC2:
+						decodeColorBlock(block + 8, false, pixels);
+
+						// Explicit 4-bit alpha
+						for (UINT32 i = 0; i < 16; i++)
+						{
+							const UINT32 alpha = (block[i / 2] >> ((i % 2) * 4)) & 0xF;
+							pixels[i][3] = (UINT8)(alpha * 17);
+						}
+						break;
+					case PF_BC3:
+					{
+						decodeColorBlock(block + 8, false, pixels);
+
+						UINT8 alpha[16];
+						decodeChannelBlock(block, alpha);
+
+						for (UINT32 i = 0; i < 16; i++)
+							pixels[i][3] = alpha[i];
+					}
+						break;
+					case PF_BC4:
+					{
+						UINT8 red[16];
+						decodeChannelBlock(block, red);
+
+						for (UINT32 i = 0; i < 16; i++)
+						{
+							pixels[i][0] = red[i];
+							pixels[i][1] = red[i];
+							pixels[i][2] = red[i];
+							pixels[i][3] = 255;
+						}
+					}
+						break;
+					case PF_BC5:
+					{
+						UINT8 red[16];
+						UINT8 green[16];
+						decodeChannelBlock(block, red);
+						decodeChannelBlock(block + 8, green);
+
+						for (UINT32 i = 0; i < 16; i++)
+						{
+							pixels[i][0] = red[i];
+							pixels[i][1] = green[i];
+							pixels[i][2] = 0;
+							pixels[i][3] = 255;
+						}
+					}
+						break;
+					default:
+						break;
+					}
+
+					// Blocks on the right and bottom edges can extend past the image
+					for (UINT32 y = 0; y < 4 && blockY * 4 + y < height; y++)
+					{
+						for (UINT32 x = 0; x < 4 && blockX * 4 + x < width; x++)
+						{
+							const UINT32 dstIdx = ((z * height + blockY * 4 + y) * width + blockX * 4 + x) * 4;
+							memcpy(dstData + dstIdx, pixels[y * 4 + x], 4);
+						}
+					}
+				}
+			}
+		}
+
+		return output;
+	}
+
+	void IconGenerator::downsample(const PixelData& source, PixelData& dest)
+	{
+		const UINT32 srcWidth = source.getWidth();
+		const UINT32 dstWidth = dest.getWidth();
+		const UINT32 dstHeight = dest.getHeight();
+
+		assert(source.getFormat() == PF_RGBA8 && dest.getFormat() == PF_RGBA8);
+		assert(dstWidth == std::max(1U, srcWidth / 2) && dstHeight == std::max(1U, source.getHeight() / 2));
+
+		const UINT32 srcRowSize = srcWidth * 4;
+		const UINT32 dstRowSize = dstWidth * 4;
+
+		// Odd or single pixel sources sample their last row or column twice
+		const UINT32 srcLastX = srcWidth - 1;
+		const UINT32 srcLastY = source.getHeight() - 1;
+
+		const UINT8* srcData = source.getData();
+		UINT8* dstData = dest.getData();
+
+		for (UINT32 y = 0; y < dstHeight; y++)
+		{
+			const UINT8* row0 = srcData + std::min(y * 2, srcLastY) * srcRowSize;
+			const UINT8* row1 = srcData + std::min(y * 2 + 1, srcLastY) * srcRowSize;
+			UINT8* dstRow = dstData + y * dstRowSize;
+
+			UINT32 x = 0;
+
+#if BS_ICON_GENERATOR_SSE2
+			// Two destination pixels at a time, from four source pixels in each row. Channels are widened to 16 bits so
+			// the sums don't overflow, and the result is rounded the same way as in the scalar loop below.
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rounding = _mm_set1_epi16(2);
+
+			for (; (x + 2) * 2 <= srcWidth; x += 2)
+			{
+				const __m128i top = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+				const __m128i bottom = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+
+				// Vertical sums, source pixels 0 and 1 in the low half, 2 and 3 in the high half
+				const __m128i sumLow = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+				const __m128i sumHigh = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+				// Horizontal sums, leaving the result for each destination pixel in the lower 64 bits
+				const __m128i pairLow = _mm_add_epi16(sumLow, _mm_srli_si128(sumLow, 8));
+				const __m128i pairHigh = _mm_add_epi16(sumHigh, _mm_srli_si128(sumHigh, 8));
+
+				__m128i average = _mm_unpacklo_epi64(pairLow, pairHigh);
+				average = _mm_srli_epi16(_mm_add_epi16(average, rounding), 2);
+
+				_mm_storel_epi64((__m128i*)(dstRow + x * 4), _mm_packus_epi16(average, average));
+			}
+#endif
+
+			for (; x < dstWidth; x++)
+			{
+				const UINT32 x0 = std::min(x * 2, srcLastX) * 4;
+				const UINT32 x1 = std::min(x * 2 + 1, srcLastX) * 4;
+
+				for (UINT32 c = 0; c < 4; c++)
+				{
+					const UINT32 sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+					dstRow[x * 4 + c] = (UINT8)((sum + 2) / 4);
+				}
+			}
+		}
+	}
+}
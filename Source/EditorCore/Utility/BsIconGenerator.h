@@ -0,0 +1,55 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Editor
+	 *  @{
+	 */
+
+	/**
+	 * Generates differently sized versions of an icon. Used for application icons injected into executables, as well as
+	 * for project library resource preview icons.
+	 */
+	class BS_ED_EXPORT IconGenerator
+	{
+	public:
+		/**
+		 * Generates square RGBA8 icons of the requested sizes. The source is only filtered once for every size that
+		 * isn't exactly half of another requested size. Remaining sizes are produced by repeatedly halving those.
+		 *
+		 * @param[in]	source	Source image, in any format supported by PixelUtil::scale().
+		 * @param[in]	sizes	Width and height of the icons to generate.
+		 * @return				Generated icons, keyed by their size.
+		 */
+		static Map<UINT32, SPtr<PixelData>> generate(const PixelData& source, const Vector<UINT32>& sizes);
+
+		/**
+		 * Reads the texture's pixels from its CPU cached copy, using the smallest mip level that is at least as large as
+		 * the requested size. Never waits on the core thread. Block compressed data is decompressed, and only the first
+		 * slice of a 3D texture is read.
+		 *
+		 * @return	Pixels in a format supported by generate(), or null if the texture has no CPU cached data or its
+		 *			format cannot be decompressed.
+		 */
+		static SPtr<PixelData> readCachedPixels(Texture& texture, UINT32 size);
+
+		/**
+		 * Decompresses BC1 to BC5 block compressed data into an RGBA8 image. Single and two channel formats are expanded
+		 * to grayscale and red-green respectively. Returns null for any other format.
+		 */
+		static SPtr<PixelData> decompress(const PixelData& source);
+
+		/**
+		 * Halves the size of an RGBA8 image using a 2x2 box filter. Both images must be tightly packed, as created by
+		 * PixelData::create(), and the destination must be half the size of the source, rounded down. Uses SSE2 where
+		 * available.
+		 */
+		static void downsample(const PixelData& source, PixelData& dest);
+	};
+
+	/** @} */
+}
@@ -0,0 +1,395 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsResourceArchive.h"
+#include "Resources/BsResources.h"
+#include "Resources/BsResource.h"
+#include "Resources/BsSavedResourceData.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsCompression.h"
+#include "Debug/BsDebug.h"
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace bs
+{
+	ResourceArchive::~ResourceArchive()
+	{
+		// Prefetch reads from the mapped chunks, so it must finish before they are unmapped
+		stopPrefetch();
+
+		for (auto& chunk : mChunks)
+			unmapChunk(chunk);
+	}
+
+	SPtr<ResourceArchive> ResourceArchive::open(const Path& path)
+	{
+		SPtr<ResourceArchive> archive = bs_shared_ptr<ResourceArchive>(new (bs_alloc<ResourceArchive>()) ResourceArchive());
+
+		MappedChunk firstChunk;
+		if (!mapChunk(path, firstChunk))
+		{
+			LOGERR("Unable to open resource archive \"" + path.toString() + "\".");
+			return nullptr;
+		}
+
+		archive->mChunks.push_back(firstChunk);
+
+		ResourceArchiveHeader header;
+		if (firstChunk.size < sizeof(header))
+		{
+			LOGERR("Resource archive \"" + path.toString() + "\" is corrupt.");
+			return nullptr;
+		}
+
+		memcpy(&header, firstChunk.data, sizeof(header));
+		if (header.magic != RESOURCE_ARCHIVE_MAGIC || header.version != RESOURCE_ARCHIVE_VERSION ||
+			sizeof(header) + header.numEntries * (UINT64)sizeof(ResourceArchiveEntry) > firstChunk.size)
+		{
+			LOGERR("Resource archive \"" + path.toString() + "\" is corrupt or was made with an incompatible version.");
+			return nullptr;
+		}
+
+		archive->mEntries = (const ResourceArchiveEntry*)(firstChunk.data + sizeof(header));
+		archive->mNumEntries = header.numEntries;
+
+		for (UINT32 i = 1; i < header.numChunks; i++)
+		{
+			const Path chunkPath = getChunkPath(path, i);
+
+			MappedChunk chunk;
+			if (!mapChunk(chunkPath, chunk))
+			{
+				LOGERR("Unable to open resource archive chunk \"" + chunkPath.toString() + "\".");
+				return nullptr;
+			}
+
+			archive->mChunks.push_back(chunk);
+
+			ResourceArchiveChunkHeader chunkHeader;
+			if (chunk.size < sizeof(chunkHeader))
+			{
+				LOGERR("Resource archive chunk \"" + chunkPath.toString() + "\" is corrupt.");
+				return nullptr;
+			}
+
+			memcpy(&chunkHeader, chunk.data, sizeof(chunkHeader));
+			if (chunkHeader.magic != RESOURCE_ARCHIVE_MAGIC || chunkHeader.version != RESOURCE_ARCHIVE_VERSION ||
+				chunkHeader.chunk != i)
+			{
+				LOGERR("Resource archive chunk \"" + chunkPath.toString() + "\" doesn't belong to the archive.");
+				return nullptr;
+			}
+		}
+
+		// Make sure all entries are in bounds, so they don't need to be checked on load
+		for (UINT32 i = 0; i < archive->mNumEntries; i++)
+		{
+			const ResourceArchiveEntry& entry = archive->mEntries[i];
+			if (entry.chunk >= archive->mChunks.size() || entry.offset + entry.size > archive->mChunks[entry.chunk].size)
+			{
+				LOGERR("Resource archive \"" + path.toString() + "\" is corrupt.");
+				return nullptr;
+			}
+		}
+
+		return archive;
+	}
+
+	bool ResourceArchive::contains(const UUID& uuid) const
+	{
+		return findEntry(uuid) != nullptr;
+	}
+
+	HResource ResourceArchive::load(const UUID& uuid, bool keepLoaded)
+	{
+		UnorderedSet<UUID> loading;
+		HResource resource = loadInternal(uuid, loading);
+
+		if (keepLoaded && resource != nullptr)
+			mKeptResources.push_back(resource);
+
+		return resource;
+	}
+
+	void ResourceArchive::releaseKeptResources()
+	{
+		mKeptResources.clear();
+	}
+
+	void ResourceArchive::prefetch(const Vector<UUID>& resources)
+	{
+		struct Range
+		{
+			const UINT8* data;
+			UINT64 size;
+		};
+
+		Vector<Range> ranges;
+		for (auto& uuid : resources)
+		{
+			const ResourceArchiveEntry* entry = findEntry(uuid);
+			if (entry != nullptr)
+				ranges.push_back({ mChunks[entry->chunk].data + entry->offset, entry->size });
+		}
+
+		if (ranges.empty())
+			return;
+
+		mStopPrefetch = false;
+		mPrefetchTask = Task::create("ResourceArchivePrefetch", [this, ranges]()
+		{
+			// Touching a byte in every page makes the OS read the page into memory
+			static const UINT64 PAGE_SIZE = 4096;
+
+			volatile UINT8 sum = 0;
+			for (auto& range : ranges)
+			{
+				if (mStopPrefetch)
+					return;
+
+				for (UINT64 offset = 0; offset < range.size; offset += PAGE_SIZE)
+					sum += range.data[offset];
+			}
+		});
+
+		TaskScheduler::instance().addTask(mPrefetchTask);
+	}
+
+	void ResourceArchive::stopPrefetch()
+	{
+		if (mPrefetchTask == nullptr)
+			return;
+
+		mStopPrefetch = true;
+		mPrefetchTask->wait();
+		mPrefetchTask = nullptr;
+	}
+
+	HResource ResourceArchive::loadInternal(const UUID& uuid, UnorderedSet<UUID>& loading)
+	{
+		if (gResources().isLoaded(uuid))
+			return gResources().loadFromUUID(uuid);
+
+		const ResourceArchiveEntry* entry = findEntry(uuid);
+		if (entry == nullptr)
+		{
+			// Not packaged, meaning it's a built-in resource
+			return gResources().loadFromUUID(uuid, false, ResourceLoadFlag::LoadDependencies);
+		}
+
+		loading.insert(uuid);
+
+		// Resources are stored in the same format as when saved to individual files: saved resource data followed by the
+		// resource itself, both prefixed by their size
+		UINT8* data = mChunks[entry->chunk].data + entry->offset;
+		UINT64 size = entry->size;
+
+		SPtr<MemoryDataStream> decompressed;
+		if ((entry->flags & RAEF_Compressed) != 0)
+		{
+			SPtr<DataStream> compressed = bs_shared_ptr_new<MemoryDataStream>(data, (size_t)size, false);
+			decompressed = Compression::decompress(compressed);
+
+			if (decompressed == nullptr || decompressed->size() != entry->uncompressedSize)
+			{
+				LOGERR("Unable to decompress resource " + uuid.toString() + " from the resource archive.");
+				return HResource();
+			}
+
+			data = decompressed->getPtr();
+			size = decompressed->size();
+		}
+
+		MemorySerializer ms;
+		SPtr<SavedResourceData> savedData;
+		UINT64 offset = 0;
+
+		UINT32 metaSize = 0;
+		if (size >= sizeof(metaSize))
+		{
+			memcpy(&metaSize, data, sizeof(metaSize));
+			offset += sizeof(metaSize);
+
+			if (offset + metaSize <= size)
+				savedData = std::static_pointer_cast<SavedResourceData>(ms.decode(data + offset, metaSize));
+
+			offset += metaSize;
+		}
+
+		UINT32 objectSize = 0;
+		if (savedData == nullptr || offset + sizeof(objectSize) > size)
+		{
+			LOGERR("Resource " + uuid.toString() + " in the resource archive is corrupt.");
+			return HResource();
+		}
+
+		memcpy(&objectSize, data + offset, sizeof(objectSize));
+		offset += sizeof(objectSize);
+
+		if (offset + objectSize > size)
+		{
+			LOGERR("Resource " + uuid.toString() + " in the resource archive is corrupt.");
+			return HResource();
+		}
+
+		// Dependencies must be loaded first, so handles to them resolve as the resource is deserialized
+		Vector<HResource> dependencies;
+		for (auto& dependency : savedData->getDependencies())
+		{
+			if (loading.find(dependency) == loading.end())
+				dependencies.push_back(loadInternal(dependency, loading));
+		}
+
+		SPtr<IReflectable> object;
+		if (savedData->getCompressionMethod() != 0)
+		{
+			SPtr<DataStream> compressed = bs_shared_ptr_new<MemoryDataStream>(data + offset, (size_t)objectSize, false);
+			SPtr<MemoryDataStream> objectData = Compression::decompress(compressed);
+
+			if (objectData != nullptr)
+				object = ms.decode(objectData->getPtr(), (UINT32)objectData->size());
+		}
+		else
+			object = ms.decode(data + offset, objectSize);
+
+		if (object == nullptr || !object->isDerivedFrom(Resource::getRTTIStatic()))
+		{
+			LOGERR("Resource " + uuid.toString() + " in the resource archive is corrupt.");
+			return HResource();
+		}
+
+		return gResources()._createResourceHandle(std::static_pointer_cast<Resource>(object), uuid);
+	}
+
+	const ResourceArchiveEntry* ResourceArchive::findEntry(const UUID& uuid) const
+	{
+		const ResourceArchiveEntry* end = mEntries + mNumEntries;
+		const ResourceArchiveEntry* iterFind = std::lower_bound(mEntries, end, uuid,
+			[](const ResourceArchiveEntry& entry, const UUID& value) { return entry.uuid < value; });
+
+		if (iterFind == end || iterFind->uuid != uuid)
+			return nullptr;
+
+		return iterFind;
+	}
+
+	Path ResourceArchive::getChunkPath(const Path& path, UINT32 chunk)
+	{
+		if (chunk == 0)
+			return path;
+
+		Path chunkPath = path;
+		chunkPath.setFilename(path.getFilename(false) + "." + toString(chunk) + path.getExtension());
+
+		return chunkPath;
+	}
+
+	bool ResourceArchive::mapChunk(const Path& path, MappedChunk& chunk)
+	{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+		HANDLE file = CreateFileW(path.toPlatformString().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		chunk.data = (UINT8*)data;
+		chunk.size = (UINT64)fileSize.QuadPart;
+		chunk.file = file;
+		chunk.mapping = mapping;
+#else
+		int file = ::open(path.toPlatformString().c_str(), O_RDONLY);
+		if (file == -1)
+			return false;
+
+		struct stat fileStat;
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED)
+		{
+			::close(file);
+			return false;
+		}
+
+		chunk.data = (UINT8*)data;
+		chunk.size = (UINT64)fileStat.st_size;
+		chunk.file = file;
+#endif
+
+		return true;
+	}
+
+	void ResourceArchive::unmapChunk(MappedChunk& chunk)
+	{
+		if (chunk.data == nullptr)
+			return;
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+		UnmapViewOfFile(chunk.data);
+		CloseHandle((HANDLE)chunk.mapping);
+		CloseHandle((HANDLE)chunk.file);
+#else
+		munmap(chunk.data, (size_t)chunk.size);
+		::close(chunk.file);
+#endif
+
+		chunk = MappedChunk();
+	}
+
+	ArchiveResourceLoader::ArchiveResourceLoader(const SPtr<ResourceArchive>& archive, const SPtr<ResourceMapping>& mapping)
+		:mArchive(archive)
+	{
+		if (mapping == nullptr)
+			return;
+
+		// Packaged resources are named after their UUIDs
+		for (auto& entry : mapping->getMap())
+			mMapping[entry.first] = UUID(entry.second.getFilename(false));
+	}
+
+	HResource ArchiveResourceLoader::load(const Path& path, bool keepLoaded) const
+	{
+		const auto iterFind = mMapping.find(path);
+		if (iterFind == mMapping.end())
+		{
+			LOGWRN("Unable to load resource at path: \"" + path.toString() + "\". Resource not found in the build.");
+			return HResource();
+		}
+
+		return mArchive->load(iterFind->second, keepLoaded);
+	}
+}
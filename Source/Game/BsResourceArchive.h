@@ -0,0 +1,153 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "Resources/BsGameResourceManager.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Name of the archive containing all game resources, if the build was made with packed resources. */
+	static const char* GAME_RESOURCE_ARCHIVE_NAME = "Resources.archive";
+
+	/**
+	 * Header at the start of the first archive chunk, followed by the table of contents.
+	 *
+	 * @note	Layout must match ResourceArchiveWriter in the editor.
+	 */
+	struct ResourceArchiveHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		UINT32 numEntries;
+		UINT32 numChunks;
+		UINT32 pageSize;
+		UINT32 reserved;
+	};
+
+	/** Header at the start of every archive chunk other than the first. */
+	struct ResourceArchiveChunkHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		UINT32 chunk;
+		UINT32 reserved;
+	};
+
+	/** Entry in the archive table of contents. Entries are sorted by UUID. */
+	struct ResourceArchiveEntry
+	{
+		UUID uuid;
+		UINT64 offset; /**< Offset of the entry data, relative to the start of its chunk. */
+		UINT64 size; /**< Size of the entry data as stored in the archive. */
+		UINT64 uncompressedSize; /**< Size of the entry data once decompressed. Same as size if not compressed. */
+		UINT64 key; /**< Identifies the entry contents. Only used by the editor, when rebuilding the archive. */
+		UINT32 chunk; /**< Index of the chunk the data is stored in. */
+		UINT32 flags; /**< Combination of ResourceArchiveEntryFlag. */
+	};
+
+	/** Flags describing how an archive entry is stored. */
+	enum ResourceArchiveEntryFlag
+	{
+		RAEF_Compressed = 1 << 0
+	};
+
+	static const UINT32 RESOURCE_ARCHIVE_MAGIC = 0x41525342; // "BSRA"
+	static const UINT32 RESOURCE_ARCHIVE_VERSION = 2;
+
+	/**
+	 * Provides access to resources packed in a resource archive. Archive chunks are memory mapped so only the parts of
+	 * the archive that are actually used are read from the disk, and uncompressed resources are deserialized directly
+	 * from the mapped memory.
+	 */
+	class ResourceArchive
+	{
+	public:
+		~ResourceArchive();
+
+		/**
+		 * Opens the archive at the specified path. Additional chunks are expected to be in the same folder. Returns null
+		 * if the archive cannot be opened or isn't valid.
+		 */
+		static SPtr<ResourceArchive> open(const Path& path);
+
+		/** Checks does the archive contain a resource with the specified UUID. */
+		bool contains(const UUID& uuid) const;
+
+		/**
+		 * Loads the resource with the specified UUID along with all of its dependencies. If the resource is already loaded
+		 * the existing handle is returned. Returns an empty handle if the resource is not in the archive.
+		 *
+		 * @param[in]	uuid		UUID of the resource to load.
+		 * @param[in]	keepLoaded	If true the archive keeps a reference to the resource, so it stays loaded even when
+		 *							no handles to it remain.
+		 */
+		HResource load(const UUID& uuid, bool keepLoaded = false);
+
+		/** Releases references to resources loaded with @p keepLoaded, allowing them to be unloaded. */
+		void releaseKeptResources();
+
+		/**
+		 * Starts reading the data of the specified resources from the disk on a worker thread, in the provided order, so
+		 * it is already in memory when the resources are loaded. Must not be called while a prefetch is in progress.
+		 */
+		void prefetch(const Vector<UUID>& resources);
+
+		/** Stops a prefetch started with prefetch() and waits until the worker is done. */
+		void stopPrefetch();
+
+	private:
+		/** Chunk of the archive mapped into memory. */
+		struct MappedChunk
+		{
+			UINT8* data = nullptr;
+			UINT64 size = 0;
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			void* file = nullptr;
+			void* mapping = nullptr;
+#else
+			int file = -1;
+#endif
+		};
+
+		ResourceArchive() = default;
+
+		/** Maps the file at the specified path into memory. Returns false if the file cannot be mapped. */
+		static bool mapChunk(const Path& path, MappedChunk& chunk);
+
+		/** Releases a chunk mapped with mapChunk(). */
+		static void unmapChunk(MappedChunk& chunk);
+
+		/** Returns the path of the archive chunk with the specified index. */
+		static Path getChunkPath(const Path& path, UINT32 chunk);
+
+		/** Returns the table of contents entry for the resource with the specified UUID, or null if there isn't one. */
+		const ResourceArchiveEntry* findEntry(const UUID& uuid) const;
+
+		/** Loads the resource and its dependencies, skipping resources that are already in the process of loading. */
+		HResource loadInternal(const UUID& uuid, UnorderedSet<UUID>& loading);
+
+		Vector<MappedChunk> mChunks;
+		const ResourceArchiveEntry* mEntries = nullptr;
+		UINT32 mNumEntries = 0;
+		Vector<HResource> mKeptResources;
+
+		SPtr<Task> mPrefetchTask;
+		std::atomic<bool> mStopPrefetch{false};
+	};
+
+	/** Loads game resources requested by path from a resource archive. */
+	class ArchiveResourceLoader : public IGameResourceLoader
+	{
+	public:
+		ArchiveResourceLoader(const SPtr<ResourceArchive>& archive, const SPtr<ResourceMapping>& mapping);
+
+		/** @copydoc IGameResourceLoader::load */
+		HResource load(const Path& path, bool keepLoaded) const override;
+
+	private:
+		SPtr<ResourceArchive> mArchive;
+		UnorderedMap<Path, UUID> mMapping;
+	};
+}
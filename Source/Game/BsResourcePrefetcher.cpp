@@ -0,0 +1,114 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsResourcePrefetcher.h"
+#include "BsResourceArchive.h"
+#include "Resources/BsResources.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+
+using namespace std::placeholders;
+
+namespace bs
+{
+	bool ResourcePrefetcher::loadProfile(const Path& path)
+	{
+		mResources.clear();
+
+		if (!FileSystem::isFile(path))
+			return false;
+
+		SPtr<DataStream> stream = FileSystem::openFile(path, true);
+		if (stream == nullptr)
+			return false;
+
+		const size_t entrySize = sizeof(UUID) + sizeof(float);
+
+		Header header;
+		if (stream->read(&header, sizeof(header)) != sizeof(header) || header.magic != MAGIC || header.version != VERSION ||
+			stream->size() < sizeof(header) + header.numEntries * entrySize)
+		{
+			LOGWRN("Resource load profile \"" + path.toString() + "\" is corrupt.");
+			return false;
+		}
+
+		mResources.resize(header.numEntries);
+		for (auto& uuid : mResources)
+		{
+			// Load time is only used by the editor
+			float time;
+			stream->read(&uuid, sizeof(uuid));
+			stream->read(&time, sizeof(time));
+		}
+
+		stream->close();
+		return true;
+	}
+
+	void ResourcePrefetcher::prefetch(const SPtr<ResourceArchive>& archive)
+	{
+		if (archive != nullptr)
+		{
+			mArchive = archive;
+			mArchive->prefetch(mResources);
+			return;
+		}
+
+		// Dependencies are listed before the resources that use them, so there is no need for the resource system to
+		// discover them on its own
+		Lock lock(mMutex);
+
+		mHandles.reserve(mResources.size());
+		for (auto& uuid : mResources)
+			mHandles.push_back(gResources().loadFromUUID(uuid, true, ResourceLoadFlag::None));
+	}
+
+	void ResourcePrefetcher::releaseOnLoad(const HResource& resource)
+	{
+		mOnResourceLoadedConn.disconnect();
+
+		if (resource == nullptr || resource.isLoaded())
+		{
+			Lock lock(mMutex);
+			mHandles.clear();
+
+			return;
+		}
+
+		mReleaseOnLoadUUID = resource.getUUID();
+		mOnResourceLoadedConn = gResources().onResourceLoaded.connect(
+			std::bind(&ResourcePrefetcher::onResourceLoaded, this, _1));
+
+		// Resource might have finished loading before the connection was made
+		if (resource.isLoaded())
+		{
+			Lock lock(mMutex);
+			mHandles.clear();
+		}
+	}
+
+	void ResourcePrefetcher::release()
+	{
+		mOnResourceLoadedConn.disconnect();
+
+		if (mArchive != nullptr)
+		{
+			mArchive->stopPrefetch();
+			mArchive = nullptr;
+		}
+
+		Lock lock(mMutex);
+		mHandles.clear();
+	}
+
+	void ResourcePrefetcher::onResourceLoaded(const HResource& resource)
+	{
+		if (resource.getUUID() != mReleaseOnLoadUUID)
+			return;
+
+		// Might be triggered from a worker thread, so only the handles are released here, and the connection is left
+		// for the main thread to disconnect
+		Lock lock(mMutex);
+		mHandles.clear();
+	}
+}
@@ -0,0 +1,71 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisites.h"
+
+namespace bs
+{
+	class ResourceArchive;
+
+	/** Name of the file in the game resources folder listing the resources the game loads on startup. */
+	static const char* GAME_RESOURCE_LOAD_PROFILE_NAME = "LoadProfile.dat";
+
+	/**
+	 * Starts loading the resources listed in the load profile written by the build, before they are requested by the
+	 * game. Resources are listed in the order they are expected to be loaded, every resource after its dependencies.
+	 */
+	class ResourcePrefetcher
+	{
+	public:
+		/**
+		 * Reads the load profile from the specified file. Returns false if the profile doesn't exist or isn't valid.
+		 *
+		 * @note	File layout must match ResourceLoadProfile in the editor.
+		 */
+		bool loadProfile(const Path& path);
+
+		/**
+		 * Starts loading the profiled resources. If the resources are packed in an archive their data is read into memory
+		 * on a worker thread, otherwise they are loaded asynchronously by the resource system.
+		 *
+		 * @param[in]	archive		Archive containing the game resources, or null if resources are stored as separate
+		 *							files.
+		 */
+		void prefetch(const SPtr<ResourceArchive>& archive);
+
+		/**
+		 * Releases the handles to the prefetched resources once the provided resource finishes loading, or immediately
+		 * if it is already loaded. Meant to be called with the main scene, as by then the resources it needs are
+		 * referenced by the scene itself, and the rest no longer need to be kept loaded.
+		 */
+		void releaseOnLoad(const HResource& resource);
+
+		/** Stops any prefetching in progress and releases the prefetched resources. */
+		void release();
+
+	private:
+		/** Header at the start of a profile file. */
+		struct Header
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 numEntries;
+			UINT32 reserved;
+		};
+
+		/** Triggered when any resource finishes loading. */
+		void onResourceLoaded(const HResource& resource);
+
+		static const UINT32 MAGIC = 0x504C5342; // "BSLP"
+		static const UINT32 VERSION = 1;
+
+		Vector<UUID> mResources;
+		Vector<HResource> mHandles;
+		SPtr<ResourceArchive> mArchive;
+
+		UUID mReleaseOnLoadUUID;
+		HEvent mOnResourceLoadedConn;
+		Mutex mMutex;
+	};
+}
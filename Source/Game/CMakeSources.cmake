@@ -1,9 +1,13 @@
 set(BS_GAME_INC_NOFILTER
 	"resource.h"
+	"BsResourceArchive.h"
+	"BsResourcePrefetcher.h"
 )
 
 set(BS_GAME_SRC_NOFILTER
 	"Main.cpp"
+	"BsResourceArchive.cpp"
+	"BsResourcePrefetcher.cpp"
 )
 
 source_group("Header Files" FILES ${BS_GAME_INC_NOFILTER})
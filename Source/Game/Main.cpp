@@ -12,8 +12,12 @@
 #include "Scene/BsSceneObject.h"
 #include "Scene/BsSceneManager.h"
 #include "RenderAPI/BsRenderAPI.h"
+#include "Utility/BsDynLibManager.h"
+#include "Utility/BsDynLib.h"
 #include "Resources/BsGameResourceManager.h"
 #include "BsEngineConfig.h"
+#include "BsResourceArchive.h"
+#include "BsResourcePrefetcher.h"
 
 void runApplication();
 
@@ -97,6 +101,21 @@ void runApplication()
 
 	GameResourceManager::instance().setMapping(resMapping);
 
+	// If resources were packed, load them from the archive instead of individual files
+	SPtr<ResourceArchive> resourceArchive;
+
+	Path resourceArchivePath = resourcesPath + GAME_RESOURCE_ARCHIVE_NAME;
+	if (FileSystem::exists(resourceArchivePath))
+	{
+		resourceArchive = ResourceArchive::open(resourceArchivePath);
+
+		if (resourceArchive != nullptr)
+		{
+			SPtr<IGameResourceLoader> loader = bs_shared_ptr_new<ArchiveResourceLoader>(resourceArchive, resMapping);
+			GameResourceManager::instance().setLoader(loader);
+		}
+	}
+
 	if (gameSettings->fullscreen)
 	{
 		if (gameSettings->useDesktopResolution)
@@ -141,24 +160,64 @@ void runApplication()
 		Path resourceRoot = resourcesPath;
 		resourceRoot.makeParent(); // Remove /Resources entry, as we expect all resources to be relative to that path
 
+		// If resources were packed, the manifest refers to entries in the archive rather than to individual files.
+		// Those resources are loaded through the archive, and are found by UUID once loaded.
 		manifest = ResourceManifest::load(resourceManifestPath, resourceRoot);
 
 		gResources().registerResourceManifest(manifest);
 	}
 
+	// Start loading everything the game is expected to need, so it's ready by the time it is requested
+	ResourcePrefetcher prefetcher;
+	if (prefetcher.loadProfile(resourcesPath + GAME_RESOURCE_LOAD_PROFILE_NAME))
+		prefetcher.prefetch(resourceArchive);
+
 	{
-		HPrefab mainScene = static_resource_cast<Prefab>(gResources().loadFromUUID(gameSettings->mainSceneUUID, 
-			false, ResourceLoadFlag::LoadDependencies));
-		if (mainScene.isLoaded(false))
+		// Archived resources are read from memory and always load synchronously. Other resources load in the background,
+		// and the scene is instantiated progressively behind a loading screen.
+		HPrefab mainScene;
+		if (resourceArchive != nullptr && resourceArchive->contains(gameSettings->mainSceneUUID))
+			mainScene = static_resource_cast<Prefab>(resourceArchive->load(gameSettings->mainSceneUUID));
+		else
+		{
+			mainScene = static_resource_cast<Prefab>(gResources().loadFromUUID(gameSettings->mainSceneUUID,
+				true, ResourceLoadFlag::LoadDependencies));
+		}
+
+		typedef void(*LoadSceneFunc)(const HPrefab&, bool, bool);
+
+		LoadSceneFunc loadSceneCall = nullptr;
+		DynLib* scriptPlugin = gDynLibManager().load("SBansheeEngine");
+		if (scriptPlugin != nullptr)
+			loadSceneCall = (LoadSceneFunc)scriptPlugin->getSymbol("loadScene");
+
+		if (loadSceneCall != nullptr)
+			loadSceneCall(mainScene, false, true);
+		else
 		{
-			HSceneObject root = mainScene->instantiate();
-			HSceneObject oldRoot = gSceneManager().getRootNode();
+			mainScene.blockUntilLoaded();
 
-			gSceneManager().setRootNode(root);
-			oldRoot->destroy();
+			if (mainScene.isLoaded(false))
+			{
+				HSceneObject root = mainScene->instantiate();
+				HSceneObject oldRoot = gSceneManager().getRootNode();
+
+				gSceneManager().setRootNode(root);
+				oldRoot->destroy();
+			}
 		}
+
+		// Resources used by the main scene are referenced by it once loaded, so prefetched handles are only needed
+		// until then. Keeping them for the game's lifetime would prevent unused resources from ever unloading.
+		prefetcher.releaseOnLoad(mainScene);
 	}
 
 	Application::instance().runMainLoop();
+
+	prefetcher.release();
+
+	if (resourceArchive != nullptr)
+		resourceArchive->releaseKeptResources();
+
 	Application::shutDown();
 }
\ No newline at end of file
@@ -129,6 +129,28 @@ namespace BansheeEditor
             }
         }
 
+        /// <summary>
+        /// Called by the runtime when the editor is running in headless mode, instead of <see cref="OnEditorStartUp"/>.
+        /// Builds the currently loaded project for the active platform and logs the time spent in each build step.
+        /// </summary>
+        /// <returns>True if the build succeeded.</returns>
+        static bool OnHeadlessBuild()
+        {
+            try
+            {
+                BuildStep[] steps = BuildManager.Build();
+                foreach (var step in steps)
+                    Debug.Log(step.Name + ": " + step.Time.ToString("F0") + " ms");
+
+                return true;
+            }
+            catch (Exception e)
+            {
+                Debug.LogError("Build failed: " + e);
+                return false;
+            }
+        }
+
         /// <summary>
         /// Called 60 times per second by the runtime.
         /// </summary>
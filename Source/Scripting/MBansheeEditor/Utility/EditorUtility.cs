@@ -82,13 +82,14 @@ namespace BansheeEditor
         }
 
         /// <summary>
-        /// Find all resources that the provided resource depends on.
+        /// Find all resources that the provided resource depends on. The dependencies are not loaded, use 
+        /// <see cref="ProjectLibrary.GetPath"/> and <see cref="ProjectLibrary.Load{T}"/> to load the ones you need.
         /// </summary>
         /// <param name="resource">Resource whose dependencies to find.</param>
         /// <param name="recursive">Determines whether or not child objects will also be searched (if object has any 
         ///                         children).</param>
-        /// <returns>All resources the provided resource is dependant on (does not include itself).</returns>
-        public static Resource[] FindDependencies(Resource resource, bool recursive = true)
+        /// <returns>UUIDs of all resources the provided resource is dependant on (does not include itself).</returns>
+        public static UUID[] FindDependencies(Resource resource, bool recursive = true)
         {
             return Internal_FindDependencies(resource, recursive);
         }
@@ -117,7 +118,7 @@ namespace BansheeEditor
         private static extern void Internal_CalculateArrayCenter(SceneObject[] objects, out Vector3 center);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
-        private static extern Resource[] Internal_FindDependencies(Resource resource, bool recursive);
+        private static extern UUID[] Internal_FindDependencies(Resource resource, bool recursive);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern bool Internal_IsInternal(IntPtr soPtr);
@@ -3,6 +3,7 @@
 using System;
 using System.IO;
 using System.Runtime.CompilerServices;
+using System.Text;
 using System.Threading;
 using BansheeEngine;
 
@@ -108,6 +109,56 @@ namespace BansheeEditor
             set { Internal_SetDebug(mCachedPtr, value); }
         }
 
+        /// <summary>
+        /// Determines should the resources be packed into a single archive, instead of being output as separate files.
+        /// Reduces the number of files the game needs to open and allows it to memory map the resources.
+        /// </summary>
+        public bool PackResources
+        {
+            get { return Internal_GetPackResources(mCachedPtr); }
+            set { Internal_SetPackResources(mCachedPtr, value); }
+        }
+
+        /// <summary>
+        /// Determines should uncompressed textures be block compressed when building for this platform. Reduces
+        /// the size of the build and the amount of video memory used by the textures.
+        /// </summary>
+        public bool CompressTextures
+        {
+            get { return Internal_GetCompressTextures(mCachedPtr); }
+            set { Internal_SetCompressTextures(mCachedPtr, value); }
+        }
+
+        /// <summary>
+        /// Number of largest mip levels to remove from textures when building for this platform. Each removed level
+        /// halves the texture resolution, allowing lower quality builds to use less memory.
+        /// </summary>
+        public int TextureMipsToSkip
+        {
+            get { return Internal_GetTextureMipsToSkip(mCachedPtr); }
+            set { Internal_SetTextureMipsToSkip(mCachedPtr, value); }
+        }
+
+        /// <summary>
+        /// Determines should meshes be built without tangents. Enable for platforms whose shaders don't use normal
+        /// mapping.
+        /// </summary>
+        public bool StripMeshTangents
+        {
+            get { return Internal_GetStripMeshTangents(mCachedPtr); }
+            set { Internal_SetStripMeshTangents(mCachedPtr, value); }
+        }
+
+        /// <summary>
+        /// Determines should textures and meshes be built without a CPU copy of their data, regardless of their
+        /// import options. Reduces memory use, but scripts won't be able to read the texture or mesh data.
+        /// </summary>
+        public bool StripCPUCachedData
+        {
+            get { return Internal_GetStripCPUCachedData(mCachedPtr); }
+            set { Internal_SetStripCPUCachedData(mCachedPtr, value); }
+        }
+
         /// <summary>
         /// A set of semicolon separated defines to use when compiling scripts for this platform.
         /// </summary>
@@ -149,6 +200,36 @@ namespace BansheeEditor
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         static extern void Internal_SetDebug(IntPtr thisPtr, bool fullscreen);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern bool Internal_GetPackResources(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern void Internal_SetPackResources(IntPtr thisPtr, bool packResources);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern bool Internal_GetCompressTextures(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern void Internal_SetCompressTextures(IntPtr thisPtr, bool compressTextures);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern int Internal_GetTextureMipsToSkip(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern void Internal_SetTextureMipsToSkip(IntPtr thisPtr, int textureMipsToSkip);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern bool Internal_GetStripMeshTangents(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern void Internal_SetStripMeshTangents(IntPtr thisPtr, bool stripMeshTangents);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern bool Internal_GetStripCPUCachedData(IntPtr thisPtr);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        static extern void Internal_SetStripCPUCachedData(IntPtr thisPtr, bool stripCPUCachedData);
     }
 
     /// <summary>
@@ -272,23 +353,19 @@ namespace BansheeEditor
         }
 
         /// <summary>
-        /// Builds the executable and packages the game.
+        /// Builds the executable and packages the game. Independent build steps, such as copying binaries and packaging
+        /// resources, execute in parallel.
         /// </summary>
-        public static void Build()
+        /// <returns>Steps the build consisted of, along with the time each step took.</returns>
+        public static BuildStep[] Build()
         {
             PlatformType activePlatform = ActivePlatform;
             PlatformInfo platformInfo = ActivePlatformInfo;
 
+            // Note: Paths are retrieved up front, as steps running on other threads must not call into the engine
             string srcRoot = GetBuildFolder(BuildFolder.SourceRoot, activePlatform);
             string destRoot = GetBuildFolder(BuildFolder.DestinationRoot, activePlatform);
 
-            // Prepare clean destination folder
-            if(Directory.Exists(destRoot))
-                Directory.Delete(destRoot, true);
-
-            Directory.CreateDirectory(destRoot);
-
-            // Compile game assembly
             string bansheeAssemblyFolder;
             if(platformInfo.Debug)
                 bansheeAssemblyFolder = GetBuildFolder(BuildFolder.BansheeDebugAssemblies, activePlatform);
@@ -298,89 +375,186 @@ namespace BansheeEditor
             string srcBansheeAssemblyFolder = Path.Combine(srcRoot, bansheeAssemblyFolder);
             string destBansheeAssemblyFolder = Path.Combine(destRoot, bansheeAssemblyFolder);
 
-            Directory.CreateDirectory(destBansheeAssemblyFolder);
-            CompilerInstance ci = ScriptCompiler.CompileAsync(ScriptAssemblyType.Game, ActivePlatform, platformInfo.Debug, destBansheeAssemblyFolder);
+            string dataFolder = GetBuildFolder(BuildFolder.Data, activePlatform);
+            string binaryFolder = GetBuildFolder(BuildFolder.NativeBinaries, activePlatform);
+            string frameworkAssemblyFolder = GetBuildFolder(BuildFolder.FrameworkAssemblies, activePlatform);
+            string monoFolder = GetBuildFolder(BuildFolder.Mono, activePlatform);
+            string resourcesFolder = GetBuildFolder(BuildFolder.Resources, activePlatform);
+
+            string srcBin = Path.Combine(srcRoot, binaryFolder);
+            string destBin = destRoot;
+
+            string[] nativeBinaries = GetNativeBinaries(activePlatform);
+            string[] frameworkAssemblies = GetFrameworkAssemblies(activePlatform);
 
-            // Copy engine assembly
+            string srcExecFile = GetMainExecutable(activePlatform);
+            string destExecFile = Path.Combine(destBin, Path.GetFileName(srcExecFile));
+
+            BuildTaskGraph graph = new BuildTaskGraph();
+
+            // Icons are generated on an engine worker thread while the remaining steps run, and are only injected once
+            // the executable is copied
+            BuildStep generateIcons = graph.Add("Start icon generation", true, () => StartIconGeneration(platformInfo));
+
+            // Prepare clean destination folder. Packaged resources are kept, as packaging only writes the resources
+            // that changed since the last build, and removes outputs that are no longer used by itself.
+            BuildStep prepare = graph.Add("Prepare output folder", false, () =>
+            {
+                if (Directory.Exists(destRoot))
+                    ClearFolder(destRoot, Path.Combine(destRoot, resourcesFolder));
+
+                Directory.CreateDirectory(destRoot);
+                Directory.CreateDirectory(destBansheeAssemblyFolder);
+            });
+
+            // Compile game assembly
+            CompilerInstance ci = null;
+            BuildStep startCompile = graph.Add("Start script compilation", true, () =>
+            {
+                ci = ScriptCompiler.CompileAsync(ScriptAssemblyType.Game, activePlatform, platformInfo.Debug,
+                    destBansheeAssemblyFolder);
+            }, prepare);
+
+            graph.Add("Compile scripts", false, () =>
+            {
+                while (!ci.IsDone)
+                    Thread.Sleep(50);
+
+                // Without this the build would succeed without a game assembly
+                if (ci.HasErrors)
+                {
+                    StringBuilder errors = new StringBuilder();
+                    errors.AppendLine("Script compilation failed:");
+
+                    foreach (var msg in ci.ErrorMessages)
+                        errors.AppendLine(msg.file + "[" + msg.line + ":" + msg.column + "]: " + msg.message);
+
+                    throw new InvalidOperationException(errors.ToString());
+                }
+            }, startCompile);
+
+            graph.Add("Copy engine assembly", false, () =>
             {
                 string srcFile = Path.Combine(srcBansheeAssemblyFolder, EditorApplication.EngineAssemblyName);
                 string destFile = Path.Combine(destBansheeAssemblyFolder, EditorApplication.EngineAssemblyName);
 
                 File.Copy(srcFile, destFile);
-            }
-
-            // Copy builtin data
-            string dataFolder = GetBuildFolder(BuildFolder.Data, activePlatform);
-            string srcData = Path.Combine(srcRoot, dataFolder);
-            string destData = Path.Combine(destRoot, dataFolder);
+            }, prepare);
 
-            DirectoryEx.Copy(srcData, destData);
+            BuildStep copyData = graph.Add("Copy builtin data", false, () =>
+            {
+                DirectoryEx.Copy(Path.Combine(srcRoot, dataFolder), Path.Combine(destRoot, dataFolder));
+            }, prepare);
 
-            // Copy native binaries
-            string binaryFolder = GetBuildFolder(BuildFolder.NativeBinaries, activePlatform);
-            string srcBin = Path.Combine(srcRoot, binaryFolder);
-            string destBin = destRoot;
+            graph.Add("Copy native binaries", false, () =>
+            {
+                foreach (var entry in nativeBinaries)
+                    File.Copy(Path.Combine(srcBin, entry), Path.Combine(destBin, entry));
+            }, prepare);
 
-            string[] nativeBinaries = GetNativeBinaries(activePlatform);
-            foreach (var entry in nativeBinaries)
+            graph.Add("Copy framework assemblies", false, () =>
             {
-                string srcFile = Path.Combine(srcBin, entry);
-                string destFile = Path.Combine(destBin, entry);
+                string srcFrameworkAssemblyFolder = Path.Combine(srcRoot, frameworkAssemblyFolder);
+                string destFrameworkAssemblyFolder = Path.Combine(destRoot, frameworkAssemblyFolder);
 
-                File.Copy(srcFile, destFile);
-            }
+                Directory.CreateDirectory(destFrameworkAssemblyFolder);
 
-            // Copy .NET framework assemblies
-            string frameworkAssemblyFolder = GetBuildFolder(BuildFolder.FrameworkAssemblies, activePlatform);
-            string srcFrameworkAssemblyFolder = Path.Combine(srcRoot, frameworkAssemblyFolder);
-            string destFrameworkAssemblyFolder = Path.Combine(destRoot, frameworkAssemblyFolder);
+                foreach (var entry in frameworkAssemblies)
+                {
+                    string srcFile = Path.Combine(srcFrameworkAssemblyFolder, entry + ".dll");
+                    string destFile = Path.Combine(destFrameworkAssemblyFolder, entry + ".dll");
 
-            Directory.CreateDirectory(destFrameworkAssemblyFolder);
+                    File.Copy(srcFile, destFile);
+                }
+            }, prepare);
 
-            string[] frameworkAssemblies = GetFrameworkAssemblies(activePlatform);
-            foreach (var entry in frameworkAssemblies)
+            graph.Add("Copy Mono", false, () =>
             {
-                string srcFile = Path.Combine(srcFrameworkAssemblyFolder, entry + ".dll");
-                string destFile = Path.Combine(destFrameworkAssemblyFolder, entry + ".dll");
+                DirectoryEx.Copy(Path.Combine(srcRoot, monoFolder), Path.Combine(destRoot, monoFolder));
+            }, prepare);
 
-                File.Copy(srcFile, destFile);
+            BuildStep copyExecutable = graph.Add("Copy executable", false, () =>
+            {
+                File.Copy(srcExecFile, destExecFile);
+            }, prepare);
+
+            // Both write into the data folder, so they must not run while the builtin data is still being copied into it
+            graph.Add("Package resources", true, () => PackageResources(destRoot, platformInfo), copyData);
+            graph.Add("Create startup settings", true, () => CreateStartupSettings(destRoot, platformInfo), copyData);
+
+            // Registered after the other main thread steps, so waiting for the icons doesn't hold them up
+            graph.Add("Inject icons", true, () => Internal_InjectIcons(destExecFile), generateIcons, copyExecutable);
+
+            // Hashes every file in the build, so must run after everything else has been written
+            graph.Add("Write build manifest", true, () => Internal_WriteBuildManifest(destRoot), graph.Steps);
+
+            try
+            {
+                graph.Run();
+            }
+            finally
+            {
+                if (ci != null)
+                    ci.Dispose();
             }
 
-            // Copy Mono
-            string monoFolder = GetBuildFolder(BuildFolder.Mono, activePlatform);
-            string srcMonoFolder = Path.Combine(srcRoot, monoFolder);
-            string destMonoFolder = Path.Combine(destRoot, monoFolder);
+            return graph.Steps;
+        }
 
-            DirectoryEx.Copy(srcMonoFolder, destMonoFolder);
+        /// <summary>
+        /// Creates a patch that updates an older build of the game to the build in the provided folder. Every build
+        /// contains a manifest listing all of its files along with hashes of their contents, and the patch only contains
+        /// the files that differ from the old build's manifest, along with a list of files to remove.
+        /// </summary>
+        /// <param name="oldManifestPath">Absolute path to the manifest of the build the patch is applied to.</param>
+        /// <param name="buildFolder">Absolute path to the root folder of the new build.</param>
+        /// <param name="patchFolder">Absolute path to the folder to write the patch to. Any existing contents are
+        ///                           deleted.</param>
+        /// <returns>True if the patch was created successfully.</returns>
+        public static bool CreatePatch(string oldManifestPath, string buildFolder, string patchFolder)
+        {
+            return Internal_CreatePatch(oldManifestPath, buildFolder, patchFolder);
+        }
 
-            string srcExecFile = GetMainExecutable(activePlatform);
-            string destExecFile = Path.Combine(destBin, Path.GetFileName(srcExecFile));
+        /// <summary>
+        /// Deletes all files and folders within a folder, except for one of its sub-folders and its contents.
+        /// </summary>
+        /// <param name="folder">Absolute path to the folder to clear.</param>
+        /// <param name="keepFolder">Absolute path to the sub-folder to keep. Can be nested at any depth.</param>
+        private static void ClearFolder(string folder, string keepFolder)
+        {
+            char[] separators = { Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar };
+            string keepPath = Path.GetFullPath(keepFolder).TrimEnd(separators) + Path.DirectorySeparatorChar;
 
-            File.Copy(srcExecFile, destExecFile);
+            foreach (var entry in Directory.GetDirectories(folder))
+            {
+                string entryPath = Path.GetFullPath(entry).TrimEnd(separators) + Path.DirectorySeparatorChar;
 
-            InjectIcons(destExecFile, platformInfo);
-            PackageResources(destRoot, platformInfo);
-            CreateStartupSettings(destRoot, platformInfo);
+                if (string.Equals(entryPath, keepPath, StringComparison.OrdinalIgnoreCase))
+                    continue;
 
-            // Wait until compile finishes
-            while (!ci.IsDone)
-                Thread.Sleep(200);
+                if (keepPath.StartsWith(entryPath, StringComparison.OrdinalIgnoreCase))
+                    ClearFolder(entry, keepFolder);
+                else
+                    Directory.Delete(entry, true);
+            }
 
-            ci.Dispose();
+            foreach (var entry in Directory.GetFiles(folder))
+                File.Delete(entry);
         }
 
         /// <summary>
-        /// Injects icons specified in <see cref="PlatformInfo"/> into an executable at the specified path.
+        /// Starts generating the icons specified in <see cref="PlatformInfo"/> on a worker thread. Call 
+        /// <see cref="Internal_InjectIcons"/> to wait until they are generated and inject them into the executable.
         /// </summary>
-        /// <param name="filePath">Absolute path to the executable to inject icons in.</param>
-        /// <param name="info">Object containing references to icons to inject.</param>
-        private static void InjectIcons(string filePath, PlatformInfo info)
+        /// <param name="info">Object containing references to icons to generate.</param>
+        private static void StartIconGeneration(PlatformInfo info)
         {
             IntPtr infoPtr = IntPtr.Zero;
             if (info != null)
                 infoPtr = info.GetCachedPtr();
 
-            Internal_InjectIcons(filePath, infoPtr);
+            Internal_StartIconGeneration(infoPtr);
         }
 
         /// <summary>
@@ -474,7 +648,9 @@ namespace BansheeEditor
             /// <summary>Folder where miscelaneous Mono files are stored. Relative to root.</summary>
             Mono,
             /// <summary>Folder where builtin data is stored. Relative to root.</summary>
-            Data
+            Data,
+            /// <summary>Folder where packaged game resources are stored. Relative to root.</summary>
+            Resources
         }
 
         [MethodImpl(MethodImplOptions.InternalCall)]
@@ -508,13 +684,22 @@ namespace BansheeEditor
         private static extern string Internal_GetBuildFolder(BuildFolder folder, PlatformType platform);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
-        private static extern void Internal_InjectIcons(string filePath, IntPtr info);
+        private static extern void Internal_StartIconGeneration(IntPtr info);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_InjectIcons(string filePath);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern void Internal_PackageResources(string buildFolder, IntPtr info);
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern void Internal_CreateStartupSettings(string buildFolder, IntPtr info);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern void Internal_WriteBuildManifest(string buildFolder);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool Internal_CreatePatch(string oldManifestPath, string buildFolder, string patchFolder);
     }
 
     /** @} */
@@ -0,0 +1,203 @@
+﻿//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+
+namespace BansheeEditor
+{
+    /** @addtogroup Build
+     *  @{
+     */
+
+    /// <summary>
+    /// Single step of the build process, as registered with <see cref="BuildTaskGraph"/>.
+    /// </summary>
+    public sealed class BuildStep
+    {
+        internal Action action;
+        internal bool mainThread;
+        internal BuildStep[] dependencies;
+        internal bool started;
+        internal bool done;
+        internal Exception error;
+
+        /// <summary>
+        /// Name of the step, as displayed to the user.
+        /// </summary>
+        public string Name { get; internal set; }
+
+        /// <summary>
+        /// Time the step took to execute, in milliseconds. Zero if the step didn't execute.
+        /// </summary>
+        public float Time { get; internal set; }
+    }
+
+    /// <summary>
+    /// Executes build steps, starting each step as soon as all the steps it depends on finish. Steps that don't need to
+    /// run on the main thread execute on their own threads, in parallel with other steps.
+    /// </summary>
+    internal sealed class BuildTaskGraph
+    {
+        private List<BuildStep> steps = new List<BuildStep>();
+        private object sync = new object();
+
+        /// <summary>
+        /// Returns all the registered steps, in the order they were added.
+        /// </summary>
+        public BuildStep[] Steps
+        {
+            get { return steps.ToArray(); }
+        }
+
+        /// <summary>
+        /// Registers a new step.
+        /// </summary>
+        /// <param name="name">Name of the step, as displayed to the user.</param>
+        /// <param name="mainThread">True if the step calls into the engine and must execute on the main thread. Other
+        ///                          steps must only perform managed operations, such as copying files.</param>
+        /// <param name="action">Callback performing the step.</param>
+        /// <param name="dependencies">Steps that must finish before this step starts.</param>
+        /// <returns>Object representing the step, usable as a dependency of other steps.</returns>
+        public BuildStep Add(string name, bool mainThread, Action action, params BuildStep[] dependencies)
+        {
+            BuildStep step = new BuildStep();
+            step.Name = name;
+            step.action = action;
+            step.mainThread = mainThread;
+            step.dependencies = dependencies;
+
+            steps.Add(step);
+            return step;
+        }
+
+        /// <summary>
+        /// Executes all the registered steps and waits until they finish. If a step fails, steps depending on it are not
+        /// executed, and the first error is thrown once all the running steps finish.
+        /// </summary>
+        public void Run()
+        {
+            while (true)
+            {
+                BuildStep mainThreadStep = null;
+                lock (sync)
+                {
+                    bool failed = false;
+                    bool running = false;
+                    bool pending = false;
+
+                    foreach (var step in steps)
+                    {
+                        failed |= step.error != null;
+                        running |= step.started && !step.done;
+                    }
+
+                    foreach (var step in steps)
+                    {
+                        if (step.started || failed)
+                            continue;
+
+                        if (!CanStart(step))
+                        {
+                            pending = true;
+                            continue;
+                        }
+
+                        if (step.mainThread)
+                        {
+                            if (mainThreadStep == null)
+                            {
+                                step.started = true;
+                                mainThreadStep = step;
+                            }
+                            else
+                                pending = true;
+
+                            continue;
+                        }
+
+                        step.started = true;
+                        running = true;
+
+                        BuildStep threadStep = step;
+                        Thread thread = new Thread(() => Execute(threadStep));
+                        thread.Start();
+                    }
+
+                    if (mainThreadStep == null)
+                    {
+                        if (!running)
+                        {
+                            if (failed)
+                                break;
+
+                            // Steps can only be pending because of a dependency cycle at this point
+                            if (pending)
+                                throw new InvalidOperationException("Build steps have cyclic dependencies.");
+
+                            break;
+                        }
+
+                        Monitor.Wait(sync);
+                        continue;
+                    }
+                }
+
+                Execute(mainThreadStep);
+            }
+
+            foreach (var step in steps)
+            {
+                if (step.error != null)
+                    throw new Exception("Build step \"" + step.Name + "\" failed.", step.error);
+            }
+        }
+
+        /// <summary>
+        /// Checks have all the dependencies of the step finished successfully.
+        /// </summary>
+        /// <param name="step">Step to check.</param>
+        /// <returns>True if the step can be started.</returns>
+        private static bool CanStart(BuildStep step)
+        {
+            foreach (var dependency in step.dependencies)
+            {
+                if (!dependency.done || dependency.error != null)
+                    return false;
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Executes the step, recording its duration and any error.
+        /// </summary>
+        /// <param name="step">Step to execute.</param>
+        private void Execute(BuildStep step)
+        {
+            Stopwatch stopwatch = Stopwatch.StartNew();
+            Exception error = null;
+
+            try
+            {
+                step.action();
+            }
+            catch (Exception e)
+            {
+                error = e;
+            }
+
+            lock (sync)
+            {
+                step.Time = (float)stopwatch.Elapsed.TotalMilliseconds;
+                step.error = error;
+                step.done = true;
+
+                Monitor.PulseAll(sync);
+            }
+        }
+    }
+
+    /** @} */
+}
@@ -1,6 +1,7 @@
 ﻿//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 using System;
+using System.Text;
 using BansheeEngine;
 
 namespace BansheeEditor
@@ -107,11 +108,19 @@ namespace BansheeEditor
         {
             if (buildScheduledFrame == Time.FrameIdx)
             {
-                BuildManager.Build();
+                BuildStep[] steps = BuildManager.Build();
                 ProgressBar.Hide();
 
                 EditorApplication.OpenFolder(BuildManager.OutputFolder);
-                DialogBox.Open(new LocEdString("Build complete"), new LocEdString("Build complete"), DialogBox.Type.OK);
+
+                StringBuilder timings = new StringBuilder();
+                timings.AppendLine("Build complete. Time per step:");
+
+                foreach (var step in steps)
+                    timings.AppendLine(step.Name + ": " + step.Time.ToString("F0") + " ms");
+
+                Debug.Log(timings.ToString());
+                DialogBox.Open(new LocEdString("Build complete"), new LocEdString(timings.ToString()), DialogBox.Type.OK);
             }
         }
 
@@ -165,6 +174,7 @@ namespace BansheeEditor
 
             GUIResourceField sceneField = new GUIResourceField(typeof(Prefab), new LocEdString("Startup scene"));
             GUIToggleField debugToggle = new GUIToggleField(new LocEdString("Debug"));
+            GUIToggleField packResourcesToggle = new GUIToggleField(new LocEdString("Pack resources"));
             
             GUIToggleField fullscreenField = new GUIToggleField(new LocEdString("Fullscreen"));
             GUIIntField widthField = new GUIIntField(new LocEdString("Window width"));
@@ -172,24 +182,40 @@ namespace BansheeEditor
 
             GUITextField definesField = new GUITextField(new LocEdString("Defines"));
 
+            GUIToggleField compressTexturesToggle = new GUIToggleField(new LocEdString("Compress textures"));
+            GUIIntField textureMipsToSkipField = new GUIIntField(new LocEdString("Texture mips to skip"));
+            GUIToggleField stripMeshTangentsToggle = new GUIToggleField(new LocEdString("Strip mesh tangents"));
+            GUIToggleField stripCPUCachedDataToggle = new GUIToggleField(new LocEdString("Strip CPU cached data"));
+
             layout.AddSpace(5);
             layout.AddElement(options);
             layout.AddSpace(5);
             layout.AddElement(sceneField);
             layout.AddElement(debugToggle);
+            layout.AddElement(packResourcesToggle);
             layout.AddElement(fullscreenField);
             layout.AddElement(widthField);
             layout.AddElement(heightField);
             layout.AddSpace(5);
             layout.AddElement(definesField);
             layout.AddSpace(5);
+            layout.AddElement(compressTexturesToggle);
+            layout.AddElement(textureMipsToSkipField);
+            layout.AddElement(stripMeshTangentsToggle);
+            layout.AddElement(stripCPUCachedDataToggle);
+            layout.AddSpace(5);
 
             sceneField.ValueRef = platformInfo.MainScene;
             debugToggle.Value = platformInfo.Debug;
+            packResourcesToggle.Value = platformInfo.PackResources;
             definesField.Value = platformInfo.Defines;
             fullscreenField.Value = platformInfo.Fullscreen;
             widthField.Value = platformInfo.WindowedWidth;
             heightField.Value = platformInfo.WindowedHeight;
+            compressTexturesToggle.Value = platformInfo.CompressTextures;
+            textureMipsToSkipField.Value = platformInfo.TextureMipsToSkip;
+            stripMeshTangentsToggle.Value = platformInfo.StripMeshTangents;
+            stripCPUCachedDataToggle.Value = platformInfo.StripCPUCachedData;
 
             if (platformInfo.Fullscreen)
             {
@@ -199,6 +225,7 @@ namespace BansheeEditor
 
             sceneField.OnChanged += x => platformInfo.MainScene = x;
             debugToggle.OnChanged += x => platformInfo.Debug = x;
+            packResourcesToggle.OnChanged += x => platformInfo.PackResources = x;
             definesField.OnChanged += x => platformInfo.Defines = x;
             fullscreenField.OnChanged += x =>
             {
@@ -209,6 +236,10 @@ namespace BansheeEditor
             };
             widthField.OnChanged += x => platformInfo.WindowedWidth = x;
             heightField.OnChanged += x => platformInfo.WindowedHeight = x;
+            compressTexturesToggle.OnChanged += x => platformInfo.CompressTextures = x;
+            textureMipsToSkipField.OnChanged += x => platformInfo.TextureMipsToSkip = MathEx.Max(0, x);
+            stripMeshTangentsToggle.OnChanged += x => platformInfo.StripMeshTangents = x;
+            stripCPUCachedDataToggle.OnChanged += x => platformInfo.StripCPUCachedData = x;
 
             switch (platformInfo.Type)
             {
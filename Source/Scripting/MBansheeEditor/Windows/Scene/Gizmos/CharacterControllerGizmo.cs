@@ -17,7 +17,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="controller">Collider to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.Retained)]
         private static void Draw(CharacterController controller)
         {
             SceneObject so = controller.SceneObject;
@@ -17,7 +17,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="collider">Collider to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected | DrawGizmoFlags.Retained)]
         private static void DrawBoxCollider(BoxCollider collider)
         {
             SceneObject so = collider.SceneObject;
@@ -35,7 +35,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="collider">Collider to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected | DrawGizmoFlags.Retained)]
         private static void DrawSphereCollider(SphereCollider collider)
         {
             SceneObject so = collider.SceneObject;
@@ -53,7 +53,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="collider">Collider to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected | DrawGizmoFlags.Retained)]
         private static void DrawCapsuleCollider(CapsuleCollider collider)
         {
             SceneObject so = collider.SceneObject;
@@ -80,7 +80,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="collider">Collider to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected | DrawGizmoFlags.Retained)]
         private static void DrawMeshCollider(MeshCollider collider)
         {
             PhysicsMesh mesh = collider.Mesh;
@@ -100,7 +100,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="collider">Collider to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.ParentSelected | DrawGizmoFlags.Retained)]
         private static void DrawPlaneCollider(PlaneCollider collider)
         {
             SceneObject so = collider.SceneObject;
@@ -22,7 +22,13 @@ namespace BansheeEditor
         /// <summary>Gizmo is only displayed when its scene object is not selected.</summary>
         NotSelected = 0x04,
         /// <summary>Gizmo can be clicked on in scene view, which will select its scene object.</summary>
-        Pickable = 0x08
+        Pickable = 0x08,
+        /// <summary>
+        /// Gizmo draw calls are cached and the draw method is only called again when the component's scene object
+        /// moves, the scene is modified or a resource is loaded. Use only for gizmos that depend solely on their
+        /// component's state and the resources it references.
+        /// </summary>
+        Retained = 0x10
     }
 
     /// <summary>
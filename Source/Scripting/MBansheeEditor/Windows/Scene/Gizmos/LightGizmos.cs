@@ -17,7 +17,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="light">Light to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.Retained)]
         private static void Draw(Light light)
         {
             Vector3 position = light.SceneObject.Position;
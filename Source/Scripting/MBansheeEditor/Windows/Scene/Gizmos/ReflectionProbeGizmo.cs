@@ -17,7 +17,7 @@ namespace BansheeEditor
         /// Method called by the runtime when gizmos are meant to be drawn.
         /// </summary>
         /// <param name="reflProbe">Reflection probe to draw gizmos for.</param>
-        [DrawGizmo(DrawGizmoFlags.Selected)]
+        [DrawGizmo(DrawGizmoFlags.Selected | DrawGizmoFlags.Retained)]
         private static void Draw(ReflectionProbe reflProbe)
         {
             Vector3 position = reflProbe.SceneObject.Position;
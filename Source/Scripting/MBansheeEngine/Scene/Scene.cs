@@ -80,6 +80,37 @@ namespace BansheeEngine
             SetActive(scene);
         }
 
+        /// <summary>
+        /// Checks is a scene started with <see cref="LoadAsync"/> still loading.
+        /// </summary>
+        public static bool IsLoading
+        {
+            get { return Internal_IsLoading(); }
+        }
+
+        /// <summary>
+        /// Returns the progress of the scene load started with <see cref="LoadAsync"/>, in range [0, 1].
+        /// </summary>
+        public static float LoadProgress
+        {
+            get { return Internal_GetLoadProgress(); }
+        }
+
+        /// <summary>
+        /// Starts loading a new scene without stalling the game. Scene objects are instantiated progressively over
+        /// multiple frames, and become active as soon as they are instantiated. Use <see cref="IsLoading"/> to check when
+        /// the scene has been fully loaded.
+        /// </summary>
+        /// <param name="path">Path to the prefab to load.</param>
+        /// <param name="additive">If true the scene is added to the current scene, otherwise it replaces it.</param>
+        public static void LoadAsync(string path, bool additive = false)
+        {
+            Prefab scene = Internal_LoadSceneAsync(path, additive);
+
+            if (!additive)
+                SetActive(scene);
+        }
+
         /// <summary>
         /// Sets the currently active scene to the provided scene.
         /// </summary>
@@ -152,6 +183,15 @@ namespace BansheeEngine
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern Prefab Internal_LoadScene(string path);
 
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern Prefab Internal_LoadSceneAsync(string path, bool additive);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern bool Internal_IsLoading();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        private static extern float Internal_GetLoadProgress();
+
         [MethodImpl(MethodImplOptions.InternalCall)]
         private static extern SceneObject Internal_GetRoot();
 
@@ -6,6 +6,7 @@
 #include "BsMonoAssembly.h"
 #include "BsMonoClass.h"
 #include "BsMonoMethod.h"
+#include "BsMonoUtil.h"
 #include "Serialization/BsScriptAssemblyManager.h"
 #include "BsScriptGizmoManager.h"
 #include "BsScriptHandleManager.h"
@@ -59,6 +60,10 @@ namespace bs
 		mOnAssemblyRefreshDoneConn = ScriptObjectManager::instance().onRefreshComplete.connect(std::bind(&EditorScriptManager::onAssemblyRefreshDone, this));
 		triggerOnInitialize();
 
+		// Headless editor has no user interface to start up, and doesn't run the main loop
+		if (gEditorApplication().isHeadless())
+			return;
+
 		// Trigger OnEditorStartUp
 		const String EDITOR_ON_STARTUP = "Program::OnEditorStartUp";
 		mEditorAssembly->invoke(EDITOR_ON_STARTUP);
@@ -114,6 +119,16 @@ namespace bs
 		mEditorAssembly->invoke(EDITOR_ON_QUITREQUESTED);
 	}
 
+	bool EditorScriptManager::runHeadlessBuild()
+	{
+		MonoMethod* buildMethod = mProgramEdClass->getMethod("OnHeadlessBuild");
+		if (buildMethod == nullptr)
+			return false;
+
+		MonoObject* succeededObj = buildMethod->invoke(nullptr, nullptr);
+		return succeededObj != nullptr && *(bool*)MonoUtil::unbox(succeededObj);
+	}
+
 	void EditorScriptManager::triggerOnInitialize()
 	{
 		const String ASSEMBLY_ENTRY_POINT = "Program::OnInitialize";
@@ -32,6 +32,14 @@ namespace bs
 		 */
 		void quitRequested();
 
+		/**
+		 * Runs the managed build pipeline for the active platform, when the editor is running in headless mode. Returns
+		 * true if the build succeeded.
+		 *
+		 * @note	Internal method.
+		 */
+		bool runHeadlessBuild();
+
 	private:
 		/** Triggers Program::OnInitialize callback. Should be called after startup and after assembly reload. */
 		void triggerOnInitialize();
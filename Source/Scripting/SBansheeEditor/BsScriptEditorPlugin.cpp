@@ -30,4 +30,9 @@ namespace bs
 	{
 		EditorScriptManager::instance().quitRequested();
 	}
+
+	extern "C" BS_SCR_BED_EXPORT bool runHeadlessBuild()
+	{
+		return EditorScriptManager::instance().runHeadlessBuild();
+	}
 }
\ No newline at end of file
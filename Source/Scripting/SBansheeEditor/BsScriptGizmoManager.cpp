@@ -13,9 +13,13 @@
 #include "BsManagedComponent.h"
 #include "Scene/BsGizmoManager.h"
 #include "Scene/BsSelection.h"
+#include "UndoRedo/BsUndoRedo.h"
+#include "BsPlayInEditorManager.h"
 #include "BsScriptObjectManager.h"
 #include "BsScriptGameObjectManager.h"
 #include "Wrappers/BsScriptComponent.h"
+#include "Resources/BsResources.h"
+#include "Utility/BsContentHash.h"
 
 using namespace std::placeholders;
 
@@ -25,12 +29,23 @@ namespace bs
 		:mScriptObjectManager(scriptObjectManager), mDrawGizmoAttribute(nullptr), mFlagsField(nullptr)
 	{
 		mDomainLoadedConn = ScriptObjectManager::instance().onRefreshDomainLoaded.connect(std::bind(&ScriptGizmoManager::reloadAssemblyData, this));
+		mResourceLoadedConn = gResources().onResourceLoaded.connect(
+			std::bind(&ScriptGizmoManager::onResourceChanged, this, _1));
+		mResourceModifiedConn = gResources().onResourceModified.connect(
+			std::bind(&ScriptGizmoManager::onResourceChanged, this, _1));
 		reloadAssemblyData();
 	}
 
 	ScriptGizmoManager::~ScriptGizmoManager()
 	{
 		mDomainLoadedConn.disconnect();
+		mResourceLoadedConn.disconnect();
+		mResourceModifiedConn.disconnect();
+	}
+
+	void ScriptGizmoManager::onResourceChanged(const HResource& resource)
+	{
+		mResourceVersion++;
 	}
 
 	void ScriptGizmoManager::update()
@@ -47,6 +62,13 @@ namespace bs
 		
 		Vector<HSceneObject> selectedObjects = Selection::instance().getSceneObjects();
 
+		// Retained gizmos can't tell when their component's properties change. Assume any new undo command might have
+		// changed them, and always redraw gizmos while scripts are running or for the object open in the inspector.
+		// Gizmos can also depend on resources their component references (e.g. a collider's mesh), so any resource
+		// that finishes loading or is reimported redraws them as well.
+		UINT64 retainedVersion = ContentHash::combine(UndoRedo::instance().getTopCommandId(), mResourceVersion);
+		bool allowRetained = PlayInEditorManager::instance().getState() != PlayInEditorState::Playing;
+
 		while (!todo.empty())
 		{
 			if (isParentSelected && parentSelectedPopIdx == (UINT32)todo.size())
@@ -112,11 +134,25 @@ namespace bs
 					if (drawGizmo)
 					{
 						bool pickable = (flags & (UINT32)DrawGizmoFlags::Pickable) != 0;
-						GizmoManager::instance().startGizmo(curSO);
+						bool retained = (flags & (UINT32)DrawGizmoFlags::Retained) != 0 && allowRetained &&
+							!(isSelected && selectedObjects.size() == 1);
+
+						bool needsDraw = true;
+						if (retained)
+						{
+							needsDraw = GizmoManager::instance().startRetainedGizmo(curSO, component.getInstanceId(),
+								retainedVersion);
+						}
+						else
+							GizmoManager::instance().startGizmo(curSO);
+
 						GizmoManager::instance().setPickable(pickable);
 
-						void* params[1] = { managedInstance };
-						iterFind->second.drawGizmosMethod->invoke(nullptr, params);
+						if (needsDraw)
+						{
+							void* params[1] = { managedInstance };
+							iterFind->second.drawGizmosMethod->invoke(nullptr, params);
+						}
 
 						GizmoManager::instance().endGizmo();
 					}
@@ -130,6 +166,9 @@ namespace bs
 
 	void ScriptGizmoManager::reloadAssemblyData()
 	{
+		// Cached draw calls may come from drawer methods that no longer exist or have changed
+		GizmoManager::instance().clearRetainedGizmos();
+
 		// Reload DrawGizmo attribute from editor assembly
 		MonoAssembly* editorAssembly = MonoManager::instance().getAssembly(EDITOR_ASSEMBLY);
 		mDrawGizmoAttribute = editorAssembly->getClass("BansheeEditor", "DrawGizmo");
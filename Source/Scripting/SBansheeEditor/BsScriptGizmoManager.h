@@ -17,7 +17,13 @@ namespace bs
 		Selected = 0x01, /**< Gizmo is only displayed when its scene object is selected. */
 		ParentSelected = 0x02, /**< Gizmo is only displayed when its parent scene object is selected. */
 		NotSelected = 0x04, /**< Gizmo is only displayed when its scene object is not selected. */
-		Pickable = 0x08 /**< Gizmo can be clicked on in scene view, which will select its scene object. */
+		Pickable = 0x08, /**< Gizmo can be clicked on in scene view, which will select its scene object. */
+		/**
+		 * Gizmo draw calls are cached and the draw method is only called again when the component's scene object
+		 * moves, the scene is modified or a resource is loaded. Use only for gizmos that depend solely on their
+		 * component's state and the resources it references.
+		 */
+		Retained = 0x10
 	};
 
 	/** 
@@ -58,8 +64,14 @@ namespace bs
 		 */
 		bool isValidDrawGizmoMethod(MonoMethod* method, MonoClass*& componentType, UINT32& drawGizmoFlags);
 
+		/** Triggered when a resource is loaded or modified. Invalidates all retained gizmos. */
+		void onResourceChanged(const HResource& resource);
+
 		ScriptAssemblyManager& mScriptObjectManager;
 		HEvent mDomainLoadedConn;
+		HEvent mResourceLoadedConn;
+		HEvent mResourceModifiedConn;
+		UINT64 mResourceVersion = 0;
 
 		MonoClass* mDrawGizmoAttribute;
 		MonoField* mFlagsField;
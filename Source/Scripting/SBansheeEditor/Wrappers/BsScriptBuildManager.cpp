@@ -21,9 +21,18 @@
 #include "Scene/BsSceneObject.h"
 #include "Debug/BsDebug.h"
 #include "Resources/BsGameResourceManager.h"
+#include "Build/BsResourcePackager.h"
+#include "Utility/BsIconGenerator.h"
+#include "Build/BsBuildManifest.h"
+#include "Importer/BsImporter.h"
+#include "Importer/BsTextureImportOptions.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
+	SPtr<Task> ScriptBuildManager::sIconTask;
+	Map<UINT32, SPtr<PixelData>> ScriptBuildManager::sIcons;
+
 	ScriptBuildManager::ScriptBuildManager(MonoObject* instance)
 		:ScriptObject(instance)
 	{ }
@@ -40,9 +49,12 @@ namespace bs
 		metaData.scriptClass->addInternalCall("Internal_GetDefines", (void*)&ScriptBuildManager::internal_GetDefines);
 		metaData.scriptClass->addInternalCall("Internal_GetNativeBinaries", (void*)&ScriptBuildManager::internal_GetNativeBinaries);
 		metaData.scriptClass->addInternalCall("Internal_GetBuildFolder", (void*)&ScriptBuildManager::internal_GetBuildFolder);
+		metaData.scriptClass->addInternalCall("Internal_StartIconGeneration", (void*)&ScriptBuildManager::internal_StartIconGeneration);
 		metaData.scriptClass->addInternalCall("Internal_InjectIcons", (void*)&ScriptBuildManager::internal_InjectIcons);
 		metaData.scriptClass->addInternalCall("Internal_PackageResources", (void*)&ScriptBuildManager::internal_PackageResources);
 		metaData.scriptClass->addInternalCall("Internal_CreateStartupSettings", (void*)&ScriptBuildManager::internal_CreateStartupSettings);
+		metaData.scriptClass->addInternalCall("Internal_WriteBuildManifest", (void*)&ScriptBuildManager::internal_WriteBuildManifest);
+		metaData.scriptClass->addInternalCall("Internal_CreatePatch", (void*)&ScriptBuildManager::internal_CreatePatch);
 	}
 
 	MonoArray* ScriptBuildManager::internal_GetAvailablePlatforms()
@@ -154,6 +166,9 @@ namespace bs
 			case ScriptBuildFolder::Data:
 				nativeFolderType = BuildFolder::Data;
 				break;
+			case ScriptBuildFolder::Resources:
+				nativeFolderType = BuildFolder::Resources;
+				break;
 			default:
 				break;
 			}
@@ -164,252 +179,95 @@ namespace bs
 		return MonoUtil::stringToMono(path.toString());
 	}
 
-	void ScriptBuildManager::internal_InjectIcons(MonoString* filePath, ScriptPlatformInfo* info)
+	void ScriptBuildManager::internal_StartIconGeneration(ScriptPlatformInfo* info)
 	{
+		if (sIconTask != nullptr)
+			sIconTask->wait();
+
+		sIconTask = nullptr;
+		sIcons.clear();
+
 		if (info == nullptr)
 			return;
 
-		Path executablePath = MonoUtil::monoToString(filePath);
-
-		Map<UINT32, SPtr<PixelData>> icons;
+		Path iconPath;
 		SPtr<PlatformInfo> platformInfo = info->getPlatformInfo();
 		switch (platformInfo->type)
 		{
 		case PlatformType::Windows:
 		{
 			SPtr<WinPlatformInfo> winPlatformInfo = std::static_pointer_cast<WinPlatformInfo>(platformInfo);
-
-			struct IconData
-			{
-				UINT32 size;
-				SPtr<PixelData> pixels;
-			};
-
-			IconData textures[] =
-			{ 
-				{ 16, nullptr },
-				{ 32, nullptr },
-				{ 48, nullptr },
-				{ 64, nullptr },
-				{ 96, nullptr },
-				{ 128, nullptr },
-				{ 192, nullptr },
-				{ 256, nullptr }
-			};
-
-			HTexture icon = gResources().load(winPlatformInfo->icon);
-			if (icon.isLoaded())
-			{
-				auto& texProps = icon->getProperties();
-
-				SPtr<PixelData> pixels = texProps.allocBuffer(0, 0);
-				icon->readData(pixels);
-				gCoreThread().submit(true);
-
-				for (auto& entry : textures)
-				{
-					entry.pixels = PixelData::create(entry.size, entry.size, 1, PF_RGBA8);
-					PixelUtil::scale(*pixels, *entry.pixels);
-
-					icons[entry.size] = entry.pixels;
-				}
-			}
+			iconPath = gProjectLibrary().uuidToPath(winPlatformInfo->icon.getUUID());
 		}
 			break;
 		default:
 			break;
 		}
 
-		IconUtility::updateIconExe(executablePath, icons);
-	}
-
-	void ScriptBuildManager::internal_PackageResources(MonoString* buildFolder, ScriptPlatformInfo* info)
-	{
-		UnorderedSet<Path> usedResources;
-		SPtr<ResourceMapping> resourceMap = ResourceMapping::create();
-
-		// Get all resources manually included in build
-		Vector<ProjectLibrary::FileEntry*> buildResources = gProjectLibrary().getResourcesForBuild();
-		for (auto& entry : buildResources)
-		{
-			if (entry->meta == nullptr)
-			{
-				LOGWRN("Cannot include resource in build, missing meta file for: " + entry->path.toString());
-				continue;
-			}
-
-			auto& resourceMetas = entry->meta->getResourceMetaData();
-			for(auto& resMeta : resourceMetas)
-			{
-				Path resourcePath;
-				if (gResources().getFilePathFromUUID(resMeta->getUUID(), resourcePath))
-					usedResources.insert(resourcePath);
-				else
-					LOGWRN("Cannot include resource in build, missing imported asset for: " + entry->path.toString());
-			}
-		}
-
-		// Include main scene
-		SPtr<PlatformInfo> platformInfo;
-
-		if (info != nullptr)
-			platformInfo = info->getPlatformInfo();
-
-		if (platformInfo != nullptr)
-		{
-			Path resourcePath;
-			if (gResources().getFilePathFromUUID(platformInfo->mainScene.getUUID(), resourcePath))
-				usedResources.insert(resourcePath);
-			else
-				LOGWRN("Cannot include main scene in build, missing imported asset.");
-		}
-
-		// Find dependencies of all resources
-		Vector<Path> newResources;
-		for (auto& entry : usedResources)
-			newResources.push_back(entry);
-
-		while (!newResources.empty())
-		{
-			Vector<Path> allDependencies;
-			for (auto& entry : newResources)
-			{
-				Vector<UUID> curDependencies = gResources().getDependencies(entry);
-				for (auto& entry : curDependencies)
-				{
-					Path resourcePath;
-					if (gResources().getFilePathFromUUID(entry, resourcePath))
-					{
-						if (usedResources.find(resourcePath) == usedResources.end())
-						{
-							allDependencies.push_back(resourcePath);
-							usedResources.insert(resourcePath);
-						}
-					}
-				}
-			}
-
-			newResources = allDependencies;
-		} 
-
-		// Copy resources
-		Path buildPath = MonoUtil::monoToString(buildFolder);
+		if (iconPath.isEmpty() || !FileSystem::isFile(iconPath))
+			return;
 
-		Path outputPath = buildPath;
-		outputPath.append(GAME_RESOURCES_FOLDER_NAME);
+		SPtr<ImportOptions> importOptions = gImporter().createImportOptions(iconPath);
+		if (importOptions == nullptr || importOptions->getRTTI()->getRTTIId() != TID_TextureImportOptions)
+			return;
 
-		FileSystem::createDir(outputPath);
+		// The icon is imported again with CPU caching enabled, so its pixels can be read on a worker thread without
+		// waiting on the GPU. Generating the icons then overlaps with the rest of the build.
+		SPtr<TextureImportOptions> textureIO = std::static_pointer_cast<TextureImportOptions>(importOptions);
+		textureIO->setFormat(PF_RGBA8);
+		textureIO->setCPUCached(true);
 
-		Path libraryDir = gProjectLibrary().getResourcesFolder();
-		for (auto& entry : usedResources)
+		sIconTask = Task::create("GenerateBuildIcons", [iconPath, textureIO]()
 		{
-			UUID uuid;
-
-			const bool found = gResources().getUUIDFromFilePath(entry, uuid);
-			BS_ASSERT(found);
+			const Vector<UINT32> sizes = { 16, 32, 48, 64, 96, 128, 192, 256 };
 
-			Path sourcePath = gProjectLibrary().uuidToPath(uuid);
-			if (sourcePath.isEmpty()) // Resource not part of library, meaning its built-in and we don't need to copy those here
-				continue;
+			Vector<SubResourceRaw> importedResources = gImporter()._importAll(iconPath, textureIO);
+			if (importedResources.empty())
+				return;
 
-			SPtr<ProjectResourceMeta> resMeta = gProjectLibrary().findResourceMeta(sourcePath);
-			assert(resMeta != nullptr);
+			SPtr<Texture> texture = std::static_pointer_cast<Texture>(importedResources[0].value);
+			SPtr<PixelData> pixels = IconGenerator::readCachedPixels(*texture, sizes.back());
+			if (pixels != nullptr)
+				sIcons = IconGenerator::generate(*pixels, sizes);
+		});
 
-			Path destPath = outputPath;
-			destPath.setFilename(entry.getFilename());
-
-			// Create library -> packaged resource mapping
-			Path relSourcePath = sourcePath;
-			if (sourcePath.isAbsolute())
-				relSourcePath.makeRelative(libraryDir);
-
-			Path relDestPath = GAME_RESOURCES_FOLDER_NAME;
-			relDestPath.setFilename(entry.getFilename());
-
-			resourceMap->add(relSourcePath, relDestPath);
-
-			// If resource is prefab make sure to update it in case any of the prefabs it is referencing changed
-			if (resMeta->getTypeID() == TID_Prefab)
-			{
-				bool reload = gResources().isLoaded(uuid);
-
-				HPrefab prefab = static_resource_cast<Prefab>(gProjectLibrary().load(sourcePath));
-				prefab->_updateChildInstances();
-
-				// Clear prefab diffs as they're not used in standalone
-				Stack<HSceneObject> todo;
-				todo.push(prefab->_getRoot());
-
-				while (!todo.empty())
-				{
-					HSceneObject current = todo.top();
-					todo.pop();
-
-					current->_clearPrefabDiff();
-
-					UINT32 numChildren = current->getNumChildren();
-					for (UINT32 i = 0; i < numChildren; i++)
-					{
-						HSceneObject child = current->getChild(i);
-						todo.push(child);
-					}
-				}
-
-				gResources().save(prefab, destPath, false);
-
-				// Need to unload this one as we modified it in memory, and we don't want to persist those changes past
-				// this point
-				gResources().release(prefab);
-
-				if (reload)
-					gProjectLibrary().load(sourcePath);
-			}
-			else
-				FileSystem::copy(entry, destPath);
-		}
-
-		// Save icon
-		Path iconFolder = BuiltinResources::getIconFolder();
-
-		Path sourceRoot = BuildManager::instance().getBuildFolder(BuildFolder::SourceRoot, platformInfo->type);
-		iconFolder.makeRelative(sourceRoot);
+		TaskScheduler::instance().addTask(sIconTask);
+	}
 
-		Path destRoot = BuildManager::instance().getBuildFolder(BuildFolder::DestinationRoot, platformInfo->type);
-		Path destIconFile = destRoot;
-		destIconFile.append(iconFolder);
-		destIconFile.setFilename(String(BuiltinResources::IconTextureName) + ".asset");
+	void ScriptBuildManager::internal_InjectIcons(MonoString* filePath)
+	{
+		Path executablePath = MonoUtil::monoToString(filePath);
 
-		switch (platformInfo->type)
-		{
-		case PlatformType::Windows:
+		if (sIconTask != nullptr)
 		{
-			SPtr<WinPlatformInfo> winPlatformInfo = std::static_pointer_cast<WinPlatformInfo>(platformInfo);
-			
-			HTexture icon = gResources().load(winPlatformInfo->icon);
-			if (icon != nullptr)
-				gResources().save(icon, destIconFile, true);
+			sIconTask->wait();
+			sIconTask = nullptr;
 		}
-			break;
-		default:
-			break;
-		};
 
-		// Save manifest
-		Path manifestPath = outputPath;
-		manifestPath.append(GAME_RESOURCE_MANIFEST_NAME);
+		IconUtility::updateIconExe(executablePath, sIcons);
+		sIcons.clear();
+	}
 
-		Path internalResourcesFolder = gEditorApplication().getProjectPath();
-		internalResourcesFolder.append(PROJECT_INTERNAL_DIR);
+	void ScriptBuildManager::internal_PackageResources(MonoString* buildFolder, ScriptPlatformInfo* info)
+	{
+		SPtr<PlatformInfo> platformInfo;
 
-		SPtr<ResourceManifest> manifest = gProjectLibrary()._getManifest();
-		ResourceManifest::save(manifest, manifestPath, internalResourcesFolder);
+		if (info != nullptr)
+			platformInfo = info->getPlatformInfo();
 
-		// Save resource map
-		Path mappingPath = outputPath;
-		mappingPath.append(GAME_RESOURCE_MAPPING_NAME);
+		Path buildPath = MonoUtil::monoToString(buildFolder);
 
-		FileEncoder fe(mappingPath);
-		fe.encode(resourceMap.get());
+		ResourcePackager packager(buildPath, platformInfo);
+		packager.package();
+
+		const ResourcePackagingStats& stats = packager.getStats();
+		LOGDBG("Packaged " + toString(stats.numResources) + " resources (" + toString(stats.numCopied) + " copied, " +
+			toString(stats.numCooked) + " cooked, " + toString(stats.numPrefabsSaved) + " prefabs saved, " +
+			toString(stats.numSkipped) + " up to date, " + toString(stats.numRemoved) + " removed) in " + toString(stats.totalTime) + " ms. Dependencies: " +
+			toString(stats.dependencyTime) + " ms, hashing: " + toString(stats.hashTime) + " ms, copying: " +
+			toString(stats.copyTime) + " ms, prefabs: " + toString(stats.prefabTime) + " ms, archive: " +
+			toString(stats.archiveTime) + " ms (" + toString(stats.numArchiveReused) + " entries reused), finalizing: " +
+			toString(stats.finalizeTime) + " ms.");
 	}
 
 	void ScriptBuildManager::internal_CreateStartupSettings(MonoString* buildFolder, ScriptPlatformInfo* info)
@@ -447,4 +305,27 @@ namespace bs
 		FileEncoder fe(outputPath);
 		fe.encode(gameSettings.get());
 	}
+
+	void ScriptBuildManager::internal_WriteBuildManifest(MonoString* buildFolder)
+	{
+		Path buildFolderPath = MonoUtil::monoToString(buildFolder);
+		BuildManifest::writeToBuild(buildFolderPath);
+	}
+
+	bool ScriptBuildManager::internal_CreatePatch(MonoString* oldManifestPath, MonoString* buildFolder,
+		MonoString* patchFolder)
+	{
+		Path oldManifestFile = MonoUtil::monoToString(oldManifestPath);
+		SPtr<BuildManifest> oldManifest = BuildManifest::load(oldManifestFile);
+		if (oldManifest == nullptr)
+		{
+			LOGERR("Cannot create patch, unable to load the build manifest at \"" + oldManifestFile.toString() + "\".");
+			return false;
+		}
+
+		Path buildFolderPath = MonoUtil::monoToString(buildFolder);
+		Path patchFolderPath = MonoUtil::monoToString(patchFolder);
+
+		return BuildManifest::createPatch(*oldManifest, buildFolderPath, patchFolderPath);
+	}
 }
@@ -22,7 +22,8 @@ namespace bs
 		BansheeReleaseAssemblies, /**< Folder where Banshee specific release assemblies are stored. Relative to root. */
 		FrameworkAssemblies, /**< Folder where .NET framework assemblies are stored. Relative to root. */
 		Mono, /**< Folder where miscelaneous Mono files are stored. Relative to root. */
-		Data /**< Folder where builtin data is stored. Relative to root. */
+		Data, /**< Folder where builtin data is stored. Relative to root. */
+		Resources /**< Folder where packaged game resources are stored. Relative to root. */
 	};
 
 	/**	Interop class between C++ & CLR for BuildManager. */
@@ -47,9 +48,18 @@ namespace bs
 		static MonoString* internal_GetDefines(PlatformType type);
 		static MonoArray* internal_GetNativeBinaries(PlatformType type);
 		static MonoString* internal_GetBuildFolder(ScriptBuildFolder folder, PlatformType platform);
-		static void internal_InjectIcons(MonoString* filePath, ScriptPlatformInfo* info);
+		static void internal_StartIconGeneration(ScriptPlatformInfo* info);
+		static void internal_InjectIcons(MonoString* filePath);
 		static void internal_PackageResources(MonoString* buildFolder, ScriptPlatformInfo* info);
 		static void internal_CreateStartupSettings(MonoString* buildFolder, ScriptPlatformInfo* info);
+		static void internal_WriteBuildManifest(MonoString* buildFolder);
+		static bool internal_CreatePatch(MonoString* oldManifestPath, MonoString* buildFolder, MonoString* patchFolder);
+
+		/** Task generating the executable icons, started by internal_StartIconGeneration(). */
+		static SPtr<Task> sIconTask;
+
+		/** Executable icons generated by sIconTask, keyed by their size. */
+		static Map<UINT32, SPtr<PixelData>> sIcons;
 	};
 
 	/** @} */
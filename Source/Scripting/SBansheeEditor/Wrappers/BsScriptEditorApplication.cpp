@@ -22,6 +22,7 @@
 #include "BsScriptResourceManager.h"
 #include "FileSystem/BsFileSystem.h"
 #include "Wrappers/BsScriptPrefab.h"
+#include "Build/BsResourceLoadProfile.h"
 
 #include "BsScriptRenderTexture.generated.h"
 
@@ -31,6 +32,7 @@ namespace bs
 	bool ScriptEditorApplication::mRequestAssemblyReload = false;
 	Path ScriptEditorApplication::mProjectLoadPath;
 	HEvent ScriptEditorApplication::OnStatusBarClickedConn;
+	ResourceLoadRecorder* ScriptEditorApplication::mLoadRecorder = nullptr;
 
 	ScriptEditorApplication::OnProjectLoadedThunkDef ScriptEditorApplication::onProjectLoadedThunk;
 	ScriptEditorApplication::OnStatusBarClickedThunkDef ScriptEditorApplication::onStatusBarClickedThunk;
@@ -85,11 +87,16 @@ namespace bs
 	{
 		MainEditorWindow* mainWindow = EditorWindowManager::instance().getMainWindow();
 		OnStatusBarClickedConn = mainWindow->getStatusBar().onMessageClicked.connect(&ScriptEditorApplication::onStatusBarClicked);
+
+		mLoadRecorder = bs_new<ResourceLoadRecorder>();
 	}
 
 	void ScriptEditorApplication::shutDown()
 	{
 		OnStatusBarClickedConn.disconnect();
+
+		bs_delete(mLoadRecorder);
+		mLoadRecorder = nullptr;
 	}
 
 	void ScriptEditorApplication::update()
@@ -325,10 +332,17 @@ namespace bs
 
 	void ScriptEditorApplication::internal_SetIsPlaying(bool value)
 	{
+		// Record resources the game loads while running, so builds can prefetch them on startup
 		if (value)
+		{
+			mLoadRecorder->start();
 			PlayInEditorManager::instance().setState(PlayInEditorState::Playing);
+		}
 		else
+		{
+			mLoadRecorder->stop();
 			PlayInEditorManager::instance().setState(PlayInEditorState::Stopped);
+		}
 	}
 
 	bool ScriptEditorApplication::internal_GetIsPaused()
@@ -339,7 +353,10 @@ namespace bs
 	void ScriptEditorApplication::internal_SetIsPaused(bool value)
 	{
 		if (value)
+		{
+			mLoadRecorder->start();
 			PlayInEditorManager::instance().setState(PlayInEditorState::Paused);
+		}
 		else
 		{
 			bool isPaused = PlayInEditorManager::instance().getState() == PlayInEditorState::Paused;
@@ -350,6 +367,7 @@ namespace bs
 
 	void ScriptEditorApplication::internal_FrameStep()
 	{
+		mLoadRecorder->start();
 		PlayInEditorManager::instance().frameStep();
 	}
 
@@ -36,6 +36,7 @@ namespace bs
 		static bool mRequestAssemblyReload;
 		static Path mProjectLoadPath;
 		static HEvent OnStatusBarClickedConn;
+		static ResourceLoadRecorder* mLoadRecorder;
 
 		/************************************************************************/
 		/* 								CLR HOOKS						   		*/
@@ -12,6 +12,7 @@
 #include "BsScriptResourceManager.h"
 #include "Utility/BsUtility.h"
 #include "Scene/BsSceneObject.h"
+#include "Library/BsProjectLibrary.h"
 
 namespace bs
 {
@@ -62,21 +63,31 @@ namespace bs
 		ScriptResource* srcResource = ScriptResource::toNative(resource);
 		if (srcResource == nullptr)
 		{
-			ScriptArray emptyArray = ScriptArray::create<ScriptResource>(0);
+			ScriptArray emptyArray = ScriptArray::create<ScriptUUID>(0);
 			return emptyArray.getInternal();
 		}
 
 		HResource srcHandle = srcResource->getGenericHandle();
-		Vector<ResourceDependency> dependencies = Utility::findResourceDependencies(srcHandle, recursive);
 
-		UINT32 numEntries = (UINT32)dependencies.size();
-		ScriptArray output = ScriptArray::create<ScriptResource>(numEntries);
-		for (UINT32 i = 0; i < numEntries; i++)
+		// Only UUIDs are returned, so finding dependencies never starts loading them
+		Vector<UUID> dependencies;
+		if (gProjectLibrary().findResourceMeta(srcHandle.getUUID()) != nullptr)
+		{
+			// Use the references recorded by the library, instead of walking the resource and its dependencies
+			dependencies = gProjectLibrary().getResourceDependencies(srcHandle.getUUID(), recursive);
+		}
+		else
 		{
-			ScriptResourceBase* dependency = ScriptResourceManager::instance().getScriptResource(dependencies[i].resource, true);
-			output.set(i, dependency->getManagedInstance());
+			Vector<ResourceDependency> resourceDependencies = Utility::findResourceDependencies(srcHandle, recursive);
+			for (auto& entry : resourceDependencies)
+				dependencies.push_back(entry.resource.getUUID());
 		}
 
+		UINT32 numEntries = (UINT32)dependencies.size();
+		ScriptArray output = ScriptArray::create<ScriptUUID>(numEntries);
+		for (UINT32 i = 0; i < numEntries; i++)
+			output.set(i, dependencies[i]);
+
 		return output.getInternal();
 	}
 
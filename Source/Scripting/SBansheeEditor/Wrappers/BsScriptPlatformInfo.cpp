@@ -35,6 +35,16 @@ namespace bs
 		metaData.scriptClass->addInternalCall("Internal_SetResolution", (void*)&ScriptPlatformInfo::internal_SetResolution);
 		metaData.scriptClass->addInternalCall("Internal_GetDebug", (void*)&ScriptPlatformInfo::internal_GetDebug);
 		metaData.scriptClass->addInternalCall("Internal_SetDebug", (void*)&ScriptPlatformInfo::internal_SetDebug);
+		metaData.scriptClass->addInternalCall("Internal_GetPackResources", (void*)&ScriptPlatformInfo::internal_GetPackResources);
+		metaData.scriptClass->addInternalCall("Internal_SetPackResources", (void*)&ScriptPlatformInfo::internal_SetPackResources);
+		metaData.scriptClass->addInternalCall("Internal_GetCompressTextures", (void*)&ScriptPlatformInfo::internal_GetCompressTextures);
+		metaData.scriptClass->addInternalCall("Internal_SetCompressTextures", (void*)&ScriptPlatformInfo::internal_SetCompressTextures);
+		metaData.scriptClass->addInternalCall("Internal_GetTextureMipsToSkip", (void*)&ScriptPlatformInfo::internal_GetTextureMipsToSkip);
+		metaData.scriptClass->addInternalCall("Internal_SetTextureMipsToSkip", (void*)&ScriptPlatformInfo::internal_SetTextureMipsToSkip);
+		metaData.scriptClass->addInternalCall("Internal_GetStripMeshTangents", (void*)&ScriptPlatformInfo::internal_GetStripMeshTangents);
+		metaData.scriptClass->addInternalCall("Internal_SetStripMeshTangents", (void*)&ScriptPlatformInfo::internal_SetStripMeshTangents);
+		metaData.scriptClass->addInternalCall("Internal_GetStripCPUCachedData", (void*)&ScriptPlatformInfo::internal_GetStripCPUCachedData);
+		metaData.scriptClass->addInternalCall("Internal_SetStripCPUCachedData", (void*)&ScriptPlatformInfo::internal_SetStripCPUCachedData);
 	}
 
 	MonoObject* ScriptPlatformInfo::create(const SPtr<PlatformInfo>& platformInfo)
@@ -117,6 +127,56 @@ namespace bs
 		thisPtr->getPlatformInfo()->debug = debug;
 	}
 
+	bool ScriptPlatformInfo::internal_GetPackResources(ScriptPlatformInfoBase* thisPtr)
+	{
+		return thisPtr->getPlatformInfo()->packResources;
+	}
+
+	void ScriptPlatformInfo::internal_SetPackResources(ScriptPlatformInfoBase* thisPtr, bool packResources)
+	{
+		thisPtr->getPlatformInfo()->packResources = packResources;
+	}
+
+	bool ScriptPlatformInfo::internal_GetCompressTextures(ScriptPlatformInfoBase* thisPtr)
+	{
+		return thisPtr->getPlatformInfo()->compressTextures;
+	}
+
+	void ScriptPlatformInfo::internal_SetCompressTextures(ScriptPlatformInfoBase* thisPtr, bool compressTextures)
+	{
+		thisPtr->getPlatformInfo()->compressTextures = compressTextures;
+	}
+
+	UINT32 ScriptPlatformInfo::internal_GetTextureMipsToSkip(ScriptPlatformInfoBase* thisPtr)
+	{
+		return thisPtr->getPlatformInfo()->textureMipsToSkip;
+	}
+
+	void ScriptPlatformInfo::internal_SetTextureMipsToSkip(ScriptPlatformInfoBase* thisPtr, UINT32 textureMipsToSkip)
+	{
+		thisPtr->getPlatformInfo()->textureMipsToSkip = textureMipsToSkip;
+	}
+
+	bool ScriptPlatformInfo::internal_GetStripMeshTangents(ScriptPlatformInfoBase* thisPtr)
+	{
+		return thisPtr->getPlatformInfo()->stripMeshTangents;
+	}
+
+	void ScriptPlatformInfo::internal_SetStripMeshTangents(ScriptPlatformInfoBase* thisPtr, bool stripMeshTangents)
+	{
+		thisPtr->getPlatformInfo()->stripMeshTangents = stripMeshTangents;
+	}
+
+	bool ScriptPlatformInfo::internal_GetStripCPUCachedData(ScriptPlatformInfoBase* thisPtr)
+	{
+		return thisPtr->getPlatformInfo()->stripCPUCachedData;
+	}
+
+	void ScriptPlatformInfo::internal_SetStripCPUCachedData(ScriptPlatformInfoBase* thisPtr, bool stripCPUCachedData)
+	{
+		thisPtr->getPlatformInfo()->stripCPUCachedData = stripCPUCachedData;
+	}
+
 	ScriptWinPlatformInfo::ScriptWinPlatformInfo(MonoObject* instance)
 		:ScriptObject(instance)
 	{
@@ -51,6 +51,16 @@ namespace bs
 		static void internal_SetResolution(ScriptPlatformInfoBase* thisPtr, UINT32 width, UINT32 height);
 		static bool internal_GetDebug(ScriptPlatformInfoBase* thisPtr);
 		static void internal_SetDebug(ScriptPlatformInfoBase* thisPtr, bool debug);
+		static bool internal_GetPackResources(ScriptPlatformInfoBase* thisPtr);
+		static void internal_SetPackResources(ScriptPlatformInfoBase* thisPtr, bool packResources);
+		static bool internal_GetCompressTextures(ScriptPlatformInfoBase* thisPtr);
+		static void internal_SetCompressTextures(ScriptPlatformInfoBase* thisPtr, bool compressTextures);
+		static UINT32 internal_GetTextureMipsToSkip(ScriptPlatformInfoBase* thisPtr);
+		static void internal_SetTextureMipsToSkip(ScriptPlatformInfoBase* thisPtr, UINT32 textureMipsToSkip);
+		static bool internal_GetStripMeshTangents(ScriptPlatformInfoBase* thisPtr);
+		static void internal_SetStripMeshTangents(ScriptPlatformInfoBase* thisPtr, bool stripMeshTangents);
+		static bool internal_GetStripCPUCachedData(ScriptPlatformInfoBase* thisPtr);
+		static void internal_SetStripCPUCachedData(ScriptPlatformInfoBase* thisPtr, bool stripCPUCachedData);
 	};
 
 	/**	Interop class between C++ & CLR for WinPlatformInfo. */
@@ -18,6 +18,9 @@ namespace bs
 		:ScriptObject(object), mCamera(camera), mSelectionRenderer(nullptr)
 	{
 		mSelectionRenderer = bs_new<SelectionRenderer>();
+
+		mSnapData.normal = Vector3::UNIT_Y;
+		mSnapData.pickPosition = Vector3::ZERO;
 	}
 
 	ScriptSceneSelection::~ScriptSceneSelection()
@@ -66,32 +69,40 @@ namespace bs
 			}
 		}
 
-		HSceneObject pickedObject = ScenePicking::instance().pickClosestObject(thisPtr->mCamera, *inputPos, Vector2I(1, 1), ignoredSceneObjects);
-		if (pickedObject)
+		// Selection is applied once the pick completes, without waiting on the core thread if the pick needs rendering
+		auto onPicked = [additive](const ScenePickOperation& operation)
 		{
-			if (additive) // Append to existing selection
+			const Vector<HSceneObject>& pickedObjects = operation.getObjects();
+			if (!pickedObjects.empty())
 			{
-				Vector<HSceneObject> selectedSOs = Selection::instance().getSceneObjects();
+				const HSceneObject& pickedObject = pickedObjects[0];
+				if (additive) // Append to existing selection
+				{
+					Vector<HSceneObject> selectedSOs = Selection::instance().getSceneObjects();
 
-				auto iterFind = std::find_if(selectedSOs.begin(), selectedSOs.end(),
-					[&](const HSceneObject& obj) { return obj == pickedObject; }
-				);
+					auto iterFind = std::find_if(selectedSOs.begin(), selectedSOs.end(),
+						[&](const HSceneObject& obj) { return obj == pickedObject; }
+					);
 
-				if (iterFind == selectedSOs.end())
-					selectedSOs.push_back(pickedObject);
+					if (iterFind == selectedSOs.end())
+						selectedSOs.push_back(pickedObject);
 
-				Selection::instance().setSceneObjects(selectedSOs);
+					Selection::instance().setSceneObjects(selectedSOs);
+				}
+				else
+				{
+					Vector<HSceneObject> selectedSOs = { pickedObject };
+					Selection::instance().setSceneObjects(selectedSOs);
+				}
 			}
-			else
+			else if (!additive)
 			{
-				Vector<HSceneObject> selectedSOs = { pickedObject };
-				Selection::instance().setSceneObjects(selectedSOs);
+				Selection::instance().clearSceneSelection();
 			}
-		}
-		else if (!additive)
-		{
-			Selection::instance().clearSceneSelection();
-		}
+		};
+
+		ScenePicking::instance().pickObjectsAsync(thisPtr->mCamera, *inputPos, Vector2I(1, 1), ignoredSceneObjects, 
+			onPicked);
 	}
 
 	void ScriptSceneSelection::internal_PickObjects(ScriptSceneSelection* thisPtr, Vector2I* inputPos, Vector2I* area, 
@@ -117,40 +128,44 @@ namespace bs
 			}
 		}
 
-		Vector<HSceneObject> pickedObjects = ScenePicking::instance().pickObjects(thisPtr->mCamera, *inputPos, 
-			*area, ignoredSceneObjects);
-
-		if (pickedObjects.size() != 0)
+		// Selection is applied once the pick completes, without waiting on the core thread if the pick needs rendering
+		auto onPicked = [additive](const ScenePickOperation& operation)
 		{
-			if (additive) // Append to existing selection
+			const Vector<HSceneObject>& pickedObjects = operation.getObjects();
+			if (pickedObjects.size() != 0)
 			{
-				Vector<HSceneObject> selectedSOs = Selection::instance().getSceneObjects();
-
-				for (int i = 0; i < (int)pickedObjects.size(); i++)
+				if (additive) // Append to existing selection
 				{
-					bool found = false;
-					for (int j = 0; j < (int)selectedSOs.size(); j++)
+					Vector<HSceneObject> selectedSOs = Selection::instance().getSceneObjects();
+
+					for (int i = 0; i < (int)pickedObjects.size(); i++)
 					{
-						if (selectedSOs[j] == pickedObjects[i])
+						bool found = false;
+						for (int j = 0; j < (int)selectedSOs.size(); j++)
 						{
-							found = true;
-							break;
+							if (selectedSOs[j] == pickedObjects[i])
+							{
+								found = true;
+								break;
+							}
 						}
+
+						if (!found)
+							selectedSOs.push_back(pickedObjects[i]);
 					}
 
-					if (!found)
-						selectedSOs.push_back(pickedObjects[i]);
+					Selection::instance().setSceneObjects(selectedSOs);
 				}
-
-				Selection::instance().setSceneObjects(selectedSOs);
+				else
+					Selection::instance().setSceneObjects(pickedObjects);
 			}
-			else
-				Selection::instance().setSceneObjects(pickedObjects);
-		}
-		else if (!additive)
-		{
-			Selection::instance().clearSceneSelection();
-		}
+			else if (!additive)
+			{
+				Selection::instance().clearSceneSelection();
+			}
+		};
+
+		ScenePicking::instance().pickObjectsAsync(thisPtr->mCamera, *inputPos, *area, ignoredSceneObjects, onPicked);
 	}
 
 	MonoObject* ScriptSceneSelection::internal_Snap(ScriptSceneSelection* thisPtr, Vector2I* inputPos, SnapData* data, 
@@ -176,10 +191,36 @@ namespace bs
 			}
 		}
 
-		HSceneObject instance = ScenePicking::instance().pickClosestObject(thisPtr->mCamera, *inputPos, Vector2I(1, 1), 
-			ignoredSceneObjects, data);
+		// Snapping is queried every frame while dragging, so rather than waiting for picks that need rendering to
+		// complete, report the results of the last completed pick. A new pick is started once the previous one is done.
+		if (thisPtr->mSnapOperation == nullptr)
+		{
+			thisPtr->mSnapOperation = ScenePicking::instance().pickObjectsAsync(thisPtr->mCamera, *inputPos, 
+				Vector2I(1, 1), ignoredSceneObjects, nullptr, true);
+		}
+
+		if (thisPtr->mSnapOperation->isComplete())
+		{
+			const Vector<HSceneObject>& pickedObjects = thisPtr->mSnapOperation->getObjects();
+			if (!pickedObjects.empty())
+			{
+				thisPtr->mSnapObject = pickedObjects[0];
+				thisPtr->mSnapData = thisPtr->mSnapOperation->getSnapData();
+
+				Matrix3 rotation;
+				thisPtr->mSnapObject->getTransform().getRotation().toRotationMatrix(rotation);
+				thisPtr->mSnapData.normal = rotation.inverse().transpose().multiply(thisPtr->mSnapData.normal);
+			}
+			else
+				thisPtr->mSnapObject = HSceneObject();
+
+			thisPtr->mSnapOperation = nullptr;
+		}
+
+		*data = thisPtr->mSnapData;
 
-		if (instance == nullptr)
+		HSceneObject instance = thisPtr->mSnapObject;
+		if (instance == nullptr || instance.isDestroyed())
 			return nullptr;
 
 		ScriptSceneObject* scriptSO = ScriptGameObjectManager::instance().getOrCreateScriptSceneObject(instance);
@@ -27,6 +27,11 @@ namespace bs
 		SPtr<Camera> mCamera;
 		SelectionRenderer* mSelectionRenderer;
 
+		// Snap pick in progress, and the results of the last completed one
+		SPtr<ScenePickOperation> mSnapOperation;
+		HSceneObject mSnapObject;
+		SnapData mSnapData;
+
 		/************************************************************************/
 		/* 								CLR HOOKS						   		*/
 		/************************************************************************/
@@ -17,6 +17,7 @@
 #include "Wrappers/BsScriptDebug.h"
 #include "Wrappers/GUI/BsScriptGUI.h"
 #include "BsPlayInEditorManager.h"
+#include "BsSceneLoader.h"
 #include "Wrappers/BsScriptScene.h"
 #include "GUI/BsGUIManager.h"
 
@@ -35,6 +36,7 @@ namespace bs
 		MonoAssembly& bansheeEngineAssembly = MonoManager::instance().loadAssembly(engineAssemblyPath.toString(), ENGINE_ASSEMBLY);
 
 		PlayInEditorManager::startUp();
+		SceneLoader::startUp();
 		ScriptDebug::startUp();
 		GameResourceManager::startUp();
 		ScriptObjectManager::startUp();
@@ -117,6 +119,7 @@ namespace bs
 		ScriptObjectManager::shutDown();
 		GameResourceManager::shutDown();
 		ScriptDebug::shutDown();
+		SceneLoader::shutDown();
 		PlayInEditorManager::shutDown();
 
 		// Make sure all GUI elements are actually destroyed
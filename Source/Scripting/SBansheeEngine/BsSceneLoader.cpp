@@ -0,0 +1,172 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSceneLoader.h"
+#include "Scene/BsPrefab.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsSceneManager.h"
+#include "Utility/BsSplashScreen.h"
+#include "Utility/BsTimer.h"
+
+namespace bs
+{
+	float SceneLoadOperation::getProgress() const
+	{
+		switch (mState)
+		{
+		case SceneLoadState::Instantiating:
+			return mNumToInstantiate > 0 ? mNumInstantiated / (float)mNumToInstantiate : 1.0f;
+		case SceneLoadState::Done:
+			return 1.0f;
+		default:
+			return 0.0f;
+		}
+	}
+
+	SPtr<SceneLoadOperation> SceneLoader::load(const HPrefab& scene, SceneLoadMode mode, bool showLoadingScreen)
+	{
+		SPtr<SceneLoadOperation> operation = bs_shared_ptr_new<SceneLoadOperation>();
+		operation->mScene = scene;
+		operation->mMode = mode;
+		operation->mShowLoadingScreen = showLoadingScreen;
+
+		mOperations.push_back(operation);
+		updateLoadingScreen();
+
+		return operation;
+	}
+
+	SPtr<SceneLoadOperation> SceneLoader::getActiveLoad() const
+	{
+		if (mOperations.empty())
+			return nullptr;
+
+		return mOperations.front();
+	}
+
+	void SceneLoader::update()
+	{
+		Timer timer;
+		auto isOverBudget = [this, &timer]() { return timer.getMicroseconds() / 1000.0f >= mTimeBudget; };
+
+		while (!mOperations.empty())
+		{
+			SPtr<SceneLoadOperation> operation = mOperations.front();
+			if (operation->mState == SceneLoadState::Queued)
+				operation->mState = SceneLoadState::LoadingResources;
+
+			if (operation->mState == SceneLoadState::LoadingResources)
+			{
+				if (operation->mScene.getUUID().empty())
+					operation->mState = SceneLoadState::Failed;
+				else if (!operation->mScene.isLoaded(true))
+					break;
+				else if (beginInstantiation(*operation))
+					operation->mState = SceneLoadState::Instantiating;
+				else
+					operation->mState = SceneLoadState::Failed;
+			}
+
+			if (operation->mState == SceneLoadState::Instantiating)
+			{
+				if (operation->mRoot.isDestroyed())
+					operation->mState = SceneLoadState::Failed;
+				else
+				{
+					// Always instantiate at least one object, so the load progresses no matter how small the budget.
+					// Moving a child to the new root removes it from the clone, so the next one is always first.
+					while (operation->mNumInstantiated < operation->mNumToInstantiate)
+					{
+						HSceneObject instance = operation->mClone->getChild(0);
+						instance->setParent(operation->mRoot, false);
+						instance->_instantiate();
+
+						operation->mNumInstantiated++;
+
+						if (isOverBudget())
+							break;
+					}
+
+					if (operation->mNumInstantiated == operation->mNumToInstantiate)
+						operation->mState = SceneLoadState::Done;
+				}
+			}
+
+			if (!operation->isDone())
+				break;
+
+			releaseClone(*operation);
+			mOperations.erase(mOperations.begin());
+			onLoadFinished(operation);
+
+			if (isOverBudget())
+				break;
+		}
+
+		updateLoadingScreen();
+	}
+
+	bool SceneLoader::beginInstantiation(SceneLoadOperation& operation)
+	{
+		HSceneObject source = operation.mScene->_getRoot();
+		if (source == nullptr)
+			return false;
+
+		// The scene is cloned as a whole without being instantiated, so any references between the top-level objects
+		// point to their clones, and the children of the clone are then instantiated one by one. Components on the root
+		// itself cannot be instantiated without its children, so such scenes are instantiated all at once.
+		HSceneObject root;
+		if (!source->getComponents().empty())
+			root = operation.mScene->instantiate();
+		else
+		{
+			root = SceneObject::create(source->getName());
+			root->setLocalTransform(source->getLocalTransform());
+
+			operation.mClone = source->clone(false);
+			operation.mNumToInstantiate = operation.mClone->getNumChildren();
+		}
+
+		if (root == nullptr)
+			return false;
+
+		// New scene objects are created under the current root, which is what additive loads need
+		if (operation.mMode == SceneLoadMode::Replace)
+		{
+			HSceneObject oldRoot = gSceneManager().getRootNode();
+
+			gSceneManager().setRootNode(root);
+			oldRoot->destroy();
+		}
+
+		operation.mRoot = root;
+		return true;
+	}
+
+	void SceneLoader::releaseClone(SceneLoadOperation& operation)
+	{
+		if (operation.mClone == nullptr)
+			return;
+
+		if (!operation.mClone.isDestroyed())
+			operation.mClone->destroy(true);
+
+		operation.mClone = nullptr;
+	}
+
+	void SceneLoader::updateLoadingScreen()
+	{
+		bool showLoadingScreen = false;
+		for (auto& operation : mOperations)
+			showLoadingScreen |= operation->mShowLoadingScreen;
+
+		if (showLoadingScreen == mIsLoadingScreenShown)
+			return;
+
+		if (showLoadingScreen)
+			SplashScreen::show();
+		else
+			SplashScreen::hide();
+
+		mIsLoadingScreenShown = showLoadingScreen;
+	}
+}
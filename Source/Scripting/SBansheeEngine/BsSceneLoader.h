@@ -0,0 +1,143 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsScriptEnginePrerequisites.h"
+#include "Utility/BsModule.h"
+
+namespace bs
+{
+	/** @addtogroup SBansheeEngine
+	 *  @{
+	 */
+
+	/** Determines what happens with the current scene when a new scene is loaded. */
+	enum class SceneLoadMode
+	{
+		Replace, /**< Current scene is destroyed and the loaded scene becomes the new root of the scene graph. */
+		Additive /**< Loaded scene is added to the current scene, under a scene object of its own. */
+	};
+
+	/** States a scene load can be in. */
+	enum class SceneLoadState
+	{
+		Queued, /**< Waiting for other scene loads to finish. */
+		LoadingResources, /**< Waiting for the scene prefab and its dependencies to load. */
+		Instantiating, /**< Instantiating the scene objects, a few at a time every frame. */
+		Done, /**< Scene is fully instantiated. */
+		Failed /**< Scene failed to load, or the object it was being instantiated into was destroyed. */
+	};
+
+	/** Scene load started with SceneLoader::load(). */
+	class BS_SCR_BE_EXPORT SceneLoadOperation
+	{
+	public:
+		/** Returns the scene prefab being loaded. */
+		const HPrefab& getScene() const { return mScene; }
+
+		/** Returns how is the scene being loaded. */
+		SceneLoadMode getMode() const { return mMode; }
+
+		/** Returns the current state of the load. */
+		SceneLoadState getState() const { return mState; }
+
+		/** Checks has the load finished, either successfully or not. */
+		bool isDone() const { return mState == SceneLoadState::Done || mState == SceneLoadState::Failed; }
+
+		/** Returns the fraction of the scene that has been instantiated, in range [0, 1]. */
+		float getProgress() const;
+
+		/**
+		 * Returns the scene object the scene is being instantiated in. Only valid once the load reaches the instantiation
+		 * state.
+		 */
+		const HSceneObject& getRoot() const { return mRoot; }
+
+	private:
+		friend class SceneLoader;
+
+		HPrefab mScene;
+		SceneLoadMode mMode = SceneLoadMode::Replace;
+		SceneLoadState mState = SceneLoadState::Queued;
+		bool mShowLoadingScreen = false;
+
+		HSceneObject mRoot;
+		HSceneObject mClone;
+		UINT32 mNumInstantiated = 0;
+		UINT32 mNumToInstantiate = 0;
+	};
+
+	/**
+	 * Loads scenes without stalling the application. Scenes are instantiated progressively over multiple frames, one
+	 * top-level scene object at a time, spending at most the time budget per frame. An optional loading screen can be
+	 * displayed until the load finishes.
+	 *
+	 * The whole scene is cloned at once when instantiation begins, so references between different top-level objects
+	 * resolve the same as with Prefab::instantiate(). Only adding the cloned objects to the scene and initializing
+	 * their components is spread over multiple frames.
+	 *
+	 * Loads are processed in the order they were started. Scene objects become active as soon as they are instantiated,
+	 * meaning components of an object might initialize before the rest of the scene exists.
+	 */
+	class BS_SCR_BE_EXPORT SceneLoader : public Module<SceneLoader>
+	{
+	public:
+		/**
+		 * Starts loading a scene. The scene prefab doesn't need to be loaded yet, but its load (along with the load of
+		 * its dependencies) must have been started by the caller, for example with an asynchronous Resources::load().
+		 *
+		 * @param[in]	scene				Prefab containing the scene to load.
+		 * @param[in]	mode				Determines what happens with the current scene.
+		 * @param[in]	showLoadingScreen	If true, a loading screen is displayed until the scene is fully loaded.
+		 * @return							Object that can be used for tracking the progress of the load.
+		 */
+		SPtr<SceneLoadOperation> load(const HPrefab& scene, SceneLoadMode mode, bool showLoadingScreen = false);
+
+		/** Checks is there any scene load in progress. */
+		bool isLoading() const { return !mOperations.empty(); }
+
+		/** Returns the scene load currently being processed, or null if no load is in progress. */
+		SPtr<SceneLoadOperation> getActiveLoad() const;
+
+		/** Sets the maximum amount of time to spend instantiating scene objects per frame, in milliseconds. */
+		void setTimeBudget(float budget) { mTimeBudget = budget; }
+
+		/** Returns the maximum amount of time to spend instantiating scene objects per frame, in milliseconds. */
+		float getTimeBudget() const { return mTimeBudget; }
+
+		/** Triggered when a scene load finishes, whether successfully or not. */
+		Event<void(const SPtr<SceneLoadOperation>&)> onLoadFinished;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Called once per frame. Advances the active scene load.
+		 *
+		 * @note	Internal method.
+		 */
+		void update();
+
+		/** @} */
+
+	private:
+		/**
+		 * Creates the scene object the scene is instantiated in, and determines which objects need to be instantiated.
+		 * Returns false if the scene cannot be instantiated.
+		 */
+		bool beginInstantiation(SceneLoadOperation& operation);
+
+		/** Destroys the part of the scene clone that wasn't instantiated yet, if any. */
+		void releaseClone(SceneLoadOperation& operation);
+
+		/** Shows or hides the loading screen, depending on whether any of the remaining loads requested it. */
+		void updateLoadingScreen();
+
+		Vector<SPtr<SceneLoadOperation>> mOperations;
+		float mTimeBudget = 4.0f;
+		bool mIsLoadingScreenShown = false;
+	};
+
+	/** @} */
+}
@@ -6,6 +6,7 @@
 #include "Script/BsScriptManager.h"
 #include "Wrappers/GUI/BsScriptGUI.h"
 #include "BsPlayInEditorManager.h"
+#include "BsSceneLoader.h"
 
 namespace bs
 {
@@ -26,7 +27,14 @@ namespace bs
 	extern "C" BS_SCR_BE_EXPORT void updatePlugin()
 	{
 		PlayInEditorManager::instance().update();
+		SceneLoader::instance().update();
 		ScriptObjectManager::instance().update();
 		ScriptGUI::update();
 	}
+
+	extern "C" BS_SCR_BE_EXPORT void loadScene(const HPrefab& scene, bool additive, bool showLoadingScreen)
+	{
+		SceneLoadMode mode = additive ? SceneLoadMode::Additive : SceneLoadMode::Replace;
+		SceneLoader::instance().load(scene, mode, showLoadingScreen);
+	}
 }
\ No newline at end of file
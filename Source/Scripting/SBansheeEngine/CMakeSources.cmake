@@ -11,6 +11,7 @@ set(BS_SBANSHEEENGINE_INC_NOFILTER
 	"BsScriptObjectManager.h"
 	"BsEngineScriptLibrary.h"
 	"BsPlayInEditorManager.h"
+	"BsSceneLoader.h"
 )
 
 set(BS_SBANSHEEENGINE_SRC_WRAPPERS_GUI
@@ -194,6 +195,7 @@ set(BS_SBANSHEEENGINE_SRC_NOFILTER
 	"BsScriptObjectManager.cpp"
 	"BsEngineScriptLibrary.cpp"
 	"BsPlayInEditorManager.cpp"
+	"BsSceneLoader.cpp"
 )
 
 set(BS_SBANSHEEENGINE_INC_RTTI
@@ -17,6 +17,7 @@
 #include "Wrappers/BsScriptPrefab.h"
 #include "Wrappers/BsScriptSceneObject.h"
 #include "BsScriptObjectManager.h"
+#include "BsSceneLoader.h"
 
 namespace bs
 {
@@ -34,6 +35,9 @@ namespace bs
 	void ScriptScene::initRuntimeData()
 	{
 		metaData.scriptClass->addInternalCall("Internal_LoadScene", (void*)&ScriptScene::internal_LoadScene);
+		metaData.scriptClass->addInternalCall("Internal_LoadSceneAsync", (void*)&ScriptScene::internal_LoadSceneAsync);
+		metaData.scriptClass->addInternalCall("Internal_IsLoading", (void*)&ScriptScene::internal_IsLoading);
+		metaData.scriptClass->addInternalCall("Internal_GetLoadProgress", (void*)&ScriptScene::internal_GetLoadProgress);
 		metaData.scriptClass->addInternalCall("Internal_GetRoot", (void*)&ScriptScene::internal_GetRoot);
 		metaData.scriptClass->addInternalCall("Internal_ClearScene", (void*)&ScriptScene::internal_ClearScene);
 		metaData.scriptClass->addInternalCall("Internal_GetMainCameraSO", (void*)&ScriptScene::internal_GetMainCameraSO);
@@ -80,6 +84,41 @@ namespace bs
 		}
 	}
 
+	MonoObject* ScriptScene::internal_LoadSceneAsync(MonoString* path, bool additive)
+	{
+		Path nativePath = MonoUtil::monoToString(path);
+
+		// Note: The prefab itself is still loaded synchronously, only its instantiation is spread over multiple frames
+		HPrefab prefab = GameResourceManager::instance().load<Prefab>(nativePath, true);
+		if (prefab.isLoaded(false))
+		{
+			SceneLoadMode mode = additive ? SceneLoadMode::Additive : SceneLoadMode::Replace;
+			SceneLoader::instance().load(prefab, mode);
+
+			ScriptResourceBase* scriptPrefab = ScriptResourceManager::instance().getScriptResource(prefab, true);
+			return scriptPrefab->getManagedInstance();
+		}
+		else
+		{
+			LOGERR("Failed loading scene at path: \"" + nativePath.toString() + "\"");
+			return nullptr;
+		}
+	}
+
+	bool ScriptScene::internal_IsLoading()
+	{
+		return SceneLoader::instance().isLoading();
+	}
+
+	float ScriptScene::internal_GetLoadProgress()
+	{
+		SPtr<SceneLoadOperation> operation = SceneLoader::instance().getActiveLoad();
+		if (operation == nullptr)
+			return 1.0f;
+
+		return operation->getProgress();
+	}
+
 	void ScriptScene::onRefreshStarted()
 	{
 		MonoMethod* uuidMethod = metaData.scriptClass->getMethod("GetSceneUUID");
@@ -43,6 +43,9 @@ namespace bs
 		/* 								CLR HOOKS						   		*/
 		/************************************************************************/
 		static MonoObject* internal_LoadScene(MonoString* path);
+		static MonoObject* internal_LoadSceneAsync(MonoString* path, bool additive);
+		static bool internal_IsLoading();
+		static float internal_GetLoadProgress();
 		static MonoObject* internal_GetRoot();
 		static void internal_ClearScene();
 		static MonoObject* internal_GetMainCameraSO();